@@ -29,7 +29,7 @@ namespace mitk
    * If only one M0 image is present normalization will be done by dividing the voxel value by the corresponding
    * M0 voxel value. If multiple M0 images are present normalization between any two M0 images will be done by
    * dividing by a linear interpolation between the two.
-   * The M0 images themselves will be removed from the result.
+   * The M0 images themselves will be removed from the result. The voxels are normalized in parallel.
    * The output image will have the same 3D geometry as the input image, a time geometry only consisting of non M0 images and a double pixel type.
    */
   class MITKCEST_EXPORT CESTImageNormalizationFilter : public ImageToImageFilter
@@ -20,6 +20,11 @@ found in the LICENSE file.
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 mitk::CESTImageNormalizationFilter::CESTImageNormalizationFilter()
 {
 }
@@ -87,24 +92,34 @@ void mitk::CESTImageNormalizationFilter::NormalizeTimeSteps(const itk::Image<TPi
     }
   }
 
+  if (mZeroIndices.empty())
+  {
+    mitkThrow() << "mitk::CESTImageNormalizationFilter: input has no normalization (M0) image.";
+  }
+
+  unsigned int numberOfTimesteps = image->GetLargestPossibleRegion().GetSize(3);
+  if (offsets.size() != numberOfTimesteps)
+  {
+    mitkThrow() << "mitk::CESTImageNormalizationFilter: number of offsets (" << offsets.size()
+                << ") does not match the number of time steps (" << numberOfTimesteps << ") of the input.";
+  }
+
   auto resultImage = OutputImageType::New();
   typename ImageType::RegionType targetEntireRegion = image->GetLargestPossibleRegion();
   targetEntireRegion.SetSize(3, m_NonM0Indices.size());
   resultImage->SetRegions(targetEntireRegion);
-  resultImage->Allocate();
-  resultImage->FillBuffer(0);
+  resultImage->Allocate(true);
 
-  unsigned int numberOfTimesteps = image->GetLargestPossibleRegion().GetSize(3);
+  // determine the M0 images and interpolation weight of every non M0 time step once
+  struct NormalizationStep
+  {
+    unsigned int sourceTimestep;
+    unsigned int lowerMZeroIndex;
+    unsigned int upperMZeroIndex;
+    double weight;
+  };
+  std::vector<NormalizationStep> normalizationSteps;
 
-  typename ImageType::RegionType lowerMZeroRegion = image->GetLargestPossibleRegion();
-  lowerMZeroRegion.SetSize(3, 1);
-  typename ImageType::RegionType upperMZeroRegion = image->GetLargestPossibleRegion();
-  upperMZeroRegion.SetSize(3, 1);
-  typename ImageType::RegionType sourceRegion = image->GetLargestPossibleRegion();
-  sourceRegion.SetSize(3, 1);
-  typename OutputImageType::RegionType targetRegion = resultImage->GetLargestPossibleRegion();
-  targetRegion.SetSize(3, 1);
-  unsigned int targetTimestep = 0;
   for (unsigned int sourceTimestep = 0; sourceTimestep < numberOfTimesteps; ++sourceTimestep)
   {
     unsigned int lowerMZeroIndex = mZeroIndices[0];
@@ -133,42 +148,66 @@ void mitk::CESTImageNormalizationFilter::NormalizeTimeSteps(const itk::Image<TPi
       weight = 1.0 - double(sourceTimestep - lowerMZeroIndex) / double(upperMZeroIndex - lowerMZeroIndex);
     }
 
-
-    if (isMZero)
+    if (!isMZero)
     {
-      //do nothing
+      normalizationSteps.push_back({ sourceTimestep, lowerMZeroIndex, upperMZeroIndex, weight });
     }
-    else
-    {
-      lowerMZeroRegion.SetIndex(3, lowerMZeroIndex);
-      upperMZeroRegion.SetIndex(3, upperMZeroIndex);
-      sourceRegion.SetIndex(3, sourceTimestep);
-      targetRegion.SetIndex(3, targetTimestep);
+  }
 
-      itk::ImageRegionConstIterator<ImageType> lowerMZeroIterator(image, lowerMZeroRegion);
-      itk::ImageRegionConstIterator<ImageType> upperMZeroIterator(image, upperMZeroRegion);
-      itk::ImageRegionConstIterator<ImageType> sourceIterator(image, sourceRegion);
-      itk::ImageRegionIterator<OutputImageType> targetIterator(resultImage.GetPointer(), targetRegion);
+  // Time steps are stored one after another, so the voxels are split into blocks. Each thread normalizes all time
+  // steps of a block at once, which keeps the M0 values of the block in the cache.
+  const typename ImageType::SizeType size = image->GetLargestPossibleRegion().GetSize();
+  const std::size_t numberOfVoxels = size[0] * size[1] * size[2];
+  const std::size_t blockSize = 4096;
+  const std::size_t numberOfBlocks = (numberOfVoxels + blockSize - 1) / blockSize;
 
-      while (!sourceIterator.IsAtEnd())
+  const TPixel *sourceBuffer = image->GetBufferPointer();
+  double *targetBuffer = resultImage->GetBufferPointer();
+  std::atomic<std::size_t> nextBlock(0);
+
+  auto normalizeBlocks = [&]()
+  {
+    for (std::size_t block = nextBlock++; block < numberOfBlocks; block = nextBlock++)
+    {
+      const std::size_t begin = block * blockSize;
+      const std::size_t end = std::min(begin + blockSize, numberOfVoxels);
+
+      for (std::size_t targetTimestep = 0; targetTimestep < normalizationSteps.size(); ++targetTimestep)
       {
-        double normalizationFactor = weight * lowerMZeroIterator.Get() + (1.0 - weight) * upperMZeroIterator.Get();
-        if (mitk::Equal(normalizationFactor, 0))
-        {
-          targetIterator.Set(0);
-        }
-        else
+        const NormalizationStep &step = normalizationSteps[targetTimestep];
+        const TPixel *lowerMZero = sourceBuffer + step.lowerMZeroIndex * numberOfVoxels;
+        const TPixel *upperMZero = sourceBuffer + step.upperMZeroIndex * numberOfVoxels;
+        const TPixel *source = sourceBuffer + step.sourceTimestep * numberOfVoxels;
+        double *target = targetBuffer + targetTimestep * numberOfVoxels;
+
+        for (std::size_t voxel = begin; voxel < end; ++voxel)
         {
-          targetIterator.Set(double(sourceIterator.Get()) / normalizationFactor);
+          double normalizationFactor = step.weight * lowerMZero[voxel] + (1.0 - step.weight) * upperMZero[voxel];
+          if (mitk::Equal(normalizationFactor, 0))
+          {
+            target[voxel] = 0;
+          }
+          else
+          {
+            target[voxel] = double(source[voxel]) / normalizationFactor;
+          }
         }
-
-        ++lowerMZeroIterator;
-        ++upperMZeroIterator;
-        ++sourceIterator;
-        ++targetIterator;
       }
-      ++targetTimestep;
     }
+  };
+
+  std::size_t numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  numberOfThreads = std::min(numberOfThreads, numberOfBlocks);
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back(normalizeBlocks);
+  }
+  normalizeBlocks();
+  for (auto &thread : threads)
+  {
+    thread.join();
   }
 
   // get  Pointer to output image
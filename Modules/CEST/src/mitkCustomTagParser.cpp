@@ -35,7 +35,10 @@ found in the LICENSE file.
 
 #include <algorithm>
 #include <cstdint>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -58,6 +61,124 @@ namespace
 
     return result;
   };
+
+  int HexDigitValue(char digit)
+  {
+    if (digit >= '0' && digit <= '9')
+      return digit - '0';
+    if (digit >= 'a' && digit <= 'f')
+      return digit - 'a' + 10;
+    if (digit >= 'A' && digit <= 'F')
+      return digit - 'A' + 10;
+    return -1;
+  }
+
+  /// decodes the hex encoded tag and extracts the parameters of its ASCCONV section
+  bool ParsePrivateParameters(const std::string &dicomPropertyString, std::map<std::string, std::string> &privateParameters)
+  {
+    // The Siemens private tag contains information like "43\52\23\34".
+    // We jump over each "\" and convert the number;
+    std::string bytes;
+
+    {
+      const std::size_t SUBSTR_LENGTH = 2;
+      const std::size_t INPUT_LENGTH = dicomPropertyString.length();
+
+      if (INPUT_LENGTH < SUBSTR_LENGTH)
+        return false;
+
+      const std::size_t MAX_INPUT_OFFSET = INPUT_LENGTH - SUBSTR_LENGTH;
+      bytes.reserve(INPUT_LENGTH / 3 + 1);
+
+      for (std::size_t i = 0; i <= MAX_INPUT_OFFSET; i += 3)
+      {
+        const int high = HexDigitValue(dicomPropertyString[i]);
+        if (high < 0)
+          return false;
+
+        const int low = HexDigitValue(dicomPropertyString[i + 1]);
+        bytes.push_back(static_cast<std::string::value_type>(low < 0 ? high : high * 16 + low));
+      }
+    }
+
+    // extract parameter list
+    std::string parameterListString;
+
+    {
+      const std::string ASCCONV_BEGIN = "### ASCCONV BEGIN ###";
+      const std::string ASCCONV_END = "### ASCCONV END ###";
+
+      auto offset = bytes.find(ASCCONV_BEGIN);
+
+      if (std::string::npos == offset)
+        return false;
+
+      offset += ASCCONV_BEGIN.length();
+
+      auto count = bytes.find(ASCCONV_END, offset);
+
+      if (std::string::npos == count)
+        return false;
+
+      count -= offset;
+
+      parameterListString = bytes.substr(offset, count);
+    }
+
+    boost::replace_all(parameterListString, "\r\n", "\n");
+    boost::char_separator<char> newlineSeparator("\n");
+    boost::tokenizer<boost::char_separator<char>> parameters(parameterListString, newlineSeparator);
+    for (const auto &parameter : parameters)
+    {
+      std::vector<std::string> parts;
+      boost::split(parts, parameter, boost::is_any_of("="));
+
+      if (parts.size() == 2)
+      {
+        parts[0].erase(std::remove(parts[0].begin(), parts[0].end(), ' '), parts[0].end());
+        parts[1].erase(parts[1].begin(), parts[1].begin() + 1); // first character is a space
+        privateParameters[parts[0]] = parts[1];
+      }
+    }
+
+    return true;
+  }
+
+  typedef std::shared_ptr<const std::map<std::string, std::string>> PrivateParametersPointer;
+
+  std::mutex privateParametersCacheMutex;
+  std::list<std::pair<std::string, PrivateParametersPointer>> privateParametersCache;
+  const std::size_t MAXIMUM_PRIVATE_PARAMETERS_CACHE_SIZE = 8;
+
+  /// All images of a series share the private tag, so the parameters are cached by tag value. Loading a series
+  /// parses the tag several times (e.g. for the mime type check and by the reader). Returns nullptr if the tag
+  /// contains no parameters.
+  PrivateParametersPointer GetPrivateParameters(const std::string &dicomPropertyString)
+  {
+    {
+      std::lock_guard<std::mutex> lock(privateParametersCacheMutex);
+      for (auto iter = privateParametersCache.begin(); iter != privateParametersCache.end(); ++iter)
+      {
+        if (iter->first == dicomPropertyString)
+        {
+          privateParametersCache.splice(privateParametersCache.begin(), privateParametersCache, iter);
+          return iter->second;
+        }
+      }
+    }
+
+    auto privateParameters = std::make_shared<std::map<std::string, std::string>>();
+    PrivateParametersPointer result;
+    if (ParsePrivateParameters(dicomPropertyString, *privateParameters))
+      result = privateParameters;
+
+    std::lock_guard<std::mutex> lock(privateParametersCacheMutex);
+    privateParametersCache.emplace_front(dicomPropertyString, result);
+    if (privateParametersCache.size() > MAXIMUM_PRIVATE_PARAMETERS_CACHE_SIZE)
+      privateParametersCache.pop_back();
+
+    return result;
+  }
 }
 
 const std::string mitk::CustomTagParser::m_CESTPropertyPrefix = "CEST.";
@@ -252,76 +373,11 @@ mitk::PropertyList::Pointer mitk::CustomTagParser::ParseDicomPropertyString(std:
     return results;
   }
 
-  std::map<std::string, std::string> privateParameters;
-
-  // The Siemens private tag contains information like "43\52\23\34".
-  // We jump over each "\" and convert the number;
-  std::string bytes;
-
-  {
-    const std::size_t SUBSTR_LENGTH = 2;
-    const std::size_t INPUT_LENGTH = dicomPropertyString.length();
-
-    if (INPUT_LENGTH < SUBSTR_LENGTH)
-      return results;
-
-    const std::size_t MAX_INPUT_OFFSET = INPUT_LENGTH - SUBSTR_LENGTH;
-    bytes.reserve(INPUT_LENGTH / 3 + 1);
-
-    try
-    {
-      for (std::size_t i = 0; i <= MAX_INPUT_OFFSET; i += 3)
-      {
-        std::string byte_string = dicomPropertyString.substr(i, SUBSTR_LENGTH);
-        int byte = static_cast<std::string::value_type>(std::stoi(byte_string.c_str(), nullptr, 16));
-        bytes.push_back(byte);
-      }
-    }
-    catch (const std::invalid_argument&) // std::stoi() could not perform conversion
-    {
-      return results;
-    }
-  }
-
-  // extract parameter list
-  std::string parameterListString;
-
-  {
-    const std::string ASCCONV_BEGIN = "### ASCCONV BEGIN ###";
-    const std::string ASCCONV_END = "### ASCCONV END ###";
-
-    auto offset = bytes.find(ASCCONV_BEGIN);
-
-    if (std::string::npos == offset)
-      return results;
-
-    offset += ASCCONV_BEGIN.length();
-
-    auto count = bytes.find(ASCCONV_END, offset);
-
-    if (std::string::npos == count)
-      return results;
-
-    count -= offset;
-
-    parameterListString = bytes.substr(offset, count);
-  }
-
-  boost::replace_all(parameterListString, "\r\n", "\n");
-  boost::char_separator<char> newlineSeparator("\n");
-  boost::tokenizer<boost::char_separator<char>> parameters(parameterListString, newlineSeparator);
-  for (const auto &parameter : parameters)
-  {
-    std::vector<std::string> parts;
-    boost::split(parts, parameter, boost::is_any_of("="));
+  auto cachedParameters = GetPrivateParameters(dicomPropertyString);
+  if (!cachedParameters)
+    return results;
 
-    if (parts.size() == 2)
-    {
-      parts[0].erase(std::remove(parts[0].begin(), parts[0].end(), ' '), parts[0].end());
-      parts[1].erase(parts[1].begin(), parts[1].begin() + 1); // first character is a space
-      privateParameters[parts[0]] = parts[1];
-    }
-  }
+  std::map<std::string, std::string> privateParameters = *cachedParameters;
 
   std::string revisionString = "";
 
@@ -0,0 +1,130 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// std includes
+#include <algorithm>
+
+// MITK includes
+#include <mitkCESTImageNormalizationFilter.h>
+#include <mitkCESTPropertyHelper.h>
+#include <mitkITKImageImport.h>
+#include <mitkImageCast.h>
+#include <mitkStringProperty.h>
+
+// ITK includes
+#include <itkImage.h>
+
+class mitkCESTImageNormalizationFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCESTImageNormalizationFilterTestSuite);
+
+  MITK_TEST(NormalizeBetweenTwoM0Images_Success);
+  MITK_TEST(NormalizeWithoutM0Image_Failure);
+  MITK_TEST(NormalizeWithWrongNumberOfOffsets_Failure);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<short, 4> InputImageType;
+  typedef itk::Image<double, 4> OutputImageType;
+
+  mitk::Image::Pointer m_CESTImage;
+
+  /** Creates an image whose time steps have the same value in every voxel, except for the first voxel of the M0
+   images (time steps 0 and 3), which is 0.*/
+  mitk::Image::Pointer CreateCESTImage(const std::string &offsets)
+  {
+    // more voxels than the filter processes in one block
+    InputImageType::SizeType size = {{70, 70, 2, 4}};
+    InputImageType::Pointer image = InputImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+
+    const short values[4] = {100, 50, 80, 400};
+    const std::size_t numberOfVoxels = size[0] * size[1] * size[2];
+    for (unsigned int timestep = 0; timestep < 4; ++timestep)
+    {
+      std::fill_n(image->GetBufferPointer() + timestep * numberOfVoxels, numberOfVoxels, values[timestep]);
+    }
+    image->GetBufferPointer()[0] = 0;
+    image->GetBufferPointer()[3 * numberOfVoxels] = 0;
+
+    mitk::Image::Pointer result = mitk::GrabItkImageMemory(image.GetPointer());
+    result->SetProperty(mitk::CEST_PROPERTY_NAME_OFFSETS().c_str(), mitk::StringProperty::New(offsets));
+    return result;
+  }
+
+public:
+  void setUp() override
+  {
+  }
+
+  void tearDown() override
+  {
+    m_CESTImage = nullptr;
+  }
+
+  void NormalizeBetweenTwoM0Images_Success()
+  {
+    m_CESTImage = this->CreateCESTImage("-300 1 2 -300");
+
+    auto normalizationFilter = mitk::CESTImageNormalizationFilter::New();
+    normalizationFilter->SetInput(m_CESTImage);
+    normalizationFilter->Update();
+    mitk::Image::Pointer normalizedImage = normalizationFilter->GetOutput();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("M0 images are removed.", 2u, normalizedImage->GetTimeSteps());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Offsets of M0 images are removed.",
+                                 std::string("1 2 "),
+                                 normalizedImage->GetProperty(mitk::CEST_PROPERTY_NAME_OFFSETS().c_str())->GetValueAsString());
+
+    OutputImageType::Pointer result;
+    mitk::CastToItkImage(normalizedImage, result);
+
+    const std::size_t numberOfVoxels = 70 * 70 * 2;
+    const double *buffer = result->GetBufferPointer();
+
+    // time step 1 is normalized by 2/3 * 100 + 1/3 * 400, time step 2 by 1/3 * 100 + 2/3 * 400
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(50.0 / 200.0, buffer[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(50.0 / 200.0, buffer[numberOfVoxels - 1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(80.0 / 300.0, buffer[numberOfVoxels + 1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(80.0 / 300.0, buffer[2 * numberOfVoxels - 1], mitk::eps);
+
+    // normalization by 0 results in 0
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, buffer[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, buffer[numberOfVoxels], mitk::eps);
+  }
+
+  void NormalizeWithoutM0Image_Failure()
+  {
+    m_CESTImage = this->CreateCESTImage("3 1 2 -1");
+
+    auto normalizationFilter = mitk::CESTImageNormalizationFilter::New();
+    normalizationFilter->SetInput(m_CESTImage);
+    CPPUNIT_ASSERT_THROW(normalizationFilter->Update(), mitk::Exception);
+  }
+
+  void NormalizeWithWrongNumberOfOffsets_Failure()
+  {
+    m_CESTImage = this->CreateCESTImage("-300 1 2 -300 3");
+
+    auto normalizationFilter = mitk::CESTImageNormalizationFilter::New();
+    normalizationFilter->SetInput(m_CESTImage);
+    CPPUNIT_ASSERT_THROW(normalizationFilter->Update(), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCESTImageNormalizationFilter)
@@ -61,9 +61,10 @@ mitk::ContourElement::VertexIterator mitk::ContourElement::end()
 mitk::ContourElement::ContourElement(const mitk::ContourElement &other)
   : itk::LightObject(), m_IsClosed(other.m_IsClosed)
 {
+  this->Reserve(other.GetSize());
   for (const auto &v : other.m_Vertices)
   {
-    m_Vertices.push_back(new ContourModelVertex(*v));
+    m_Vertices.push_back(this->CreateVertex(v->Coordinates, v->IsControlPoint));
   }
 }
 
@@ -72,9 +73,10 @@ mitk::ContourElement &mitk::ContourElement::operator=(const ContourElement &othe
   if (this != &other)
   {
     this->Clear();
+    this->Reserve(other.GetSize());
     for (const auto &v : other.m_Vertices)
     {
-      m_Vertices.push_back(new ContourModelVertex(*v));
+      m_Vertices.push_back(this->CreateVertex(v->Coordinates, v->IsControlPoint));
     }
   }
 
@@ -92,14 +94,84 @@ mitk::ContourElement::VertexSizeType mitk::ContourElement::GetSize() const
   return this->m_Vertices.size();
 }
 
+void mitk::ContourElement::Reserve(VertexSizeType numberOfVertices)
+{
+  VertexSizeType available = this->m_NumberOfFreeVertices;
+  if (!this->m_VertexBlocks.empty())
+  {
+    const auto &vertices = this->m_VertexBlocks.back().Vertices;
+    available += vertices.capacity() - vertices.size();
+  }
+
+  if (numberOfVertices > available)
+  {
+    this->m_VertexBlocks.emplace_back();
+    this->m_VertexBlocks.back().Vertices.reserve(numberOfVertices);
+  }
+}
+
+mitk::ContourElement::VertexType *mitk::ContourElement::CreateVertex(const mitk::Point3D &point, bool isControlPoint)
+{
+  if (0 != this->m_NumberOfFreeVertices)
+  {
+    // the most recent blocks are the most likely ones to have free vertices
+    for (auto block = this->m_VertexBlocks.rbegin(); block != this->m_VertexBlocks.rend(); ++block)
+    {
+      if (block->FreeVertices.empty())
+        continue;
+
+      VertexType *vertex = block->FreeVertices.back();
+      block->FreeVertices.pop_back();
+      --this->m_NumberOfFreeVertices;
+
+      vertex->Coordinates = point;
+      vertex->IsControlPoint = isControlPoint;
+      return vertex;
+    }
+  }
+
+  if (this->m_VertexBlocks.empty() ||
+      this->m_VertexBlocks.back().Vertices.size() == this->m_VertexBlocks.back().Vertices.capacity())
+  {
+    // grow geometrically, so that a contour consists of few blocks
+    this->m_VertexBlocks.emplace_back();
+    this->m_VertexBlocks.back().Vertices.reserve(std::max<VertexSizeType>(64, this->m_Vertices.size()));
+  }
+
+  auto &vertices = this->m_VertexBlocks.back().Vertices;
+  vertices.emplace_back(point, isControlPoint);
+  return &vertices.back();
+}
+
+void mitk::ContourElement::ReleaseVertex(VertexType *vertex)
+{
+  auto block = std::find_if(this->m_VertexBlocks.begin(), this->m_VertexBlocks.end(), [vertex](const VertexBlock &b) {
+    return !b.Vertices.empty() && vertex >= b.Vertices.data() && vertex < b.Vertices.data() + b.Vertices.size();
+  });
+
+  if (block == this->m_VertexBlocks.end())
+    mitkThrow() << "Vertex does not belong to this contour element.";
+
+  if (block->FreeVertices.size() + 1 == block->Vertices.size())
+  {
+    // all vertices of the block were removed, so its memory is given back
+    this->m_NumberOfFreeVertices -= block->FreeVertices.size();
+    this->m_VertexBlocks.erase(block);
+    return;
+  }
+
+  block->FreeVertices.push_back(vertex);
+  ++this->m_NumberOfFreeVertices;
+}
+
 void mitk::ContourElement::AddVertex(const mitk::Point3D &vertex, bool isControlPoint)
 {
-  this->m_Vertices.push_back(new VertexType(vertex, isControlPoint));
+  this->m_Vertices.push_back(this->CreateVertex(vertex, isControlPoint));
 }
 
 void mitk::ContourElement::AddVertexAtFront(const mitk::Point3D &vertex, bool isControlPoint)
 {
-  this->m_Vertices.push_front(new VertexType(vertex, isControlPoint));
+  this->m_Vertices.push_front(this->CreateVertex(vertex, isControlPoint));
 }
 
 void mitk::ContourElement::InsertVertexAtIndex(const mitk::Point3D &vertex, bool isControlPoint, VertexSizeType index)
@@ -108,7 +180,7 @@ void mitk::ContourElement::InsertVertexAtIndex(const mitk::Point3D &vertex, bool
   {
     auto _where = this->m_Vertices.begin();
     _where += index;
-    this->m_Vertices.insert(_where, new VertexType(vertex, isControlPoint));
+    this->m_Vertices.insert(_where, this->CreateVertex(vertex, isControlPoint));
   }
 }
 
@@ -362,7 +434,16 @@ void mitk::ContourElement::Concatenate(const mitk::ContourElement *other, bool c
 {
   if (other->GetSize() > 0)
   {
-    for (const auto &sourceVertex : other->m_Vertices)
+    // the vertex list of this contour changes while iterating, so concatenating a contour with itself needs a copy
+    VertexListType ownVertices;
+    if (other == this)
+    {
+      ownVertices = this->m_Vertices;
+    }
+    const VertexListType &sourceVertices = other == this ? ownVertices : other->m_Vertices;
+
+    this->Reserve(other->GetSize());
+    for (const auto &sourceVertex : sourceVertices)
     {
       if (check)
       {
@@ -373,12 +454,12 @@ void mitk::ContourElement::Concatenate(const mitk::ContourElement *other, bool c
 
         if (finding == this->m_Vertices.end())
         {
-          this->m_Vertices.push_back(new ContourModelVertex(*sourceVertex));
+          this->m_Vertices.push_back(this->CreateVertex(sourceVertex->Coordinates, sourceVertex->IsControlPoint));
         }
       }
       else
       {
-        this->m_Vertices.push_back(new ContourModelVertex(*sourceVertex));
+        this->m_Vertices.push_back(this->CreateVertex(sourceVertex->Coordinates, sourceVertex->IsControlPoint));
       }
     }
   }
@@ -433,7 +514,7 @@ bool mitk::ContourElement::RemoveVertexByIterator(VertexListType::iterator &iter
 {
   if (iter != this->m_Vertices.end())
   {
-    delete *iter;
+    this->ReleaseVertex(*iter);
     this->m_Vertices.erase(iter);
     return true;
   }
@@ -443,11 +524,9 @@ bool mitk::ContourElement::RemoveVertexByIterator(VertexListType::iterator &iter
 
 void mitk::ContourElement::Clear()
 {
-  for (auto vertex : m_Vertices)
-  {
-    delete vertex;
-  }
   this->m_Vertices.clear();
+  this->m_VertexBlocks.clear();
+  this->m_NumberOfFreeVertices = 0;
 }
 
 //----------------------------------------------------------------------
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <mitkNumericTypes.h>
 
 #include <deque>
+#include <vector>
 
 namespace mitk
 {
@@ -26,6 +27,11 @@ namespace mitk
   end of the contour and to iterate in both directions.
   To mark a vertex as a special one it can be set as a control point.
 
+  The vertex instances themselves are allocated in blocks owned by the ContourElement, so the
+  vertices of a contour are contiguous in memory and adding, copying or clearing a contour does
+  not allocate or free every vertex separately. Vertex pointers stay valid until the vertex is
+  removed or the contour is cleared.
+
   \note This class assumes that it manages its vertices. So if a vertex instance is added to this
   class the ownership of the vertex is transfered to the ContourElement instance.
   The ContourElement instance takes care of deleting vertex instances if needed.
@@ -105,6 +111,11 @@ namespace mitk
     */
     VertexSizeType GetSize() const;
 
+    /** \brief Prepares the storage for the given number of additional vertices,
+    so that they are allocated contiguously.
+    */
+    void Reserve(VertexSizeType numberOfVertices);
+
     /** \brief Add a vertex at the end of the contour
     \param point - coordinates in 3D space.
     \param isControlPoint - is the vertex a special control point.
@@ -281,8 +292,26 @@ namespace mitk
     \result Indicates if the element indicated by the iterator was removed. If iterator points to end it returns false.*/
     bool RemoveVertexByIterator(VertexListType::iterator& iter);
 
+    /** Internal helper functions to allocate a vertex from the vertex blocks and to give it back.*/
+    VertexType *CreateVertex(const mitk::Point3D &point, bool isControlPoint);
+    void ReleaseVertex(VertexType *vertex);
+
     VertexListType m_Vertices; // double ended queue with vertices
     bool m_IsClosed = false;
+
+  private:
+    /** A block of vertex instances. It is never resized beyond its capacity, so pointers to its vertices
+    stay valid. Removed vertices are kept in FreeVertices until they are reused or the whole block is released.*/
+    struct VertexBlock
+    {
+      std::vector<VertexType> Vertices;
+      std::vector<VertexType *> FreeVertices;
+    };
+
+    /** Storage of the vertex instances. Vertices that were removed are reused before a new block is created,
+    and a block is released as soon as all of its vertices were removed.*/
+    std::vector<VertexBlock> m_VertexBlocks;
+    VertexSizeType m_NumberOfFreeVertices = 0;
   };
 } // namespace mitk
 
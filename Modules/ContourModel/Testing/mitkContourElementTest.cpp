@@ -33,6 +33,7 @@ class mitkContourElementTestSuite : public mitk::TestFixture
   MITK_TEST(GetControlVertices);
   MITK_TEST(RedistributeControlVertices);
   MITK_TEST(Others);
+  MITK_TEST(VertexStorage);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -344,6 +345,56 @@ public:
     CPPUNIT_ASSERT(m_Contour5to6->GetSize() == copyConstructed->GetSize());
   }
 
+  void VertexStorage()
+  {
+    // vertex pointers have to stay valid while the contour grows beyond its first storage blocks
+    auto firstVertex = m_Contour1to4->GetVertexAt(0);
+    for (int i = 0; i < 1000; ++i)
+    {
+      m_Contour1to4->AddVertex(GeneratePoint(i), i % 10 == 0);
+      m_Contour1to4->AddVertexAtFront(GeneratePoint(-i), false);
+    }
+    CPPUNIT_ASSERT(m_Contour1to4->GetSize() == 2004);
+    CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(1000) == firstVertex);
+    CPPUNIT_ASSERT(firstVertex->Coordinates == m_p1);
+    CPPUNIT_ASSERT(firstVertex->IsControlPoint);
+
+    // removed vertices are reused
+    auto removedVertex = m_Contour1to4->GetVertexAt(5);
+    CPPUNIT_ASSERT(m_Contour1to4->RemoveVertex(removedVertex));
+    m_Contour1to4->AddVertex(m_p7, true);
+    CPPUNIT_ASSERT(m_Contour1to4->GetSize() == 2004);
+    CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(2003)->Coordinates == m_p7);
+    CPPUNIT_ASSERT(m_Contour1to4->GetIndex(firstVertex) == 999);
+
+    mitk::ContourElement::Pointer copy = m_Contour1to4->Clone();
+    CPPUNIT_ASSERT(copy->GetSize() == m_Contour1to4->GetSize());
+    for (mitk::ContourElement::VertexSizeType i = 0; i < copy->GetSize(); ++i)
+    {
+      CPPUNIT_ASSERT(*(copy->GetVertexAt(i)) == *(m_Contour1to4->GetVertexAt(i)));
+      CPPUNIT_ASSERT(copy->GetVertexAt(i) != m_Contour1to4->GetVertexAt(i));
+    }
+
+    // removing all other vertices releases their blocks, the remaining vertex stays valid
+    while (m_Contour1to4->GetSize() > 1)
+      CPPUNIT_ASSERT(m_Contour1to4->RemoveVertexAt(m_Contour1to4->GetVertexAt(0) == firstVertex ? 1 : 0));
+    CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(0) == firstVertex);
+    CPPUNIT_ASSERT(firstVertex->Coordinates == m_p1);
+
+    for (int i = 0; i < 200; ++i)
+      m_Contour1to4->AddVertex(GeneratePoint(i), false);
+    CPPUNIT_ASSERT(m_Contour1to4->GetSize() == 201);
+    CPPUNIT_ASSERT(firstVertex->Coordinates == m_p1);
+    for (int i = 0; i < 200; ++i)
+      CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(i + 1)->Coordinates == GeneratePoint(i));
+
+    m_Contour1to4->Reserve(100);
+    m_Contour1to4->Clear();
+    CPPUNIT_ASSERT(m_Contour1to4->IsEmpty());
+    m_Contour1to4->AddVertex(m_p2, false);
+    CPPUNIT_ASSERT(m_Contour1to4->GetVertexAt(0)->Coordinates == m_p2);
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkContourElement)
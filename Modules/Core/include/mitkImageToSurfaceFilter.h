@@ -23,6 +23,7 @@ found in the LICENSE file.
 #include <vtkImageData.h>
 
 #include <vtkMarchingCubes.h>
+#include <vtkSmartPointer.h>
 #include <vtkSmoothPolyDataFilter.h>
 
 namespace mitk
@@ -170,6 +171,22 @@ namespace mitk
      */
     itkGetConstMacro(TargetReduction, float);
 
+    /**
+     * Set the edge length (in voxels) of the blocks in which the image is meshed. Neighboring blocks
+     * share one layer of voxels, so that their meshes have identical vertices on the common face and
+     * are stitched seamlessly. Smoothing and decimation are applied per block and keep the vertices on
+     * the block faces in place. Hence, the full resolution mesh of the whole image is never held in memory.
+     * As vtkQuadricDecimation cannot preserve the block faces, QuadricDecimation is replaced by
+     * DecimatePro in this mode.
+     * 0 (default) meshes the whole image at once.
+     */
+    itkSetMacro(BlockSize, unsigned int);
+
+    /**
+     * Returns the edge length of the blocks in which the image is meshed (0 if it is meshed at once).
+     */
+    itkGetConstMacro(BlockSize, unsigned int);
+
     /**
      * Transforms a point by a 4x4 matrix
      */
@@ -208,6 +225,24 @@ namespace mitk
      */
     void CreateSurface(int time, vtkImageData *vtkimage, mitk::Surface *surface, const ScalarType threshold);
 
+    /**
+     * Creates the surface block by block (see SetBlockSize()). Called by CreateSurface() if a block size is set.
+     */
+    void CreateSurfaceBlockwise(int time, vtkImageData *vtkimage, mitk::Surface *surface, const ScalarType threshold);
+
+    /**
+     * Returns the extent and spacing of the grid which is split into blocks. By default, this is the
+     * grid of vtkimage. Subclasses that resample the image have to override this method.
+     */
+    virtual void GetBlockGrid(vtkImageData *vtkimage, int extent[6], double spacing[3]);
+
+    /**
+     * Returns the image data of the given block. The extent is given in index coordinates of the grid
+     * returned by GetBlockGrid() and the returned image must have exactly this extent. By default, the
+     * block is copied out of vtkimage. Subclasses override this method to pre-process the image block-wise.
+     */
+    virtual vtkSmartPointer<vtkImageData> CreateBlock(vtkImageData *vtkimage, const int extent[6]);
+
     /**
     * Flag whether the created surface shall be smoothed or not (default is "false"). SetSmooth (bool _arg)
     * */
@@ -240,6 +275,11 @@ namespace mitk
     * smoothRelaxation)
     * */
     float m_SmoothRelaxation;
+
+    /**
+    * The edge length of the blocks in which the image is meshed. See also SetBlockSize (unsigned int _arg)
+    * */
+    unsigned int m_BlockSize;
   };
 
 } // namespace mitk
@@ -12,8 +12,10 @@ found in the LICENSE file.
 
 #include "mitkException.h"
 #include <mitkImageToSurfaceFilter.h>
+#include <vtkAppendPolyData.h>
 #include <vtkDecimatePro.h>
 #include <vtkImageChangeInformation.h>
+#include <vtkImageClip.h>
 #include <vtkImageData.h>
 #include <vtkLinearTransform.h>
 #include <vtkMath.h>
@@ -26,13 +28,16 @@ found in the LICENSE file.
 
 #include "mitkProgressBar.h"
 
+#include <algorithm>
+
 mitk::ImageToSurfaceFilter::ImageToSurfaceFilter()
   : m_Smooth(false),
     m_Decimate(NoDecimation),
     m_Threshold(1.0),
     m_TargetReduction(0.95f),
     m_SmoothIteration(50),
-    m_SmoothRelaxation(0.1)
+    m_SmoothRelaxation(0.1),
+    m_BlockSize(0)
 {
 }
 
@@ -45,6 +50,12 @@ void mitk::ImageToSurfaceFilter::CreateSurface(int time,
                                                mitk::Surface *surface,
                                                const ScalarType threshold)
 {
+  if (m_BlockSize > 0)
+  {
+    this->CreateSurfaceBlockwise(time, vtkimage, surface, threshold);
+    return;
+  }
+
   vtkImageChangeInformation *indexCoordinatesImageFilter = vtkImageChangeInformation::New();
   indexCoordinatesImageFilter->SetInputData(vtkimage);
   indexCoordinatesImageFilter->SetOutputOrigin(0.0, 0.0, 0.0);
@@ -162,6 +173,169 @@ void mitk::ImageToSurfaceFilter::CreateSurface(int time,
   polydata->UnRegister(nullptr);
 }
 
+void mitk::ImageToSurfaceFilter::CreateSurfaceBlockwise(int time,
+                                                        vtkImageData *vtkimage,
+                                                        mitk::Surface *surface,
+                                                        const ScalarType threshold)
+{
+  int gridExtent[6];
+  double gridSpacing[3];
+  this->GetBlockGrid(vtkimage, gridExtent, gridSpacing);
+
+  mitk::Vector3D spacing = GetInput()->GetGeometry(time)->GetSpacing();
+
+  vtkSmartPointer<vtkMatrix4x4> vtkmatrix = vtkSmartPointer<vtkMatrix4x4>::New();
+  GetInput()->GetGeometry(time)->GetVtkTransform()->GetMatrix(vtkmatrix);
+  double(*matrix)[4] = vtkmatrix->Element;
+
+  for (unsigned int i = 0; i < 3; ++i)
+    for (unsigned int j = 0; j < 3; ++j)
+      matrix[i][j] /= spacing[j];
+
+  vtkSmartPointer<vtkAppendPolyData> appendFilter = vtkSmartPointer<vtkAppendPolyData>::New();
+  const int blockSize = static_cast<int>(m_BlockSize);
+  int blockExtent[6];
+
+  // Neighboring blocks share the voxels of their common face, so that every cell of the grid
+  // is meshed exactly once and the vertices on the face are created identically in both blocks
+  for (blockExtent[4] = gridExtent[4]; blockExtent[4] < gridExtent[5]; blockExtent[4] += blockSize)
+  {
+    blockExtent[5] = std::min(blockExtent[4] + blockSize, gridExtent[5]);
+
+    for (blockExtent[2] = gridExtent[2]; blockExtent[2] < gridExtent[3]; blockExtent[2] += blockSize)
+    {
+      blockExtent[3] = std::min(blockExtent[2] + blockSize, gridExtent[3]);
+
+      for (blockExtent[0] = gridExtent[0]; blockExtent[0] < gridExtent[1]; blockExtent[0] += blockSize)
+      {
+        blockExtent[1] = std::min(blockExtent[0] + blockSize, gridExtent[1]);
+
+        vtkSmartPointer<vtkImageData> block = this->CreateBlock(vtkimage, blockExtent);
+
+        double range[2];
+        block->GetScalarRange(range);
+
+        if (range[0] > threshold || range[1] < threshold)
+          continue; // The surface does not pass through this block
+
+        vtkSmartPointer<vtkImageChangeInformation> indexCoordinatesImageFilter =
+          vtkSmartPointer<vtkImageChangeInformation>::New();
+        indexCoordinatesImageFilter->SetInputData(block);
+        indexCoordinatesImageFilter->SetOutputOrigin(0.0, 0.0, 0.0);
+        indexCoordinatesImageFilter->SetOutputSpacing(gridSpacing);
+
+        vtkSmartPointer<vtkMarchingCubes> skinExtractor = vtkSmartPointer<vtkMarchingCubes>::New();
+        skinExtractor->ComputeScalarsOff();
+        skinExtractor->SetInputConnection(indexCoordinatesImageFilter->GetOutputPort());
+        skinExtractor->SetValue(0, threshold);
+        skinExtractor->Update();
+
+        vtkSmartPointer<vtkPolyData> polydata = skinExtractor->GetOutput();
+
+        if (polydata->GetNumberOfPoints() == 0 || polydata->GetNumberOfCells() == 0)
+          continue;
+
+        // The vertices on the block faces are boundary vertices of the block mesh, which are
+        // neither moved by the smoothing nor removed by the decimation
+        if (m_Smooth)
+        {
+          vtkSmartPointer<vtkSmoothPolyDataFilter> smoother = vtkSmartPointer<vtkSmoothPolyDataFilter>::New();
+          smoother->SetInputData(polydata);
+          smoother->SetNumberOfIterations(m_SmoothIteration);
+          smoother->SetRelaxationFactor(m_SmoothRelaxation);
+          smoother->SetFeatureAngle(60);
+          smoother->FeatureEdgeSmoothingOff();
+          smoother->BoundarySmoothingOff();
+          smoother->SetConvergence(0);
+          smoother->Update();
+          polydata = smoother->GetOutput();
+        }
+
+        if (m_Decimate != NoDecimation)
+        {
+          vtkSmartPointer<vtkDecimatePro> decimate = vtkSmartPointer<vtkDecimatePro>::New();
+          decimate->SplittingOff();
+          decimate->SetErrorIsAbsolute(5);
+          decimate->SetFeatureAngle(30);
+          decimate->PreserveTopologyOn();
+          decimate->BoundaryVertexDeletionOff();
+          decimate->SetDegree(10);
+          decimate->SetInputData(polydata);
+          decimate->SetTargetReduction(m_TargetReduction);
+          decimate->SetMaximumError(0.002);
+          decimate->Update();
+          polydata = decimate->GetOutput();
+        }
+
+        vtkPoints *points = polydata->GetPoints();
+        const vtkIdType n = points->GetNumberOfPoints();
+        double point[3];
+
+        for (vtkIdType i = 0; i < n; ++i)
+        {
+          points->GetPoint(i, point);
+          mitkVtkLinearTransformPoint(matrix, point, point);
+          points->SetPoint(i, point);
+        }
+
+        appendFilter->AddInputData(polydata);
+      }
+    }
+  }
+  ProgressBar::GetInstance()->Progress();
+
+  if (appendFilter->GetNumberOfInputConnections(0) == 0)
+  {
+    surface->SetVtkPolyData(vtkSmartPointer<vtkPolyData>::New(), time);
+    ProgressBar::GetInstance()->Progress(2);
+    return;
+  }
+
+  // Merge the duplicate vertices on the block faces
+  vtkSmartPointer<vtkCleanPolyData> stitchFilter = vtkSmartPointer<vtkCleanPolyData>::New();
+  stitchFilter->SetInputConnection(appendFilter->GetOutputPort());
+  stitchFilter->PieceInvariantOff();
+  stitchFilter->ConvertLinesToPointsOff();
+  stitchFilter->ConvertPolysToLinesOff();
+  stitchFilter->ConvertStripsToPolysOff();
+  stitchFilter->PointMergingOn();
+  stitchFilter->Update();
+  ProgressBar::GetInstance()->Progress();
+
+  vtkSmartPointer<vtkPolyDataNormals> normalsGenerator = vtkSmartPointer<vtkPolyDataNormals>::New();
+  normalsGenerator->SetInputConnection(stitchFilter->GetOutputPort());
+  normalsGenerator->FlipNormalsOn();
+
+  vtkSmartPointer<vtkCleanPolyData> cleanPolyDataFilter = vtkSmartPointer<vtkCleanPolyData>::New();
+  cleanPolyDataFilter->SetInputConnection(normalsGenerator->GetOutputPort());
+  cleanPolyDataFilter->PieceInvariantOff();
+  cleanPolyDataFilter->ConvertLinesToPointsOff();
+  cleanPolyDataFilter->ConvertPolysToLinesOff();
+  cleanPolyDataFilter->ConvertStripsToPolysOff();
+  cleanPolyDataFilter->PointMergingOn();
+  cleanPolyDataFilter->Update();
+
+  surface->SetVtkPolyData(cleanPolyDataFilter->GetOutput(), time);
+  ProgressBar::GetInstance()->Progress();
+}
+
+void mitk::ImageToSurfaceFilter::GetBlockGrid(vtkImageData *vtkimage, int extent[6], double spacing[3])
+{
+  vtkimage->GetExtent(extent);
+  vtkimage->GetSpacing(spacing);
+}
+
+vtkSmartPointer<vtkImageData> mitk::ImageToSurfaceFilter::CreateBlock(vtkImageData *vtkimage, const int extent[6])
+{
+  vtkSmartPointer<vtkImageClip> clipFilter = vtkSmartPointer<vtkImageClip>::New();
+  clipFilter->SetInputData(vtkimage);
+  clipFilter->SetOutputWholeExtent(const_cast<int *>(extent));
+  clipFilter->ClipDataOn();
+  clipFilter->Update();
+
+  return clipFilter->GetOutput();
+}
+
 void mitk::ImageToSurfaceFilter::GenerateData()
 {
   mitk::Surface *surface = this->GetOutput();
@@ -44,6 +44,8 @@ class mitkImageToSurfaceFilterTestSuite : public mitk::TestFixture
   MITK_TEST(testDecimatePromeshDecimation);
   MITK_TEST(testQuadricDecimation);
   MITK_TEST(testSmoothingOfSurface);
+  MITK_TEST(testBlockwiseSurfaceGeneration);
+  MITK_TEST(testBlockwiseDecimation);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -145,6 +147,50 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Testing smoothing of surface changes point data!",
                            CompareSurfacePointPositions(testSurface1, testSurface4));
   }
+
+  void testBlockwiseSurfaceGeneration()
+  {
+    mitk::ImageToSurfaceFilter::Pointer testObject = mitk::ImageToSurfaceFilter::New();
+    testObject->SetInput(m_BallImage);
+    testObject->Update();
+    mitk::Surface::Pointer testSurface1 = testObject->GetOutput()->Clone();
+
+    testObject->SetBlockSize(8);
+    testObject->Update();
+    mitk::Surface::Pointer testSurface2 = testObject->GetOutput()->Clone();
+
+    // The block meshes have to be stitched to exactly the mesh of the whole image
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of points of block-wise surface generation!",
+                                 testSurface1->GetVtkPolyData()->GetNumberOfPoints(),
+                                 testSurface2->GetVtkPolyData()->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Testing number of cells of block-wise surface generation!",
+                                 testSurface1->GetVtkPolyData()->GetNumberOfCells(),
+                                 testSurface2->GetVtkPolyData()->GetNumberOfCells());
+
+    double bounds1[6], bounds2[6];
+    testSurface1->GetVtkPolyData()->GetBounds(bounds1);
+    testSurface2->GetVtkPolyData()->GetBounds(bounds2);
+    for (int i = 0; i < 6; ++i)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("Testing bounds of block-wise surface generation!", bounds1[i], bounds2[i], 1e-6);
+  }
+
+  void testBlockwiseDecimation()
+  {
+    mitk::ImageToSurfaceFilter::Pointer testObject = mitk::ImageToSurfaceFilter::New();
+    testObject->SetInput(m_BallImage);
+    testObject->SetBlockSize(16);
+    testObject->Update();
+    mitk::Surface::Pointer testSurface1 = testObject->GetOutput()->Clone();
+
+    testObject->SetDecimate(mitk::ImageToSurfaceFilter::QuadricDecimation);
+    testObject->SetTargetReduction(0.5f);
+    testObject->Update();
+    mitk::Surface::Pointer testSurface2 = testObject->GetOutput()->Clone();
+
+    CPPUNIT_ASSERT_MESSAGE("Testing block-wise mesh decimation!",
+                           testSurface1->GetVtkPolyData()->GetNumberOfPoints() >
+                             testSurface2->GetVtkPolyData()->GetNumberOfPoints());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkImageToSurfaceFilter)
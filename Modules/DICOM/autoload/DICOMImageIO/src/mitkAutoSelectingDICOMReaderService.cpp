@@ -19,6 +19,10 @@ namespace mitk {
 AutoSelectingDICOMReaderService::AutoSelectingDICOMReaderService()
   : BaseDICOMReaderService("MITK DICOM Reader v2 (autoselect)")
 {
+  Options defaultOptions;
+  defaultOptions[OPTION_USE_PERSISTENT_TAG_INDEX()] = false;
+  this->SetDefaultOptions(defaultOptions);
+
   this->SetRanking(5);
   this->RegisterService();
 }
@@ -30,6 +34,7 @@ DICOMFileReader::Pointer AutoSelectingDICOMReaderService::GetReader(const mitk::
   selector->LoadBuiltIn3DConfigs();
   selector->LoadBuiltIn3DnTConfigs();
   selector->SetInputFiles(relevantFiles);
+  selector->SetUsePersistentTagIndex(this->GetUsePersistentTagIndex());
 
   mitk::DICOMFileReader::Pointer reader = selector->GetFirstReaderWithMinimumNumberOfOutputImages();
   if(reader.IsNotNull())
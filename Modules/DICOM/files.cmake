@@ -12,7 +12,9 @@ set(CPP_FILES
   mitkDICOMTagBasedSorter.cpp
   mitkDICOMGDCMImageFrameInfo.cpp
   mitkDICOMImageFrameInfo.cpp
+  mitkDICOMEnhancedMultiFrameInfo.cpp
   mitkDICOMIOHelper.cpp
+  mitkDICOMLocaleHelper.cpp
   mitkDICOMGenericImageFrameInfo.cpp
   mitkDICOMDatasetAccessingImageFrameInfo.cpp
   mitkDICOMSortCriterion.cpp
@@ -29,6 +31,7 @@ set(CPP_FILES
   mitkDICOMTagCache.cpp
   mitkDICOMGDCMTagCache.cpp
   mitkDICOMGenericTagCache.cpp
+  mitkDICOMPersistentTagIndex.cpp
   mitkDICOMEnums.cpp
   mitkDICOMReaderConfigurator.cpp
   mitkDICOMFileReaderSelector.cpp
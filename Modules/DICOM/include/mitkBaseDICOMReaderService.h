@@ -50,6 +50,15 @@ protected:
   void SetOnlyRegardOwnSeries(bool);
   bool GetOnlyRegardOwnSeries() const;
 
+  /** Name of the reader option that controls if the tag scanners reuse the tag values of unchanged
+  files from the DICOMPersistentTagIndex. Derived services that want to offer it add it with the
+  value false to their default options.*/
+  static std::string OPTION_USE_PERSISTENT_TAG_INDEX();
+
+  /** Returns the value of the option OPTION_USE_PERSISTENT_TAG_INDEX() or false if the service
+  does not offer the option.*/
+  bool GetUsePersistentTagIndex() const;
+
 private:
   /** Flags that constrols if the read() operation should only regard DICOM files of the same series
   if the specified GetLocalFileName() is a file. If it is a director, this flag has no impact (it is
@@ -26,7 +26,9 @@ namespace mitk
     \ingroup DICOMModule
     \brief Encapsulates the tag scanning process for a set of DICOM files.
 
-    For the scanning process it uses DCMTK functionality.
+    For the scanning process it uses DCMTK functionality. Files are distributed
+    to several threads (see NumberOfThreads) and parsed only up to the last
+    scanned top-level tag, so usually the pixel data is skipped.
   */
   class MITKDICOM_EXPORT DICOMDCMTKTagScanner : public DICOMTagScanner
   {
@@ -0,0 +1,120 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMEnhancedMultiFrameInfo_h
+#define mitkDICOMEnhancedMultiFrameInfo_h
+
+#include "mitkPoint.h"
+#include "mitkVector.h"
+
+#include "MitkDICOMExports.h"
+
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+
+/**
+  \ingroup DICOMModule
+  \brief Frame geometry of an enhanced multi-frame DICOM object (e.g. Enhanced CT/MR Image Storage).
+
+  Enhanced multi-frame objects store thousands of frames in a single file and describe each frame
+  in the Shared and Per-frame Functional Groups Sequences instead of top level tags. Read() parses
+  these sequences once and keeps the attributes that are needed to build an mitk::Image in typed
+  arrays (one entry per frame, in the order of the frames in the file).
+
+  SortFrames() then brings the frames into the order of mitk::Image: the time steps are determined by
+  the Dimension Index Values, the slices of a time step are sorted along the slice normal.
+
+  This class is a helper to DICOMITKSeriesGDCMReader.
+ */
+class MITKDICOM_EXPORT DICOMEnhancedMultiFrameInfo
+{
+  public:
+
+    DICOMEnhancedMultiFrameInfo();
+
+    /**
+      \brief Whether the SOP class describes its frames in functional groups and can be loaded by this class.
+     */
+    static bool IsEnhancedMultiFrameSOPClass(const std::string& sopClassUID);
+
+    /**
+      \brief Reads the functional groups of the given file, the pixel data is not read.
+      \return false if the file is no multi-frame object or lacks geometry information of the frames.
+     */
+    bool Read(const std::string& filename);
+
+    void SetImageOrientation(const Vector3D& right, const Vector3D& up);
+    void SetPixelSpacing(double spacingX, double spacingY);
+
+    /**
+      \brief Appends the description of the next frame of the file.
+      \param dimensionIndexValues the values of (0020,9157) Dimension Index Values, may be empty
+     */
+    void AddFrame(const Point3D& imagePosition,
+                  const std::vector<unsigned int>& dimensionIndexValues,
+                  double rescaleSlope = 1.0,
+                  double rescaleIntercept = 0.0);
+
+    unsigned int GetNumberOfFrames() const;
+
+    /**
+      \brief Whether all frames share the same rescale slope and intercept.
+     */
+    bool HasUniformRescale() const;
+
+    /**
+      \brief Determines the order of the frames in the mitk::Image, see GetFrameOrder().
+      \return false if the frames do not form an orthogonal block of equidistant slices with the same number of
+      frames per position.
+     */
+    bool SortFrames();
+
+    /**
+      \brief The frame number in the file for each slice of the mitk::Image (time steps are outermost).
+     */
+    const std::vector<unsigned int>& GetFrameOrder() const;
+
+    unsigned int GetNumberOfSlices() const;
+    unsigned int GetNumberOfTimeSteps() const;
+
+    /** \brief Position of the first slice of the mitk::Image. */
+    Point3D GetOrigin() const;
+    /** \brief Spacing in x, y (pixel spacing) and z (distance of the slices). */
+    Vector3D GetSpacing() const;
+
+    Vector3D GetRight() const;
+    Vector3D GetUp() const;
+    Vector3D GetNormal() const;
+
+  private:
+
+    std::vector<Point3D> m_ImagePositions;
+    std::vector<unsigned int> m_DimensionIndexValues;
+    std::vector<std::size_t> m_DimensionIndexOffsets;
+    std::vector<double> m_RescaleSlopes;
+    std::vector<double> m_RescaleIntercepts;
+
+    Vector3D m_Right;
+    Vector3D m_Up;
+    double m_PixelSpacing[2];
+
+    std::vector<unsigned int> m_FrameOrder;
+    unsigned int m_NumberOfSlices;
+    double m_SliceDistance;
+};
+
+}
+
+#endif
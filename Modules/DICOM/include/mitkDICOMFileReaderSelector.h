@@ -92,6 +92,10 @@ class MITKDICOM_EXPORT DICOMFileReaderSelector : public itk::LightObject
     /// Input files
     const StringList& GetInputFiles() const;
 
+    /// \brief Let the tag scanner reuse the tag values of unchanged files from the DICOMPersistentTagIndex (default: false).
+    void SetUsePersistentTagIndex(bool use);
+    bool GetUsePersistentTagIndex() const;
+
     /// Execute the analysis and selection process. The first reader with a minimal number of outputs will be returned.
     DICOMFileReader::Pointer GetFirstReaderWithMinimumNumberOfOutputImages();
 
@@ -108,6 +112,7 @@ class MITKDICOM_EXPORT DICOMFileReaderSelector : public itk::LightObject
     StringList m_PossibleConfigurations;
     StringList m_InputFilenames;
     ReaderList m_Readers;
+    bool m_UsePersistentTagIndex;
 
  };
 
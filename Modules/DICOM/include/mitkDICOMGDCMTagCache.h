@@ -14,9 +14,14 @@ found in the LICENSE file.
 #define mitkDICOMGDCMTagCache_h
 
 #include "mitkDICOMTagCache.h"
+#include "mitkDICOMPersistentTagIndex.h"
 
+#include <list>
+#include <map>
 #include <set>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <gdcmScanner.h>
 
@@ -31,6 +36,9 @@ namespace mitk
   {
     public:
 
+      /** Tag values of files that were taken from the DICOMPersistentTagIndex instead of being scanned. */
+      typedef std::map<std::string, DICOMPersistentTagIndex::ValueList> IndexedValuesMapType;
+
       mitkClassMacro(DICOMGDCMTagCache, DICOMTagCache);
       itkFactorylessNewMacro( DICOMGDCMTagCache );
       itkCloneMacro(Self);
@@ -43,8 +51,29 @@ namespace mitk
 
       void InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles);
 
+      /**
+        \brief Initializes the cache from scanners that each scanned a part of the input files.
+        The scanners are kept alive by the cache because the frame infos refer to their values.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners, const StringList& inputFiles);
+
+      /**
+        \brief Initializes the cache from scanners and from indexed values. Files that are
+        contained in indexedValues are not looked up in the scanners.
+      */
+      void InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners, const StringList& inputFiles, const IndexedValuesMapType& indexedValues);
+
+      /**
+        \brief Returns a scanner that holds the values of all input files.
+        If the files were scanned by several scanners or taken from the DICOMPersistentTagIndex,
+        the first call scans all input files again, because gdcm::Scanner cannot be merged.
+        Prefer GetScanners() or GetFrameInfoList() in new code.
+      */
       const gdcm::Scanner& GetScanner() const;
 
+      /** \brief Returns the scanners that scanned the input files, each one holds a part of them. */
+      const std::vector<std::shared_ptr<gdcm::Scanner>>& GetScanners() const;
+
   protected:
 
       DICOMGDCMTagCache();
@@ -52,7 +81,14 @@ namespace mitk
 
       std::set<DICOMTag> m_ScannedTags;
 
-      std::shared_ptr<gdcm::Scanner> m_Scanner;
+      std::vector<std::shared_ptr<gdcm::Scanner>> m_Scanners;
+
+      /** Scanner that holds the values of all input files, see GetScanner(). */
+      mutable std::shared_ptr<gdcm::Scanner> m_CompleteScanner;
+      mutable std::mutex m_CompleteScannerMutex;
+
+      /** Storage of the indexed values, the frame infos refer to these strings. */
+      std::list<std::string> m_IndexedValues;
 
       DICOMDatasetAccessingImageFrameList m_ScanResult;
 
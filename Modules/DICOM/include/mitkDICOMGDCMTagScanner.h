@@ -41,6 +41,9 @@ namespace mitk
     results, care should be taken that all the tags and files of interest
     are communicated to DICOMGDCMTagScanner before requesting the results!
 
+    The files are split into one contiguous part per thread (see NumberOfThreads),
+    each part is scanned by its own gdcm::Scanner.
+
     @remark This scanner does only support the scanning for simple value tag.
     If you need to scann for sequence items or non-top-level elements, this scanner
     will not be sufficient. See i.a. DICOMDCMTKTagScanner for these cases.
@@ -109,7 +112,6 @@ namespace mitk
       std::set<DICOMTag> m_ScannedTags;
       StringList m_InputFilenames;
       DICOMGDCMTagCache::Pointer m_Cache;
-      std::shared_ptr<gdcm::Scanner> m_GDCMScanner;
 
     private:
       DICOMGDCMTagScanner(const DICOMGDCMTagScanner&);
@@ -13,8 +13,6 @@ found in the LICENSE file.
 #ifndef mitkDICOMITKSeriesGDCMReader_h
 #define mitkDICOMITKSeriesGDCMReader_h
 
-#include <stack>
-#include "itkMutexLock.h"
 #include "mitkDICOMFileReader.h"
 #include "mitkDICOMDatasetSorter.h"
 #include "mitkDICOMGDCMImageFrameInfo.h"
@@ -22,6 +20,9 @@ found in the LICENSE file.
 #include "mitkNormalDirectionConsistencySorter.h"
 #include "MitkDICOMExports.h"
 
+#include <functional>
+#include <vector>
+
 
 namespace itk
 {
@@ -186,6 +187,14 @@ namespace mitk
   as an absolute last step of AnalyzeInputFiles(). Given this, a sub-class could implement only LoadImages() and Condense3DBlocks() instead
   repeating most of AnalyzeInputFiles().
 
+  \subsection DICOMITKSeriesGDCMReader_EnhancedMultiFrame Enhanced multi-frame objects
+
+  Files of enhanced SOP classes (e.g. Enhanced CT/MR Image Storage) with more than one frame do not take part in the sorting
+  described above. They describe the position of every frame in their functional groups, so each file becomes a block of its own.
+  When the image is loaded, DICOMEnhancedMultiFrameInfo arranges the frames by these functional groups (including time steps)
+  and all frames are decoded by a single read of the pixel data. If the frames cannot be arranged, they are loaded in the
+  order of the file as before.
+
 */
 class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 {
@@ -199,6 +208,7 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     /**
       \brief Runs the sorting / splitting process described in \ref DICOMITKSeriesGDCMReader_LoadingStrategy.
+      Enhanced multi-frame files are output as blocks of their own (see \ref DICOMITKSeriesGDCMReader_EnhancedMultiFrame).
       Method required by DICOMFileReader.
     */
     void AnalyzeInputFiles() override;
@@ -206,6 +216,7 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
     // void AllocateOutputImages();
     /**
       \brief Loads images using itk::ImageSeriesReader, potentially applies shearing to correct gantry tilt.
+      The blocks are loaded concurrently, the slices of each block are decoded concurrently (see SetNumberOfThreads()).
     */
     bool LoadImages() override;
 
@@ -227,6 +238,68 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     bool GetFixTiltByShearing() const;
 
+    /**
+      \brief Number of threads used by LoadImages() (default: 0 = number of cores).
+      Threads are spread over the image blocks first, the remaining threads decode the slices within a block.
+      Does not influence the sorting result, so changing it does not require another AnalyzeInputFiles().
+    */
+    void SetNumberOfThreads(unsigned int numberOfThreads)
+    {
+      m_NumberOfThreads = numberOfThreads;
+    };
+
+    unsigned int GetNumberOfThreads() const
+    {
+      return m_NumberOfThreads;
+    };
+
+    /**
+      \brief Called during progressive loading as soon as the image of a block and its final volume buffer exist and
+      the image was set to the block (no slice loaded yet), then after every loaded slice. loadedSlices has one entry
+      per slice of the image, true for the slices whose pixel data is loaded. Calls come from the loading threads.
+    */
+    typedef std::function<void(const DICOMImageBlockDescriptor& block, Image* image, const std::vector<bool>& loadedSlices)> ProgressiveLoadingCallback;
+
+    /**
+      \brief Controls whether LoadImages() loads 3D blocks progressively (default: off).
+      The image of a block and its volume are created from the geometry of the block before any pixel data is read,
+      then the volume is filled slice by slice, starting with the center slice or the slice at the progressive loading
+      focus. Slices that are not loaded yet are zero; the progressive loading callback tells which slices are available.
+      To show the image early, call LoadImages() in a background thread, add the image to the data storage when the
+      callback reports it, and call Modified() on it and request a render update (in the GUI thread) when further slices
+      arrive. If loading fails after the image was reported, the image stays with the block and LoadImages() returns
+      false. Blocks with gantry tilt correction are loaded as a whole.
+    */
+    void SetProgressiveLoading(bool on)
+    {
+      m_ProgressiveLoading = on;
+    };
+
+    bool GetProgressiveLoading() const
+    {
+      return m_ProgressiveLoading;
+    };
+
+    void SetProgressiveLoadingCallback(const ProgressiveLoadingCallback& callback)
+    {
+      m_ProgressiveLoadingCallback = callback;
+    };
+
+    /**
+      \brief World point (e.g. the position of the current view) whose slice is loaded first during progressive loading.
+    */
+    void SetProgressiveLoadingFocus(const Point3D& focus)
+    {
+      m_ProgressiveLoadingFocus = focus;
+      m_HasProgressiveLoadingFocus = true;
+    };
+
+    /** \brief Load the center slice of every block first again. */
+    void ResetProgressiveLoadingFocus()
+    {
+      m_HasProgressiveLoadingFocus = false;
+    };
+
     /**
       \brief Controls whether groups of only two images are accepted when ensuring consecutive slices via EquiDistantBlocksSorter.
     */
@@ -290,12 +363,12 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
     /// \brief Return active C locale
   static std::string GetActiveLocale();
     /**
-      \brief Remember current locale on stack, activate "C" locale.
+      \brief Activate "C" locale, see PushDICOMLocale().
       "C" locale is required for correct parsing of numbers by itk::ImageSeriesReader
     */
     void PushLocale() const;
     /**
-      \brief Activate last remembered locale from locale stack
+      \brief Restore the locale that was active before the first PushLocale(), see PopDICOMLocale().
       "C" locale is required for correct parsing of numbers by itk::ImageSeriesReader
     */
     void PopLocale() const;
@@ -331,6 +404,9 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
     virtual bool LoadMitkImageForImageBlockDescriptor(DICOMImageBlockDescriptor& block) const;
 
+    /// \brief Number of threads that decode the slices of one block while all blocks are loaded concurrently
+    unsigned int GetNumberOfSliceLoadingThreads() const;
+
     /// \brief Describe this reader's confidence for given SOP class UID
   static ReaderImplementationLevel GetReaderImplementationLevel(const std::string sopClassUID);
   private:
@@ -361,12 +437,14 @@ class MITKDICOM_EXPORT DICOMITKSeriesGDCMReader : public DICOMFileReader
 
   private:
 
-    static itk::MutexLock::Pointer s_LocaleMutex;
+    double m_DecimalPlacesForOrientation;
 
-    mutable std::stack<std::string> m_ReplacedCLocales;
-    mutable std::stack<std::locale> m_ReplacedCinLocales;
+    unsigned int m_NumberOfThreads;
 
-    double m_DecimalPlacesForOrientation;
+    bool m_ProgressiveLoading;
+    ProgressiveLoadingCallback m_ProgressiveLoadingCallback;
+    Point3D m_ProgressiveLoadingFocus;
+    bool m_HasProgressiveLoadingFocus;
 
     DICOMTagCache::Pointer m_TagCache;
     bool m_ExternalCache;
@@ -0,0 +1,35 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMLocaleHelper_h
+#define mitkDICOMLocaleHelper_h
+
+#include <MitkDICOMExports.h>
+
+namespace mitk
+{
+  /**
+    \brief Activates the "C" locale (LC_NUMERIC and std::cin) that is required for
+    the correct parsing of numbers by GDCM, DCMTK and itk::ImageSeriesReader.
+
+    The locale is process wide, so all DICOM scanners and readers share one reference
+    count: the first push remembers the current locale and activates "C", the last
+    pop restores the remembered locale. Scans and loads may therefore overlap in any
+    order on any thread, each of them only has to pair its own push and pop.
+  */
+  MITKDICOM_EXPORT void PushDICOMLocale();
+
+  /** \brief Counterpart of PushDICOMLocale(). */
+  MITKDICOM_EXPORT void PopDICOMLocale();
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMPersistentTagIndex_h
+#define mitkDICOMPersistentTagIndex_h
+
+#include "mitkDICOMEnums.h"
+#include "mitkDICOMTagPath.h"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <MitkDICOMExports.h>
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMModule
+    \brief On-disk index of the tag values of scanned DICOM files.
+
+    DICOMTagScanner implementations use this index to avoid parsing the headers of
+    files that did not change since their last scan. For every scanner class and
+    directory there is one index file in the index directory (see SetIndexDirectory()). An entry of a
+    file is only used if size and modification time of the file are unchanged and
+    all tags of the current scan were scanned for the entry. All other files are
+    scanned as usual and their entries are updated by Update() and Save().
+
+    Modification times are compared with the resolution of the file system (nanoseconds
+    on most POSIX systems, 100 ns on Windows).
+
+    Usage:
+     - Load() the index for the files and tags of a scan
+     - Find() the values of each file, scan the files without values
+     - Update() the entries of the scanned files and Save() the index
+  */
+  class MITKDICOM_EXPORT DICOMPersistentTagIndex
+  {
+    public:
+
+      /**
+        \brief Value of a finding. isNull marks findings without a value, e.g. elements that
+        GDCM reports with a null value; they are restored as such instead of as empty strings.
+      */
+      struct IndexedValue
+      {
+        IndexedValue() : isNull(false) {}
+        IndexedValue(const DICOMTagPath& path, const std::string& value, bool isNull = false)
+          : path(path), value(value), isNull(isNull)
+        {
+        }
+
+        DICOMTagPath path;
+        std::string value;
+        bool isNull;
+      };
+
+      /** Tag values of a file. The paths are the explicit paths of the findings. */
+      typedef std::vector<IndexedValue> ValueList;
+
+      /**
+        \brief Directory that stores the index files. An empty directory disables the index.
+        The default is a "MITK/DICOMTagIndex" directory in the cache directory of the user.
+      */
+      static void SetIndexDirectory(const std::string& directory);
+      static std::string GetIndexDirectory();
+
+      /** \param scannerName Identifies the scanner whose values are indexed, scanners do not share entries. */
+      explicit DICOMPersistentTagIndex(const std::string& scannerName);
+
+      /**
+        \brief Loads the index files of all directories that contain one of the given files.
+        Find() and Update() refer to the files and scanned tags passed here.
+      */
+      void Load(const StringList& filenames, const std::set<DICOMTagPath>& scannedTags);
+
+      /**
+        \brief Returns the indexed values of the file or nullptr if the file changed, was
+        not indexed or was indexed for other tags.
+      */
+      const ValueList* Find(const std::string& filename) const;
+
+      /** \brief Replaces the entry of the file by the values of a new scan. */
+      void Update(const std::string& filename, const ValueList& values);
+
+      /** \brief Writes the index files of all directories that were updated. */
+      void Save();
+
+    private:
+
+      struct FileStatus
+      {
+        std::uint64_t Size;
+        std::int64_t ModificationTime; // finest resolution of the file system, only compared for equality
+      };
+
+      static bool GetFileStatus(const std::string& filename, FileStatus& status);
+
+      struct Entry
+      {
+        FileStatus Status;
+        std::size_t ScannedTagsId;
+        ValueList Values;
+      };
+
+      /**
+        Entries refer to their scanned tags by an id, so the tags of a scan only have to be
+        compared once per distinct set of scanned tags.
+      */
+      struct DirectoryIndex
+      {
+        std::vector<std::set<DICOMTagPath>> ScannedTags;
+        std::vector<bool> CoversScannedTags;
+        std::size_t CurrentScannedTagsId = 0;
+        std::map<std::string, Entry> Entries;
+        bool Modified = false;
+      };
+
+      std::string GetIndexFilename(const std::string& directory) const;
+      bool ReadIndexFile(const std::string& directory, DirectoryIndex& index) const;
+      bool WriteIndexFile(const std::string& directory, const DirectoryIndex& index) const;
+
+      std::string m_ScannerName;
+      std::string m_IndexDirectory;
+      std::set<DICOMTagPath> m_ScannedTags;
+      std::map<std::string, DirectoryIndex> m_Directories;
+      std::map<std::string, FileStatus> m_FileStatus;
+  };
+}
+
+#endif
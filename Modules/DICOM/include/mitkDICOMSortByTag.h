@@ -43,6 +43,12 @@ class MITKDICOM_EXPORT DICOMSortByTag : public DICOMSortCriterion
 
     double NumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to) const override;
 
+    /// \brief The key is the numerical tag value.
+    unsigned int GetSortKeySize() const override;
+    void ExtractSortKey(const mitk::DICOMDatasetAccess* dataset, double* key) const override;
+    bool CompareSortKeys(const double* left, const double* right, bool& leftBeforeRight) const override;
+    double SortKeyDistance(const double* from, const double* to) const override;
+
     void Print(std::ostream& os) const override;
 
     bool operator==(const DICOMSortCriterion& other) const override;
@@ -33,6 +33,12 @@ namespace mitk
   Because there are identical tags values quite oftenly, a DICOMSortCriterion
   will always hold a secondary DICOMSortCriterion. In cases of equal tag
   values, the decision is refered to the secondary criterion.
+
+  Criteria may additionally provide a numeric sort key (see GetSortKeySize()).
+  DICOMTagBasedSorter then parses the tag values only once per dataset via
+  ExtractSortKey() and sorts by CompareSortKeys(), which has to decide exactly
+  like IsLeftBeforeRight() does. Subclasses that override IsLeftBeforeRight()
+  of a criterion with sort keys have to override the sort key methods as well.
 */
 class MITKDICOM_EXPORT DICOMSortCriterion : public itk::LightObject
 {
@@ -52,6 +58,22 @@ class MITKDICOM_EXPORT DICOMSortCriterion : public itk::LightObject
     /// This ansers the question of consecutive datasets.
     virtual double NumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to) const = 0;
 
+    /// \brief Number of values that ExtractSortKey() writes per dataset, 0 if this criterion has no sort key (default).
+    virtual unsigned int GetSortKeySize() const;
+
+    /// \brief Parse the tag values of dataset into key, which holds GetSortKeySize() values.
+    virtual void ExtractSortKey(const mitk::DICOMDatasetAccess* dataset, double* key) const;
+
+    /// \brief IsLeftBeforeRight() for keys of ExtractSortKey(), without asking the secondary criterion.
+    /// \return false if the keys do not decide, leftBeforeRight is only set if they do.
+    virtual bool CompareSortKeys(const double* left, const double* right, bool& leftBeforeRight) const;
+
+    /// \brief NumericDistance() for keys of ExtractSortKey().
+    virtual double SortKeyDistance(const double* from, const double* to) const;
+
+    /// \brief Whether this criterion and all secondary criteria provide sort keys.
+    bool HasSortKeys() const;
+
     /// \brief The fallback criterion.
     DICOMSortCriterion::ConstPointer GetSecondaryCriterion() const;
 
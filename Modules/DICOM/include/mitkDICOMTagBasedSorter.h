@@ -157,6 +157,36 @@ class MITKDICOM_EXPORT DICOMTagBasedSorter : public DICOMDatasetSorter
       DICOMSortCriterion::ConstPointer m_SortCriterion;
     };
 
+    /**
+      \brief Sort keys of a list of datasets (see DICOMSortCriterion::GetSortKeySize()).
+
+      The tag values are parsed only once per dataset into one array. Comparisons of
+      rows in this array decide like ParameterizedDatasetSort does for the datasets,
+      including the final comparison of dataset pointers, so sorting row indices by
+      IsLeftBeforeRight() results in the same order as sorting the datasets.
+      Requires DICOMSortCriterion::HasSortKeys().
+    */
+    class SortKeyTable
+    {
+      public:
+
+        SortKeyTable(const DICOMSortCriterion* criterion, const DICOMDatasetList& datasets);
+
+        bool IsLeftBeforeRight(std::size_t left, std::size_t right) const;
+        double NumericDistance(std::size_t from, std::size_t to) const;
+
+        /// \brief Sorts the datasets (the same as passed to the constructor) and reorders the rows accordingly.
+        void Sort(DICOMDatasetList& datasets);
+
+      private:
+
+        std::vector<const DICOMSortCriterion*> m_Criteria;
+        std::vector<unsigned int> m_KeyOffsets;
+        unsigned int m_RowSize;
+        std::vector<double> m_Keys;
+        DICOMDatasetList m_Datasets;
+    };
+
 
     DICOMTagBasedSorter();
     ~DICOMTagBasedSorter() override;
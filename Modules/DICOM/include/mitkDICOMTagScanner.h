@@ -13,9 +13,6 @@ found in the LICENSE file.
 #ifndef mitkDICOMTagScanner_h
 #define mitkDICOMTagScanner_h
 
-#include <stack>
-#include "itkMutexLock.h"
-
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMTagPath.h"
 #include "mitkDICOMTagCache.h"
@@ -86,17 +83,39 @@ namespace mitk
       */
       virtual DICOMTagCache::Pointer GetScanCache() const = 0;
 
+      /**
+        \brief Number of threads that Scan() distributes the input files to.
+        0 (default) uses the number of hardware threads.
+      */
+      itkSetMacro(NumberOfThreads, unsigned int);
+      itkGetConstMacro(NumberOfThreads, unsigned int);
+
+      /**
+        \brief Reuse the tag values of unchanged files from the DICOMPersistentTagIndex
+        and store the values of scanned files in it (default: false).
+        The index is written to the user cache directory, so it is only enabled on request.
+      */
+      itkSetMacro(UsePersistentTagIndex, bool);
+      itkGetConstMacro(UsePersistentTagIndex, bool);
+      itkBooleanMacro(UsePersistentTagIndex);
+
     protected:
 
+      /**
+        \brief Number of threads that should be used to scan the given number of files.
+        Respects NumberOfThreads but does not start threads for a handful of files.
+      */
+      unsigned int GetNumberOfScanThreads(std::size_t numberOfFiles) const;
+
       /** \brief Return active C locale */
       static std::string GetActiveLocale();
       /**
-      \brief Remember current locale on stack, activate "C" locale.
+      \brief Activate "C" locale, see PushDICOMLocale().
       "C" locale is required for correct parsing of numbers by itk::ImageSeriesReader
       */
       void PushLocale() const;
       /**
-      \brief Activate last remembered locale from locale stack
+      \brief Restore the locale that was active before the first PushLocale(), see PopDICOMLocale().
       "C" locale is required for correct parsing of numbers by itk::ImageSeriesReader
       */
       void PopLocale() const;
@@ -104,12 +123,10 @@ namespace mitk
       DICOMTagScanner();
       ~DICOMTagScanner() override;
 
-    private:
-
-      static itk::MutexLock::Pointer s_LocaleMutex;
+      unsigned int m_NumberOfThreads;
+      bool m_UsePersistentTagIndex;
 
-      mutable std::stack<std::string> m_ReplacedCLocales;
-      mutable std::stack<std::locale> m_ReplacedCinLocales;
+    private:
 
       DICOMTagScanner(const DICOMTagScanner&);
   };
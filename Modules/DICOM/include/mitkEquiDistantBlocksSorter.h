@@ -19,6 +19,8 @@ found in the LICENSE file.
 
 #include "mitkVector.h"
 
+#include <unordered_map>
+
 namespace mitk
 {
 
@@ -183,6 +185,22 @@ class MITKDICOM_EXPORT EquiDistantBlocksSorter : public DICOMDatasetSorter
     SliceGroupingAnalysisResult
     AnalyzeFileForITKImageSeriesReaderSpacingAssumption(const DICOMDatasetList& files, bool groupsOfSimilarImages);
 
+    /**
+      \brief Image position (patient) of a dataset, see GetParsedPosition().
+    */
+    struct ParsedPosition
+    {
+      bool HasPosition;
+      Point3D Origin;
+    };
+
+    /**
+      \brief Returns the image position of the dataset, which is parsed only once per Sort().
+      AnalyzeFileForITKImageSeriesReaderSpacingAssumption() is called repeatedly for the
+      remaining datasets, this avoids parsing their tag values again in every call.
+    */
+    const ParsedPosition& GetParsedPosition(const DICOMDatasetAccess* dataset);
+
     /**
       \brief Safely convert const char* to std::string.
      */
@@ -204,6 +222,8 @@ class MITKDICOM_EXPORT EquiDistantBlocksSorter : public DICOMDatasetSorter
     bool m_ToleratedOriginOffsetIsAbsolute;
 
     bool m_AcceptTwoSlicesGroups;
+
+    std::unordered_map<const DICOMDatasetAccess*, ParsedPosition> m_ParsedPositions;
 };
 
 }
@@ -16,9 +16,13 @@ found in the LICENSE file.
 #include "mitkImage.h"
 #include "mitkGantryTiltInformation.h"
 #include "mitkDICOMTag.h"
+#include "mitkDICOMEnhancedMultiFrameInfo.h"
 
 #include <itkGDCMImageIO.h>
 
+#include <functional>
+#include <vector>
+
 /* Forward deceleration of an DCMTK class. Used in the txx but part of the interface.*/
 class OFDateTime;
 
@@ -36,9 +40,48 @@ class ITKDICOMSeriesReaderHelper
     typedef std::vector<std::string> StringContainer;
     typedef std::list<StringContainer> StringContainerList;
 
+    /**
+      \brief Number of threads that decode the slices of a block (default: 0 = number of cores).
+      Slices are decoded by one itk::GDCMImageIO per thread, which also parallelizes JPEG and JPEG 2000 decompression.
+    */
+    void SetNumberOfThreads( unsigned int numberOfThreads );
+    unsigned int GetNumberOfThreads() const;
+
     Image::Pointer Load( const StringContainer& filenames, bool correctTilt, const GantryTiltInformation& tiltInfo );
     Image::Pointer Load3DnT( const StringContainerList& filenamesLists, bool correctTilt, const GantryTiltInformation& tiltInfo );
 
+    /**
+      \brief Called by LoadProgressively() once the image and its final volume buffer exist (no slice loaded yet) and
+      after every slice. loadedSlices has one entry per slice, true for the slices whose pixel data is loaded.
+      Calls are serialized, but they come from the loading threads.
+    */
+    typedef std::function<void(Image* image, const std::vector<bool>& loadedSlices)> ProgressCallback;
+
+    /**
+      \brief Loads a 3D block slice by slice, so that it can be shown before all slices are read.
+
+      The image is created from the geometry of the first and the last file and its volume is allocated (zero-filled)
+      before any pixel data is read. Then the slices are decoded concurrently, beginning with the slice closest to
+      focusPoint (the center slice if focusPoint is nullptr) and continuing alternately on both sides of it, and
+      copied into that volume. The image is complete from the start as far as mitk::Image is concerned, so only
+      the loadedSlices of the progress callback tell which slices are available already.
+      Gantry tilt correction needs the complete volume and is not done here.
+
+      \return nullptr if the files cannot be loaded slice by slice (e.g. a multi-frame file) or on errors. If progress
+      was not called yet, Load() can be used instead. Otherwise the reported image is incomplete.
+    */
+    Image::Pointer LoadProgressively( const StringContainer& filenames, const Point3D* focusPoint, const ProgressCallback& progress );
+
+    /**
+      \brief Loads an enhanced multi-frame file whose frames were sorted by DICOMEnhancedMultiFrameInfo::SortFrames().
+
+      All frames are decoded by a single read of the pixel data. If the frames are stored in the order of the image,
+      they are decoded directly into the mitk::Image, otherwise they are rearranged afterwards.
+
+      \return nullptr if the pixel data does not match frameInfo or the frames are rescaled differently, Load() should be used then.
+    */
+    Image::Pointer LoadEnhancedMultiFrame( const std::string& filename, const DICOMEnhancedMultiFrameInfo& frameInfo );
+
     static bool CanHandleFile(const std::string& filename);
 
   private:
@@ -83,6 +126,13 @@ class ITKDICOMSeriesReaderHelper
     typename ImageType::Pointer
     FixUpTiltedGeometry( ImageType* input, const GantryTiltInformation& tiltInfo );
 
+    /** Reads the slices described by the output information of an itk::ImageSeriesReader concurrently.
+     Returns nullptr if a slice does not match the output (e.g. differing pixel type), the caller then has
+     to run the ImageSeriesReader itself, which converts such slices.*/
+    template <typename ImageType>
+    typename ImageType::Pointer
+    ReadSlicesConcurrently( const ImageType* outputInformation, const StringContainer& filenames ) const;
+
     template <typename PixelType>
     Image::Pointer
     LoadDICOMByITK( const StringContainer& filenames,
@@ -90,6 +140,19 @@ class ITKDICOMSeriesReaderHelper
                     const GantryTiltInformation& tiltInfo,
                     itk::GDCMImageIO::Pointer& io);
 
+    template <typename PixelType>
+    Image::Pointer
+    LoadDICOMByITKProgressively( const StringContainer& filenames,
+                                 const Point3D* focusPoint,
+                                 const ProgressCallback& progress,
+                                 itk::GDCMImageIO::Pointer& io);
+
+    template <typename PixelType>
+    Image::Pointer
+    LoadDICOMByITKEnhancedMultiFrame( const std::string& filename,
+                                      const DICOMEnhancedMultiFrameInfo& frameInfo,
+                                      itk::GDCMImageIO::Pointer& io);
+
     template <typename PixelType>
     Image::Pointer
     LoadDICOMByITK3DnT( const StringContainerList& filenames,
@@ -97,7 +160,7 @@ class ITKDICOMSeriesReaderHelper
                         const GantryTiltInformation& tiltInfo,
                         itk::GDCMImageIO::Pointer& io);
 
-
+    unsigned int m_NumberOfThreads = 0;
 };
 
 }
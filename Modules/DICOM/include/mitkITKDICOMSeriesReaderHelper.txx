@@ -12,14 +12,115 @@ found in the LICENSE file.
 
 #include "mitkITKDICOMSeriesReaderHelper.h"
 
+#include <itkImageFileReader.h>
 #include <itkImageSeriesReader.h>
 #include <itkResampleImageFilter.h>
 //#include <itkAffineTransform.h>
 //#include <itkLinearInterpolateImageFunction.h>
 //#include <itkTimeProbesCollectorBase.h>
 
+#include "mitkImageWriteAccessor.h"
+
 #include "dcmtk/ofstd/ofdatime.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template <typename ImageType>
+typename ImageType::Pointer
+mitk::ITKDICOMSeriesReaderHelper
+::ReadSlicesConcurrently( const ImageType* outputInformation, const StringContainer& filenames ) const
+{
+  typedef typename ImageType::PixelType PixelType;
+  typedef typename itk::NumericTraits<PixelType>::ValueType ComponentType;
+
+  const typename ImageType::RegionType region = outputInformation->GetLargestPossibleRegion();
+  const std::size_t numberOfFiles = filenames.size();
+  if ( numberOfFiles == 0 || region.GetNumberOfPixels() % numberOfFiles != 0 )
+  {
+    return nullptr;
+  }
+  const std::size_t pixelsPerFile = region.GetNumberOfPixels() / numberOfFiles;
+
+  typename ImageType::Pointer volume = ImageType::New();
+  volume->CopyInformation( outputInformation );
+  volume->SetRegions( region );
+  volume->Allocate();
+  PixelType* buffer = volume->GetBufferPointer();
+
+  // the order of the files is the order of the slices, so every file has a fixed place in the buffer
+  std::atomic<std::size_t> nextFile( 0 );
+  std::atomic<bool> sliceMismatch( false );
+  std::exception_ptr readError;
+  std::mutex readErrorMutex;
+
+  auto readSlices = [&]()
+  {
+    try
+    {
+      itk::GDCMImageIO::Pointer io = itk::GDCMImageIO::New();
+      for ( std::size_t i = nextFile++; i < numberOfFiles; i = nextFile++ )
+      {
+        io->SetFileName( filenames[i] );
+        io->ReadImageInformation();
+
+        if ( io->GetComponentType() != itk::ImageIOBase::MapPixelType<ComponentType>::CType
+             || io->GetDimensions( 0 ) != region.GetSize( 0 ) || io->GetDimensions( 1 ) != region.GetSize( 1 )
+             || io->GetImageSizeInPixels() != pixelsPerFile
+             || io->GetImageSizeInBytes() != pixelsPerFile * sizeof( PixelType ) )
+        {
+          sliceMismatch = true;
+          nextFile = numberOfFiles;
+          return;
+        }
+
+        io->Read( buffer + i * pixelsPerFile );
+      }
+    }
+    catch ( ... )
+    {
+      std::lock_guard<std::mutex> lock( readErrorMutex );
+      if ( !readError )
+      {
+        readError = std::current_exception();
+      }
+      nextFile = numberOfFiles;
+    }
+  };
+
+  unsigned int numberOfThreads = m_NumberOfThreads > 0 ? m_NumberOfThreads : std::thread::hardware_concurrency();
+  numberOfThreads = static_cast<unsigned int>( std::max<std::size_t>( 1, std::min<std::size_t>( numberOfThreads, numberOfFiles ) ) );
+
+  std::vector<std::thread> threads;
+  for ( unsigned int i = 1; i < numberOfThreads; ++i )
+  {
+    threads.emplace_back( readSlices );
+  }
+  readSlices();
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  if ( readError )
+  {
+    std::rethrow_exception( readError );
+  }
+
+  if ( sliceMismatch )
+  {
+    return nullptr;
+  }
+
+  return volume;
+}
+
 template <typename PixelType>
 mitk::Image::Pointer
 mitk::ITKDICOMSeriesReaderHelper
@@ -46,13 +147,18 @@ mitk::ITKDICOMSeriesReaderHelper
                              // see NormalDirectionConsistencySorter.
 
   reader->SetFileNames(filenames);
-  reader->Update();
-  typename ImageType::Pointer readVolume = reader->GetOutput();
+  reader->UpdateOutputInformation(); // geometry of the block, from the first and the last file
+  typename ImageType::Pointer readVolume = ReadSlicesConcurrently<ImageType>(reader->GetOutput(), filenames);
+  if (readVolume.IsNull())
+  {
+    reader->Update();
+    readVolume = reader->GetOutput();
+  }
 
   // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
   if (correctTilt)
   {
-    readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
+    readVolume = FixUpTiltedGeometry( readVolume, tiltInfo );
   }
 
   image->InitializeByItk(readVolume.GetPointer());
@@ -72,6 +178,228 @@ mitk::ITKDICOMSeriesReaderHelper
   return image;
 }
 
+template <typename PixelType>
+mitk::Image::Pointer
+mitk::ITKDICOMSeriesReaderHelper
+::LoadDICOMByITKProgressively(
+    const StringContainer& filenames,
+    const Point3D* focusPoint,
+    const ProgressCallback& progress,
+    itk::GDCMImageIO::Pointer& io)
+{
+  typedef itk::Image<PixelType, 3> ImageType;
+  typedef itk::ImageSeriesReader<ImageType> ReaderType;
+  typedef itk::ImageFileReader<ImageType> SliceReaderType;
+
+  // the geometry of the block only requires the headers of the first and the last file
+  io = itk::GDCMImageIO::New();
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetImageIO(io);
+  reader->ReverseOrderOff(); // see LoadDICOMByITK()
+  reader->SetFileNames(filenames);
+  reader->UpdateOutputInformation();
+
+  const typename ImageType::SizeType size = reader->GetOutput()->GetLargestPossibleRegion().GetSize();
+  const unsigned int numberOfSlices = static_cast<unsigned int>(size[2]);
+  if (numberOfSlices != filenames.size())
+  {
+    return nullptr; // not one slice per file
+  }
+  const std::size_t pixelsPerSlice = size[0] * size[1];
+
+  mitk::Image::Pointer image = mitk::Image::New();
+  image->InitializeByItk(reader->GetOutput());
+
+  unsigned int firstSlice = numberOfSlices / 2;
+  if (focusPoint != nullptr)
+  {
+    Point3D focusIndex;
+    image->GetGeometry()->WorldToIndex(*focusPoint, focusIndex);
+    firstSlice = static_cast<unsigned int>(std::max(0.0, std::min<double>(numberOfSlices - 1, std::floor(focusIndex[2] + 0.5))));
+  }
+
+  // first, first + 1, first - 1, first + 2, ...
+  std::vector<unsigned int> sliceOrder;
+  sliceOrder.reserve(numberOfSlices);
+  sliceOrder.push_back(firstSlice);
+  for (unsigned int distance = 1; sliceOrder.size() < numberOfSlices; ++distance)
+  {
+    if (firstSlice + distance < numberOfSlices)
+    {
+      sliceOrder.push_back(firstSlice + distance);
+    }
+    if (distance <= firstSlice)
+    {
+      sliceOrder.push_back(firstSlice - distance);
+    }
+  }
+
+  // The complete volume is allocated (and zeroed once, so that missing slices show up as background) before the
+  // image is reported, so the image keeps its buffer while it is shown. The loading threads copy the slices into
+  // this buffer directly instead of using mitk::Image::SetSlice(), which would leave the image without a complete
+  // volume until the end and call Modified() from the loading threads.
+  mitk::Image::ImageDataItemPointer volume = image->GetVolumeData(0);
+  if (volume.IsNull())
+  {
+    return nullptr;
+  }
+  char* volumeData = static_cast<char*>(volume->GetData());
+  const std::size_t bytesPerSlice = pixelsPerSlice * sizeof(PixelType);
+  std::memset(volumeData, 0, bytesPerSlice * numberOfSlices);
+
+  std::mutex progressMutex;
+  std::vector<bool> loadedSlices(numberOfSlices, false);
+  if (progress)
+  {
+    progress(image, loadedSlices);
+  }
+
+  std::atomic<std::size_t> nextSlice(0);
+  std::exception_ptr readError;
+  std::mutex readErrorMutex;
+
+  auto readSlices = [&]()
+  {
+    try
+    {
+      // ImageFileReader converts slices with another pixel type, like ImageSeriesReader does
+      typename SliceReaderType::Pointer sliceReader = SliceReaderType::New();
+      sliceReader->SetImageIO(itk::GDCMImageIO::New());
+
+      for (std::size_t i = nextSlice++; i < numberOfSlices; i = nextSlice++)
+      {
+        const unsigned int sliceIndex = sliceOrder[i];
+        sliceReader->SetFileName(filenames[sliceIndex]);
+        sliceReader->Update();
+
+        const ImageType* slice = sliceReader->GetOutput();
+        if (slice->GetLargestPossibleRegion().GetNumberOfPixels() != pixelsPerSlice)
+        {
+          mitkThrow() << "Slice " << filenames[sliceIndex] << " does not match the size of the first slice of its block.";
+        }
+
+        // every slice is written by exactly one thread
+        std::memcpy(volumeData + sliceIndex * bytesPerSlice, slice->GetBufferPointer(), bytesPerSlice);
+
+        std::lock_guard<std::mutex> lock(progressMutex);
+        loadedSlices[sliceIndex] = true;
+        if (progress)
+        {
+          progress(image, loadedSlices);
+        }
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(readErrorMutex);
+      if (!readError)
+      {
+        readError = std::current_exception();
+      }
+      nextSlice = numberOfSlices;
+    }
+  };
+
+  unsigned int numberOfThreads = m_NumberOfThreads > 0 ? m_NumberOfThreads : std::thread::hardware_concurrency();
+  numberOfThreads = std::max(1u, std::min(numberOfThreads, numberOfSlices));
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back(readSlices);
+  }
+  readSlices();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  if (readError)
+  {
+    std::rethrow_exception(readError);
+  }
+
+  return image;
+}
+
+template <typename PixelType>
+mitk::Image::Pointer
+mitk::ITKDICOMSeriesReaderHelper
+::LoadDICOMByITKEnhancedMultiFrame(
+    const std::string& filename,
+    const DICOMEnhancedMultiFrameInfo& frameInfo,
+    itk::GDCMImageIO::Pointer& io)
+{
+  typedef itk::Image<PixelType, 3> ImageType;
+
+  const std::vector<unsigned int>& frameOrder = frameInfo.GetFrameOrder();
+  const std::size_t numberOfFrames = frameOrder.size();
+
+  // GDCMImageIO describes a multi-frame object as a volume with one slice per frame
+  if (io->GetNumberOfDimensions() != 3 || io->GetDimensions(2) != numberOfFrames
+      || io->GetImageSizeInBytes() != io->GetImageSizeInPixels() * sizeof(PixelType))
+  {
+    MITK_DEBUG << "Pixel data of " << filename << " does not match its functional groups.";
+    return nullptr;
+  }
+
+  // the geometry is taken from the functional groups, the image only describes it and has no buffer
+  typename ImageType::Pointer geometryImage = ImageType::New();
+  typename ImageType::SizeType size;
+  size[0] = io->GetDimensions(0);
+  size[1] = io->GetDimensions(1);
+  size[2] = frameInfo.GetNumberOfSlices();
+  geometryImage->SetRegions(size);
+
+  const Point3D origin = frameInfo.GetOrigin();
+  const Vector3D spacing = frameInfo.GetSpacing();
+  const Vector3D right = frameInfo.GetRight();
+  const Vector3D up = frameInfo.GetUp();
+  const Vector3D normal = frameInfo.GetNormal();
+
+  typename ImageType::PointType itkOrigin;
+  typename ImageType::SpacingType itkSpacing;
+  typename ImageType::DirectionType direction;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    itkOrigin[i] = origin[i];
+    itkSpacing[i] = spacing[i];
+    direction[i][0] = right[i];
+    direction[i][1] = up[i];
+    direction[i][2] = normal[i];
+  }
+  geometryImage->SetOrigin(itkOrigin);
+  geometryImage->SetSpacing(itkSpacing);
+  geometryImage->SetDirection(direction);
+
+  mitk::Image::Pointer image = mitk::Image::New();
+  image->InitializeByItk(geometryImage.GetPointer(), 1, frameInfo.GetNumberOfTimeSteps());
+
+  const std::size_t pixelsPerFrame = size[0] * size[1];
+  {
+    mitk::ImageWriteAccessor accessor(image);
+    auto* buffer = static_cast<PixelType*>(accessor.GetData());
+
+    if (std::is_sorted(frameOrder.cbegin(), frameOrder.cend()))
+    {
+      // the frames are stored in the order of the image, so they are decoded right into it
+      io->Read(buffer);
+    }
+    else
+    {
+      std::vector<PixelType> frames(numberOfFrames * pixelsPerFrame);
+      io->Read(frames.data());
+
+      for (std::size_t i = 0; i < numberOfFrames; ++i)
+      {
+        std::copy_n(frames.data() + frameOrder[i] * pixelsPerFrame, pixelsPerFrame, buffer + i * pixelsPerFrame);
+      }
+    }
+  }
+
+  return image;
+}
+
 #define MITK_DEBUG_OUTPUT_FILELIST(list)\
   MITK_DEBUG << "-------------------------------------------"; \
   for (StringContainer::const_iterator _iter = (list).cbegin(); _iter!=(list).cend(); ++_iter) \
@@ -122,13 +450,18 @@ mitk::ITKDICOMSeriesReaderHelper
 #endif // MBILOG_ENABLE_DEBUG
 
   reader->SetFileNames(filenamesForTimeSteps.front());
-  reader->Update();
-  typename ImageType::Pointer readVolume = reader->GetOutput();
+  reader->UpdateOutputInformation();
+  typename ImageType::Pointer readVolume = ReadSlicesConcurrently<ImageType>(reader->GetOutput(), filenamesForTimeSteps.front());
+  if (readVolume.IsNull())
+  {
+    reader->Update();
+    readVolume = reader->GetOutput();
+  }
 
   // if we detected that the images are from a tilted gantry acquisition, we need to push some pixels into the right position
   if (correctTilt)
   {
-    readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
+    readVolume = FixUpTiltedGeometry( readVolume, tiltInfo );
   }
 
   image->InitializeByItk(readVolume.GetPointer(), 1, numberOfTimeSteps);
@@ -145,12 +478,17 @@ mitk::ITKDICOMSeriesReaderHelper
 #endif // MBILOG_ENABLE_DEBUG
 
     reader->SetFileNames( *timestepsIter );
-    reader->Update();
-    readVolume = reader->GetOutput();
+    reader->UpdateOutputInformation();
+    readVolume = ReadSlicesConcurrently<ImageType>( reader->GetOutput(), *timestepsIter );
+    if (readVolume.IsNull())
+    {
+      reader->Update();
+      readVolume = reader->GetOutput();
+    }
 
     if (correctTilt)
     {
-      readVolume = FixUpTiltedGeometry( reader->GetOutput(), tiltInfo );
+      readVolume = FixUpTiltedGeometry( readVolume, tiltInfo );
     }
 
     image->SetImportVolume(readVolume->GetBufferPointer(), currentTimeStep);
@@ -42,6 +42,12 @@ class MITKDICOM_EXPORT SortByImagePositionPatient : public DICOMSortCriterion
 
     double NumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to) const override;
 
+    /// \brief The key holds the orientation vectors (right, up) and the image position, 9 values.
+    unsigned int GetSortKeySize() const override;
+    void ExtractSortKey(const mitk::DICOMDatasetAccess* dataset, double* key) const override;
+    bool CompareSortKeys(const double* left, const double* right, bool& leftBeforeRight) const override;
+    double SortKeyDistance(const double* from, const double* to) const override;
+
     void Print(std::ostream& os) const override;
 
     bool operator==(const DICOMSortCriterion& other) const override;
@@ -55,6 +61,7 @@ class MITKDICOM_EXPORT SortByImagePositionPatient : public DICOMSortCriterion
     SortByImagePositionPatient& operator=(const SortByImagePositionPatient& other);
 
     double InternalNumericDistance(const mitk::DICOMDatasetAccess* from, const mitk::DICOMDatasetAccess* to, bool& possible) const;
+    double InternalNumericDistance(const double* from, const double* to, bool& possible) const;
 
   private:
 };
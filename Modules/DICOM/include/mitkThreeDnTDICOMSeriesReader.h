@@ -55,10 +55,6 @@ class MITKDICOM_EXPORT ThreeDnTDICOMSeriesReader : public DICOMITKSeriesGDCMRead
     itkSetMacro(OnlyCondenseSameSeries, bool);
     itkGetConstMacro(OnlyCondenseSameSeries, bool);
 
-    // void AllocateOutputImages();
-    /// \brief Load via multiple calls to itk::ImageSeriesReader.
-    bool LoadImages() override;
-
     bool operator==(const DICOMFileReader& other) const override;
 
     static bool GetDefaultGroup3DandT()
@@ -56,6 +56,17 @@ bool BaseDICOMReaderService::GetOnlyRegardOwnSeries() const
   return m_OnlyRegardOwnSeries;
 }
 
+std::string BaseDICOMReaderService::OPTION_USE_PERSISTENT_TAG_INDEX()
+{
+  return "Use persistent tag index";
+}
+
+bool BaseDICOMReaderService::GetUsePersistentTagIndex() const
+{
+  const us::Any option = this->GetOption(OPTION_USE_PERSISTENT_TAG_INDEX());
+  return !option.Empty() && us::any_cast<bool>(option);
+}
+
 
 std::vector<itk::SmartPointer<BaseData> > BaseDICOMReaderService::DoRead()
 {
@@ -142,6 +153,7 @@ std::vector<itk::SmartPointer<BaseData> > BaseDICOMReaderService::DoRead()
           mitk::DICOMDCMTKTagScanner::Pointer scanner = mitk::DICOMDCMTKTagScanner::New();
           scanner->AddTagPaths(reader->GetTagsOfInterest());
           scanner->SetInputFiles(relevantFiles);
+          scanner->SetUsePersistentTagIndex(this->GetUsePersistentTagIndex());
           scanner->Scan();
 
           reader->SetTagCache(scanner->GetScanCache());
@@ -12,10 +12,17 @@ found in the LICENSE file.
 
 #include "mitkDICOMDCMTKTagScanner.h"
 #include "mitkDICOMGenericImageFrameInfo.h"
+#include "mitkDICOMPersistentTagIndex.h"
 
 #include <dcmtk/dcmdata/dcfilefo.h>
 #include <dcmtk/dcmdata/dcpath.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 mitk::DICOMDCMTKTagScanner::DICOMDCMTKTagScanner()
 {
 }
@@ -98,64 +105,185 @@ mitk::DICOMTagPath DcmPathToTagPath(DcmPath * dcmpath)
   return result;
 }
 
+namespace
+{
+  /** Parsing of a file can stop at the returned tag because no scanned top-level element follows it. */
+  DcmTagKey GetStopParsingTag(const std::set<mitk::DICOMTagPath>& scannedTags)
+  {
+    mitk::DICOMTag lastTag(0, 0);
+    for (const auto& path : scannedTags)
+    {
+      if (path.IsEmpty() || path.GetFirstNode().type == mitk::DICOMTagPath::NodeInfo::NodeType::AnyElement)
+      {
+        return DCM_UndefinedTagKey;
+      }
+      lastTag = std::max(lastTag, path.GetFirstNode().tag);
+    }
+
+    if (lastTag.GetElement() < 0xFFFF)
+    {
+      return DcmTagKey(static_cast<Uint16>(lastTag.GetGroup()), static_cast<Uint16>(lastTag.GetElement() + 1));
+    }
+    if (lastTag.GetGroup() < 0xFFFF)
+    {
+      return DcmTagKey(static_cast<Uint16>(lastTag.GetGroup() + 1), 0);
+    }
+    return DCM_UndefinedTagKey;
+  }
+
+  /** Collects the values of all findings of the scanned tags, returns false if the file cannot be read. */
+  bool ScanFile(const std::string& fileName,
+                const std::set<mitk::DICOMTagPath>& scannedTags,
+                const DcmTagKey& stopParsingTag,
+                DcmPathProcessor& processor,
+                mitk::DICOMPersistentTagIndex::ValueList& values)
+  {
+    DcmFileFormat dfile;
+    OFCondition cond = dfile.loadFileUntilTag(
+      fileName.c_str(), EXS_Unknown, EGL_noChange, DCM_MaxReadLength, ERM_autoDetect, stopParsingTag);
+    if (cond.bad())
+    {
+      MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << fileName;
+      return false;
+    }
+
+    for (const auto& path : scannedTags)
+    {
+      std::string tagPath = mitk::DICOMTagPathToDCMTKSearchPath(path);
+      cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
+      if (cond.good())
+      {
+        OFList< DcmPath * > findings;
+        processor.getResults(findings);
+        for (const auto& finding : findings)
+        {
+          auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
+          if (!element)
+          {
+            auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
+            if (item)
+            {
+              element = item->getElement(finding->back()->m_itemNo);
+            }
+          }
+
+          if (element)
+          {
+            OFString value;
+            cond = element->getOFStringArray(value);
+            if (cond.good())
+            {
+              values.emplace_back(DcmPathToTagPath(finding), std::string(value.c_str()));
+            }
+          }
+        }
+      }
+    }
+
+    return true;
+  }
+
+  mitk::DICOMGenericImageFrameInfo::Pointer CreateFrameInfo(const std::string& fileName,
+                                                            const mitk::DICOMPersistentTagIndex::ValueList& values)
+  {
+    mitk::DICOMGenericImageFrameInfo::Pointer info = mitk::DICOMGenericImageFrameInfo::New(fileName);
+    for (const auto& value : values)
+    {
+      info->SetTagValue(value.path, value.value);
+    }
+    return info;
+  }
+}
+
 void mitk::DICOMDCMTKTagScanner::Scan()
 {
   this->PushLocale();
 
   try
   {
-    DcmPathProcessor processor;
-    processor.setItemWildcardSupport(true);
+    const DcmTagKey stopParsingTag = GetStopParsingTag(m_ScannedTags);
+    const std::size_t numberOfFiles = m_InputFilenames.size();
 
-    DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
+    // only files that are not (or no longer) indexed have to be parsed
+    DICOMPersistentTagIndex index(this->GetNameOfClass());
+    if (m_UsePersistentTagIndex)
+    {
+      index.Load(m_InputFilenames, m_ScannedTags);
+    }
 
-    for (const auto& fileName : this->m_InputFilenames)
+    std::vector<const DICOMPersistentTagIndex::ValueList*> indexedValues(numberOfFiles);
+    std::vector<std::size_t> filesToScan;
+    for (std::size_t i = 0; i < numberOfFiles; ++i)
     {
-      DcmFileFormat dfile;
-      OFCondition cond = dfile.loadFile(fileName.c_str());
-      if (cond.bad())
+      indexedValues[i] = index.Find(m_InputFilenames[i]);
+      if (indexedValues[i] == nullptr)
       {
-        MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << fileName;
+        filesToScan.push_back(i);
       }
-      else
+    }
+
+    // files are handed out one by one, results keep the order of the input files
+    std::vector<DICOMPersistentTagIndex::ValueList> scannedValues(numberOfFiles);
+    std::vector<char> isScanned(numberOfFiles, 0);
+    const std::size_t numberOfFilesToScan = filesToScan.size();
+    std::atomic<std::size_t> nextFile(0);
+    std::exception_ptr scanError;
+    std::mutex scanErrorMutex;
+
+    auto scanFiles = [&]() {
+      try
       {
-        DICOMGenericImageFrameInfo::Pointer info = DICOMGenericImageFrameInfo::New(fileName);
+        DcmPathProcessor processor;
+        processor.setItemWildcardSupport(true);
 
-        for (const auto& path : this->m_ScannedTags)
+        for (std::size_t next = nextFile++; next < numberOfFilesToScan; next = nextFile++)
         {
-          std::string tagPath = DICOMTagPathToDCMTKSearchPath(path);
-          cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
-          if (cond.good())
-          {
-            OFList< DcmPath * > findings;
-            processor.getResults(findings);
-            for (const auto& finding : findings)
-            {
-              auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
-              if (!element)
-              {
-                auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
-                if (item)
-                {
-                  element = item->getElement(finding->back()->m_itemNo);
-                }
-              }
-
-              if (element)
-              {
-                OFString value;
-                cond = element->getOFStringArray(value);
-                if (cond.good())
-                {
-                  info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
-                }
-              }
-            }
-          }
+          const std::size_t i = filesToScan[next];
+          isScanned[i] = ScanFile(m_InputFilenames[i], m_ScannedTags, stopParsingTag, processor, scannedValues[i]);
+        }
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(scanErrorMutex);
+        if (!scanError)
+        {
+          scanError = std::current_exception();
         }
-        newCache->AddFrameInfo(info);
+        nextFile = numberOfFilesToScan;
+      }
+    };
+
+    const unsigned int numberOfThreads = this->GetNumberOfScanThreads(numberOfFilesToScan);
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < numberOfThreads; ++i)
+    {
+      threads.emplace_back(scanFiles);
+    }
+    scanFiles();
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    if (scanError)
+    {
+      std::rethrow_exception(scanError);
+    }
+
+    DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
+    for (std::size_t i = 0; i < numberOfFiles; ++i)
+    {
+      if (indexedValues[i] != nullptr)
+      {
+        newCache->AddFrameInfo(CreateFrameInfo(m_InputFilenames[i], *indexedValues[i]));
+      }
+      else if (isScanned[i])
+      {
+        newCache->AddFrameInfo(CreateFrameInfo(m_InputFilenames[i], scannedValues[i]));
+        index.Update(m_InputFilenames[i], scannedValues[i]);
       }
     }
+    index.Save();
 
     m_Cache = newCache;
 
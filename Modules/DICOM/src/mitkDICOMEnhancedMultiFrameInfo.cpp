@@ -0,0 +1,434 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMEnhancedMultiFrameInfo.h"
+
+#include <gdcmAttribute.h>
+#include <gdcmReader.h>
+#include <gdcmSequenceOfItems.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <set>
+
+namespace
+{
+  /** Positions along the slice normal closer than this (in mm) belong to the same slice. */
+  const double SamePositionTolerance = 1e-3;
+
+  /** Tolerated deviation from an equidistant, orthogonal block as fraction of the slice distance,
+      like the default of DICOMITKSeriesGDCMReader::SetToleratedOriginOffsetToAdaptive(). */
+  const double ToleratedOriginOffset = 0.3;
+
+  /** The attributes of a frame found in the functional groups. */
+  struct FrameAttributes
+  {
+    bool HasPosition = false;
+    mitk::Point3D Position;
+    bool HasOrientation = false;
+    mitk::Vector3D Right;
+    mitk::Vector3D Up;
+    bool HasPixelSpacing = false;
+    double PixelSpacing[2] = { 1.0, 1.0 };
+    double RescaleSlope = 1.0;
+    double RescaleIntercept = 0.0;
+    std::vector<unsigned int> DimensionIndexValues;
+  };
+
+  template <typename TAttribute>
+  bool ReadAttribute( const gdcm::DataSet& dataset, TAttribute& attribute )
+  {
+    const gdcm::Tag tag = attribute.GetTag();
+    if ( !dataset.FindDataElement( tag ) || dataset.GetDataElement( tag ).IsEmpty() )
+    {
+      return false;
+    }
+
+    attribute.SetFromDataElement( dataset.GetDataElement( tag ) );
+    return true;
+  }
+
+  /** Reads an attribute of the (single item) functional group macro sequence macroTag. */
+  template <typename TAttribute>
+  bool ReadMacroAttribute( const gdcm::DataSet& functionalGroups, const gdcm::Tag& macroTag, TAttribute& attribute )
+  {
+    if ( !functionalGroups.FindDataElement( macroTag ) )
+    {
+      return false;
+    }
+
+    const gdcm::SmartPointer<gdcm::SequenceOfItems> macro = functionalGroups.GetDataElement( macroTag ).GetValueAsSQ();
+    if ( !macro || macro->GetNumberOfItems() == 0 )
+    {
+      return false;
+    }
+
+    return ReadAttribute( macro->GetItem( 1 ).GetNestedDataSet(), attribute );
+  }
+
+  void ReadOrientation( const gdcm::Attribute<0x0020, 0x0037>& orientation, FrameAttributes& attributes )
+  {
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+      attributes.Right[i] = orientation.GetValue( i );
+      attributes.Up[i]    = orientation.GetValue( i + 3 );
+    }
+    attributes.HasOrientation = true;
+  }
+
+  /** Updates attributes by the functional groups of a shared or per-frame functional groups item. */
+  void ReadFunctionalGroups( const gdcm::DataSet& functionalGroups, FrameAttributes& attributes )
+  {
+    gdcm::Attribute<0x0020, 0x0032> position;
+    if ( ReadMacroAttribute( functionalGroups, gdcm::Tag( 0x0020, 0x9113 ), position ) ) // plane position sequence
+    {
+      for ( unsigned int i = 0; i < 3; ++i )
+      {
+        attributes.Position[i] = position.GetValue( i );
+      }
+      attributes.HasPosition = true;
+    }
+
+    gdcm::Attribute<0x0020, 0x0037> orientation;
+    if ( ReadMacroAttribute( functionalGroups, gdcm::Tag( 0x0020, 0x9116 ), orientation ) ) // plane orientation sequence
+    {
+      ReadOrientation( orientation, attributes );
+    }
+
+    gdcm::Attribute<0x0028, 0x0030> pixelSpacing;
+    if ( ReadMacroAttribute( functionalGroups, gdcm::Tag( 0x0028, 0x9110 ), pixelSpacing ) ) // pixel measures sequence
+    {
+      // row spacing (y) first
+      attributes.PixelSpacing[0] = pixelSpacing.GetValue( 1 );
+      attributes.PixelSpacing[1] = pixelSpacing.GetValue( 0 );
+      attributes.HasPixelSpacing = true;
+    }
+
+    const gdcm::Tag pixelValueTransformationTag( 0x0028, 0x9145 );
+    gdcm::Attribute<0x0028, 0x1052> rescaleIntercept;
+    if ( ReadMacroAttribute( functionalGroups, pixelValueTransformationTag, rescaleIntercept ) )
+    {
+      attributes.RescaleIntercept = rescaleIntercept.GetValue();
+    }
+
+    gdcm::Attribute<0x0028, 0x1053> rescaleSlope;
+    if ( ReadMacroAttribute( functionalGroups, pixelValueTransformationTag, rescaleSlope ) )
+    {
+      attributes.RescaleSlope = rescaleSlope.GetValue();
+    }
+
+    gdcm::Attribute<0x0020, 0x9157> dimensionIndexValues;
+    if ( ReadMacroAttribute( functionalGroups, gdcm::Tag( 0x0020, 0x9111 ), dimensionIndexValues ) ) // frame content sequence
+    {
+      attributes.DimensionIndexValues.resize( dimensionIndexValues.GetNumberOfValues() );
+      for ( unsigned int i = 0; i < dimensionIndexValues.GetNumberOfValues(); ++i )
+      {
+        attributes.DimensionIndexValues[i] = dimensionIndexValues.GetValue( i );
+      }
+    }
+  }
+
+  std::string TrimUID( const std::string& uid )
+  {
+    const auto end = uid.find_last_not_of( std::string( " \0", 2 ) );
+    return std::string::npos == end ? std::string() : uid.substr( 0, end + 1 );
+  }
+}
+
+mitk::DICOMEnhancedMultiFrameInfo::DICOMEnhancedMultiFrameInfo()
+: m_PixelSpacing{ 1.0, 1.0 }
+, m_NumberOfSlices( 0 )
+, m_SliceDistance( 1.0 )
+{
+  m_DimensionIndexOffsets.push_back( 0 );
+  m_Right.Fill( 0.0 );
+  m_Up.Fill( 0.0 );
+}
+
+bool mitk::DICOMEnhancedMultiFrameInfo::IsEnhancedMultiFrameSOPClass( const std::string& sopClassUID )
+{
+  static const std::set<std::string> enhancedMultiFrameSOPClasses = {
+    "1.2.840.10008.5.1.4.1.1.2.1", // Enhanced CT Image Storage
+    "1.2.840.10008.5.1.4.1.1.2.2", // Legacy Converted Enhanced CT Image Storage
+    "1.2.840.10008.5.1.4.1.1.4.1", // Enhanced MR Image Storage
+    "1.2.840.10008.5.1.4.1.1.4.4"  // Legacy Converted Enhanced MR Image Storage
+  };
+
+  return enhancedMultiFrameSOPClasses.count( TrimUID( sopClassUID ) ) > 0;
+}
+
+bool mitk::DICOMEnhancedMultiFrameInfo::Read( const std::string& filename )
+{
+  *this = DICOMEnhancedMultiFrameInfo();
+
+  gdcm::Reader reader;
+  reader.SetFileName( filename.c_str() );
+  if ( !reader.ReadUpToTag( gdcm::Tag( 0x7fe0, 0x0010 ), std::set<gdcm::Tag>() ) ) // everything but the pixel data
+  {
+    return false;
+  }
+  const gdcm::DataSet& dataset = reader.GetFile().GetDataSet();
+
+  gdcm::Attribute<0x0028, 0x0008> numberOfFramesAttribute;
+  if ( !ReadAttribute( dataset, numberOfFramesAttribute ) || numberOfFramesAttribute.GetValue() < 1 )
+  {
+    return false;
+  }
+  const auto numberOfFrames = static_cast<unsigned int>( numberOfFramesAttribute.GetValue() );
+
+  // legacy converted objects may keep the orientation at top level
+  FrameAttributes sharedAttributes;
+  gdcm::Attribute<0x0020, 0x0037> orientation;
+  if ( ReadAttribute( dataset, orientation ) )
+  {
+    ReadOrientation( orientation, sharedAttributes );
+  }
+
+  const gdcm::Tag sharedFunctionalGroupsTag( 0x5200, 0x9229 );
+  if ( dataset.FindDataElement( sharedFunctionalGroupsTag ) )
+  {
+    const gdcm::SmartPointer<gdcm::SequenceOfItems> sharedFunctionalGroups =
+      dataset.GetDataElement( sharedFunctionalGroupsTag ).GetValueAsSQ();
+    if ( sharedFunctionalGroups && sharedFunctionalGroups->GetNumberOfItems() > 0 )
+    {
+      ReadFunctionalGroups( sharedFunctionalGroups->GetItem( 1 ).GetNestedDataSet(), sharedAttributes );
+    }
+  }
+
+  const gdcm::Tag perFrameFunctionalGroupsTag( 0x5200, 0x9230 );
+  if ( !dataset.FindDataElement( perFrameFunctionalGroupsTag ) )
+  {
+    return false;
+  }
+
+  const gdcm::SmartPointer<gdcm::SequenceOfItems> perFrameFunctionalGroups =
+    dataset.GetDataElement( perFrameFunctionalGroupsTag ).GetValueAsSQ();
+  if ( !perFrameFunctionalGroups || perFrameFunctionalGroups->GetNumberOfItems() != numberOfFrames )
+  {
+    return false;
+  }
+
+  for ( unsigned int frame = 0; frame < numberOfFrames; ++frame )
+  {
+    FrameAttributes attributes = sharedAttributes;
+    ReadFunctionalGroups( perFrameFunctionalGroups->GetItem( frame + 1 ).GetNestedDataSet(), attributes );
+
+    if ( !attributes.HasPosition || !attributes.HasOrientation )
+    {
+      return false;
+    }
+
+    if ( frame == 0 )
+    {
+      this->SetImageOrientation( attributes.Right, attributes.Up );
+      this->SetPixelSpacing( attributes.PixelSpacing[0], attributes.PixelSpacing[1] );
+    }
+    else if ( ( attributes.Right - m_Right ).GetNorm() > mitk::eps || ( attributes.Up - m_Up ).GetNorm() > mitk::eps
+              || std::abs( attributes.PixelSpacing[0] - m_PixelSpacing[0] ) > mitk::eps
+              || std::abs( attributes.PixelSpacing[1] - m_PixelSpacing[1] ) > mitk::eps )
+    {
+      // frames of different planes or resolutions do not fit into a single mitk::Image
+      return false;
+    }
+
+    this->AddFrame( attributes.Position,
+                    attributes.DimensionIndexValues,
+                    attributes.RescaleSlope,
+                    attributes.RescaleIntercept );
+  }
+
+  return true;
+}
+
+void mitk::DICOMEnhancedMultiFrameInfo::SetImageOrientation( const Vector3D& right, const Vector3D& up )
+{
+  m_Right = right;
+  m_Up    = up;
+}
+
+void mitk::DICOMEnhancedMultiFrameInfo::SetPixelSpacing( double spacingX, double spacingY )
+{
+  m_PixelSpacing[0] = spacingX;
+  m_PixelSpacing[1] = spacingY;
+}
+
+void mitk::DICOMEnhancedMultiFrameInfo::AddFrame( const Point3D& imagePosition,
+                                                  const std::vector<unsigned int>& dimensionIndexValues,
+                                                  double rescaleSlope,
+                                                  double rescaleIntercept )
+{
+  m_ImagePositions.push_back( imagePosition );
+  m_DimensionIndexValues.insert( m_DimensionIndexValues.end(), dimensionIndexValues.begin(), dimensionIndexValues.end() );
+  m_DimensionIndexOffsets.push_back( m_DimensionIndexValues.size() );
+  m_RescaleSlopes.push_back( rescaleSlope );
+  m_RescaleIntercepts.push_back( rescaleIntercept );
+}
+
+unsigned int mitk::DICOMEnhancedMultiFrameInfo::GetNumberOfFrames() const
+{
+  return static_cast<unsigned int>( m_ImagePositions.size() );
+}
+
+bool mitk::DICOMEnhancedMultiFrameInfo::HasUniformRescale() const
+{
+  const auto differs = []( double a, double b ) { return std::abs( a - b ) > mitk::eps; };
+
+  return std::adjacent_find( m_RescaleSlopes.begin(), m_RescaleSlopes.end(), differs ) == m_RescaleSlopes.end()
+         && std::adjacent_find( m_RescaleIntercepts.begin(), m_RescaleIntercepts.end(), differs ) == m_RescaleIntercepts.end();
+}
+
+bool mitk::DICOMEnhancedMultiFrameInfo::SortFrames()
+{
+  m_FrameOrder.clear();
+  m_NumberOfSlices = 0;
+  m_SliceDistance  = 1.0;
+
+  const unsigned int numberOfFrames = this->GetNumberOfFrames();
+  const Vector3D normal = this->GetNormal();
+  if ( numberOfFrames == 0 || normal.GetNorm() < mitk::eps )
+  {
+    return false;
+  }
+
+  std::vector<double> distances( numberOfFrames );
+  for ( unsigned int frame = 0; frame < numberOfFrames; ++frame )
+  {
+    distances[frame] = normal * m_ImagePositions[frame].GetVectorFromOrigin();
+  }
+
+  // the positions of the slices along the normal
+  std::vector<double> slicePositions( distances );
+  std::sort( slicePositions.begin(), slicePositions.end() );
+  slicePositions.erase( std::unique( slicePositions.begin(),
+                                     slicePositions.end(),
+                                     []( double a, double b ) { return b - a < SamePositionTolerance; } ),
+                        slicePositions.end() );
+
+  const auto numberOfSlices = static_cast<unsigned int>( slicePositions.size() );
+  if ( numberOfFrames % numberOfSlices != 0 )
+  {
+    return false;
+  }
+  const unsigned int numberOfTimeSteps = numberOfFrames / numberOfSlices;
+
+  if ( numberOfSlices > 1 )
+  {
+    m_SliceDistance = ( slicePositions.back() - slicePositions.front() ) / ( numberOfSlices - 1 );
+  }
+  const double toleratedOffset = ToleratedOriginOffset * m_SliceDistance;
+
+  for ( unsigned int slice = 1; slice < numberOfSlices; ++slice )
+  {
+    if ( std::abs( slicePositions[slice] - ( slicePositions.front() + slice * m_SliceDistance ) ) > toleratedOffset )
+    {
+      return false; // not equidistant
+    }
+  }
+
+  // the order of the dimension index values is the order of acquisition, it tells the time step of a frame
+  std::vector<unsigned int> acquisitionOrder( numberOfFrames );
+  std::iota( acquisitionOrder.begin(), acquisitionOrder.end(), 0 );
+  std::stable_sort( acquisitionOrder.begin(),
+                    acquisitionOrder.end(),
+                    [this]( unsigned int a, unsigned int b ) {
+                      return std::lexicographical_compare( m_DimensionIndexValues.begin() + m_DimensionIndexOffsets[a],
+                                                           m_DimensionIndexValues.begin() + m_DimensionIndexOffsets[a + 1],
+                                                           m_DimensionIndexValues.begin() + m_DimensionIndexOffsets[b],
+                                                           m_DimensionIndexValues.begin() + m_DimensionIndexOffsets[b + 1] );
+                    } );
+
+  const unsigned int firstFrame = acquisitionOrder.front();
+  std::vector<unsigned int> frameOrder( numberOfFrames );
+  std::vector<unsigned int> framesPerSlice( numberOfSlices, 0 );
+  for ( const auto frame : acquisitionOrder )
+  {
+    // frames of other slices must only be shifted along the normal
+    const Vector3D inPlaneOffset = ( m_ImagePositions[frame] - m_ImagePositions[firstFrame] )
+                                   - normal * ( distances[frame] - distances[firstFrame] );
+    if ( inPlaneOffset.GetNorm() > toleratedOffset )
+    {
+      return false;
+    }
+
+    const auto slice = static_cast<unsigned int>(
+      std::upper_bound( slicePositions.begin(), slicePositions.end(), distances[frame] ) - slicePositions.begin() - 1 );
+    const unsigned int timeStep = framesPerSlice[slice]++;
+    if ( timeStep >= numberOfTimeSteps )
+    {
+      return false; // more frames at this position than at others
+    }
+
+    frameOrder[timeStep * numberOfSlices + slice] = frame;
+  }
+
+  m_FrameOrder     = frameOrder;
+  m_NumberOfSlices = numberOfSlices;
+  return true;
+}
+
+const std::vector<unsigned int>& mitk::DICOMEnhancedMultiFrameInfo::GetFrameOrder() const
+{
+  return m_FrameOrder;
+}
+
+unsigned int mitk::DICOMEnhancedMultiFrameInfo::GetNumberOfSlices() const
+{
+  return m_NumberOfSlices;
+}
+
+unsigned int mitk::DICOMEnhancedMultiFrameInfo::GetNumberOfTimeSteps() const
+{
+  return m_NumberOfSlices > 0 ? this->GetNumberOfFrames() / m_NumberOfSlices : 0;
+}
+
+mitk::Point3D mitk::DICOMEnhancedMultiFrameInfo::GetOrigin() const
+{
+  if ( m_FrameOrder.empty() )
+  {
+    Point3D origin;
+    origin.Fill( 0.0 );
+    return origin;
+  }
+
+  return m_ImagePositions[m_FrameOrder.front()];
+}
+
+mitk::Vector3D mitk::DICOMEnhancedMultiFrameInfo::GetSpacing() const
+{
+  Vector3D spacing;
+  spacing[0] = m_PixelSpacing[0];
+  spacing[1] = m_PixelSpacing[1];
+  spacing[2] = m_SliceDistance;
+  return spacing;
+}
+
+mitk::Vector3D mitk::DICOMEnhancedMultiFrameInfo::GetRight() const
+{
+  return m_Right;
+}
+
+mitk::Vector3D mitk::DICOMEnhancedMultiFrameInfo::GetUp() const
+{
+  return m_Up;
+}
+
+mitk::Vector3D mitk::DICOMEnhancedMultiFrameInfo::GetNormal() const
+{
+  Vector3D normal = itk::CrossProduct( m_Right, m_Up );
+  const double norm = normal.GetNorm();
+  if ( norm > mitk::eps )
+  {
+    normal /= norm;
+  }
+  return normal;
+}
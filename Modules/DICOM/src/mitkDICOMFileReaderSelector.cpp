@@ -22,6 +22,7 @@ found in the LICENSE file.
 
 mitk::DICOMFileReaderSelector
 ::DICOMFileReaderSelector()
+: m_UsePersistentTagIndex(false)
 {
 }
 
@@ -182,6 +183,20 @@ mitk::DICOMFileReaderSelector
   return m_InputFilenames;
 }
 
+void
+mitk::DICOMFileReaderSelector
+::SetUsePersistentTagIndex(bool use)
+{
+  m_UsePersistentTagIndex = use;
+}
+
+bool
+mitk::DICOMFileReaderSelector
+::GetUsePersistentTagIndex() const
+{
+  return m_UsePersistentTagIndex;
+}
+
 mitk::DICOMFileReader::Pointer
 mitk::DICOMFileReaderSelector
 ::GetFirstReaderWithMinimumNumberOfOutputImages()
@@ -191,6 +206,7 @@ mitk::DICOMFileReaderSelector
   // do the tag scanning externally and just ONCE
   DICOMGDCMTagScanner::Pointer gdcmScanner = DICOMGDCMTagScanner::New();
   gdcmScanner->SetInputFiles( m_InputFilenames );
+  gdcmScanner->SetUsePersistentTagIndex( m_UsePersistentTagIndex );
 
   // let all readers analyze the file set
   for ( auto rIter = m_Readers.cbegin(); rIter != m_Readers.cend(); ++rIter )
@@ -14,6 +14,8 @@ found in the LICENSE file.
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMGDCMImageFrameInfo.h"
 
+#include <algorithm>
+
 mitk::DICOMGDCMTagCache::DICOMGDCMTagCache()
 {
 }
@@ -82,23 +84,97 @@ mitk::DICOMDatasetAccessingImageFrameList mitk::DICOMGDCMTagCache::GetFrameInfoL
 
 void
 mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles)
+{
+  this->InitCache(scannedTags, std::vector<std::shared_ptr<gdcm::Scanner>>(1, scanner), inputFiles);
+}
+
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners, const StringList& inputFiles)
+{
+  this->InitCache(scannedTags, scanners, inputFiles, IndexedValuesMapType());
+}
+
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners, const StringList& inputFiles, const IndexedValuesMapType& indexedValues)
 {
   m_ScannedTags = scannedTags;
   m_InputFilenames = inputFiles;
-  m_Scanner = scanner;
+  m_Scanners = scanners;
+  m_IndexedValues.clear();
+
+  {
+    // a single scanner that scanned all input files can be returned by GetScanner() directly
+    std::lock_guard<std::mutex> lock(m_CompleteScannerMutex);
+    m_CompleteScanner = m_Scanners.size() == 1 && indexedValues.empty() ? m_Scanners.front() : nullptr;
+  }
 
   m_ScanResult.clear();
   m_ScanResult.reserve(m_InputFilenames.size());
 
   for (auto inputIter = m_InputFilenames.cbegin(); inputIter != m_InputFilenames.cend(); ++inputIter)
   {
+    const auto indexedIter = indexedValues.find(*inputIter);
+    if (indexedIter != indexedValues.cend())
+    {
+      gdcm::Scanner::TagToValue mapping;
+      for (const auto& value : indexedIter->second)
+      {
+        if (value.path.Size() != 1)
+        {
+          continue;
+        }
+
+        const DICOMTag& tag = value.path.GetFirstNode().tag;
+        if (value.isNull)
+        {
+          mapping[gdcm::Tag(tag.GetGroup(), tag.GetElement())] = nullptr;
+          continue;
+        }
+
+        m_IndexedValues.push_back(value.value);
+        mapping[gdcm::Tag(tag.GetGroup(), tag.GetElement())] = m_IndexedValues.back().c_str();
+      }
+
+      m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0), mapping).GetPointer());
+      continue;
+    }
+
+    if (m_Scanners.empty())
+    {
+      continue;
+    }
+
+    // files that were not readable are unknown to all scanners and get the (empty) default mapping
+    auto scannerIter = std::find_if(m_Scanners.cbegin(), m_Scanners.cend(),
+      [inputIter](const std::shared_ptr<gdcm::Scanner>& scanner) { return scanner->IsKey(inputIter->c_str()); });
+    const gdcm::Scanner& scanner = scannerIter != m_Scanners.cend() ? **scannerIter : *m_Scanners.front();
+
     m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0),
-      m_Scanner->GetMapping(inputIter->c_str())).GetPointer());
+      scanner.GetMapping(inputIter->c_str())).GetPointer());
   }
 }
 
 const gdcm::Scanner&
 mitk::DICOMGDCMTagCache::GetScanner() const
 {
-  return *(this->m_Scanner);
+  std::lock_guard<std::mutex> lock(m_CompleteScannerMutex);
+  if (!m_CompleteScanner)
+  {
+    // the values are spread over several scanners or were taken from the index, gdcm::Scanner
+    // offers no way to merge them, so all input files are scanned once more
+    auto scanner = std::make_shared<gdcm::Scanner>();
+    for (const auto& tag : m_ScannedTags)
+    {
+      scanner->AddTag(gdcm::Tag(tag.GetGroup(), tag.GetElement()));
+    }
+    scanner->Scan(m_InputFilenames);
+    m_CompleteScanner = scanner;
+  }
+  return *m_CompleteScanner;
+}
+
+const std::vector<std::shared_ptr<gdcm::Scanner>>&
+mitk::DICOMGDCMTagCache::GetScanners() const
+{
+  return this->m_Scanners;
 }
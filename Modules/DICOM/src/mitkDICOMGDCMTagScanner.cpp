@@ -13,12 +13,16 @@ found in the LICENSE file.
 #include "mitkDICOMGDCMTagScanner.h"
 #include "mitkDICOMGDCMTagCache.h"
 #include "mitkDICOMGDCMImageFrameInfo.h"
+#include "mitkDICOMPersistentTagIndex.h"
 
 #include <gdcmScanner.h>
 
+#include <exception>
+#include <mutex>
+#include <thread>
+
 mitk::DICOMGDCMTagScanner::DICOMGDCMTagScanner()
 {
-  m_GDCMScanner = std::make_shared<gdcm::Scanner>();
 }
 
 mitk::DICOMGDCMTagScanner::~DICOMGDCMTagScanner()
@@ -41,8 +45,6 @@ mitk::DICOMDatasetFinding mitk::DICOMGDCMTagScanner::GetTagValue( DICOMImageFram
 void mitk::DICOMGDCMTagScanner::AddTag( const DICOMTag& tag )
 {
   m_ScannedTags.insert( tag );
-  m_GDCMScanner->AddTag(
-    gdcm::Tag( tag.GetGroup(), tag.GetElement() ) ); // also a set, duplicate calls to AddTag don't hurt
 }
 
 void mitk::DICOMGDCMTagScanner::AddTags( const DICOMTagList& tags )
@@ -93,10 +95,106 @@ void mitk::DICOMGDCMTagScanner::SetInputFiles( const StringList& filenames )
 void mitk::DICOMGDCMTagScanner::Scan()
 {
   // TODO integrate push/pop locale??
-  m_GDCMScanner->Scan( m_InputFilenames );
+
+  // only files that are not (or no longer) indexed have to be scanned
+  std::set<DICOMTagPath> scannedPaths;
+  for (const auto& tag : m_ScannedTags)
+  {
+    scannedPaths.insert(DICOMTagPath(tag));
+  }
+
+  DICOMPersistentTagIndex index(this->GetNameOfClass());
+  if (m_UsePersistentTagIndex)
+  {
+    index.Load(m_InputFilenames, scannedPaths);
+  }
+
+  DICOMGDCMTagCache::IndexedValuesMapType indexedValues;
+  StringList filesToScan;
+  for (const auto& filename : m_InputFilenames)
+  {
+    const auto* values = index.Find(filename);
+    if (values != nullptr)
+    {
+      indexedValues[filename] = *values;
+    }
+    else
+    {
+      filesToScan.push_back(filename);
+    }
+  }
+
+  // gdcm::Scanner is not thread-safe, so every thread scans a contiguous part of the files with its own scanner
+  const std::size_t numberOfFiles = filesToScan.size();
+  const unsigned int numberOfThreads = this->GetNumberOfScanThreads(numberOfFiles);
+
+  std::vector<std::shared_ptr<gdcm::Scanner>> scanners(numberOfThreads);
+  std::exception_ptr scanError;
+  std::mutex scanErrorMutex;
+
+  auto scanPart = [&](unsigned int part) {
+    try
+    {
+      auto scanner = std::make_shared<gdcm::Scanner>();
+      for (const auto& tag : m_ScannedTags)
+      {
+        scanner->AddTag(gdcm::Tag(tag.GetGroup(), tag.GetElement()));
+      }
+
+      StringList files(filesToScan.cbegin() + part * numberOfFiles / numberOfThreads,
+                       filesToScan.cbegin() + (part + 1) * numberOfFiles / numberOfThreads);
+      scanner->Scan(files);
+      scanners[part] = scanner;
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(scanErrorMutex);
+      if (!scanError)
+      {
+        scanError = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int part = 1; part < numberOfThreads; ++part)
+  {
+    threads.emplace_back(scanPart, part);
+  }
+  scanPart(0);
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  if (scanError)
+  {
+    std::rethrow_exception(scanError);
+  }
+
+  for (const auto& scanner : scanners)
+  {
+    for (const auto& filename : scanner->GetFilenames())
+    {
+      if (!scanner->IsKey(filename.c_str()))
+      {
+        continue;
+      }
+
+      DICOMPersistentTagIndex::ValueList values;
+      for (const auto& tagValue : scanner->GetMapping(filename.c_str()))
+      {
+        values.emplace_back(DICOMTagPath(tagValue.first.GetGroup(), tagValue.first.GetElement()),
+                            tagValue.second != nullptr ? std::string(tagValue.second) : std::string(),
+                            tagValue.second == nullptr);
+      }
+      index.Update(filename, values);
+    }
+  }
+  index.Save();
 
   DICOMGDCMTagCache::Pointer newCache = DICOMGDCMTagCache::New();
-  newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
+  newCache->InitCache(m_ScannedTags, scanners, m_InputFilenames, indexedValues);
 
   m_Cache = newCache;
 }
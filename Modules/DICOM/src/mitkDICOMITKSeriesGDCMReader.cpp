@@ -20,8 +20,32 @@ found in the LICENSE file.
 #include "mitkGantryTiltInformation.h"
 #include "mitkDICOMTagBasedSorter.h"
 #include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMLocaleHelper.h"
+#include "mitkDICOMEnhancedMultiFrameInfo.h"
 
-itk::MutexLock::Pointer mitk::DICOMITKSeriesGDCMReader::s_LocaleMutex = itk::MutexLock::New();
+#include <algorithm>
+#include <atomic>
+#include <clocale>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+  /** Whether the frame is a file of an enhanced SOP class that contains more than one frame. */
+  bool IsEnhancedMultiFrameFile( const mitk::DICOMDatasetAccessingImageFrameInfo* frame )
+  {
+    const std::string sopClassUID = frame->GetTagValueAsString( mitk::DICOMTag( 0x0008, 0x0016 ) ).value;
+    if ( !mitk::DICOMEnhancedMultiFrameInfo::IsEnhancedMultiFrameSOPClass( sopClassUID ) )
+    {
+      return false;
+    }
+
+    const std::string numberOfFrames = frame->GetTagValueAsString( mitk::DICOMTag( 0x0028, 0x0008 ) ).value;
+    return std::strtol( numberOfFrames.c_str(), nullptr, 10 ) > 1;
+  }
+}
 
 
 mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPlacesForOrientation, bool simpleVolumeImport )
@@ -29,6 +53,9 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( unsigned int decimalPl
 , m_FixTiltByShearing(m_DefaultFixTiltByShearing)
 , m_SimpleVolumeReading( simpleVolumeImport )
 , m_DecimalPlacesForOrientation( decimalPlacesForOrientation )
+, m_NumberOfThreads( 0 )
+, m_ProgressiveLoading( false )
+, m_HasProgressiveLoadingFocus( false )
 , m_ExternalCache(false)
 {
   this->EnsureMandatorySortersArePresent( decimalPlacesForOrientation, simpleVolumeImport );
@@ -42,9 +69,12 @@ mitk::DICOMITKSeriesGDCMReader::DICOMITKSeriesGDCMReader( const DICOMITKSeriesGD
 , m_Sorter( other.m_Sorter )
 , m_EquiDistantBlocksSorter( other.m_EquiDistantBlocksSorter->Clone() )
 , m_NormalDirectionConsistencySorter( other.m_NormalDirectionConsistencySorter->Clone() )
-, m_ReplacedCLocales( other.m_ReplacedCLocales )
-, m_ReplacedCinLocales( other.m_ReplacedCinLocales )
 , m_DecimalPlacesForOrientation( other.m_DecimalPlacesForOrientation )
+, m_NumberOfThreads( other.m_NumberOfThreads )
+, m_ProgressiveLoading( other.m_ProgressiveLoading )
+, m_ProgressiveLoadingCallback( other.m_ProgressiveLoadingCallback )
+, m_ProgressiveLoadingFocus( other.m_ProgressiveLoadingFocus )
+, m_HasProgressiveLoadingFocus( other.m_HasProgressiveLoadingFocus )
 , m_TagCache( other.m_TagCache )
 , m_ExternalCache(other.m_ExternalCache)
 {
@@ -65,9 +95,12 @@ mitk::DICOMITKSeriesGDCMReader& mitk::DICOMITKSeriesGDCMReader::
     this->m_Sorter                           = other.m_Sorter; // TODO should clone the list items
     this->m_EquiDistantBlocksSorter          = other.m_EquiDistantBlocksSorter->Clone();
     this->m_NormalDirectionConsistencySorter = other.m_NormalDirectionConsistencySorter->Clone();
-    this->m_ReplacedCLocales                 = other.m_ReplacedCLocales;
-    this->m_ReplacedCinLocales               = other.m_ReplacedCinLocales;
     this->m_DecimalPlacesForOrientation      = other.m_DecimalPlacesForOrientation;
+    this->m_NumberOfThreads                  = other.m_NumberOfThreads;
+    this->m_ProgressiveLoading               = other.m_ProgressiveLoading;
+    this->m_ProgressiveLoadingCallback       = other.m_ProgressiveLoadingCallback;
+    this->m_ProgressiveLoadingFocus          = other.m_ProgressiveLoadingFocus;
+    this->m_HasProgressiveLoadingFocus       = other.m_HasProgressiveLoadingFocus;
     this->m_TagCache                         = other.m_TagCache;
   }
   return *this;
@@ -151,45 +184,12 @@ std::string mitk::DICOMITKSeriesGDCMReader::GetActiveLocale()
 
 void mitk::DICOMITKSeriesGDCMReader::PushLocale() const
 {
-  s_LocaleMutex->Lock();
-
-  std::string currentCLocale = setlocale( LC_NUMERIC, nullptr );
-  m_ReplacedCLocales.push( currentCLocale );
-  setlocale( LC_NUMERIC, "C" );
-
-  std::locale currentCinLocale( std::cin.getloc() );
-  m_ReplacedCinLocales.push( currentCinLocale );
-  std::locale l( "C" );
-  std::cin.imbue( l );
-
-  s_LocaleMutex->Unlock();
+  PushDICOMLocale();
 }
 
 void mitk::DICOMITKSeriesGDCMReader::PopLocale() const
 {
-  s_LocaleMutex->Lock();
-
-  if ( !m_ReplacedCLocales.empty() )
-  {
-    setlocale( LC_NUMERIC, m_ReplacedCLocales.top().c_str() );
-    m_ReplacedCLocales.pop();
-  }
-  else
-  {
-    MITK_WARN << "Mismatched PopLocale on DICOMITKSeriesGDCMReader.";
-  }
-
-  if ( !m_ReplacedCinLocales.empty() )
-  {
-    std::cin.imbue( m_ReplacedCinLocales.top() );
-    m_ReplacedCinLocales.pop();
-  }
-  else
-  {
-    MITK_WARN << "Mismatched PopLocale on DICOMITKSeriesGDCMReader.";
-  }
-
-  s_LocaleMutex->Unlock();
+  PopDICOMLocale();
 }
 
 mitk::DICOMITKSeriesGDCMReader::SortingBlockList
@@ -251,8 +251,27 @@ void mitk::DICOMITKSeriesGDCMReader::AnalyzeInputFiles()
     // ensure that the tag cache contains our required tags AND files and has scanned!
   }
 
+  // enhanced multi-frame files describe all their frames themselves, each of them is a block of its own
+  // and does not take part in the sorting of single-frame files
+  DICOMDatasetAccessingImageFrameList singleFrameFiles;
+  DICOMDatasetAccessingImageFrameList enhancedMultiFrameFiles;
+  for ( const auto& frame : m_TagCache->GetFrameInfoList() )
+  {
+    if ( IsEnhancedMultiFrameFile( frame ) )
+    {
+      enhancedMultiFrameFiles.push_back( frame );
+    }
+    else
+    {
+      singleFrameFiles.push_back( frame );
+    }
+  }
+
   m_SortingResultInProgress.clear();
-  m_SortingResultInProgress.push_back(m_TagCache->GetFrameInfoList());
+  if ( !singleFrameFiles.empty() || enhancedMultiFrameFiles.empty() )
+  {
+    m_SortingResultInProgress.push_back( singleFrameFiles );
+  }
 
   // sort and split blocks as configured
 
@@ -288,7 +307,7 @@ void mitk::DICOMITKSeriesGDCMReader::AnalyzeInputFiles()
   timeStart( "Output" );
   unsigned int o = this->GetNumberOfOutputs();
   this->SetNumberOfOutputs(
-    o + m_SortingResultInProgress.size() ); // Condense3DBlocks may already have added outputs!
+    o + m_SortingResultInProgress.size() + enhancedMultiFrameFiles.size() ); // Condense3DBlocks may already have added outputs!
   for ( auto blockIter = m_SortingResultInProgress.cbegin(); blockIter != m_SortingResultInProgress.cend();
         ++o, ++blockIter )
   {
@@ -321,6 +340,21 @@ void mitk::DICOMITKSeriesGDCMReader::AnalyzeInputFiles()
 
     this->SetOutput( o, block );
   }
+
+  for ( auto fileIter = enhancedMultiFrameFiles.cbegin(); fileIter != enhancedMultiFrameFiles.cend(); ++o, ++fileIter )
+  {
+    // the frames are sorted from the functional groups when the image is loaded
+    DICOMImageBlockDescriptor block;
+    block.SetTagCache( this->GetTagCache() );
+    block.SetAdditionalTagsOfInterest( GetAdditionalTagsOfInterest() );
+    block.SetTagLookupTableToPropertyFunctor( GetTagLookupTableToPropertyFunctor() );
+    block.SetImageFrameList( ConvertToDICOMImageFrameList( DICOMDatasetAccessingImageFrameList( 1, *fileIter ) ) );
+    block.SetFlag( "enhancedMultiFrame", true );
+
+    block.SetReaderImplementationLevel( this->GetReaderImplementationLevel( block.GetSOPClassUID() ) );
+
+    this->SetOutput( o, block );
+  }
   timeStop( "Output" );
 
 #if defined( MBILOG_ENABLE_DEBUG ) || defined( ENABLE_TIMING )
@@ -390,6 +424,11 @@ mitk::ReaderImplementationLevel
     return SOPClassUnknown;
   }
 
+  if ( DICOMEnhancedMultiFrameInfo::IsEnhancedMultiFrameSOPClass( sopClassUID ) )
+  {
+    return SOPClassSupported;
+  }
+
   gdcm::UIDs uidKnowledge;
   uidKnowledge.SetFromUID( sopClassUID.c_str() );
 
@@ -420,17 +459,67 @@ mitk::ReaderImplementationLevel
 
 bool mitk::DICOMITKSeriesGDCMReader::LoadImages()
 {
-  bool success = true;
+  const unsigned int numberOfOutputs = this->GetNumberOfOutputs();
+  const unsigned int numberOfThreads = this->GetNumberOfThreads() > 0 ? this->GetNumberOfThreads() : std::thread::hardware_concurrency();
+  const unsigned int numberOfBlockThreads = std::max( 1u, std::min( numberOfThreads, numberOfOutputs ) );
+
+  // blocks are handed out one by one, every block is written by exactly one thread
+  std::atomic<unsigned int> nextOutput( 0 );
+  std::atomic<bool> success( true );
+  std::exception_ptr loadError;
+  std::mutex loadErrorMutex;
+
+  auto loadBlocks = [&]()
+  {
+    try
+    {
+      for ( unsigned int o = nextOutput++; o < numberOfOutputs; o = nextOutput++ )
+      {
+        if ( !this->LoadMitkImageForOutput( o ) )
+        {
+          success = false;
+        }
+      }
+    }
+    catch ( ... )
+    {
+      std::lock_guard<std::mutex> lock( loadErrorMutex );
+      if ( !loadError )
+      {
+        loadError = std::current_exception();
+      }
+      nextOutput = numberOfOutputs;
+    }
+  };
 
-  unsigned int numberOfOutputs = this->GetNumberOfOutputs();
-  for ( unsigned int o = 0; o < numberOfOutputs; ++o )
+  std::vector<std::thread> threads;
+  for ( unsigned int i = 1; i < numberOfBlockThreads; ++i )
   {
-    success &= this->LoadMitkImageForOutput( o );
+    threads.emplace_back( loadBlocks );
+  }
+  loadBlocks();
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  if ( loadError )
+  {
+    std::rethrow_exception( loadError );
   }
 
   return success;
 }
 
+unsigned int mitk::DICOMITKSeriesGDCMReader::GetNumberOfSliceLoadingThreads() const
+{
+  const unsigned int numberOfOutputs = this->GetNumberOfOutputs();
+  const unsigned int numberOfThreads = this->GetNumberOfThreads() > 0 ? this->GetNumberOfThreads() : std::thread::hardware_concurrency();
+  const unsigned int numberOfBlockThreads = std::max( 1u, std::min( numberOfThreads, numberOfOutputs ) );
+
+  return std::max( 1u, numberOfThreads / numberOfBlockThreads );
+}
+
 bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(
   DICOMImageBlockDescriptor& block ) const
 {
@@ -447,10 +536,61 @@ bool mitk::DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(
   }
 
   mitk::ITKDICOMSeriesReaderHelper helper;
+  helper.SetNumberOfThreads( this->GetNumberOfSliceLoadingThreads() );
   bool success( true );
   try
   {
-    mitk::Image::Pointer mitkImage = helper.Load( filenames, m_FixTiltByShearing && hasTilt, tiltInfo );
+    mitk::Image::Pointer mitkImage;
+    if ( block.GetFlag( "enhancedMultiFrame", false ) )
+    {
+      DICOMEnhancedMultiFrameInfo frameInfo;
+      if ( frameInfo.Read( filenames.front() ) && frameInfo.SortFrames() )
+      {
+        mitkImage = helper.LoadEnhancedMultiFrame( filenames.front(), frameInfo );
+      }
+
+      if ( mitkImage.IsNotNull() )
+      {
+        block.SetFlag( "3D+t", mitkImage->GetTimeSteps() > 1 );
+      }
+      else
+      {
+        MITK_WARN << "Unable to arrange the frames of " << filenames.front()
+                  << " by their functional groups, loading them in the order of the file.";
+      }
+    }
+    else if ( m_ProgressiveLoading && !( m_FixTiltByShearing && hasTilt ) )
+    {
+      bool isImageReported( false );
+      mitkImage = helper.LoadProgressively(
+        filenames,
+        m_HasProgressiveLoadingFocus ? &m_ProgressiveLoadingFocus : nullptr,
+        [this, &block, &isImageReported]( Image* image, const std::vector<bool>& loadedSlices )
+        {
+          if ( !isImageReported )
+          {
+            block.SetMitkImage( image ); // the block is usable before its pixel data is loaded
+            isImageReported = true;
+          }
+          if ( m_ProgressiveLoadingCallback )
+          {
+            m_ProgressiveLoadingCallback( block, image, loadedSlices );
+          }
+        } );
+
+      if ( mitkImage.IsNull() && isImageReported )
+      {
+        // the reported image might already be shown, so it is not replaced by another one
+        MITK_ERROR << "Progressive loading of " << filenames.front() << " failed, the image of the block is incomplete.";
+        PopLocale();
+        return false;
+      }
+    }
+
+    if ( mitkImage.IsNull() )
+    {
+      mitkImage = helper.Load( filenames, m_FixTiltByShearing && hasTilt, tiltInfo );
+    }
     block.SetMitkImage( mitkImage );
   }
   catch ( const std::exception& e )
@@ -608,6 +748,9 @@ mitk::DICOMTagPathList mitk::DICOMITKSeriesGDCMReader::GetTagsOfInterest() const
   tags = DICOMImageBlockDescriptor::GetTagsOfInterest();
   completeList.insert( completeList.end(), tags.cbegin(), tags.cend() );
 
+  // identify enhanced multi-frame files (sop class UID is already requested by DICOMImageBlockDescriptor)
+  completeList.push_back( DICOMTag( 0x0028, 0x0008 ) ); // number of frames
+
 
   const AdditionalTagsMapType tagList = GetAdditionalTagsOfInterest();
   for ( auto iter = tagList.cbegin();
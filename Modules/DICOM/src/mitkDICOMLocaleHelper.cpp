@@ -0,0 +1,72 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMLocaleHelper.h"
+
+#include <mitkLogMacros.h>
+
+#include <clocale>
+#include <iostream>
+#include <locale>
+#include <mutex>
+#include <string>
+
+namespace
+{
+  struct DICOMLocaleState
+  {
+    std::mutex Mutex;
+    unsigned int NumberOfUsers = 0;
+    std::string ReplacedCLocale;
+    std::locale ReplacedCinLocale;
+  };
+
+  DICOMLocaleState& GetDICOMLocaleState()
+  {
+    static DICOMLocaleState state;
+    return state;
+  }
+}
+
+void mitk::PushDICOMLocale()
+{
+  auto& state = GetDICOMLocaleState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+
+  if (state.NumberOfUsers++ == 0)
+  {
+    const char* currentCLocale = setlocale(LC_NUMERIC, nullptr);
+    state.ReplacedCLocale = currentCLocale != nullptr ? currentCLocale : "C";
+    setlocale(LC_NUMERIC, "C");
+
+    state.ReplacedCinLocale = std::cin.getloc();
+    std::cin.imbue(std::locale("C"));
+  }
+}
+
+void mitk::PopDICOMLocale()
+{
+  auto& state = GetDICOMLocaleState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+
+  if (state.NumberOfUsers == 0)
+  {
+    MITK_WARN << "Mismatched PopDICOMLocale.";
+    return;
+  }
+
+  if (--state.NumberOfUsers == 0)
+  {
+    setlocale(LC_NUMERIC, state.ReplacedCLocale.c_str());
+    std::cin.imbue(state.ReplacedCinLocale);
+  }
+}
@@ -0,0 +1,521 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagIndex.h"
+
+#include <mitkLogMacros.h>
+
+#include <itksys/SystemTools.hxx>
+
+#if defined(_WIN32)
+#include <itksys/Encoding.hxx>
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <sstream>
+
+namespace
+{
+  const char IndexFileMagic[8] = { 'M', 'I', 'T', 'K', 'D', 'T', 'I', '2' };
+
+  // limits for the sizes read from an index file, protect against corrupted files
+  const std::uint32_t MaximumCount = 1u << 24;
+  const std::uint32_t MaximumStringLength = 1u << 26;
+
+  std::string GetDefaultIndexDirectory()
+  {
+    std::string cacheDirectory;
+#if defined(_WIN32)
+    if (!itksys::SystemTools::GetEnv("LOCALAPPDATA", cacheDirectory) || cacheDirectory.empty())
+    {
+      return std::string();
+    }
+#elif defined(__APPLE__)
+    if (!itksys::SystemTools::GetEnv("HOME", cacheDirectory) || cacheDirectory.empty())
+    {
+      return std::string();
+    }
+    cacheDirectory += "/Library/Caches";
+#else
+    if (!itksys::SystemTools::GetEnv("XDG_CACHE_HOME", cacheDirectory) || cacheDirectory.empty())
+    {
+      if (!itksys::SystemTools::GetEnv("HOME", cacheDirectory) || cacheDirectory.empty())
+      {
+        return std::string();
+      }
+      cacheDirectory += "/.cache";
+    }
+#endif
+    return cacheDirectory + "/MITK/DICOMTagIndex";
+  }
+
+  /** 64 bit FNV-1a hash, unlike std::hash it is the same for all builds and platforms. */
+  std::uint64_t HashString(const std::string& value)
+  {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const char c : value)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  /** Returns a name for the temporary file of an index file that is unique for concurrent writers
+   * in this and in other processes. */
+  std::string GetTemporaryFilename(const std::string& indexFilename)
+  {
+    static std::atomic<unsigned int> counter(0);
+    static const std::uint64_t processToken = []() {
+      std::random_device device;
+      return (static_cast<std::uint64_t>(device()) << 32) ^ device();
+    }();
+
+    std::ostringstream filename;
+    filename << indexFilename << '.' << std::hex << processToken << '.' << counter++ << ".tmp";
+    return filename.str();
+  }
+
+  std::mutex& GetIndexDirectoryMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  std::string& GetIndexDirectoryInstance()
+  {
+    static std::string directory = GetDefaultIndexDirectory();
+    return directory;
+  }
+
+  template <typename T>
+  void Write(std::ostream& stream, T value)
+  {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void WriteString(std::ostream& stream, const std::string& value)
+  {
+    Write<std::uint32_t>(stream, static_cast<std::uint32_t>(value.size()));
+    stream.write(value.data(), value.size());
+  }
+
+  void WritePath(std::ostream& stream, const mitk::DICOMTagPath& path)
+  {
+    Write<std::uint32_t>(stream, static_cast<std::uint32_t>(path.Size()));
+    for (const auto& node : path.GetNodes())
+    {
+      Write<std::uint8_t>(stream, static_cast<std::uint8_t>(node.type));
+      Write<std::uint32_t>(stream, node.tag.GetGroup());
+      Write<std::uint32_t>(stream, node.tag.GetElement());
+      Write<std::int32_t>(stream, node.selection);
+    }
+  }
+
+  template <typename T>
+  bool Read(std::istream& stream, T& value)
+  {
+    return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+  }
+
+  bool ReadCount(std::istream& stream, std::uint32_t& count)
+  {
+    return Read(stream, count) && count <= MaximumCount;
+  }
+
+  bool ReadString(std::istream& stream, std::string& value)
+  {
+    std::uint32_t length = 0;
+    if (!Read(stream, length) || length > MaximumStringLength)
+    {
+      return false;
+    }
+    value.resize(length);
+    return length == 0 || static_cast<bool>(stream.read(&value[0], length));
+  }
+
+  bool ReadPath(std::istream& stream, mitk::DICOMTagPath& path)
+  {
+    std::uint32_t numberOfNodes = 0;
+    if (!ReadCount(stream, numberOfNodes))
+    {
+      return false;
+    }
+
+    path.Reset();
+    for (std::uint32_t i = 0; i < numberOfNodes; ++i)
+    {
+      std::uint8_t type = 0;
+      std::uint32_t group = 0;
+      std::uint32_t element = 0;
+      std::int32_t selection = 0;
+      if (!Read(stream, type) || !Read(stream, group) || !Read(stream, element) || !Read(stream, selection) ||
+          type > static_cast<std::uint8_t>(mitk::DICOMTagPath::NodeInfo::NodeType::AnyElement))
+      {
+        return false;
+      }
+
+      path.AddNode(mitk::DICOMTagPath::NodeInfo(mitk::DICOMTag(group, element),
+        static_cast<mitk::DICOMTagPath::NodeInfo::NodeType>(type), selection));
+    }
+    return true;
+  }
+}
+
+void mitk::DICOMPersistentTagIndex::SetIndexDirectory(const std::string& directory)
+{
+  std::lock_guard<std::mutex> lock(GetIndexDirectoryMutex());
+  GetIndexDirectoryInstance() = directory;
+}
+
+std::string mitk::DICOMPersistentTagIndex::GetIndexDirectory()
+{
+  std::lock_guard<std::mutex> lock(GetIndexDirectoryMutex());
+  return GetIndexDirectoryInstance();
+}
+
+mitk::DICOMPersistentTagIndex::DICOMPersistentTagIndex(const std::string& scannerName)
+  : m_ScannerName(scannerName)
+{
+}
+
+std::string mitk::DICOMPersistentTagIndex::GetIndexFilename(const std::string& directory) const
+{
+  std::ostringstream filename;
+  filename << m_IndexDirectory << "/" << m_ScannerName << "_" << std::hex << std::setw(16) << std::setfill('0')
+           << HashString(directory) << ".index";
+  return filename.str();
+}
+
+bool mitk::DICOMPersistentTagIndex::GetFileStatus(const std::string& filename, FileStatus& status)
+{
+#if defined(_WIN32)
+  WIN32_FILE_ATTRIBUTE_DATA data;
+  if (!GetFileAttributesExW(itksys::Encoding::ToWindowsExtendedPath(filename).c_str(), GetFileExInfoStandard, &data) ||
+      (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+  {
+    return false;
+  }
+
+  status.Size = (static_cast<std::uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+  status.ModificationTime = static_cast<std::int64_t>(
+    (static_cast<std::uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime);
+#else
+  struct stat fileStat;
+  if (stat(filename.c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+  {
+    return false;
+  }
+
+  status.Size = static_cast<std::uint64_t>(fileStat.st_size);
+#if defined(__APPLE__)
+  const auto& modificationTime = fileStat.st_mtimespec;
+#else
+  const auto& modificationTime = fileStat.st_mtim;
+#endif
+  status.ModificationTime = static_cast<std::int64_t>(modificationTime.tv_sec) * 1000000000 +
+                            static_cast<std::int64_t>(modificationTime.tv_nsec);
+#endif
+  return true;
+}
+
+void mitk::DICOMPersistentTagIndex::Load(const StringList& filenames, const std::set<DICOMTagPath>& scannedTags)
+{
+  m_IndexDirectory = GetIndexDirectory();
+  m_ScannedTags = scannedTags;
+  m_Directories.clear();
+  m_FileStatus.clear();
+
+  if (m_IndexDirectory.empty())
+  {
+    return;
+  }
+
+  for (const auto& filename : filenames)
+  {
+    FileStatus status;
+    if (!GetFileStatus(filename, status))
+    {
+      continue;
+    }
+    m_FileStatus[filename] = status;
+
+    const std::string directory = itksys::SystemTools::GetFilenamePath(filename);
+    if (m_Directories.find(directory) != m_Directories.end())
+    {
+      continue;
+    }
+
+    DirectoryIndex& index = m_Directories[directory];
+    if (!this->ReadIndexFile(directory, index))
+    {
+      index = DirectoryIndex();
+    }
+
+    // compare the tags of this scan once with all distinct sets of scanned tags of the index
+    index.CoversScannedTags.clear();
+    index.CurrentScannedTagsId = index.ScannedTags.size();
+    for (std::size_t id = 0; id < index.ScannedTags.size(); ++id)
+    {
+      const auto& indexedTags = index.ScannedTags[id];
+      index.CoversScannedTags.push_back(
+        std::includes(indexedTags.begin(), indexedTags.end(), m_ScannedTags.begin(), m_ScannedTags.end()));
+      if (indexedTags == m_ScannedTags)
+      {
+        index.CurrentScannedTagsId = id;
+      }
+    }
+
+    if (index.CurrentScannedTagsId == index.ScannedTags.size())
+    {
+      index.ScannedTags.push_back(m_ScannedTags);
+      index.CoversScannedTags.push_back(true);
+    }
+  }
+}
+
+const mitk::DICOMPersistentTagIndex::ValueList* mitk::DICOMPersistentTagIndex::Find(const std::string& filename) const
+{
+  const auto statusIter = m_FileStatus.find(filename);
+  if (statusIter == m_FileStatus.end())
+  {
+    return nullptr;
+  }
+
+  const auto directoryIter = m_Directories.find(itksys::SystemTools::GetFilenamePath(filename));
+  if (directoryIter == m_Directories.end())
+  {
+    return nullptr;
+  }
+
+  const DirectoryIndex& index = directoryIter->second;
+  const auto entryIter = index.Entries.find(filename);
+  if (entryIter == index.Entries.end())
+  {
+    return nullptr;
+  }
+
+  const Entry& entry = entryIter->second;
+  if (entry.Status.Size != statusIter->second.Size ||
+      entry.Status.ModificationTime != statusIter->second.ModificationTime ||
+      !index.CoversScannedTags[entry.ScannedTagsId])
+  {
+    return nullptr;
+  }
+
+  return &entry.Values;
+}
+
+void mitk::DICOMPersistentTagIndex::Update(const std::string& filename, const ValueList& values)
+{
+  const auto statusIter = m_FileStatus.find(filename);
+  if (statusIter == m_FileStatus.end())
+  {
+    return;
+  }
+
+  const auto directoryIter = m_Directories.find(itksys::SystemTools::GetFilenamePath(filename));
+  if (directoryIter == m_Directories.end())
+  {
+    return;
+  }
+
+  DirectoryIndex& index = directoryIter->second;
+  Entry& entry = index.Entries[filename];
+  entry.Status = statusIter->second;
+  entry.ScannedTagsId = index.CurrentScannedTagsId;
+  entry.Values = values;
+  index.Modified = true;
+}
+
+void mitk::DICOMPersistentTagIndex::Save()
+{
+  for (auto& directoryIter : m_Directories)
+  {
+    DirectoryIndex& index = directoryIter.second;
+    if (!index.Modified)
+    {
+      continue;
+    }
+
+    if (!itksys::SystemTools::MakeDirectory(m_IndexDirectory) ||
+        !this->WriteIndexFile(directoryIter.first, index))
+    {
+      MITK_WARN << "Cannot write DICOM tag index of directory " << directoryIter.first << " to " << m_IndexDirectory;
+      return;
+    }
+
+    index.Modified = false;
+  }
+}
+
+bool mitk::DICOMPersistentTagIndex::ReadIndexFile(const std::string& directory, DirectoryIndex& index) const
+{
+  std::ifstream stream(this->GetIndexFilename(directory), std::ios::binary);
+  if (!stream)
+  {
+    return false;
+  }
+
+  char magic[sizeof(IndexFileMagic)];
+  std::string indexedDirectory;
+  if (!stream.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), IndexFileMagic) ||
+      !ReadString(stream, indexedDirectory) || indexedDirectory != directory)
+  {
+    return false;
+  }
+
+  std::uint32_t numberOfTagSets = 0;
+  if (!ReadCount(stream, numberOfTagSets))
+  {
+    return false;
+  }
+
+  index.ScannedTags.resize(numberOfTagSets);
+  for (auto& scannedTags : index.ScannedTags)
+  {
+    std::uint32_t numberOfTags = 0;
+    if (!ReadCount(stream, numberOfTags))
+    {
+      return false;
+    }
+
+    for (std::uint32_t i = 0; i < numberOfTags; ++i)
+    {
+      DICOMTagPath path;
+      if (!ReadPath(stream, path))
+      {
+        return false;
+      }
+      scannedTags.insert(path);
+    }
+  }
+
+  std::uint32_t numberOfEntries = 0;
+  if (!ReadCount(stream, numberOfEntries))
+  {
+    return false;
+  }
+
+  for (std::uint32_t i = 0; i < numberOfEntries; ++i)
+  {
+    std::string filename;
+    Entry entry;
+    std::uint32_t scannedTagsId = 0;
+    std::uint32_t numberOfValues = 0;
+    if (!ReadString(stream, filename) || !Read(stream, entry.Status.Size) ||
+        !Read(stream, entry.Status.ModificationTime) || !Read(stream, scannedTagsId) ||
+        scannedTagsId >= numberOfTagSets || !ReadCount(stream, numberOfValues))
+    {
+      return false;
+    }
+
+    entry.ScannedTagsId = scannedTagsId;
+    entry.Values.resize(numberOfValues);
+    for (auto& value : entry.Values)
+    {
+      std::uint8_t isNull = 0;
+      if (!ReadPath(stream, value.path) || !Read(stream, isNull) || !ReadString(stream, value.value))
+      {
+        return false;
+      }
+      value.isNull = isNull != 0;
+    }
+
+    index.Entries.emplace(std::move(filename), std::move(entry));
+  }
+
+  return true;
+}
+
+bool mitk::DICOMPersistentTagIndex::WriteIndexFile(const std::string& directory, const DirectoryIndex& index) const
+{
+  const std::string indexFilename = this->GetIndexFilename(directory);
+
+  // only write the sets of scanned tags that are still used by an entry
+  std::vector<std::uint32_t> newIds(index.ScannedTags.size(), MaximumCount);
+  std::vector<const std::set<DICOMTagPath>*> usedTagSets;
+  for (const auto& entryIter : index.Entries)
+  {
+    auto& newId = newIds[entryIter.second.ScannedTagsId];
+    if (newId == MaximumCount)
+    {
+      newId = static_cast<std::uint32_t>(usedTagSets.size());
+      usedTagSets.push_back(&index.ScannedTags[entryIter.second.ScannedTagsId]);
+    }
+  }
+
+  // write to a temporary file first and rename it over the index file, so that concurrent readers see
+  // either the old or the new index, never a partial or missing one
+  const std::string temporaryFilename = GetTemporaryFilename(indexFilename);
+  {
+    std::ofstream stream(temporaryFilename, std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+      return false;
+    }
+
+    stream.write(IndexFileMagic, sizeof(IndexFileMagic));
+    WriteString(stream, directory);
+
+    Write<std::uint32_t>(stream, static_cast<std::uint32_t>(usedTagSets.size()));
+    for (const auto* scannedTags : usedTagSets)
+    {
+      Write<std::uint32_t>(stream, static_cast<std::uint32_t>(scannedTags->size()));
+      for (const auto& path : *scannedTags)
+      {
+        WritePath(stream, path);
+      }
+    }
+
+    Write<std::uint32_t>(stream, static_cast<std::uint32_t>(index.Entries.size()));
+    for (const auto& entryIter : index.Entries)
+    {
+      const Entry& entry = entryIter.second;
+      WriteString(stream, entryIter.first);
+      Write(stream, entry.Status.Size);
+      Write(stream, entry.Status.ModificationTime);
+      Write<std::uint32_t>(stream, newIds[entry.ScannedTagsId]);
+      Write<std::uint32_t>(stream, static_cast<std::uint32_t>(entry.Values.size()));
+      for (const auto& value : entry.Values)
+      {
+        WritePath(stream, value.path);
+        Write<std::uint8_t>(stream, value.isNull ? 1 : 0);
+        WriteString(stream, value.value);
+      }
+    }
+
+    stream.flush();
+    stream.close();
+    if (stream.fail())
+    {
+      itksys::SystemTools::RemoveFile(temporaryFilename);
+      return false;
+    }
+  }
+
+  // RenameFile replaces an existing target (rename() on POSIX, MoveFileEx with MOVEFILE_REPLACE_EXISTING on Windows)
+  if (!itksys::SystemTools::RenameFile(temporaryFilename, indexFilename))
+  {
+    itksys::SystemTools::RemoveFile(temporaryFilename);
+    return false;
+  }
+  return true;
+}
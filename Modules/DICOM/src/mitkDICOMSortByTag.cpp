@@ -175,3 +175,40 @@ mitk::DICOMSortByTag
   return toDouble - fromDouble;
   // TODO second-level compare?
 }
+
+unsigned int
+mitk::DICOMSortByTag
+::GetSortKeySize() const
+{
+  return 1;
+}
+
+void
+mitk::DICOMSortByTag
+::ExtractSortKey(const mitk::DICOMDatasetAccess* dataset, double* key) const
+{
+  assert(dataset);
+
+  // same conversion as in NumericCompare(), invalid findings have an empty value
+  key[0] = OFStandard::atof(dataset->GetTagValueAsString(m_Tag).value.c_str());
+}
+
+bool
+mitk::DICOMSortByTag
+::CompareSortKeys(const double* left, const double* right, bool& leftBeforeRight) const
+{
+  if (left[0] != right[0])
+  {
+    leftBeforeRight = left[0] < right[0];
+    return true;
+  }
+
+  return false;
+}
+
+double
+mitk::DICOMSortByTag
+::SortKeyDistance(const double* from, const double* to) const
+{
+  return to[0] - from[0];
+}
@@ -67,6 +67,50 @@ mitk::DICOMSortCriterion
   return allTags;
 }
 
+unsigned int
+mitk::DICOMSortCriterion
+::GetSortKeySize() const
+{
+  return 0;
+}
+
+void
+mitk::DICOMSortCriterion
+::ExtractSortKey(const mitk::DICOMDatasetAccess* /*dataset*/, double* /*key*/) const
+{
+}
+
+bool
+mitk::DICOMSortCriterion
+::CompareSortKeys(const double* /*left*/, const double* /*right*/, bool& /*leftBeforeRight*/) const
+{
+  return false;
+}
+
+double
+mitk::DICOMSortCriterion
+::SortKeyDistance(const double* /*from*/, const double* /*to*/) const
+{
+  return 0.0;
+}
+
+bool
+mitk::DICOMSortCriterion
+::HasSortKeys() const
+{
+  const DICOMSortCriterion* criterionToCheck = this;
+  while (criterionToCheck)
+  {
+    if (criterionToCheck->GetSortKeySize() == 0)
+    {
+      return false;
+    }
+    criterionToCheck = criterionToCheck->m_SecondaryCriterion.GetPointer();
+  }
+
+  return true;
+}
+
 bool
 mitk::DICOMSortCriterion
 ::NextLevelIsLeftBeforeRight(const mitk::DICOMDatasetAccess* left, const mitk::DICOMDatasetAccess* right) const
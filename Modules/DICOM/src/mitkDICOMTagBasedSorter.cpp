@@ -14,6 +14,8 @@ found in the LICENSE file.
 
 #include <algorithm>
 #include <iomanip>
+#include <memory>
+#include <numeric>
 
 mitk::DICOMTagBasedSorter::CutDecimalPlaces
 ::CutDecimalPlaces(unsigned int precision)
@@ -394,6 +396,12 @@ mitk::DICOMTagBasedSorter
     //    - sorting order (ascending, descending)
     //    - sort numerically
     //    - ... ?
+    //
+    // if all criteria provide sort keys, the tag values are parsed once per dataset
+    // instead of once per comparison (see SortKeyTable)
+    const bool useSortKeys = m_SortCriterion->HasSortKeys();
+    std::vector<std::unique_ptr<SortKeyTable>> sortKeyTables; // one per group, rows in sorted order
+
     unsigned int groupIndex(0);
     for (auto gIter = groups.begin();
          gIter != groups.end();
@@ -413,7 +421,15 @@ mitk::DICOMTagBasedSorter
 #endif // #ifdef MBILOG_ENABLE_DEBUG
 
 
-      std::sort( dsList.begin(), dsList.end(), ParameterizedDatasetSort( m_SortCriterion ) );
+      if (useSortKeys)
+      {
+        sortKeyTables.emplace_back(new SortKeyTable(m_SortCriterion, dsList));
+        sortKeyTables.back()->Sort(dsList);
+      }
+      else
+      {
+        std::sort( dsList.begin(), dsList.end(), ParameterizedDatasetSort( m_SortCriterion ) );
+      }
 
 #ifdef MBILOG_ENABLE_DEBUG
       MITK_DEBUG << "   --------------------------------------------------------------------------------";
@@ -435,9 +451,10 @@ mitk::DICOMTagBasedSorter
     {
       // Step 2: create new groups by enforcing consecutive order within each group
       unsigned int groupIndex(0);
+      std::size_t tableIndex(0);
       for (auto gIter = groups.begin();
            gIter != groups.end();
-           ++gIter)
+           ++tableIndex, ++gIter)
       {
         std::stringstream groupKey;
         groupKey << std::setfill('0') << std::setw(6) << groupIndex++;
@@ -456,7 +473,9 @@ mitk::DICOMTagBasedSorter
             // for the second and every following dataset:
             // let the sorting criterion calculate a "distance"
             // if the distance is not 1, split off a new group!
-            const double currentDistance = m_SortCriterion->NumericDistance(previousDS, *dataset);
+            const double currentDistance = useSortKeys
+                                         ? sortKeyTables[tableIndex]->NumericDistance(dsIndex - 1, dsIndex)
+                                         : m_SortCriterion->NumericDistance(previousDS, *dataset);
             if (constantDistanceInitialized)
             {
               if (fabs(currentDistance - constantDistance) < fabs(constantDistance * 0.01)) // ok, deviation of up to 1% of distance is tolerated
@@ -534,7 +553,14 @@ mitk::DICOMTagBasedSorter
       firstSlices.push_back(gIter->second.front());
     }
 
-    std::sort( firstSlices.begin(), firstSlices.end(), ParameterizedDatasetSort( m_SortCriterion ) );
+    if (useSortKeys)
+    {
+      SortKeyTable(m_SortCriterion, firstSlices).Sort(firstSlices);
+    }
+    else
+    {
+      std::sort( firstSlices.begin(), firstSlices.end(), ParameterizedDatasetSort( m_SortCriterion ) );
+    }
 
     GroupIDToListType sortedResultBlocks;
     unsigned int groupKeyValue(0);
@@ -594,3 +620,85 @@ mitk::DICOMTagBasedSorter::ParameterizedDatasetSort
 
   return m_SortCriterion->IsLeftBeforeRight(left, right);
 }
+
+mitk::DICOMTagBasedSorter::SortKeyTable
+::SortKeyTable(const DICOMSortCriterion* criterion, const DICOMDatasetList& datasets)
+:m_RowSize(0)
+,m_Datasets(datasets.cbegin(), datasets.cend())
+{
+  assert(criterion);
+  assert(criterion->HasSortKeys());
+
+  for (const DICOMSortCriterion* level = criterion; level != nullptr; level = level->GetSecondaryCriterion().GetPointer())
+  {
+    m_Criteria.push_back(level);
+    m_KeyOffsets.push_back(m_RowSize);
+    m_RowSize += level->GetSortKeySize();
+  }
+
+  m_Keys.resize(m_Datasets.size() * m_RowSize);
+  for (std::size_t row = 0; row < m_Datasets.size(); ++row)
+  {
+    assert(m_Datasets[row]);
+    double* key = m_Keys.data() + row * m_RowSize;
+    for (std::size_t level = 0; level < m_Criteria.size(); ++level)
+    {
+      m_Criteria[level]->ExtractSortKey(m_Datasets[row], key + m_KeyOffsets[level]);
+    }
+  }
+}
+
+bool
+mitk::DICOMTagBasedSorter::SortKeyTable
+::IsLeftBeforeRight(std::size_t left, std::size_t right) const
+{
+  const double* leftKey = m_Keys.data() + left * m_RowSize;
+  const double* rightKey = m_Keys.data() + right * m_RowSize;
+
+  bool leftBeforeRight(false);
+  for (std::size_t level = 0; level < m_Criteria.size(); ++level)
+  {
+    if (m_Criteria[level]->CompareSortKeys(leftKey + m_KeyOffsets[level], rightKey + m_KeyOffsets[level], leftBeforeRight))
+    {
+      return leftBeforeRight;
+    }
+  }
+
+  // same fallback as DICOMSortCriterion::NextLevelIsLeftBeforeRight()
+  return (void*)m_Datasets[left] < (void*)m_Datasets[right];
+}
+
+double
+mitk::DICOMTagBasedSorter::SortKeyTable
+::NumericDistance(std::size_t from, std::size_t to) const
+{
+  // like DICOMSortCriterion::NumericDistance(), only the primary criterion is asked
+  return m_Criteria.front()->SortKeyDistance(m_Keys.data() + from * m_RowSize, m_Keys.data() + to * m_RowSize);
+}
+
+void
+mitk::DICOMTagBasedSorter::SortKeyTable
+::Sort(DICOMDatasetList& datasets)
+{
+  assert(datasets.size() == m_Datasets.size());
+
+  std::vector<std::size_t> order(m_Datasets.size());
+  std::iota(order.begin(), order.end(), 0);
+
+  // std::sort decides only by the comparisons, so the resulting permutation
+  // is the one that sorting the datasets by ParameterizedDatasetSort creates
+  std::sort(order.begin(), order.end(),
+            [this](std::size_t left, std::size_t right) { return this->IsLeftBeforeRight(left, right); });
+
+  std::vector<double> sortedKeys(m_Keys.size());
+  DICOMDatasetList sortedDatasets(m_Datasets.size());
+  for (std::size_t row = 0; row < order.size(); ++row)
+  {
+    std::copy_n(m_Keys.cbegin() + order[row] * m_RowSize, m_RowSize, sortedKeys.begin() + row * m_RowSize);
+    sortedDatasets[row] = m_Datasets[order[row]];
+  }
+
+  m_Keys.swap(sortedKeys);
+  m_Datasets.swap(sortedDatasets);
+  datasets = m_Datasets;
+}
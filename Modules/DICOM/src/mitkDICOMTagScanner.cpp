@@ -11,10 +11,14 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkDICOMTagScanner.h"
+#include "mitkDICOMLocaleHelper.h"
 
-itk::MutexLock::Pointer mitk::DICOMTagScanner::s_LocaleMutex = itk::MutexLock::New();
+#include <algorithm>
+#include <clocale>
+#include <thread>
 
 mitk::DICOMTagScanner::DICOMTagScanner()
+  : m_NumberOfThreads(0), m_UsePersistentTagIndex(false)
 {
 }
 
@@ -25,48 +29,25 @@ mitk::DICOMTagScanner::~DICOMTagScanner()
 
 void mitk::DICOMTagScanner::PushLocale() const
 {
-  s_LocaleMutex->Lock();
-
-  std::string currentCLocale = setlocale(LC_NUMERIC, nullptr);
-  m_ReplacedCLocales.push(currentCLocale);
-  setlocale(LC_NUMERIC, "C");
-
-  std::locale currentCinLocale(std::cin.getloc());
-  m_ReplacedCinLocales.push(currentCinLocale);
-  std::locale l("C");
-  std::cin.imbue(l);
-
-  s_LocaleMutex->Unlock();
+  PushDICOMLocale();
 }
 
 void mitk::DICOMTagScanner::PopLocale() const
 {
-  s_LocaleMutex->Lock();
-
-  if (!m_ReplacedCLocales.empty())
-  {
-    setlocale(LC_NUMERIC, m_ReplacedCLocales.top().c_str());
-    m_ReplacedCLocales.pop();
-  }
-  else
-  {
-    MITK_WARN << "Mismatched PopLocale on DICOMITKSeriesGDCMReader.";
-  }
-
-  if (!m_ReplacedCinLocales.empty())
-  {
-    std::cin.imbue(m_ReplacedCinLocales.top());
-    m_ReplacedCinLocales.pop();
-  }
-  else
-  {
-    MITK_WARN << "Mismatched PopLocale on DICOMITKSeriesGDCMReader.";
-  }
-
-  s_LocaleMutex->Unlock();
+  PopDICOMLocale();
 }
 
 std::string mitk::DICOMTagScanner::GetActiveLocale()
 {
   return setlocale(LC_NUMERIC, nullptr);
 }
+
+unsigned int mitk::DICOMTagScanner::GetNumberOfScanThreads(std::size_t numberOfFiles) const
+{
+  // starting a thread costs about as much as parsing a few headers
+  const std::size_t minimumFilesPerThread = 8;
+
+  unsigned int numberOfThreads = m_NumberOfThreads > 0 ? m_NumberOfThreads : std::thread::hardware_concurrency();
+  numberOfThreads = static_cast<unsigned int>(std::min<std::size_t>(numberOfThreads, numberOfFiles / minimumFilesPerThread));
+  return std::max(1u, numberOfThreads);
+}
@@ -246,6 +246,7 @@ mitk::EquiDistantBlocksSorter
   OutputListType outputs;
 
   m_SliceGroupingResults.clear();
+  m_ParsedPositions.clear();
 
   while (!remainingInput.empty()) // repeat until all files are grouped somehow
   {
@@ -266,6 +267,8 @@ mitk::EquiDistantBlocksSorter
     remainingInput = regularBlock.GetUnsortedDatasets();
   }
 
+  m_ParsedPositions.clear();
+
   unsigned int numberOfOutputs = outputs.size();
   this->SetNumberOfOutputs(numberOfOutputs);
 
@@ -330,6 +333,33 @@ mitk::EquiDistantBlocksSorter
   return s ?  std::string(s) : std::string();
 }
 
+const mitk::EquiDistantBlocksSorter::ParsedPosition&
+mitk::EquiDistantBlocksSorter
+::GetParsedPosition(const DICOMDatasetAccess* dataset)
+{
+  auto finding = m_ParsedPositions.find(dataset);
+  if (finding != m_ParsedPositions.end())
+  {
+    return finding->second;
+  }
+
+  static const DICOMTag tagImagePositionPatient = DICOMTag(0x0020,0x0032); // Image Position (Patient)
+
+  ParsedPosition position;
+  position.Origin.Fill(0.0f);
+
+  // Read tag value into point3D. PLEASE replace this by appropriate GDCM code if you figure out how to do that
+  const std::string originString = dataset->GetTagValueAsString(tagImagePositionPatient).value;
+  position.HasPosition = !originString.empty();
+  if (position.HasPosition)
+  {
+    bool ignoredConversionError(-42); // hard to get here, no graceful way to react
+    position.Origin = DICOMStringToPoint3D( originString, ignoredConversionError );
+  }
+
+  return m_ParsedPositions.emplace(dataset, position).first->second;
+}
+
 mitk::EquiDistantBlocksSorter::SliceGroupingAnalysisResult
 mitk::EquiDistantBlocksSorter
 ::AnalyzeFileForITKImageSeriesReaderSpacingAssumption(
@@ -363,11 +393,9 @@ mitk::EquiDistantBlocksSorter
        ++dsIter, ++fileIndex)
   {
     bool fileFitsIntoPattern(false);
-    std::string thisOriginString;
-    // Read tag value into point3D. PLEASE replace this by appropriate GDCM code if you figure out how to do that
-    thisOriginString = (*dsIter)->GetTagValueAsString(tagImagePositionPatient).value;
+    const ParsedPosition& thisPosition = this->GetParsedPosition(*dsIter);
 
-    if (thisOriginString.empty())
+    if (!thisPosition.HasPosition)
     {
       // don't let such files be in a common group. Everything without position information will be loaded as a single slice:
       // with standard DICOM files this can happen to: CR, DX, SC
@@ -395,7 +423,7 @@ mitk::EquiDistantBlocksSorter
     }
 
     bool ignoredConversionError(-42); // hard to get here, no graceful way to react
-    thisOrigin = DICOMStringToPoint3D( thisOriginString, ignoredConversionError );
+    thisOrigin = thisPosition.Origin;
 
     MITK_DEBUG << "  " << fileIndex << " " << (*dsIter)->GetFilenameIfAvailable()
                        << " at "
@@ -41,6 +41,16 @@ const mitk::DICOMTag mitk::ITKDICOMSeriesReaderHelper::TriggerTimeTag = mitk::DI
   case IOType:                    \
     return LoadDICOMByITK<T>( filenames, correctTilt, tiltInfo, io );
 
+void mitk::ITKDICOMSeriesReaderHelper::SetNumberOfThreads( unsigned int numberOfThreads )
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::ITKDICOMSeriesReaderHelper::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
 bool mitk::ITKDICOMSeriesReaderHelper::CanHandleFile( const std::string& filename )
 {
   MITK_DEBUG << "ITKDICOMSeriesReaderHelper::CanHandleFile " << filename;
@@ -122,6 +132,175 @@ mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::Load( const StringContain
   return nullptr;
 }
 
+#define switchProgressiveCase( IOType, T ) \
+  case IOType:                             \
+    return LoadDICOMByITKProgressively<T>( filenames, focusPoint, progress, io );
+
+mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::LoadProgressively( const StringContainer& filenames,
+                                                                          const Point3D* focusPoint,
+                                                                          const ProgressCallback& progress )
+{
+  if ( filenames.empty() )
+  {
+    MITK_DEBUG
+      << "Calling LoadDicomSeries with empty filename string container. Probably invalid application logic.";
+    return nullptr; // this is not actually an error but the result is very simple
+  }
+
+  typedef itk::GDCMImageIO DcmIoType;
+  DcmIoType::Pointer io = DcmIoType::New();
+
+  try
+  {
+    if ( io->CanReadFile( filenames.front().c_str() ) )
+    {
+      io->SetFileName( filenames.front().c_str() );
+      io->ReadImageInformation();
+
+      if ( io->GetPixelType() == itk::ImageIOBase::SCALAR )
+      {
+        switch ( io->GetComponentType() )
+        {
+          switchProgressiveCase( DcmIoType::UCHAR, unsigned char )
+          switchProgressiveCase( DcmIoType::CHAR, char )
+          switchProgressiveCase( DcmIoType::USHORT, unsigned short )
+          switchProgressiveCase( DcmIoType::SHORT, short )
+          switchProgressiveCase( DcmIoType::UINT, unsigned int )
+          switchProgressiveCase( DcmIoType::INT, int )
+          switchProgressiveCase( DcmIoType::ULONG, long unsigned int )
+          switchProgressiveCase( DcmIoType::LONG, long int )
+          switchProgressiveCase( DcmIoType::FLOAT, float )
+          switchProgressiveCase( DcmIoType::DOUBLE, double )
+          default:
+            MITK_ERROR << "Found unsupported DICOM scalar pixel type: (enum value) " << io->GetComponentType();
+        }
+      }
+      else if ( io->GetPixelType() == itk::ImageIOBase::RGB )
+      {
+        switch ( io->GetComponentType() )
+        {
+          switchProgressiveCase( DcmIoType::UCHAR, itk::RGBPixel<unsigned char> )
+          switchProgressiveCase( DcmIoType::CHAR, itk::RGBPixel<char> )
+          switchProgressiveCase( DcmIoType::USHORT, itk::RGBPixel<unsigned short> )
+          switchProgressiveCase( DcmIoType::SHORT, itk::RGBPixel<short> )
+          switchProgressiveCase( DcmIoType::UINT, itk::RGBPixel<unsigned int> )
+          switchProgressiveCase( DcmIoType::INT, itk::RGBPixel<int> )
+          switchProgressiveCase( DcmIoType::ULONG, itk::RGBPixel<long unsigned int> )
+          switchProgressiveCase( DcmIoType::LONG, itk::RGBPixel<long int> )
+          switchProgressiveCase( DcmIoType::FLOAT, itk::RGBPixel<float> )
+          switchProgressiveCase( DcmIoType::DOUBLE, itk::RGBPixel<double> )
+          default:
+            MITK_ERROR << "Found unsupported DICOM scalar pixel type: (enum value) " << io->GetComponentType();
+        }
+      }
+
+      MITK_ERROR << "Unsupported DICOM pixel type";
+      return nullptr;
+    }
+  }
+  catch ( const itk::MemoryAllocationError& e )
+  {
+    MITK_ERROR << "Out of memory. Cannot load DICOM series: " << e.what();
+  }
+  catch ( const std::exception& e )
+  {
+    MITK_ERROR << "Error encountered when loading DICOM series:" << e.what();
+  }
+  catch ( ... )
+  {
+    MITK_ERROR << "Unspecified error encountered when loading DICOM series.";
+  }
+
+  return nullptr;
+}
+
+#define switchEnhancedMultiFrameCase( IOType, T ) \
+  case IOType:                                    \
+    return LoadDICOMByITKEnhancedMultiFrame<T>( filename, frameInfo, io );
+
+mitk::Image::Pointer mitk::ITKDICOMSeriesReaderHelper::LoadEnhancedMultiFrame( const std::string& filename,
+                                                                               const DICOMEnhancedMultiFrameInfo& frameInfo )
+{
+  if ( frameInfo.GetFrameOrder().empty() )
+  {
+    MITK_DEBUG << "Calling LoadEnhancedMultiFrame with unsorted frames. Probably invalid application logic.";
+    return nullptr;
+  }
+
+  // the image reader applies a single rescale slope and intercept to all frames
+  if ( !frameInfo.HasUniformRescale() )
+  {
+    MITK_DEBUG << "Frames of " << filename << " are rescaled differently.";
+    return nullptr;
+  }
+
+  typedef itk::GDCMImageIO DcmIoType;
+  DcmIoType::Pointer io = DcmIoType::New();
+
+  try
+  {
+    if ( io->CanReadFile( filename.c_str() ) )
+    {
+      io->SetFileName( filename.c_str() );
+      io->ReadImageInformation();
+
+      if ( io->GetPixelType() == itk::ImageIOBase::SCALAR )
+      {
+        switch ( io->GetComponentType() )
+        {
+          switchEnhancedMultiFrameCase( DcmIoType::UCHAR, unsigned char )
+          switchEnhancedMultiFrameCase( DcmIoType::CHAR, char )
+          switchEnhancedMultiFrameCase( DcmIoType::USHORT, unsigned short )
+          switchEnhancedMultiFrameCase( DcmIoType::SHORT, short )
+          switchEnhancedMultiFrameCase( DcmIoType::UINT, unsigned int )
+          switchEnhancedMultiFrameCase( DcmIoType::INT, int )
+          switchEnhancedMultiFrameCase( DcmIoType::ULONG, long unsigned int )
+          switchEnhancedMultiFrameCase( DcmIoType::LONG, long int )
+          switchEnhancedMultiFrameCase( DcmIoType::FLOAT, float )
+          switchEnhancedMultiFrameCase( DcmIoType::DOUBLE, double )
+          default:
+            MITK_ERROR << "Found unsupported DICOM scalar pixel type: (enum value) " << io->GetComponentType();
+        }
+      }
+      else if ( io->GetPixelType() == itk::ImageIOBase::RGB )
+      {
+        switch ( io->GetComponentType() )
+        {
+          switchEnhancedMultiFrameCase( DcmIoType::UCHAR, itk::RGBPixel<unsigned char> )
+          switchEnhancedMultiFrameCase( DcmIoType::CHAR, itk::RGBPixel<char> )
+          switchEnhancedMultiFrameCase( DcmIoType::USHORT, itk::RGBPixel<unsigned short> )
+          switchEnhancedMultiFrameCase( DcmIoType::SHORT, itk::RGBPixel<short> )
+          switchEnhancedMultiFrameCase( DcmIoType::UINT, itk::RGBPixel<unsigned int> )
+          switchEnhancedMultiFrameCase( DcmIoType::INT, itk::RGBPixel<int> )
+          switchEnhancedMultiFrameCase( DcmIoType::ULONG, itk::RGBPixel<long unsigned int> )
+          switchEnhancedMultiFrameCase( DcmIoType::LONG, itk::RGBPixel<long int> )
+          switchEnhancedMultiFrameCase( DcmIoType::FLOAT, itk::RGBPixel<float> )
+          switchEnhancedMultiFrameCase( DcmIoType::DOUBLE, itk::RGBPixel<double> )
+          default:
+            MITK_ERROR << "Found unsupported DICOM scalar pixel type: (enum value) " << io->GetComponentType();
+        }
+      }
+
+      MITK_ERROR << "Unsupported DICOM pixel type";
+      return nullptr;
+    }
+  }
+  catch ( const itk::MemoryAllocationError& e )
+  {
+    MITK_ERROR << "Out of memory. Cannot load DICOM series: " << e.what();
+  }
+  catch ( const std::exception& e )
+  {
+    MITK_ERROR << "Error encountered when loading DICOM series:" << e.what();
+  }
+  catch ( ... )
+  {
+    MITK_ERROR << "Unspecified error encountered when loading DICOM series.";
+  }
+
+  return nullptr;
+}
+
 #define switch3DnTCase( IOType, T ) \
   case IOType:                      \
     return LoadDICOMByITK3DnT<T>( filenamesLists, correctTilt, tiltInfo, io );
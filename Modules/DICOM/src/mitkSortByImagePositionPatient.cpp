@@ -82,33 +82,85 @@ mitk::SortByImagePositionPatient
   }
 }
 
+unsigned int
+mitk::SortByImagePositionPatient
+::GetSortKeySize() const
+{
+  return 9;
+}
+
+void
+mitk::SortByImagePositionPatient
+::ExtractSortKey(const mitk::DICOMDatasetAccess* dataset, double* key) const
+{
+  static const DICOMTag tagImagePositionPatient = DICOMTag(0x0020,0x0032); // Image Position (Patient)
+  static const DICOMTag    tagImageOrientation = DICOMTag(0x0020, 0x0037); // Image Orientation
+
+  Vector3D right; right.Fill(0.0);
+  Vector3D up; up.Fill(0.0);
+  bool hasOrientation(false);
+  DICOMStringToOrientationVectors( dataset->GetTagValueAsString( tagImageOrientation ).value,
+                                   right, up, hasOrientation );
+
+  Point3D origin; origin.Fill(0.0f);
+  bool hasOrigin(false);
+  origin = DICOMStringToPoint3D(dataset->GetTagValueAsString(tagImagePositionPatient).value, hasOrigin);
+
+  // key layout: right (0-2), up (3-5), origin (6-8)
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    key[dim] = right[dim];
+    key[3 + dim] = up[dim];
+    key[6 + dim] = origin[dim];
+  }
+}
+
+bool
+mitk::SortByImagePositionPatient
+::CompareSortKeys(const double* left, const double* right, bool& leftBeforeRight) const
+{
+  bool possible(false);
+  double distance = InternalNumericDistance(left, right, possible); // returns 0.0 if not possible
+  if (possible)
+  {
+    leftBeforeRight = distance > 0.0;
+  }
+  return possible;
+}
+
+double
+mitk::SortByImagePositionPatient
+::SortKeyDistance(const double* from, const double* to) const
+{
+  bool possible(false);
+  double retVal = InternalNumericDistance(from, to, possible); // returns 0.0 if not possible
+  return possible ? retVal : 0.0;
+}
+
 double
 mitk::SortByImagePositionPatient
 ::InternalNumericDistance(const mitk::DICOMDatasetAccess* left, const mitk::DICOMDatasetAccess* right, bool& possible) const
+{
+  double leftKey[9];
+  double rightKey[9];
+  this->ExtractSortKey(left, leftKey);
+  this->ExtractSortKey(right, rightKey);
+
+  return this->InternalNumericDistance(leftKey, rightKey, possible);
+}
+
+double
+mitk::SortByImagePositionPatient
+::InternalNumericDistance(const double* left, const double* right, bool& possible) const
 {
   // sort by distance to world origin, assuming (almost) equal orientation
-  static const DICOMTag tagImagePositionPatient = DICOMTag(0x0020,0x0032); // Image Position (Patient)
-  static const DICOMTag    tagImageOrientation = DICOMTag(0x0020, 0x0037); // Image Orientation
+  const double* leftRight = left;
+  const double* leftUp = left + 3;
+  const double* leftOrigin = left + 6;
 
-  Vector3D leftRight; leftRight.Fill(0.0);
-  Vector3D leftUp; leftUp.Fill(0.0);
-  bool leftHasOrientation(false);
-  DICOMStringToOrientationVectors( left->GetTagValueAsString( tagImageOrientation ).value,
-                                   leftRight, leftUp, leftHasOrientation );
-
-  Vector3D rightRight; rightRight.Fill(0.0);
-  Vector3D rightUp; rightUp.Fill(0.0);
-  bool rightHasOrientation(false);
-  DICOMStringToOrientationVectors(right->GetTagValueAsString(tagImageOrientation).value,
-                                   rightRight, rightUp, rightHasOrientation );
-
-  Point3D leftOrigin; leftOrigin.Fill(0.0f);
-  bool leftHasOrigin(false);
-  leftOrigin = DICOMStringToPoint3D(left->GetTagValueAsString(tagImagePositionPatient).value, leftHasOrigin);
-
-  Point3D rightOrigin; rightOrigin.Fill(0.0f);
-  bool rightHasOrigin(false);
-  rightOrigin = DICOMStringToPoint3D(right->GetTagValueAsString(tagImagePositionPatient).value, rightHasOrigin);
+  const double* rightRight = right;
+  const double* rightUp = right + 3;
+  const double* rightOrigin = right + 6;
 
   //   we tolerate very small differences in image orientation, since we got to know about
   //   acquisitions where these values change across a single series (7th decimal digit)
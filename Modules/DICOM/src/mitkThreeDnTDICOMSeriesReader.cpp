@@ -195,30 +195,6 @@ mitk::ThreeDnTDICOMSeriesReader
   return non3DnTBlocks;
 }
 
-bool
-mitk::ThreeDnTDICOMSeriesReader
-::LoadImages()
-{
-  bool success = true;
-
-  unsigned int numberOfOutputs = this->GetNumberOfOutputs();
-  for (unsigned int o = 0; o < numberOfOutputs; ++o)
-  {
-    const DICOMImageBlockDescriptor& block = this->InternalGetOutput(o);
-
-    if (block.GetFlag("3D+t", false))
-    {
-      success &= this->LoadMitkImageForOutput(o);
-    }
-    else
-    {
-      success &= DICOMITKSeriesGDCMReader::LoadMitkImageForOutput(o); // let superclass handle non-3D+t
-    }
-  }
-
-  return success;
-}
-
 bool
 mitk::ThreeDnTDICOMSeriesReader
 ::LoadMitkImageForImageBlockDescriptor(DICOMImageBlockDescriptor& block) const
@@ -232,6 +208,7 @@ mitk::ThreeDnTDICOMSeriesReader
 
   if (numberOfTimesteps == 1)
   {
+    PopLocale();
     return DICOMITKSeriesGDCMReader::LoadMitkImageForImageBlockDescriptor(block);
   }
 
@@ -254,6 +231,7 @@ mitk::ThreeDnTDICOMSeriesReader
   }
 
   mitk::ITKDICOMSeriesReaderHelper helper;
+  helper.SetNumberOfThreads(this->GetNumberOfSliceLoadingThreads());
   mitk::Image::Pointer mitkImage = helper.Load3DnT( filenamesPerTimestep, m_FixTiltByShearing && hasTilt, tiltInfo );
 
   block.SetMitkImage( mitkImage );
@@ -1,9 +1,13 @@
 set(MODULE_TESTS
   mitkDICOMReaderConfiguratorTest.cpp
   mitkDICOMDCMTKTagScannerTest.cpp
+  mitkDICOMGDCMTagScannerTest.cpp
+  mitkDICOMPersistentTagIndexTest.cpp
   mitkDICOMSimpleVolumeImportTest.cpp
   mitkDICOMTagPathTest.cpp
   mitkDICOMPropertyTest.cpp
+  mitkDICOMTagBasedSorterTest.cpp
+  mitkDICOMEnhancedMultiFrameInfoTest.cpp
 )
 
 set(MODULE_CUSTOM_TESTS
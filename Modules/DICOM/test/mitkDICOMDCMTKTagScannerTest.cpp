@@ -24,6 +24,7 @@ class mitkDICOMDCMTKTagScannerTestSuite : public mitk::TestFixture
 
   MITK_TEST(DeepScanning);
   MITK_TEST(MultiFileScanning);
+  MITK_TEST(ParallelScanning);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -119,6 +120,46 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Testing value of instance uid finding of frame 3", findings.front().value == "1.2.276.0.99.1.4.8323329.3795.1303917947.940055");
   }
 
+  void ParallelScanning()
+  {
+    mitk::DICOMTagPath instanceUID(0x0008, 0x0018);
+    mitk::DICOMTagPath patientName(0x0010, 0x0010);
+
+    // enough files to be distributed to several threads
+    mitk::StringList files;
+    for (int i = 0; i < 10; ++i)
+    {
+      files.insert(files.end(), ctFiles.begin(), ctFiles.end());
+    }
+
+    scanner->SetInputFiles(files);
+    scanner->AddTagPath(instanceUID);
+    scanner->AddTagPath(patientName);
+    scanner->SetNumberOfThreads(1);
+    scanner->Scan();
+    mitk::DICOMDatasetAccessingImageFrameList expectedFrames = scanner->GetFrameInfoList();
+
+    scanner->SetNumberOfThreads(4);
+    scanner->Scan();
+    mitk::DICOMDatasetAccessingImageFrameList frames = scanner->GetFrameInfoList();
+
+    CPPUNIT_ASSERT_MESSAGE("Testing number of frames of parallel scan", frames.size() == files.size());
+    CPPUNIT_ASSERT_MESSAGE("Testing number of frames of serial scan", expectedFrames.size() == files.size());
+
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Testing order of parallel scan", frames[i]->GetFilenameIfAvailable() == files[i]);
+
+      for (const auto& path : { instanceUID, patientName })
+      {
+        auto findings = frames[i]->GetTagValueAsString(path);
+        auto expectedFindings = expectedFrames[i]->GetTagValueAsString(path);
+        CPPUNIT_ASSERT_MESSAGE("Testing findings of parallel scan", findings.size() == 1 && expectedFindings.size() == 1);
+        CPPUNIT_ASSERT_MESSAGE("Testing value of parallel scan", findings.front().value == expectedFindings.front().value);
+      }
+    }
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkDICOMDCMTKTagScanner)
@@ -0,0 +1,125 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMEnhancedMultiFrameInfo.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <string>
+#include <vector>
+
+class mitkDICOMEnhancedMultiFrameInfoTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMEnhancedMultiFrameInfoTestSuite);
+
+  MITK_TEST(IsEnhancedMultiFrameSOPClass);
+  MITK_TEST(SortFramesBySliceAndTimeStep);
+  MITK_TEST(SortFramesRejectsGaps);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  static const unsigned int NumberOfSlices = 3;
+  static const unsigned int NumberOfTimeSteps = 2;
+
+  mitk::DICOMEnhancedMultiFrameInfo m_FrameInfo;
+
+  static mitk::Point3D CreatePosition(double z)
+  {
+    mitk::Point3D position;
+    position[0] = -20.0;
+    position[1] = 5.0;
+    position[2] = z;
+    return position;
+  }
+
+public:
+
+  void setUp() override
+  {
+    m_FrameInfo = mitk::DICOMEnhancedMultiFrameInfo();
+
+    mitk::Vector3D right;
+    right[0] = 1.0;
+    right[1] = 0.0;
+    right[2] = 0.0;
+    mitk::Vector3D up;
+    up[0] = 0.0;
+    up[1] = 1.0;
+    up[2] = 0.0;
+    m_FrameInfo.SetImageOrientation(right, up);
+    m_FrameInfo.SetPixelSpacing(0.5, 0.7);
+  }
+
+  void tearDown() override
+  {
+  }
+
+  void IsEnhancedMultiFrameSOPClass()
+  {
+    CPPUNIT_ASSERT(mitk::DICOMEnhancedMultiFrameInfo::IsEnhancedMultiFrameSOPClass("1.2.840.10008.5.1.4.1.1.2.1"));
+    CPPUNIT_ASSERT(mitk::DICOMEnhancedMultiFrameInfo::IsEnhancedMultiFrameSOPClass("1.2.840.10008.5.1.4.1.1.4.1"));
+    CPPUNIT_ASSERT_MESSAGE("UIDs are padded to an even length",
+                           mitk::DICOMEnhancedMultiFrameInfo::IsEnhancedMultiFrameSOPClass(
+                             std::string("1.2.840.10008.5.1.4.1.1.4.4") + '\0'));
+
+    CPPUNIT_ASSERT_MESSAGE("CT Image Storage",
+                           !mitk::DICOMEnhancedMultiFrameInfo::IsEnhancedMultiFrameSOPClass("1.2.840.10008.5.1.4.1.1.2"));
+    CPPUNIT_ASSERT(!mitk::DICOMEnhancedMultiFrameInfo::IsEnhancedMultiFrameSOPClass(""));
+  }
+
+  void SortFramesBySliceAndTimeStep()
+  {
+    // frames of the file: (time step, slice), slices are stored in descending order along the normal
+    const unsigned int frames[NumberOfSlices * NumberOfTimeSteps][2] = {{1, 2}, {0, 2}, {0, 1}, {1, 0}, {0, 0}, {1, 1}};
+
+    for (const auto &frame : frames)
+    {
+      // the dimension index values are (temporal position, stack position), both one-based
+      const std::vector<unsigned int> dimensionIndexValues = {frame[0] + 1, NumberOfSlices - frame[1]};
+      m_FrameInfo.AddFrame(CreatePosition(10.0 + 2.5 * frame[1]), dimensionIndexValues);
+    }
+
+    CPPUNIT_ASSERT(m_FrameInfo.SortFrames());
+    CPPUNIT_ASSERT_EQUAL(NumberOfSlices, m_FrameInfo.GetNumberOfSlices());
+    CPPUNIT_ASSERT_EQUAL(NumberOfTimeSteps, m_FrameInfo.GetNumberOfTimeSteps());
+
+    const std::vector<unsigned int> expectedOrder = {4, 2, 1, 3, 5, 0};
+    CPPUNIT_ASSERT_MESSAGE("Frames are ordered by time step, then by slice", expectedOrder == m_FrameInfo.GetFrameOrder());
+
+    const mitk::Vector3D spacing = m_FrameInfo.GetSpacing();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, spacing[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.7, spacing[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, spacing[2], mitk::eps);
+
+    CPPUNIT_ASSERT_MESSAGE("Origin is the position of the lowest slice",
+                           mitk::Equal(CreatePosition(10.0), m_FrameInfo.GetOrigin(), mitk::eps, true));
+    CPPUNIT_ASSERT(m_FrameInfo.HasUniformRescale());
+  }
+
+  void SortFramesRejectsGaps()
+  {
+    const double positions[] = {10.0, 12.5, 20.0};
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      m_FrameInfo.AddFrame(CreatePosition(positions[i]), {1, i + 1}, 1.0, -1024.0 * i);
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Slices are not equidistant", !m_FrameInfo.SortFrames());
+    CPPUNIT_ASSERT(m_FrameInfo.GetFrameOrder().empty());
+    CPPUNIT_ASSERT(!m_FrameInfo.HasUniformRescale());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMEnhancedMultiFrameInfo)
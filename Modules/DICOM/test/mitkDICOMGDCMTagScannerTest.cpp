@@ -0,0 +1,109 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMFileReaderTestHelper.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+class mitkDICOMGDCMTagScannerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMGDCMTagScannerTestSuite);
+
+  MITK_TEST(MultiFileScanning);
+  MITK_TEST(ParallelScanning);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::DICOMGDCMTagScanner::Pointer scanner;
+
+  mitk::StringList ctFiles;
+  mitk::StringList instanceUIDs;
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.clear();
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+
+    instanceUIDs.clear();
+    instanceUIDs.push_back("1.2.276.0.99.1.4.8323329.3795.1303917947.940051");
+    instanceUIDs.push_back("1.2.276.0.99.1.4.8323329.3795.1303917947.940052");
+    instanceUIDs.push_back("1.2.276.0.99.1.4.8323329.3795.1303917947.940053");
+    instanceUIDs.push_back("1.2.276.0.99.1.4.8323329.3795.1303917947.940055");
+
+    scanner = mitk::DICOMGDCMTagScanner::New();
+  }
+
+  void tearDown() override
+  {
+  }
+
+  void MultiFileScanning()
+  {
+    mitk::DICOMTag instanceUID(0x0008, 0x0018);
+
+    scanner->SetInputFiles(ctFiles);
+    scanner->AddTag(instanceUID);
+    scanner->Scan();
+
+    mitk::DICOMDatasetAccessingImageFrameList frames = scanner->GetFrameInfoList();
+    CPPUNIT_ASSERT_MESSAGE("Testing DICOMGDCMTagScanner::GetFrameInfoList()", frames.size() == 4);
+
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+      mitk::DICOMDatasetFinding finding = frames[i]->GetTagValueAsString(instanceUID);
+      CPPUNIT_ASSERT_MESSAGE("Testing validity of instance uid finding", finding.isValid);
+      CPPUNIT_ASSERT_MESSAGE("Testing value of instance uid finding", finding.value == instanceUIDs[i]);
+    }
+  }
+
+  void ParallelScanning()
+  {
+    mitk::DICOMTag instanceUID(0x0008, 0x0018);
+
+    // enough files to be distributed to several scanners
+    mitk::StringList files;
+    for (int i = 0; i < 10; ++i)
+    {
+      files.insert(files.end(), ctFiles.begin(), ctFiles.end());
+    }
+
+    scanner->SetInputFiles(files);
+    scanner->AddTag(instanceUID);
+    scanner->SetNumberOfThreads(4);
+    scanner->Scan();
+
+    mitk::DICOMDatasetAccessingImageFrameList frames = scanner->GetFrameInfoList();
+    CPPUNIT_ASSERT_MESSAGE("Testing number of frames of parallel scan", frames.size() == files.size());
+
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Testing order of parallel scan", frames[i]->GetFilenameIfAvailable() == files[i]);
+
+      mitk::DICOMDatasetFinding finding = frames[i]->GetTagValueAsString(instanceUID);
+      CPPUNIT_ASSERT_MESSAGE("Testing validity of instance uid finding", finding.isValid);
+      CPPUNIT_ASSERT_MESSAGE("Testing value of instance uid finding", finding.value == instanceUIDs[i % 4]);
+      CPPUNIT_ASSERT_MESSAGE("Testing tag cache access", scanner->GetScanCache()->GetTagValue(frames[i], instanceUID).value == instanceUIDs[i % 4]);
+    }
+  }
+
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMGDCMTagScanner)
@@ -15,10 +15,16 @@ found in the LICENSE file.
 #include "mitkDICOMFilenameSorter.h"
 #include "mitkDICOMTagBasedSorter.h"
 #include "mitkDICOMSortByTag.h"
+#include "mitkImage.h"
 
 #include "mitkTestingMacros.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 #include "mitkStringProperty.h"
 
 using mitk::DICOMTag;
@@ -117,5 +123,80 @@ int mitkDICOMITKSeriesGDCMReaderBasicsTest(int argc, char* argv[])
   mitk::DICOMFileReaderTestHelper::TestMitkImagesAreLoaded( gdcmReader, additionalTags, expectedPropertyTypes );
 
 
+  //////////////////////////////////////////////////////////////////////////
+  //
+  // Concurrent loading of blocks and slices must not change the images
+  //
+  //////////////////////////////////////////////////////////////////////////
+
+  std::vector<mitk::Image::Pointer> concurrentlyLoadedImages;
+  for ( unsigned int o = 0; o < gdcmReader->GetNumberOfOutputs(); ++o )
+  {
+    concurrentlyLoadedImages.push_back( gdcmReader->GetOutput( o ).GetMitkImage() );
+  }
+
+  gdcmReader->SetNumberOfThreads( 1 );
+  MITK_TEST_CONDITION_REQUIRED( gdcmReader->LoadImages(), "Images can be loaded by a single thread." );
+
+  for ( unsigned int o = 0; o < gdcmReader->GetNumberOfOutputs(); ++o )
+  {
+    const mitk::Image::Pointer singleThreadImage = gdcmReader->GetOutput( o ).GetMitkImage();
+    MITK_TEST_CONDITION_REQUIRED( concurrentlyLoadedImages[o].IsNotNull() && singleThreadImage.IsNotNull(), "Output " << o << " is loaded." );
+    MITK_TEST_CONDITION( mitk::Equal( *concurrentlyLoadedImages[o], *singleThreadImage, mitk::eps, true ),
+                         "Concurrently loaded output " << o << " equals the single thread result." );
+  }
+
+
+  //////////////////////////////////////////////////////////////////////////
+  //
+  // Progressive loading must deliver the image early and end with the same images
+  //
+  //////////////////////////////////////////////////////////////////////////
+
+  std::atomic<unsigned int> numberOfCreatedImages( 0 );
+  std::atomic<unsigned int> numberOfLoadedSlices( 0 );
+  std::map<mitk::Image*, void*> reportedVolumeData;
+  std::mutex reportedVolumeDataMutex;
+  gdcmReader->SetNumberOfThreads( 0 );
+  gdcmReader->SetProgressiveLoading( true );
+  gdcmReader->SetProgressiveLoadingCallback( [&]( const mitk::DICOMImageBlockDescriptor& block, mitk::Image* image, const std::vector<bool>& loadedSlices )
+  {
+    const auto count = std::count( loadedSlices.cbegin(), loadedSlices.cend(), true );
+    if ( count == 0 )
+    {
+      // the image and its final volume are created before any slice is read
+      if ( block.GetMitkImage().GetPointer() == image && image->IsVolumeSet() &&
+           loadedSlices.size() == image->GetDimension( 2 ) )
+      {
+        ++numberOfCreatedImages;
+        std::lock_guard<std::mutex> lock( reportedVolumeDataMutex );
+        reportedVolumeData[image] = image->GetVolumeData( 0 )->GetData();
+      }
+    }
+    else
+    {
+      ++numberOfLoadedSlices;
+    }
+  } );
+
+  MITK_TEST_CONDITION_REQUIRED( gdcmReader->LoadImages(), "Images can be loaded progressively." );
+
+  unsigned int numberOfSlices = 0;
+  for ( unsigned int o = 0; o < gdcmReader->GetNumberOfOutputs(); ++o )
+  {
+    const mitk::Image::Pointer progressiveImage = gdcmReader->GetOutput( o ).GetMitkImage();
+    MITK_TEST_CONDITION_REQUIRED( progressiveImage.IsNotNull(), "Output " << o << " is loaded progressively." );
+    MITK_TEST_CONDITION( progressiveImage->IsVolumeSet(), "All slices of output " << o << " are set." );
+    MITK_TEST_CONDITION( reportedVolumeData[progressiveImage.GetPointer()] == progressiveImage->GetVolumeData( 0 )->GetData(),
+                         "Output " << o << " keeps the volume buffer it was reported with." );
+    MITK_TEST_CONDITION( mitk::Equal( *concurrentlyLoadedImages[o], *progressiveImage, mitk::eps, true ),
+                         "Progressively loaded output " << o << " equals the regular result." );
+    numberOfSlices += progressiveImage->GetDimension( 2 );
+  }
+
+  MITK_TEST_CONDITION( numberOfCreatedImages == gdcmReader->GetNumberOfOutputs(), "Every block reports its image before the slices." );
+  MITK_TEST_CONDITION( numberOfLoadedSlices == numberOfSlices, "Every slice is reported once." );
+
+
   MITK_TEST_END();
 }
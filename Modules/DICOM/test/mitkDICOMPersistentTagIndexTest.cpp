@@ -0,0 +1,168 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMDCMTKTagScanner.h"
+#include "mitkDICOMGDCMTagCache.h"
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMPersistentTagIndex.h"
+#include "mitkDICOMFileReaderTestHelper.h"
+
+#include "mitkIOUtil.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itksys/SystemTools.hxx>
+
+class mitkDICOMPersistentTagIndexTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMPersistentTagIndexTestSuite);
+
+  MITK_TEST(IndexIsDisabledByDefault);
+  MITK_TEST(ScanUpdatesIndex);
+  MITK_TEST(IndexRequiresAllScannedTags);
+  MITK_TEST(IndexedValuesEqualScannedValues);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  std::string m_PreviousIndexDirectory;
+  std::string m_IndexDirectory;
+
+  mitk::StringList ctFiles;
+
+  mitk::DICOMTag instanceUID = mitk::DICOMTag(0x0008, 0x0018);
+  mitk::DICOMTag patientName = mitk::DICOMTag(0x0010, 0x0010);
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.clear();
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+
+    m_PreviousIndexDirectory = mitk::DICOMPersistentTagIndex::GetIndexDirectory();
+    m_IndexDirectory = mitk::IOUtil::CreateTemporaryDirectory("mitkDICOMPersistentTagIndexTest_XXXXXX");
+    mitk::DICOMPersistentTagIndex::SetIndexDirectory(m_IndexDirectory);
+  }
+
+  void tearDown() override
+  {
+    mitk::DICOMPersistentTagIndex::SetIndexDirectory(m_PreviousIndexDirectory);
+    itksys::SystemTools::RemoveADirectory(m_IndexDirectory);
+  }
+
+  void IndexIsDisabledByDefault()
+  {
+    auto scanner = mitk::DICOMGDCMTagScanner::New();
+    CPPUNIT_ASSERT_MESSAGE("Testing default", !scanner->GetUsePersistentTagIndex());
+    scanner->SetInputFiles(ctFiles);
+    scanner->AddTag(instanceUID);
+    scanner->Scan();
+
+    mitk::DICOMPersistentTagIndex index("DICOMGDCMTagScanner");
+    index.Load(ctFiles, { mitk::DICOMTagPath(instanceUID) });
+    CPPUNIT_ASSERT_MESSAGE("Testing index after scan without index", index.Find(ctFiles.front()) == nullptr);
+  }
+
+  void ScanUpdatesIndex()
+  {
+    std::set<mitk::DICOMTagPath> scannedTags = { mitk::DICOMTagPath(instanceUID) };
+
+    mitk::DICOMPersistentTagIndex index("DICOMGDCMTagScanner");
+    index.Load(ctFiles, scannedTags);
+    CPPUNIT_ASSERT_MESSAGE("Testing empty index", index.Find(ctFiles.front()) == nullptr);
+
+    auto scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->UsePersistentTagIndexOn();
+    scanner->SetInputFiles(ctFiles);
+    scanner->AddTag(instanceUID);
+    scanner->Scan();
+
+    index.Load(ctFiles, scannedTags);
+    for (const auto& file : ctFiles)
+    {
+      auto values = index.Find(file);
+      CPPUNIT_ASSERT_MESSAGE("Testing indexed file", values != nullptr);
+      CPPUNIT_ASSERT_MESSAGE("Testing indexed values", values->size() == 1 && values->front().path == mitk::DICOMTagPath(instanceUID));
+      CPPUNIT_ASSERT_MESSAGE("Testing indexed value is not null", !values->front().isNull);
+    }
+
+    // the cache of a scan from the index still provides a scanner for all files
+    scanner->Scan();
+    auto cache = dynamic_cast<mitk::DICOMGDCMTagCache*>(scanner->GetScanCache().GetPointer());
+    CPPUNIT_ASSERT(cache != nullptr);
+    for (const auto& file : ctFiles)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Testing scanner of indexed cache", cache->GetScanner().IsKey(file.c_str()));
+    }
+  }
+
+  void IndexRequiresAllScannedTags()
+  {
+    auto scanner = mitk::DICOMGDCMTagScanner::New();
+    scanner->UsePersistentTagIndexOn();
+    scanner->SetInputFiles(ctFiles);
+    scanner->AddTag(instanceUID);
+    scanner->Scan();
+
+    mitk::DICOMPersistentTagIndex index("DICOMGDCMTagScanner");
+    index.Load(ctFiles, { mitk::DICOMTagPath(instanceUID), mitk::DICOMTagPath(patientName) });
+    CPPUNIT_ASSERT_MESSAGE("Testing index of fewer tags", index.Find(ctFiles.front()) == nullptr);
+
+    index.Load(ctFiles, {});
+    CPPUNIT_ASSERT_MESSAGE("Testing index of more tags", index.Find(ctFiles.front()) != nullptr);
+
+    mitk::DICOMPersistentTagIndex::SetIndexDirectory("");
+    index.Load(ctFiles, { mitk::DICOMTagPath(instanceUID) });
+    CPPUNIT_ASSERT_MESSAGE("Testing disabled index", index.Find(ctFiles.front()) == nullptr);
+  }
+
+  void IndexedValuesEqualScannedValues()
+  {
+    mitk::DICOMTagPath instanceUIDPath(instanceUID);
+    mitk::DICOMTagPath patientNamePath(patientName);
+
+    mitk::DICOMDatasetAccessingImageFrameList framesOfScans[2];
+    for (auto& frames : framesOfScans)
+    {
+      // the second scan uses the index of the first one
+      auto scanner = mitk::DICOMDCMTKTagScanner::New();
+      scanner->UsePersistentTagIndexOn();
+      scanner->SetInputFiles(ctFiles);
+      scanner->AddTagPath(instanceUIDPath);
+      scanner->AddTagPath(patientNamePath);
+      scanner->Scan();
+      frames = scanner->GetFrameInfoList();
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Testing number of frames", framesOfScans[0].size() == ctFiles.size() && framesOfScans[1].size() == ctFiles.size());
+
+    for (std::size_t i = 0; i < ctFiles.size(); ++i)
+    {
+      for (const auto& path : { instanceUIDPath, patientNamePath })
+      {
+        auto scannedFindings = framesOfScans[0][i]->GetTagValueAsString(path);
+        auto indexedFindings = framesOfScans[1][i]->GetTagValueAsString(path);
+        CPPUNIT_ASSERT_MESSAGE("Testing findings", scannedFindings.size() == 1 && indexedFindings.size() == 1);
+        CPPUNIT_ASSERT_MESSAGE("Testing path of indexed finding", indexedFindings.front().path == scannedFindings.front().path);
+        CPPUNIT_ASSERT_MESSAGE("Testing value of indexed finding", indexedFindings.front().value == scannedFindings.front().value);
+      }
+    }
+  }
+
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMPersistentTagIndex)
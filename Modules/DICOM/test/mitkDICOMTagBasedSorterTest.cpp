@@ -0,0 +1,210 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMGenericImageFrameInfo.h"
+#include "mitkDICOMSortByTag.h"
+#include "mitkDICOMTagBasedSorter.h"
+#include "mitkEquiDistantBlocksSorter.h"
+#include "mitkSortByImagePositionPatient.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+class mitkDICOMTagBasedSorterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMTagBasedSorterTestSuite);
+
+  MITK_TEST(SortByTagEqualsComparatorOrder);
+  MITK_TEST(SortByImagePositionEqualsExpectedOrder);
+  MITK_TEST(StrictSortingSplitsAtGap);
+  MITK_TEST(EquiDistantBlocksSeparateTimeSteps);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  // enough frames for many equal primary values and for several partitioning levels of std::sort
+  static const unsigned int NumberOfFrames = 5000;
+
+  mitk::DICOMTag instanceNumber = mitk::DICOMTag(0x0020, 0x0013);
+  mitk::DICOMTag acquisitionNumber = mitk::DICOMTag(0x0020, 0x0012);
+  mitk::DICOMTag imagePositionPatient = mitk::DICOMTag(0x0020, 0x0032);
+  mitk::DICOMTag imageOrientationPatient = mitk::DICOMTag(0x0020, 0x0037);
+
+  std::vector<mitk::DICOMGenericImageFrameInfo::Pointer> m_Frames;
+
+  mitk::DICOMDatasetList CreateFrames(unsigned int numberOfFrames)
+  {
+    m_Frames.clear();
+    mitk::DICOMDatasetList datasets;
+    for (unsigned int i = 0; i < numberOfFrames; ++i)
+    {
+      std::ostringstream filename;
+      filename << "frame" << i;
+      m_Frames.push_back(mitk::DICOMGenericImageFrameInfo::New(filename.str(), 0));
+      datasets.push_back(m_Frames.back());
+    }
+    return datasets;
+  }
+
+  /** Sorts like DICOMTagBasedSorter did before it used sort keys: by comparing the datasets.
+   * Only valid for criteria whose IsLeftBeforeRight() does not use the sort keys itself. */
+  mitk::DICOMDatasetList SortByComparator(mitk::DICOMDatasetList datasets, const mitk::DICOMSortCriterion* criterion)
+  {
+    std::sort(datasets.begin(), datasets.end(),
+              [criterion](const mitk::DICOMDatasetAccess* left, const mitk::DICOMDatasetAccess* right)
+              { return criterion->IsLeftBeforeRight(left, right); });
+    return datasets;
+  }
+
+  void AssertSortedAs(const mitk::DICOMDatasetList& input, mitk::DICOMSortCriterion::Pointer criterion, const mitk::DICOMDatasetList& expected)
+  {
+    CPPUNIT_ASSERT(criterion->HasSortKeys());
+
+    auto sorter = mitk::DICOMTagBasedSorter::New();
+    sorter->SetSortCriterion(criterion.GetPointer());
+    sorter->SetInput(input);
+    sorter->Sort();
+
+    CPPUNIT_ASSERT_EQUAL(1u, sorter->GetNumberOfOutputs());
+    CPPUNIT_ASSERT_MESSAGE("Sort keys result in the expected order", expected == sorter->GetOutput(0));
+  }
+
+public:
+
+  void setUp() override
+  {
+  }
+
+  void tearDown() override
+  {
+    m_Frames.clear();
+  }
+
+  void SortByTagEqualsComparatorOrder()
+  {
+    mitk::DICOMDatasetList datasets = this->CreateFrames(NumberOfFrames);
+
+    // many equal primary values (also non-numerical ones) to exercise the secondary criterion and the final tie-break
+    std::mt19937 random(42);
+    for (unsigned int i = 0; i < NumberOfFrames; ++i)
+    {
+      std::ostringstream instance;
+      if (i % 101 != 0)
+      {
+        instance << (i * 7919) % 997;
+      }
+      else
+      {
+        instance << "n/a";
+      }
+      m_Frames[i]->SetTagValue(instanceNumber, instance.str());
+
+      std::ostringstream acquisition;
+      acquisition << (random() % 5) << "." << (random() % 3);
+      m_Frames[i]->SetTagValue(acquisitionNumber, acquisition.str());
+    }
+    std::shuffle(datasets.begin(), datasets.end(), random);
+
+    // DICOMSortByTag::IsLeftBeforeRight() still compares the parsed tag strings
+    auto criterion = mitk::DICOMSortByTag::New(instanceNumber, mitk::DICOMSortByTag::New(acquisitionNumber).GetPointer());
+    this->AssertSortedAs(datasets, criterion.GetPointer(), this->SortByComparator(datasets, criterion));
+  }
+
+  void SortByImagePositionEqualsExpectedOrder()
+  {
+    mitk::DICOMDatasetList datasets = this->CreateFrames(NumberOfFrames);
+
+    // oblique slices, five frames per position, orientation differing in the 7th decimal digit.
+    // The frames are created in the expected order: the positions increase along the normal, and frames
+    // of one position only differ in the instance number (the normal of the left frame is applied to
+    // both positions, so the differing orientations do not separate them).
+    for (unsigned int i = 0; i < NumberOfFrames; ++i)
+    {
+      const double z = (i / 5) * 0.5;
+      std::ostringstream position;
+      position << 0.3 * z << "\\" << -12.5 << "\\" << z;
+      m_Frames[i]->SetTagValue(imagePositionPatient, position.str());
+      m_Frames[i]->SetTagValue(imageOrientationPatient, i % 2 ? "1\\0\\0\\0\\0.9701425\\-0.2425356" : "1\\0\\0\\0\\0.9701426\\-0.2425356");
+
+      std::ostringstream instance;
+      instance << (i % 5);
+      m_Frames[i]->SetTagValue(instanceNumber, instance.str());
+    }
+    const mitk::DICOMDatasetList expected = datasets;
+
+    std::mt19937 random(7);
+    std::shuffle(datasets.begin(), datasets.end(), random);
+
+    auto criterion = mitk::SortByImagePositionPatient::New(mitk::DICOMSortByTag::New(instanceNumber).GetPointer());
+    this->AssertSortedAs(datasets, criterion.GetPointer(), expected);
+  }
+
+  void StrictSortingSplitsAtGap()
+  {
+    mitk::DICOMDatasetList datasets = this->CreateFrames(10);
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+      std::ostringstream instance;
+      instance << (i < 5 ? i + 1 : i + 2); // 1..5, 7..11
+      m_Frames[i]->SetTagValue(instanceNumber, instance.str());
+    }
+    std::reverse(datasets.begin(), datasets.end());
+
+    auto sorter = mitk::DICOMTagBasedSorter::New();
+    sorter->SetSortCriterion(mitk::DICOMSortByTag::New(instanceNumber).GetPointer());
+    sorter->SetStrictSorting(true);
+    sorter->SetInput(datasets);
+    sorter->Sort();
+
+    CPPUNIT_ASSERT_EQUAL(2u, sorter->GetNumberOfOutputs());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), sorter->GetOutput(0).size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), sorter->GetOutput(1).size());
+    CPPUNIT_ASSERT_EQUAL(std::string("1"), sorter->GetOutput(0).front()->GetTagValueAsString(instanceNumber).value);
+    CPPUNIT_ASSERT_EQUAL(std::string("7"), sorter->GetOutput(1).front()->GetTagValueAsString(instanceNumber).value);
+  }
+
+  void EquiDistantBlocksSeparateTimeSteps()
+  {
+    // two time steps per position, sorted by position
+    const unsigned int numberOfPositions = 1000;
+    mitk::DICOMDatasetList datasets = this->CreateFrames(2 * numberOfPositions);
+    for (unsigned int i = 0; i < 2 * numberOfPositions; ++i)
+    {
+      std::ostringstream position;
+      position << "0\\0\\" << (i / 2) * 2.5;
+      m_Frames[i]->SetTagValue(imagePositionPatient, position.str());
+      m_Frames[i]->SetTagValue(imageOrientationPatient, "1\\0\\0\\0\\1\\0");
+    }
+
+    auto sorter = mitk::EquiDistantBlocksSorter::New();
+    sorter->SetInput(datasets);
+    sorter->Sort();
+
+    CPPUNIT_ASSERT_EQUAL(2u, sorter->GetNumberOfOutputs());
+    for (unsigned int block = 0; block < 2; ++block)
+    {
+      const mitk::DICOMDatasetList& output = sorter->GetOutput(block);
+      CPPUNIT_ASSERT_EQUAL(std::size_t(numberOfPositions), output.size());
+      for (unsigned int slice = 0; slice < numberOfPositions; ++slice)
+      {
+        CPPUNIT_ASSERT(output[slice] == datasets[2 * slice + block]);
+      }
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMTagBasedSorter)
@@ -17,7 +17,10 @@ found in the LICENSE file.
 
 #include "cpprest/asyncrt_utils.h"
 #include "cpprest/http_client.h"
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <vector>
 #include <mitkCommon.h>
 #include <mitkIRESTManager.h>
 #include <mitkRESTUtil.h>
@@ -91,6 +94,40 @@ namespace mitk
                                     utility::string_t studyUID,
                                     utility::string_t seriesUID);
 
+   /**
+    * @brief Receives the DICOM object instances (complete DICOM files as bytes) of a streamed WADO-RS response.
+    */
+   typedef std::function<void(std::vector<unsigned char> &&instance)> InstanceHandler;
+
+   /**
+    * @brief Sends a WADO-RS request for a DICOM object series and passes each contained instance to the handler as
+    * soon as it was received, without storing the instances as files.
+    *
+    * The multipart response is parsed while it streams in, chunk by chunk. The next chunk is only read after the
+    * handler returned, so a slow handler throttles the retrieval instead of the whole series piling up in memory.
+    *
+    * @param studyUID the DICOM study uid
+    * @param seriesUID the DICOM series uid
+    * @param handler called for every instance, calls are serialized
+    * @return the task to wait for, which unfolds the number of retrieved instances
+    */
+   pplx::task<unsigned int> SendWADORS(utility::string_t studyUID,
+                                       utility::string_t seriesUID,
+                                       InstanceHandler handler);
+
+   /**
+    * @brief Retrieves multiple series of a study like SendWADORS() for a single series, with at most
+    * maxConcurrentRequests responses being received at the same time.
+    *
+    * The handler calls of all series are serialized, the instances of different series may arrive interleaved.
+    *
+    * @return the task to wait for, which unfolds the number of retrieved instances of all series
+    */
+   pplx::task<unsigned int> SendWADORS(utility::string_t studyUID,
+                                       std::vector<utility::string_t> seriesUIDs,
+                                       InstanceHandler handler,
+                                       unsigned int maxConcurrentRequests = 4);
+
    /**
     * @brief Sends a QIDO request containing the given parameters to filter the query.
     *
@@ -118,6 +155,21 @@ namespace mitk
                                    utility::string_t seriesUID,
                                    utility::string_t instanceUID);
 
+   /**
+    * @brief Creates a WADO-RS request URI for a series
+    */
+   utility::string_t CreateWADORSUri(utility::string_t studyUID, utility::string_t seriesUID);
+
+   /**
+    * @brief Series of a SendWADORS() call for multiple series, shared by its concurrent requests
+    */
+   struct SeriesRetrieval;
+
+   /**
+    * @brief Retrieves the series that was not requested yet, then the following ones until all series were requested
+    */
+   pplx::task<unsigned int> RetrieveNextSeries(std::shared_ptr<SeriesRetrieval> retrieval);
+
    /**
     * @brief Creates a STOW request URI with the study uid
     */
@@ -0,0 +1,88 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMultipartRelatedParser_h
+#define mitkMultipartRelatedParser_h
+
+#include <MitkDICOMwebExports.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * @brief Incremental parser for multipart/related message bodies (RFC 2046, RFC 2387), as returned by WADO-RS.
+   *
+   * The body can be passed in chunks of any size as it is received. Each part is passed to the part handler as soon
+   * as its closing delimiter was parsed, so only the part that is currently received is kept in memory.
+   */
+  class MITKDICOMWEB_EXPORT MultipartRelatedParser
+  {
+  public:
+    /**
+     * @brief Header fields of a part. The field names are converted to lower case.
+     */
+    typedef std::map<std::string, std::string> HeaderMap;
+
+    typedef std::function<void(std::vector<unsigned char> &&body, const HeaderMap &headers)> PartHandler;
+
+    /**
+     * @brief Returns the boundary parameter of a multipart content type or an empty string if there is none.
+     */
+    static std::string GetBoundary(const std::string &contentType);
+
+    /**
+     * @throw mitk::Exception if boundary is empty
+     */
+    MultipartRelatedParser(const std::string &boundary, const PartHandler &handler);
+
+    /**
+     * @brief Parses the next chunk of the message body. Calls the part handler for every completed part.
+     */
+    void Append(const unsigned char *data, std::size_t size);
+
+    /**
+     * @brief Whether the closing delimiter was parsed. Data after it (the epilogue) is ignored.
+     */
+    bool IsFinished() const;
+
+    unsigned int GetNumberOfParts() const;
+
+  private:
+    enum class State
+    {
+      Delimiter,
+      DelimiterLine,
+      Headers,
+      Body,
+      Finished
+    };
+
+    void ParseBuffer();
+    bool ParseHeaders();
+    bool ParseBody(std::size_t searchStart);
+
+    std::string m_Delimiter;
+    PartHandler m_Handler;
+    State m_State;
+    std::vector<unsigned char> m_Buffer;
+    std::vector<unsigned char> m_Part;
+    HeaderMap m_PartHeaders;
+    unsigned int m_NumberOfParts;
+  };
+}
+
+#endif
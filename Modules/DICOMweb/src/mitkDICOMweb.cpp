@@ -11,6 +11,43 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkDICOMweb.h"
+#include "mitkMultipartRelatedParser.h"
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+
+namespace
+{
+  // size of the chunks in which streamed response bodies are read and parsed
+  const std::size_t StreamChunkSize = 64 * 1024;
+
+  pplx::task<void> ReadMultipartBody(concurrency::streams::istream body,
+                                     std::shared_ptr<mitk::MultipartRelatedParser> parser,
+                                     std::shared_ptr<std::vector<unsigned char>> chunk)
+  {
+    return body.streambuf().getn(chunk->data(), chunk->size()).then([=](std::size_t size) -> pplx::task<void> {
+      if (0 == size)
+        return pplx::task_from_result();
+
+      parser->Append(chunk->data(), size);
+
+      if (parser->IsFinished())
+        return pplx::task_from_result();
+
+      return ReadMultipartBody(body, parser, chunk);
+    });
+  }
+}
+
+struct mitk::DICOMweb::SeriesRetrieval
+{
+  utility::string_t StudyUID;
+  std::vector<utility::string_t> SeriesUIDs;
+  std::size_t NextSeries = 0;
+  std::mutex Mutex;
+  InstanceHandler Handler;
+};
 
 mitk::DICOMweb::DICOMweb() {}
 
@@ -46,6 +83,15 @@ utility::string_t mitk::DICOMweb::CreateWADOUri(utility::string_t studyUID,
   return builder.to_string();
 }
 
+utility::string_t mitk::DICOMweb::CreateWADORSUri(utility::string_t studyUID, utility::string_t seriesUID)
+{
+  MitkUriBuilder builder(m_BaseURI + U("rs/studies"));
+  builder.append_path(studyUID);
+  builder.append_path(U("series"));
+  builder.append_path(seriesUID);
+  return builder.to_string();
+}
+
 utility::string_t mitk::DICOMweb::CreateSTOWUri(utility::string_t studyUID)
 {
   MitkUriBuilder builder(m_BaseURI + U("rs/studies"));
@@ -193,6 +239,89 @@ pplx::task<std::string> mitk::DICOMweb::SendWADO(utility::string_t folderPath,
   });
 }
 
+pplx::task<unsigned int> mitk::DICOMweb::SendWADORS(utility::string_t studyUID,
+                                                    utility::string_t seriesUID,
+                                                    InstanceHandler handler)
+{
+  auto uri = CreateWADORSUri(studyUID, seriesUID);
+
+  mitk::RESTUtil::ParamMap headers;
+  headers.insert(mitk::RESTUtil::ParamMap::value_type(U("Accept"), U("multipart/related; type=\"application/dicom\"")));
+
+  return m_RESTManager->SendStreamingRequest(uri, headers)
+    .then([=](web::http::http_response response) -> pplx::task<unsigned int> {
+      auto contentType = mitk::RESTUtil::convertToUtf8(response.headers().content_type());
+      auto boundary = mitk::MultipartRelatedParser::GetBoundary(contentType);
+
+      if (boundary.empty())
+        mitkThrow() << "WADO-RS response is no multipart message (content type: " << contentType << ")";
+
+      auto parser = std::make_shared<mitk::MultipartRelatedParser>(
+        boundary, [handler](std::vector<unsigned char> &&instance, const mitk::MultipartRelatedParser::HeaderMap &) {
+          handler(std::move(instance));
+        });
+
+      auto chunk = std::make_shared<std::vector<unsigned char>>(StreamChunkSize);
+
+      return ReadMultipartBody(response.body(), parser, chunk).then([parser]() {
+        if (!parser->IsFinished())
+          mitkThrow() << "WADO-RS response ended before its closing boundary";
+
+        return parser->GetNumberOfParts();
+      });
+    });
+}
+
+pplx::task<unsigned int> mitk::DICOMweb::SendWADORS(utility::string_t studyUID,
+                                                    std::vector<utility::string_t> seriesUIDs,
+                                                    InstanceHandler handler,
+                                                    unsigned int maxConcurrentRequests)
+{
+  if (seriesUIDs.empty())
+    return pplx::task_from_result(0u);
+
+  auto retrieval = std::make_shared<SeriesRetrieval>();
+  retrieval->StudyUID = studyUID;
+  retrieval->SeriesUIDs = seriesUIDs;
+
+  // the responses are received concurrently, but the handler is called by one of them at a time
+  auto handlerMutex = std::make_shared<std::mutex>();
+  retrieval->Handler = [handler, handlerMutex](std::vector<unsigned char> &&instance) {
+    std::lock_guard<std::mutex> lock(*handlerMutex);
+    handler(std::move(instance));
+  };
+
+  auto numberOfRequests = std::min<std::size_t>(std::max(1u, maxConcurrentRequests), seriesUIDs.size());
+
+  std::vector<pplx::task<unsigned int>> tasks;
+  for (std::size_t i = 0; i < numberOfRequests; ++i)
+  {
+    tasks.push_back(RetrieveNextSeries(retrieval));
+  }
+
+  return pplx::when_all(begin(tasks), end(tasks)).then([](std::vector<unsigned int> numbersOfInstances) {
+    return std::accumulate(numbersOfInstances.begin(), numbersOfInstances.end(), 0u);
+  });
+}
+
+pplx::task<unsigned int> mitk::DICOMweb::RetrieveNextSeries(std::shared_ptr<SeriesRetrieval> retrieval)
+{
+  utility::string_t seriesUID;
+  {
+    std::lock_guard<std::mutex> lock(retrieval->Mutex);
+    if (retrieval->NextSeries == retrieval->SeriesUIDs.size())
+      return pplx::task_from_result(0u);
+
+    seriesUID = retrieval->SeriesUIDs[retrieval->NextSeries++];
+  }
+
+  return SendWADORS(retrieval->StudyUID, seriesUID, retrieval->Handler)
+    .then([=](unsigned int numberOfInstances) -> pplx::task<unsigned int> {
+      return RetrieveNextSeries(retrieval).then(
+        [numberOfInstances](unsigned int numberOfFollowingInstances) { return numberOfInstances + numberOfFollowingInstances; });
+    });
+}
+
 pplx::task<web::json::value> mitk::DICOMweb::SendQIDO(mitk::RESTUtil::ParamMap map)
 {
   auto uri = CreateQIDOUri(map);
@@ -0,0 +1,246 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkMultipartRelatedParser.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+  const std::string LineBreak = "\r\n";
+  const std::string HeaderEnd = "\r\n\r\n";
+
+  std::string Trim(const std::string &value)
+  {
+    const auto first = value.find_first_not_of(" \t");
+    if (std::string::npos == first)
+      return std::string();
+
+    const auto last = value.find_last_not_of(" \t");
+    return value.substr(first, last - first + 1);
+  }
+
+  std::string ToLower(std::string value)
+  {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+    return value;
+  }
+
+  std::vector<unsigned char>::iterator Find(std::vector<unsigned char> &buffer,
+                                            std::size_t start,
+                                            const std::string &pattern)
+  {
+    return std::search(buffer.begin() + start, buffer.end(), pattern.begin(), pattern.end());
+  }
+}
+
+std::string mitk::MultipartRelatedParser::GetBoundary(const std::string &contentType)
+{
+  // split into parameters at semicolons outside of quoted strings
+  std::vector<std::string> parameters(1);
+  bool quoted = false;
+  for (auto c : contentType)
+  {
+    if ('"' == c)
+      quoted = !quoted;
+
+    if (';' == c && !quoted)
+      parameters.emplace_back();
+    else
+      parameters.back() += c;
+  }
+
+  for (const auto &parameter : parameters)
+  {
+    const auto separator = parameter.find('=');
+    if (std::string::npos != separator && "boundary" == ToLower(Trim(parameter.substr(0, separator))))
+    {
+      auto value = Trim(parameter.substr(separator + 1));
+      if (value.size() >= 2 && '"' == value.front() && '"' == value.back())
+        value = value.substr(1, value.size() - 2);
+
+      return value;
+    }
+  }
+
+  return std::string();
+}
+
+mitk::MultipartRelatedParser::MultipartRelatedParser(const std::string &boundary, const PartHandler &handler)
+  : m_Delimiter(LineBreak + "--" + boundary),
+    m_Handler(handler),
+    m_State(State::Delimiter),
+    m_Buffer(LineBreak.begin(), LineBreak.end()), // the first delimiter does not need to follow a line break
+    m_NumberOfParts(0)
+{
+  if (boundary.empty())
+    mitkThrow() << "Multipart boundary must not be empty.";
+}
+
+void mitk::MultipartRelatedParser::Append(const unsigned char *data, std::size_t size)
+{
+  if (State::Finished == m_State || 0 == size)
+    return;
+
+  if (State::Body == m_State)
+  {
+    // only the end of the data received before can contain the beginning of the delimiter
+    const auto previousSize = m_Part.size();
+    m_Part.insert(m_Part.end(), data, data + size);
+
+    if (this->ParseBody(previousSize >= m_Delimiter.size() ? previousSize - m_Delimiter.size() + 1 : 0))
+      this->ParseBuffer();
+  }
+  else
+  {
+    m_Buffer.insert(m_Buffer.end(), data, data + size);
+    this->ParseBuffer();
+  }
+}
+
+bool mitk::MultipartRelatedParser::IsFinished() const
+{
+  return State::Finished == m_State;
+}
+
+unsigned int mitk::MultipartRelatedParser::GetNumberOfParts() const
+{
+  return m_NumberOfParts;
+}
+
+void mitk::MultipartRelatedParser::ParseBuffer()
+{
+  while (true)
+  {
+    switch (m_State)
+    {
+      case State::Delimiter:
+      {
+        // skip the preamble
+        auto delimiter = Find(m_Buffer, 0, m_Delimiter);
+        if (m_Buffer.end() == delimiter)
+        {
+          if (m_Buffer.size() >= m_Delimiter.size())
+            m_Buffer.erase(m_Buffer.begin(), m_Buffer.end() - (m_Delimiter.size() - 1));
+
+          return;
+        }
+
+        m_Buffer.erase(m_Buffer.begin(), delimiter + m_Delimiter.size());
+        m_State = State::DelimiterLine;
+        break;
+      }
+
+      case State::DelimiterLine:
+      {
+        if (m_Buffer.size() < 2)
+          return;
+
+        if ('-' == m_Buffer[0] && '-' == m_Buffer[1])
+        {
+          m_Buffer.clear();
+          m_State = State::Finished;
+          return;
+        }
+
+        // skip transport padding
+        auto lineEnd = Find(m_Buffer, 0, LineBreak);
+        if (m_Buffer.end() == lineEnd)
+          return;
+
+        m_Buffer.erase(m_Buffer.begin(), lineEnd + LineBreak.size());
+        m_State = State::Headers;
+        break;
+      }
+
+      case State::Headers:
+      {
+        if (!this->ParseHeaders())
+          return;
+
+        m_State = State::Body;
+        m_Part.swap(m_Buffer);
+        m_Buffer.clear();
+
+        if (!this->ParseBody(0))
+          return;
+
+        break;
+      }
+
+      case State::Body:
+      case State::Finished:
+        return;
+    }
+  }
+}
+
+bool mitk::MultipartRelatedParser::ParseHeaders()
+{
+  if (m_Buffer.size() < LineBreak.size())
+    return false;
+
+  m_PartHeaders.clear();
+
+  // a part without header fields starts with an empty line
+  if (std::equal(LineBreak.begin(), LineBreak.end(), m_Buffer.begin()))
+  {
+    m_Buffer.erase(m_Buffer.begin(), m_Buffer.begin() + LineBreak.size());
+    return true;
+  }
+
+  auto headerEnd = Find(m_Buffer, 0, HeaderEnd);
+  if (m_Buffer.end() == headerEnd)
+    return false;
+
+  const std::string headers(m_Buffer.begin(), headerEnd);
+  std::string::size_type lineBegin = 0;
+  while (lineBegin < headers.size())
+  {
+    auto lineEnd = headers.find(LineBreak, lineBegin);
+    if (std::string::npos == lineEnd)
+      lineEnd = headers.size();
+
+    const auto line = headers.substr(lineBegin, lineEnd - lineBegin);
+    const auto separator = line.find(':');
+    if (std::string::npos != separator)
+      m_PartHeaders[ToLower(Trim(line.substr(0, separator)))] = Trim(line.substr(separator + 1));
+
+    lineBegin = lineEnd + LineBreak.size();
+  }
+
+  m_Buffer.erase(m_Buffer.begin(), headerEnd + HeaderEnd.size());
+  return true;
+}
+
+bool mitk::MultipartRelatedParser::ParseBody(std::size_t searchStart)
+{
+  auto delimiter = Find(m_Part, searchStart, m_Delimiter);
+  if (m_Part.end() == delimiter)
+    return false;
+
+  // everything after the delimiter belongs to the following parts
+  m_Buffer.assign(delimiter + m_Delimiter.size(), m_Part.end());
+  m_Part.erase(delimiter, m_Part.end());
+
+  ++m_NumberOfParts;
+  m_State = State::DelimiterLine;
+
+  std::vector<unsigned char> part;
+  part.swap(m_Part);
+  m_Handler(std::move(part), m_PartHeaders);
+
+  return true;
+}
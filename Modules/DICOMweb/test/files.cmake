@@ -0,0 +1,4 @@
+set(MODULE_TESTS
+  mitkMultipartRelatedParserTest.cpp
+  mitkDICOMwebTest.cpp
+)
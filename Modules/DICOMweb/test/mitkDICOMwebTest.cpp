@@ -0,0 +1,172 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkDICOMweb.h>
+#include <mitkIRESTManager.h>
+#include <mitkIRESTObserver.h>
+
+#include <usGetModuleContext.h>
+#include <usModuleContext.h>
+#include <usServiceReference.h>
+
+#include <algorithm>
+
+/**
+ * The test suite acts as a local stand-in for a DICOMweb server, it answers WADO-RS requests of the
+ * series below with multipart responses that contain NumberOfInstances instances of InstanceSize bytes.
+ */
+class mitkDICOMwebTestSuite : public mitk::TestFixture, mitk::IRESTObserver
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMwebTestSuite);
+  MITK_TEST(SendWADORS_Series_ReturnsAllInstances);
+  MITK_TEST(SendWADORS_MultipleSeries_ReturnsInstancesOfAllSeries);
+  MITK_TEST(SendWADORS_NoMultipartResponse_ThrowsException);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  static const unsigned int NumberOfInstances = 5;
+  static const std::size_t InstanceSize = 300000;
+
+  mitk::IRESTManager *m_Service = nullptr;
+  std::vector<utility::string_t> m_SeriesUIDs;
+
+  web::http::http_response Notify(const web::uri &uri,
+                                  const web::json::value &,
+                                  const web::http::method &,
+                                  const mitk::RESTUtil::ParamMap &) override
+  {
+    web::http::http_response response(web::http::status_codes::OK);
+
+    // the last path segment is the series uid
+    auto seriesUID = mitk::RESTUtil::convertToUtf8(uri.path());
+    seriesUID = seriesUID.substr(seriesUID.find_last_of('/') + 1);
+
+    if ("0" == seriesUID)
+    {
+      response.set_body(U("no multipart message"));
+      return response;
+    }
+
+    const std::string boundary = "mitkDICOMwebTestBoundary";
+    std::string message;
+    for (unsigned int i = 0; i < NumberOfInstances; ++i)
+    {
+      message += "\r\n--" + boundary + "\r\nContent-Type: application/dicom\r\n\r\n";
+      message += CreateInstance(seriesUID, i);
+    }
+    message += "\r\n--" + boundary + "--\r\n";
+
+    response.set_body(std::vector<unsigned char>(message.begin(), message.end()));
+    response.headers().set_content_type(
+      U("multipart/related; type=\"application/dicom\"; boundary=") + mitk::RESTUtil::convertToTString(boundary));
+
+    return response;
+  }
+
+  /**
+   * @brief Content of an instance, which identifies the series and instance
+   */
+  static std::string CreateInstance(const std::string &seriesUID, unsigned int instanceNumber)
+  {
+    auto instance = "DICM" + seriesUID + "/" + std::to_string(instanceNumber) + "/";
+    instance.resize(InstanceSize, static_cast<char>('a' + instanceNumber));
+    return instance;
+  }
+
+  void setUp() override
+  {
+    us::ServiceReference<mitk::IRESTManager> serviceRef =
+      us::GetModuleContext()->GetServiceReference<mitk::IRESTManager>();
+    if (serviceRef)
+    {
+      m_Service = us::GetModuleContext()->GetService(serviceRef);
+    }
+
+    if (!m_Service)
+    {
+      CPPUNIT_FAIL("Getting Service in setUp() failed");
+    }
+
+    m_SeriesUIDs = {U("0"), U("1.2.3"), U("1.2.4"), U("1.2.5"), U("1.2.6")};
+    for (const auto &seriesUID : m_SeriesUIDs)
+    {
+      m_Service->ReceiveRequest(U("http://localhost:8080/dicomweb/rs/studies/1.2/series/") + seriesUID, this);
+    }
+  }
+
+  void tearDown() override { m_Service->HandleDeleteObserver(this); }
+
+  void SendWADORS_Series_ReturnsAllInstances()
+  {
+    mitk::DICOMweb dicomweb(U("http://localhost:8080/dicomweb/"));
+
+    std::vector<std::string> instances;
+    auto numberOfInstances =
+      dicomweb
+        .SendWADORS(U("1.2"), U("1.2.3"), [&instances](std::vector<unsigned char> &&instance) {
+          instances.emplace_back(instance.begin(), instance.end());
+        })
+        .get();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(NumberOfInstances), numberOfInstances);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(NumberOfInstances), instances.size());
+    for (unsigned int i = 0; i < NumberOfInstances; ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Instance is received unmodified and in order", CreateInstance("1.2.3", i) == instances[i]);
+    }
+  }
+
+  void SendWADORS_MultipleSeries_ReturnsInstancesOfAllSeries()
+  {
+    mitk::DICOMweb dicomweb(U("http://localhost:8080/dicomweb/"));
+
+    std::vector<utility::string_t> seriesUIDs(m_SeriesUIDs.begin() + 1, m_SeriesUIDs.end());
+
+    std::vector<std::string> instances;
+    auto numberOfInstances =
+      dicomweb
+        .SendWADORS(U("1.2"),
+                    seriesUIDs,
+                    [&instances](std::vector<unsigned char> &&instance) {
+                      // calls are serialized, so no locking is needed here
+                      instances.emplace_back(instance.begin(), instance.end());
+                    },
+                    2)
+        .get();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(seriesUIDs.size()) * NumberOfInstances, numberOfInstances);
+    CPPUNIT_ASSERT_EQUAL(seriesUIDs.size() * NumberOfInstances, instances.size());
+
+    for (const auto &seriesUID : seriesUIDs)
+    {
+      for (unsigned int i = 0; i < NumberOfInstances; ++i)
+      {
+        auto expected = CreateInstance(mitk::RESTUtil::convertToUtf8(seriesUID), i);
+        CPPUNIT_ASSERT_MESSAGE("Every instance is received once",
+                               1 == std::count(instances.begin(), instances.end(), expected));
+      }
+    }
+  }
+
+  void SendWADORS_NoMultipartResponse_ThrowsException()
+  {
+    mitk::DICOMweb dicomweb(U("http://localhost:8080/dicomweb/"));
+
+    CPPUNIT_ASSERT_THROW(dicomweb.SendWADORS(U("1.2"), U("0"), [](std::vector<unsigned char> &&) {}).get(),
+                         mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMweb)
@@ -0,0 +1,159 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkMultipartRelatedParser.h>
+
+#include <algorithm>
+
+class mitkMultipartRelatedParserTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkMultipartRelatedParserTestSuite);
+  MITK_TEST(GetBoundary_ReturnsBoundaryParameter);
+  MITK_TEST(Append_AnyChunkSize_ReturnsAllParts);
+  MITK_TEST(Append_BinaryParts_ReturnsUnmodifiedParts);
+  MITK_TEST(Append_MissingClosingBoundary_IsNotFinished);
+  MITK_TEST(Constructor_EmptyBoundary_ThrowsException);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  std::string m_Message;
+  std::vector<std::string> m_Parts;
+  std::vector<mitk::MultipartRelatedParser::HeaderMap> m_Headers;
+
+  void setUp() override
+  {
+    // preamble, a part that contains parts of the delimiter, a part without headers,
+    // transport padding after a delimiter, an empty part and an epilogue
+    m_Message = "This is the preamble.\r\n"
+                "--DICOMwebBoundary\r\n"
+                "Content-Type: application/dicom\r\n"
+                "\r\n"
+                "first\r\n--DICOMweb\r\n-\r\n"
+                "--DICOMwebBoundary   \r\n"
+                "\r\n"
+                "second"
+                "\r\n--DICOMwebBoundary\r\n"
+                "content-type:  application/dicom; transfer-syntax=1.2.840.10008.1.2.1 \r\n"
+                "Content-Location: /instances/3\r\n"
+                "\r\n"
+                "\r\n--DICOMwebBoundary--\r\n"
+                "This is the epilogue.";
+
+    m_Parts.clear();
+    m_Headers.clear();
+  }
+
+  void tearDown() override {}
+
+  mitk::MultipartRelatedParser::PartHandler GetPartHandler()
+  {
+    return [this](std::vector<unsigned char> &&body, const mitk::MultipartRelatedParser::HeaderMap &headers) {
+      m_Parts.emplace_back(body.begin(), body.end());
+      m_Headers.push_back(headers);
+    };
+  }
+
+  void GetBoundary_ReturnsBoundaryParameter()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::string("abc"),
+                         mitk::MultipartRelatedParser::GetBoundary("multipart/related;boundary=abc"));
+    CPPUNIT_ASSERT_EQUAL(
+      std::string("a b;c"),
+      mitk::MultipartRelatedParser::GetBoundary("multipart/related; type=\"application/dicom\"; Boundary=\"a b;c\""));
+    CPPUNIT_ASSERT_EQUAL(std::string(), mitk::MultipartRelatedParser::GetBoundary("application/dicom"));
+  }
+
+  void Append_AnyChunkSize_ReturnsAllParts()
+  {
+    for (std::size_t chunkSize = 1; chunkSize <= m_Message.size(); ++chunkSize)
+    {
+      m_Parts.clear();
+      m_Headers.clear();
+
+      mitk::MultipartRelatedParser parser("DICOMwebBoundary", this->GetPartHandler());
+      for (std::size_t offset = 0; offset < m_Message.size(); offset += chunkSize)
+      {
+        parser.Append(reinterpret_cast<const unsigned char *>(m_Message.data()) + offset,
+                      std::min(chunkSize, m_Message.size() - offset));
+      }
+
+      CPPUNIT_ASSERT_MESSAGE("Closing boundary was parsed", parser.IsFinished());
+      CPPUNIT_ASSERT_EQUAL(3u, parser.GetNumberOfParts());
+      CPPUNIT_ASSERT_EQUAL(std::size_t(3), m_Parts.size());
+
+      CPPUNIT_ASSERT_EQUAL(std::string("first\r\n--DICOMweb\r\n-"), m_Parts[0]);
+      CPPUNIT_ASSERT_EQUAL(std::string("second"), m_Parts[1]);
+      CPPUNIT_ASSERT_EQUAL(std::string(), m_Parts[2]);
+
+      CPPUNIT_ASSERT_EQUAL(std::string("application/dicom"), m_Headers[0]["content-type"]);
+      CPPUNIT_ASSERT(m_Headers[1].empty());
+      CPPUNIT_ASSERT_EQUAL(std::string("application/dicom; transfer-syntax=1.2.840.10008.1.2.1"),
+                           m_Headers[2]["content-type"]);
+      CPPUNIT_ASSERT_EQUAL(std::string("/instances/3"), m_Headers[2]["content-location"]);
+    }
+  }
+
+  void Append_BinaryParts_ReturnsUnmodifiedParts()
+  {
+    std::vector<unsigned char> instance(100000);
+    for (std::size_t i = 0; i < instance.size(); ++i)
+    {
+      instance[i] = static_cast<unsigned char>((i * 7) % 256);
+    }
+
+    const std::string delimiter = "\r\n--b\r\n\r\n";
+    std::vector<unsigned char> message(delimiter.begin() + 2, delimiter.end());
+    message.insert(message.end(), instance.begin(), instance.end());
+    message.insert(message.end(), delimiter.begin(), delimiter.end());
+    message.insert(message.end(), instance.begin(), instance.end());
+    const std::string closingDelimiter = "\r\n--b--";
+    message.insert(message.end(), closingDelimiter.begin(), closingDelimiter.end());
+
+    std::vector<std::vector<unsigned char>> parts;
+    mitk::MultipartRelatedParser parser(
+      "b", [&parts](std::vector<unsigned char> &&body, const mitk::MultipartRelatedParser::HeaderMap &) {
+        parts.push_back(std::move(body));
+      });
+
+    const std::size_t chunkSize = 4096;
+    for (std::size_t offset = 0; offset < message.size(); offset += chunkSize)
+    {
+      parser.Append(message.data() + offset, std::min(chunkSize, message.size() - offset));
+    }
+
+    CPPUNIT_ASSERT(parser.IsFinished());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), parts.size());
+    CPPUNIT_ASSERT(instance == parts[0]);
+    CPPUNIT_ASSERT(instance == parts[1]);
+  }
+
+  void Append_MissingClosingBoundary_IsNotFinished()
+  {
+    const auto truncatedMessage = m_Message.substr(0, m_Message.find("\r\n--DICOMwebBoundary--"));
+
+    mitk::MultipartRelatedParser parser("DICOMwebBoundary", this->GetPartHandler());
+    parser.Append(reinterpret_cast<const unsigned char *>(truncatedMessage.data()), truncatedMessage.size());
+
+    CPPUNIT_ASSERT(!parser.IsFinished());
+    CPPUNIT_ASSERT_EQUAL(2u, parser.GetNumberOfParts());
+  }
+
+  void Constructor_EmptyBoundary_ThrowsException()
+  {
+    CPPUNIT_ASSERT_THROW(mitk::MultipartRelatedParser("", this->GetPartHandler()), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkMultipartRelatedParser)
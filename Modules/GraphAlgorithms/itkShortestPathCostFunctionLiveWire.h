@@ -35,6 +35,13 @@ namespace itk
   To compute  the costs of the gradient magnitude dynamically
   an iverted map of the histogram of gradient magnitude image is used.
 
+  All features only depend on the pixel that is entered. Initialize()
+  therefore combines them into a cost image once, and GetCost() only looks
+  up this image and scales by the length of the step. The cost image is
+  recomputed if the image, the cost map or the usage of the cost map
+  changes. GetMinCost() returns the minimum of the cost image, which is an
+  admissible estimate per unit length for A*.
+
   */
   template <class TInputImageType>
   class ITK_EXPORT ShortestPathCostFunctionLiveWire : public ShortestPathCostFunction<TInputImageType>
@@ -93,14 +100,32 @@ namespace itk
       this->m_CostMap = costMap;
       this->m_UseCostMap = true;
       this->m_MaxMapCosts = -1;
+      this->m_CostImage = nullptr;
       this->Modified();
     }
 
-    void SetUseCostMap(bool useCostMap) { this->m_UseCostMap = useCostMap; }
+    void SetUseCostMap(bool useCostMap)
+    {
+      if (this->m_UseCostMap != useCostMap)
+      {
+        this->m_UseCostMap = useCostMap;
+        this->m_CostImage = nullptr;
+        this->Modified();
+      }
+    }
+
     /**
      \brief Set the maximum of the dynamic cost map to save computation time.
     */
-    void SetCostMapMaximum(double max) { this->m_MaxMapCosts = max; }
+    void SetCostMapMaximum(double max)
+    {
+      if (this->m_MaxMapCosts != max)
+      {
+        this->m_MaxMapCosts = max;
+        this->m_CostImage = nullptr;
+        this->Modified();
+      }
+    }
     enum Constants
     {
       MAPSCALEFACTOR = 10
@@ -121,6 +146,8 @@ namespace itk
     const FloatImageType *GetGradientMagnitudeImage() { return this->m_GradientMagnitudeImage.GetPointer(); };
     const FloatImageType *GetEdgeImage() { return this->m_EdgeImage.GetPointer(); };
     const VectorOutputImageType *GetGradientImage() { return this->m_GradientImage.GetPointer(); };
+    /** \brief Returns the costs of entering each pixel by a horizontal or vertical step (valid after Initialize())*/
+    const FloatImageType *GetCostImage() { return this->m_CostImage.GetPointer(); };
   protected:
     ShortestPathCostFunctionLiveWire();
 
@@ -130,6 +157,7 @@ namespace itk
     FloatImageType::Pointer m_EdgeImage;
     UnsignedCharImageType::Pointer m_MaskImage;
     VectorOutputImageType::Pointer m_GradientImage;
+    FloatImageType::Pointer m_CostImage;
 
     double m_MinCosts;
 
@@ -152,6 +180,12 @@ namespace itk
 
     double m_MaxMapCosts;
 
+    /** \brief Combines the feature images into m_CostImage and updates m_MinCosts*/
+    void UpdateCostImage();
+
+    /** \brief Maps the gradient magnitude to a cost between 0 (good) and 1 (bad)*/
+    double GetGradientCost(double gradientMagnitude);
+
   private:
     double SigmoidFunction(double I, double max, double min, double alpha, double beta);
   };
@@ -15,12 +15,15 @@ found in the LICENSE file.
 
 #include "itkShortestPathCostFunctionLiveWire.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include <itkCannyEdgeDetectionImageFilter.h>
 #include <itkCastImageFilter.h>
 #include <itkGradientImageFilter.h>
 #include <itkGradientMagnitudeImageFilter.h>
+#include <itkImageRegionIterator.h>
 #include <itkLaplacianImageFilter.h>
 #include <itkStatisticsImageFilter.h>
 #include <itkZeroCrossingImageFilter.h>
@@ -38,12 +41,14 @@ namespace itk
   {
     this->m_MaskImage->SetPixel(index, 255);
     m_UseRepulsivePoints = true;
+    this->Modified();
   }
 
   template <class TInputImageType>
   void ShortestPathCostFunctionLiveWire<TInputImageType>::RemoveRepulsivePoint(const IndexType &index)
   {
     this->m_MaskImage->SetPixel(index, 0);
+    this->Modified();
   }
 
   template <class TInputImageType>
@@ -72,18 +77,12 @@ namespace itk
   {
     m_UseRepulsivePoints = false;
     this->m_MaskImage->FillBuffer(0);
+    this->Modified();
   }
 
   template <class TInputImageType>
   double ShortestPathCostFunctionLiveWire<TInputImageType>::GetCost(IndexType p1, IndexType p2)
   {
-    // local component costs
-    // weights
-    double w1;
-    double w2;
-    double w3;
-    double costs = 0.0;
-
     // if we are on the mask, return asap
     if (m_UseRepulsivePoints)
     {
@@ -91,19 +90,22 @@ namespace itk
         return 1000;
     }
 
-    double gradientX, gradientY;
-    gradientX = gradientY = 0.0;
+    double costs = m_CostImage->GetPixel(p2);
 
-    double gradientCost;
-
-    double gradientMagnitude;
+    // scale by euclidian distance
+    if (p1[0] != p2[0] && p1[1] != p2[1])
+    {
+      // diagonal neighbor
+      costs *= sqrt(2.0);
+    }
 
-    // Gradient Magnitude costs
-    gradientMagnitude = this->m_GradientMagnitudeImage->GetPixel(p2);
-    gradientX = m_GradientImage->GetPixel(p2)[0];
-    gradientY = m_GradientImage->GetPixel(p2)[1];
+    return costs;
+  }
 
-    if (m_UseCostMap && !m_CostMap.empty())
+  template <class TInputImageType>
+  double ShortestPathCostFunctionLiveWire<TInputImageType>::GetGradientCost(double gradientMagnitude)
+  {
+    if (m_UseCostMap && !m_CostMap.empty() && m_MaxMapCosts > 0.0)
     {
       std::map<int, int>::iterator end = m_CostMap.end();
       std::map<int, int>::iterator last = --(m_CostMap.end());
@@ -193,96 +195,103 @@ namespace itk
         partRight2 = ShortestPathCostFunctionLiveWire<TInputImageType>::Gaussian(keyOfX, right2->first, right2->second);
       }
 
-      if (m_MaxMapCosts > 0.0)
-      {
-        gradientCost = 1.0 - ((partRight1 + partRight2 + partLeft1 + partLeft2) / m_MaxMapCosts);
-      }
-      else
-      { // use linear mapping
-        gradientCost = 1.0 - (gradientMagnitude / m_GradientMax);
-      }
-    }
-    else
-    { // use linear mapping
-      // value between 0 (good) and 1 (bad)
-      gradientCost = 1.0 - (gradientMagnitude / m_GradientMax);
+      return 1.0 - ((partRight1 + partRight2 + partLeft1 + partLeft2) / m_MaxMapCosts);
     }
 
-    //  Laplacian zero crossing costs
-    // f(p) =     0;   if I(p)=0
-    //     or     1;   if I(p)!=0
-    double laplacianCost;
-    typename Superclass::PixelType laplaceImageValue;
+    // use linear mapping
+    // value between 0 (good) and 1 (bad)
+    return 1.0 - (gradientMagnitude / m_GradientMax);
+  }
 
-    laplaceImageValue = m_EdgeImage->GetPixel(p2);
+  template <class TInputImageType>
+  void ShortestPathCostFunctionLiveWire<TInputImageType>::UpdateCostImage()
+  {
+    // weights
+    double w1;
+    double w2;
+    double w3;
 
-    if (laplaceImageValue < 0 || laplaceImageValue > 0)
+    if (this->m_UseCostMap)
     {
-      laplacianCost = 1.0;
+      w1 = 0.43;
+      w2 = 0.43;
+      w3 = 0.14;
     }
     else
     {
-      laplacianCost = 0.0;
+      w1 = 0.10;
+      w2 = 0.85;
+      w3 = 0.05;
     }
 
-    // gradient vector at p1
-    double nGradientAtP1[2];
-    nGradientAtP1[0] = gradientX; // previously computed for gradient magnitude
-    nGradientAtP1[1] = gradientY;
+    const RegionType region = m_GradientMagnitudeImage->GetLargestPossibleRegion();
 
-    // gradient direction unit vector of p1
-    nGradientAtP1[0] /= gradientMagnitude;
-    nGradientAtP1[1] /= gradientMagnitude;
-    //-------
+    m_CostImage = FloatImageType::New();
+    m_CostImage->CopyInformation(m_GradientMagnitudeImage);
+    m_CostImage->SetRegions(region);
+    m_CostImage->Allocate();
 
-    // gradient vector at p1
-    double nGradientAtP2[2];
+    // with a cost map, the gradient costs only depend on the integral part of the gradient magnitude
+    std::map<int, double> gradientCosts;
 
-    nGradientAtP2[0] = m_GradientImage->GetPixel(p2)[0];
-    nGradientAtP2[1] = m_GradientImage->GetPixel(p2)[1];
+    m_MinCosts = std::numeric_limits<double>::max();
 
-    nGradientAtP2[0] /= m_GradientMagnitudeImage->GetPixel(p2);
-    nGradientAtP2[1] /= m_GradientMagnitudeImage->GetPixel(p2);
+    itk::ImageRegionConstIterator<FloatImageType> magnitudeIt(m_GradientMagnitudeImage, region);
+    itk::ImageRegionConstIterator<VectorOutputImageType> gradientIt(m_GradientImage, region);
+    itk::ImageRegionConstIterator<FloatImageType> edgeIt(m_EdgeImage, region);
+    itk::ImageRegionIterator<FloatImageType> costIt(m_CostImage, region);
 
-    double scalarProduct = (nGradientAtP1[0] * nGradientAtP2[0]) + (nGradientAtP1[1] * nGradientAtP2[1]);
-    if (std::abs(scalarProduct) >= 1.0)
+    for (; !costIt.IsAtEnd(); ++magnitudeIt, ++gradientIt, ++edgeIt, ++costIt)
     {
-      // this should probably not happen; make sure the input for acos is valid
-      scalarProduct = 0.999999999;
-    }
+      const double gradientMagnitude = magnitudeIt.Get();
 
-    double gradientDirectionCost = acos(scalarProduct) / 3.14159265;
+      // Gradient Magnitude costs
+      double gradientCost;
+      if (m_UseCostMap && !m_CostMap.empty() && m_MaxMapCosts > 0.0)
+      {
+        const int keyOfX = static_cast<int>(gradientMagnitude);
+        auto cached = gradientCosts.find(keyOfX);
+        if (cached == gradientCosts.end())
+          cached = gradientCosts.insert(std::make_pair(keyOfX, this->GetGradientCost(gradientMagnitude))).first;
 
-    if (this->m_UseCostMap)
-    {
-      w1 = 0.43;
-      w2 = 0.43;
-      w3 = 0.14;
-    }
-    else
-    {
-      w1 = 0.10;
-      w2 = 0.85;
-      w3 = 0.05;
-    }
-    costs = w1 * laplacianCost + w2 * gradientCost + w3 * gradientDirectionCost;
+        gradientCost = cached->second;
+      }
+      else
+      {
+        gradientCost = this->GetGradientCost(gradientMagnitude);
+      }
 
-    // scale by euclidian distance
-    double costScale;
-    if (p1[0] == p2[0] || p1[1] == p2[1])
-    {
-      // horizontal or vertical neighbor
-      costScale = 1.0;
-    }
-    else
-    {
-      // diagonal neighbor
-      costScale = sqrt(2.0);
-    }
+      //  Laplacian zero crossing costs
+      // f(p) =     0;   if I(p)=0
+      //     or     1;   if I(p)!=0
+      const double laplaceImageValue = edgeIt.Get();
+      const double laplacianCost = (laplaceImageValue < 0 || laplaceImageValue > 0) ? 1.0 : 0.0;
 
-    costs *= costScale;
+      // gradient direction costs. The direction is undefined where the gradient vanishes.
+      double gradientDirectionCost = 0.0;
+      if (gradientMagnitude > 0.0)
+      {
+        const double nGradient[2] = {gradientIt.Get()[0] / gradientMagnitude, gradientIt.Get()[1] / gradientMagnitude};
 
-    return costs;
+        double scalarProduct = (nGradient[0] * nGradient[0]) + (nGradient[1] * nGradient[1]);
+        if (std::abs(scalarProduct) >= 1.0)
+        {
+          // this should probably not happen; make sure the input for acos is valid
+          scalarProduct = 0.999999999;
+        }
+
+        gradientDirectionCost = acos(scalarProduct) / 3.14159265;
+      }
+
+      const double costs = w1 * laplacianCost + w2 * gradientCost + w3 * gradientDirectionCost;
+      costIt.Set(costs);
+
+      m_MinCosts = std::min(m_MinCosts, static_cast<double>(costIt.Get()));
+    }
+
+    // The estimate must not exceed the costs of any step, so negative costs (possible with a cost map) disable A*.
+    if (m_MinCosts < 0.0 || m_MinCosts == std::numeric_limits<double>::max())
+      m_MinCosts = 0.0;
   }
 
   template <class TInputImageType>
@@ -363,14 +372,17 @@ namespace itk
       cannyEdgeDetectionfilter->Update();
       m_EdgeImage = cannyEdgeDetectionfilter->GetOutput();
 
-      // set minCosts
-      m_MinCosts = 0.0; // The lower, the more thouroughly! 0 = dijkstra. If estimate costs are lower than actual costs
-                      // everything is fine. If estimation is higher than actual costs, you might not get the shortest
-                      // but a different path.
-
+      m_CostImage = nullptr;
       m_Initialized = true;
     }
 
+    // combine the features once instead of per call of GetCost(). This also sets m_MinCosts, the lowest cost of a
+    // step of unit length, so the estimate of A* never exceeds the actual costs.
+    if (m_CostImage.IsNull())
+    {
+      this->UpdateCostImage();
+    }
+
     // check start/end point value
     startValue = this->m_Image->GetPixel(this->m_StartIndex);
     endValue = this->m_Image->GetPixel(this->m_EndIndex);
@@ -19,6 +19,8 @@ found in the LICENSE file.
 
 #include <itkMacro.h>
 
+#include <vector>
+
 // ------- INFORMATION ----------
 /// SET FUNCTIONS
 // void SetInput( ItkImage ) // Compulsory
@@ -35,6 +37,8 @@ found in the LICENSE file.
 // for GetVectorOrderImage
 // void AddEndIndex(const IndexType & EndIndex) //Optional. By calling this function you can add several endpoints! The
 // algorithm will look for several shortest Pathes. From Start to all Endpoints.
+// void SetReuseSearchTree(bool) // Optional (default=false), keep the search tree of the last update if only the end
+// point changed. Useful for interactive tools that move the end point with the mouse.
 //
 /// GET FUNCTIONS
 // std::vector< itk::Index<3> > GetVectorPath(); // returns the shortest path as vector
@@ -68,6 +72,7 @@ namespace itk
     typedef typename TInputImageType::PixelType InputImagePixelType;
     typedef typename TInputImageType::SizeType InputImageSizeType;
     typedef typename TInputImageType::IndexType IndexType;
+    typedef typename TInputImageType::OffsetType OffsetType;
     typedef typename itk::ImageRegionIteratorWithIndex<InputImageType> InputImageIteratorType;
 
     typedef TOutputImageType OutputImageType;
@@ -130,6 +135,12 @@ namespace itk
     itkSetMacro(ActivateTimeOut, bool);
     itkGetMacro(ActivateTimeOut, bool);
 
+    // \brief (default=false), keep the nodes that were closed or discovered in the last update. If neither the start
+    // point, the input nor the cost function changed since then, the next update continues this search until the new
+    // end point is closed (or just traces the path back if it already is). Only used for a single end point.
+    itkSetMacro(ReuseSearchTree, bool);
+    itkGetMacro(ReuseSearchTree, bool);
+
     // \brief returns shortest Path as vector
     std::vector<IndexType> GetVectorPath();
 
@@ -163,13 +174,14 @@ namespace itk
       m_endPoints; // if you fill this vector, the algo will not rest until all endPoints have been reached
     std::vector<IndexType> m_endPointsClosed;
 
-    ShortestPathNode *m_Nodes; // main list that contains all nodes
+    std::vector<ShortestPathNode> m_Nodes; // main list that contains all nodes, addressed by node number
     NodeNumType m_Graph_NumberOfNodes;
     NodeNumType m_Graph_StartNode;
     NodeNumType m_Graph_EndNode;
     bool m_Graph_fullNeighbors;
     bool m_useCostFunction;
-    std::vector<ShortestPathNode *> m_Graph_DiscoveredNodeList;
+    std::vector<OffsetType> m_NeighborOffsets;    // face neighbors first, then the diagonal ones
+    std::vector<ShortestPathNode *> m_Neighbors; // neighbors of the node that is currently expanded
     ShortestPathImageFilter(Self &); // intentionally not implemented
     void operator=(const Self &);    // intentionally not implemented
     const static int BACKGROUND = 0;
@@ -187,6 +199,11 @@ namespace itk
 
     bool m_Initialized;
 
+    bool m_ReuseSearchTree;
+    ModifiedTimeType m_SearchTreeCostFunctionMTime; // cost function and input of the current search tree
+    ModifiedTimeType m_SearchTreeInputMTime;
+    std::vector<ShortestPathNode *> m_DiscoveredNodes; // binary min-heap of the discovered but not yet closed nodes
+
     CostFunctionTypePointer m_CostFunction;
     IndexType m_StartIndex, m_EndIndex;
     std::vector<IndexType> m_VectorPath;
@@ -215,8 +232,18 @@ namespace itk
     // \brief Convert image coordinate to a indexnumber of a node in m_Nodes
     unsigned int CoordToNode(IndexType);
 
-    // \brief Returns the neighbors of a node
-    std::vector<ShortestPathNode *> GetNeighbors(NodeNumType nodeNum, bool FullNeighbors);
+    // \brief Fills neighbors with the neighbors of a node
+    void GetNeighbors(NodeNumType nodeNum, bool FullNeighbors, std::vector<ShortestPathNode *> &neighbors);
+
+    // \brief Heap of the discovered nodes ordered by distAndEst
+    void PushDiscoveredNode(ShortestPathNode *node);
+    ShortestPathNode *PopDiscoveredNode();
+    // \brief Restores the heap order after distAndEst of a discovered node decreased
+    void DecreaseDiscoveredNode(ShortestPathNode *node);
+    // \brief Restores the heap order after distAndEst of all discovered nodes changed
+    void RebuildDiscoveredNodes();
+    void SiftUp(NodeNumType heapIndex);
+    void SiftDown(NodeNumType heapIndex);
 
     // \brief Check if coords are in bounds of image
     bool CoordIsInBounds(IndexType);
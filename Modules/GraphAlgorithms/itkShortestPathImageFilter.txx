@@ -25,8 +25,7 @@ namespace itk
   // Constructor  (initialize standard values)
   template <class TInputImageType, class TOutputImageType>
   ShortestPathImageFilter<TInputImageType, TOutputImageType>::ShortestPathImageFilter()
-    : m_Nodes(nullptr),
-      m_Graph_NumberOfNodes(0),
+    : m_Graph_NumberOfNodes(0),
       m_Graph_fullNeighbors(false),
       m_useCostFunction(true),
       m_FullNeighborsMode(false),
@@ -35,11 +34,40 @@ namespace itk
       m_CalcAllDistances(false),
       multipleEndPoints(false),
       m_ActivateTimeOut(false),
-      m_Initialized(false)
+      m_Initialized(false),
+      m_ReuseSearchTree(false),
+      m_SearchTreeCostFunctionMTime(0),
+      m_SearchTreeInputMTime(0)
   {
     m_endPoints.clear();
     m_endPointsClosed.clear();
 
+    // Offsets of the neighbors. The first 2*dim are the face neighbors (N4 in 2D, N6 in 3D), the remaining ones
+    // complete N8 and N26, respectively.
+    static const int neighbors2D[8][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}, {-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+    static const int neighbors3D[26][3] = {
+      // N6
+      {0, -1, 0}, {1, 0, 0}, {0, 1, 0}, {-1, 0, 0}, {0, 0, 1}, {0, 0, -1},
+      // middle slice (diagonal)
+      {-1, -1, 0}, {1, -1, 0}, {-1, 1, 0}, {1, 1, 0},
+      // back slice (diagonal, non-diagonal)
+      {-1, -1, -1}, {1, -1, -1}, {-1, 1, -1}, {1, 1, -1}, {0, -1, -1}, {1, 0, -1}, {0, 1, -1}, {-1, 0, -1},
+      // front slice (diagonal, non-diagonal)
+      {-1, -1, 1}, {1, -1, 1}, {-1, 1, 1}, {1, 1, 1}, {0, -1, 1}, {1, 0, 1}, {0, 1, 1}, {-1, 0, 1}};
+
+    const unsigned int dim = InputImageType::ImageDimension;
+    if (dim == 2 || dim == 3)
+    {
+      const unsigned int numberOfNeighbors = dim == 2 ? 8 : 26;
+      for (unsigned int i = 0; i < numberOfNeighbors; ++i)
+      {
+        OffsetType offset;
+        for (unsigned int d = 0; d < dim; ++d)
+          offset[d] = dim == 2 ? neighbors2D[i][d] : neighbors3D[i][d];
+        m_NeighborOffsets.push_back(offset);
+      }
+    }
+
     if (m_MakeOutputImage)
     {
       this->SetNumberOfRequiredOutputs(1);
@@ -50,7 +78,6 @@ namespace itk
   template <class TInputImageType, class TOutputImageType>
   ShortestPathImageFilter<TInputImageType, TOutputImageType>::~ShortestPathImageFilter()
   {
-    delete[] m_Nodes;
   }
 
   template <class TInputImageType, class TOutputImageType>
@@ -140,235 +167,107 @@ namespace itk
   }
 
   template <class TInputImageType, class TOutputImageType>
-  inline std::vector<ShortestPathNode *> ShortestPathImageFilter<TInputImageType, TOutputImageType>::GetNeighbors(
-    unsigned int nodeNum, bool FullNeighbors)
+  inline void ShortestPathImageFilter<TInputImageType, TOutputImageType>::GetNeighbors(
+    NodeNumType nodeNum, bool FullNeighbors, std::vector<ShortestPathNode *> &neighbors)
   {
-    // returns a vector of nodepointers.. these nodes are the neighbors
-    int dim = InputImageType::ImageDimension;
+    // fills the given vector with nodepointers.. these nodes are the neighbors. The vector is reused for every node,
+    // so that no memory is allocated during the search.
     IndexType Coord = NodeToCoord(nodeNum);
-    IndexType NeighborCoord;
-    std::vector<ShortestPathNode *> nodeList;
-
-    int neighborDistance = 1; // if i increase that, i might not hit the endnote
+    neighbors.clear();
 
-    // maybe use itkNeighborhoodIterator here, might be faster
+    std::size_t numberOfNeighbors = FullNeighbors ? m_NeighborOffsets.size() : 2 * InputImageType::ImageDimension;
+    numberOfNeighbors = std::min(numberOfNeighbors, m_NeighborOffsets.size());
 
-    if (dim == 2)
+    for (std::size_t i = 0; i < numberOfNeighbors; ++i)
     {
-      // N4
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1] - neighborDistance;
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      NeighborCoord[0] = Coord[0] + neighborDistance;
-      NeighborCoord[1] = Coord[1];
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1] + neighborDistance;
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      NeighborCoord[0] = Coord[0] - neighborDistance;
-      NeighborCoord[1] = Coord[1];
+      IndexType NeighborCoord = Coord + m_NeighborOffsets[i];
       if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      if (FullNeighbors)
-      {
-        // N8
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-      }
+        neighbors.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
     }
-    if (dim == 3)
+  }
+
+  template <class TInputImageType, class TOutputImageType>
+  inline void ShortestPathImageFilter<TInputImageType, TOutputImageType>::SiftUp(NodeNumType heapIndex)
+  {
+    ShortestPathNode *node = m_DiscoveredNodes[heapIndex];
+    while (heapIndex > 0)
     {
-      // N6
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1] - neighborDistance;
-      NeighborCoord[2] = Coord[2];
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+      NodeNumType parentIndex = (heapIndex - 1) / 2;
+      ShortestPathNode *parent = m_DiscoveredNodes[parentIndex];
+      if (!(node->distAndEst < parent->distAndEst))
+        break;
+
+      m_DiscoveredNodes[heapIndex] = parent;
+      parent->heapIndex = heapIndex;
+      heapIndex = parentIndex;
+    }
+    m_DiscoveredNodes[heapIndex] = node;
+    node->heapIndex = heapIndex;
+  }
 
-      NeighborCoord[0] = Coord[0] + neighborDistance;
-      NeighborCoord[1] = Coord[1];
-      NeighborCoord[2] = Coord[2];
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+  template <class TInputImageType, class TOutputImageType>
+  inline void ShortestPathImageFilter<TInputImageType, TOutputImageType>::SiftDown(NodeNumType heapIndex)
+  {
+    const auto heapSize = static_cast<NodeNumType>(m_DiscoveredNodes.size());
+    ShortestPathNode *node = m_DiscoveredNodes[heapIndex];
+    while (true)
+    {
+      NodeNumType childIndex = 2 * heapIndex + 1;
+      if (childIndex >= heapSize)
+        break;
+
+      // pick the smaller child
+      if (childIndex + 1 < heapSize &&
+          m_DiscoveredNodes[childIndex + 1]->distAndEst < m_DiscoveredNodes[childIndex]->distAndEst)
+        ++childIndex;
+
+      ShortestPathNode *child = m_DiscoveredNodes[childIndex];
+      if (!(child->distAndEst < node->distAndEst))
+        break;
+
+      m_DiscoveredNodes[heapIndex] = child;
+      child->heapIndex = heapIndex;
+      heapIndex = childIndex;
+    }
+    m_DiscoveredNodes[heapIndex] = node;
+    node->heapIndex = heapIndex;
+  }
 
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1] + neighborDistance;
-      NeighborCoord[2] = Coord[2];
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+  template <class TInputImageType, class TOutputImageType>
+  inline void ShortestPathImageFilter<TInputImageType, TOutputImageType>::PushDiscoveredNode(ShortestPathNode *node)
+  {
+    m_DiscoveredNodes.push_back(node);
+    SiftUp(static_cast<NodeNumType>(m_DiscoveredNodes.size() - 1));
+  }
 
-      NeighborCoord[0] = Coord[0] - neighborDistance;
-      NeighborCoord[1] = Coord[1];
-      NeighborCoord[2] = Coord[2];
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+  template <class TInputImageType, class TOutputImageType>
+  inline ShortestPathNode *ShortestPathImageFilter<TInputImageType, TOutputImageType>::PopDiscoveredNode()
+  {
+    ShortestPathNode *top = m_DiscoveredNodes.front();
+    ShortestPathNode *last = m_DiscoveredNodes.back();
+    m_DiscoveredNodes.pop_back();
 
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1];
-      NeighborCoord[2] = Coord[2] + neighborDistance;
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+    if (!m_DiscoveredNodes.empty())
+    {
+      m_DiscoveredNodes[0] = last;
+      SiftDown(0);
+    }
+    return top;
+  }
 
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1];
-      NeighborCoord[2] = Coord[2] - neighborDistance;
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+  template <class TInputImageType, class TOutputImageType>
+  inline void ShortestPathImageFilter<TInputImageType, TOutputImageType>::DecreaseDiscoveredNode(
+    ShortestPathNode *node)
+  {
+    SiftUp(node->heapIndex);
+  }
 
-      if (FullNeighbors)
-      {
-        // N26
-        // Middle Slice
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2];
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2];
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2];
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2];
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        // BackSlice (Diagonal)
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        // BackSlice (Non-Diag)
-        NeighborCoord[0] = Coord[0];
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1];
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0];
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1];
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        // FrontSlice (Diagonal)
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        // FrontSlice(Non-Diag)
-        NeighborCoord[0] = Coord[0];
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1];
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0];
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1];
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-      }
-    }
-    return nodeList;
+  template <class TInputImageType, class TOutputImageType>
+  void ShortestPathImageFilter<TInputImageType, TOutputImageType>::RebuildDiscoveredNodes()
+  {
+    const auto heapSize = static_cast<NodeNumType>(m_DiscoveredNodes.size());
+    for (NodeNumType i = heapSize / 2; i > 0; --i)
+      SiftDown(i - 1);
   }
 
   template <class TInputImageType, class TOutputImageType>
@@ -379,10 +278,15 @@ namespace itk
     {
       m_StartIndex[i] = StartIndex[i];
     }
-    m_Graph_StartNode = CoordToNode(m_StartIndex);
+    NodeNumType startNode = CoordToNode(m_StartIndex);
     // MITK_INFO << "StartIndex = " << StartIndex;
-    // MITK_INFO << "StartNode = " << m_Graph_StartNode;
-    m_Initialized = false;
+    // MITK_INFO << "StartNode = " << startNode;
+    if (!m_Initialized || startNode != m_Graph_StartNode)
+    {
+      m_Graph_StartNode = startNode;
+      m_Initialized = false;
+    }
+    this->Modified();
   }
 
   template <class TInputImageType, class TOutputImageType>
@@ -395,6 +299,7 @@ namespace itk
     }
     m_Graph_EndNode = CoordToNode(m_EndIndex);
     // MITK_INFO << "EndNode = " << m_Graph_EndNode;
+    this->Modified();
   }
 
   template <class TInputImageType, class TOutputImageType>
@@ -417,10 +322,9 @@ namespace itk
     const typename TInputImageType::IndexType &a)
   {
     // Returns the minimal possible costs for a path from "a" to targetnode.
-    itk::Vector<float, 3> v;
-    v[0] = m_EndIndex[0] - a[0];
-    v[1] = m_EndIndex[1] - a[1];
-    v[2] = m_EndIndex[2] - a[2];
+    itk::Vector<float, TInputImageType::ImageDimension> v;
+    for (unsigned int i = 0; i < TInputImageType::ImageDimension; ++i)
+      v[i] = m_EndIndex[i] - a[i];
 
     return m_CostFunction->GetMinCost() * v.GetNorm();
   }
@@ -428,20 +332,40 @@ namespace itk
   template <class TInputImageType, class TOutputImageType>
   void ShortestPathImageFilter<TInputImageType, TOutputImageType>::InitGraph()
   {
-    if (!m_Initialized)
+    // initalize cost function
+    m_CostFunction->Initialize();
+
+    // Calc Number of nodes
+    auto imageDimensions = TInputImageType::ImageDimension;
+    const InputImageSizeType &size = this->GetInput()->GetRequestedRegion().GetSize();
+    NodeNumType numberOfNodes = 1;
+    for (NodeNumType i = 0; i < imageDimensions; ++i)
+      numberOfNodes = numberOfNodes * size[i];
+
+    // The search tree of the last update stays valid as long as the graph and its costs are the same
+    if (!m_ReuseSearchTree || multipleEndPoints || m_CalcAllDistances || numberOfNodes != m_Graph_NumberOfNodes ||
+        m_CostFunction->GetMTime() != m_SearchTreeCostFunctionMTime ||
+        this->GetInput()->GetMTime() != m_SearchTreeInputMTime)
     {
-      // Clean up previous stuff
-      CleanUp();
+      m_Initialized = false;
+    }
 
-      // Calc Number of nodes
-      auto imageDimensions = TInputImageType::ImageDimension;
-      const InputImageSizeType &size = this->GetInput()->GetRequestedRegion().GetSize();
-      m_Graph_NumberOfNodes = 1;
-      for (NodeNumType i = 0; i < imageDimensions; ++i)
-        m_Graph_NumberOfNodes = m_Graph_NumberOfNodes * size[i];
+    if (!m_Initialized)
+    {
+      if (numberOfNodes != m_Graph_NumberOfNodes)
+      {
+        // Clean up previous stuff
+        CleanUp();
 
-      // Initialize mainNodeList with that number
-      m_Nodes = new ShortestPathNode[m_Graph_NumberOfNodes];
+        // Initialize mainNodeList with that number
+        m_Graph_NumberOfNodes = numberOfNodes;
+        m_Nodes.resize(m_Graph_NumberOfNodes);
+      }
+      else
+      {
+        m_VectorOrder.clear();
+        m_VectorPath.clear();
+      }
 
       // Initialize each node in nodelist
       for (NodeNumType i = 0; i < m_Graph_NumberOfNodes; i++)
@@ -453,15 +377,30 @@ namespace itk
         m_Nodes[i].closed = false;
       }
 
+      // The node numbers depend on the size of the input
+      m_Graph_StartNode = CoordToNode(m_StartIndex);
+      m_Graph_EndNode = CoordToNode(m_EndIndex);
+
+      // In the beginning, the Startnode needs a distance of 0 and is the only discovered node
+      m_Nodes[m_Graph_StartNode].distance = 0;
+      m_Nodes[m_Graph_StartNode].distAndEst = 0;
+
+      m_DiscoveredNodes.clear();
+      PushDiscoveredNode(&m_Nodes[m_Graph_StartNode]);
+
+      m_SearchTreeCostFunctionMTime = m_CostFunction->GetMTime();
+      m_SearchTreeInputMTime = this->GetInput()->GetMTime();
       m_Initialized = true;
     }
+    else if (!m_Nodes[m_Graph_EndNode].closed && m_CostFunction->GetMinCost() > 0.0)
+    {
+      // Continue the last search. The distances of the closed nodes are final and the discovered nodes keep their
+      // distances, only their estimates refer to the previous end point.
+      for (ShortestPathNode *node : m_DiscoveredNodes)
+        node->distAndEst = node->distance + getEstimatedCostsToTarget(NodeToCoord(node->mainListIndex));
 
-    // In the beginning, the Startnode needs a distance of 0
-    m_Nodes[m_Graph_StartNode].distance = 0;
-    m_Nodes[m_Graph_StartNode].distAndEst = 0;
-
-    // initalize cost function
-    m_CostFunction->Initialize();
+      RebuildDiscoveredNodes();
+    }
   }
 
   template <class TInputImageType, class TOutputImageType>
@@ -478,43 +417,22 @@ namespace itk
     DistanceType curNodeDistance = 0;
     NodeNumType numberOfNodesChecked = 0;
 
-    // Create Multimap (tree structure for fast searching)
-    std::multimap<double, ShortestPathNode *> myMap;
-    std::pair<std::multimap<double, ShortestPathNode *>::iterator, std::multimap<double, ShortestPathNode *>::iterator>
-      ret;
-    std::multimap<double, ShortestPathNode *>::iterator it;
-
-    // At first, only startNote is discovered.
-    myMap.insert(
-      std::pair<double, ShortestPathNode *>(m_Nodes[m_Graph_StartNode].distAndEst, &m_Nodes[m_Graph_StartNode]));
+    // The end node might have been closed by the search of a previous update already
+    if (!multipleEndPoints && !m_CalcAllDistances && m_Nodes[m_Graph_EndNode].closed)
+      return;
 
     // While there are discovered Nodes, pick the one with lowest distance,
     // update its neighbors and eventually delete it from the discovered Nodes list.
-    while (!myMap.empty())
+    // At first, only startNote is discovered (see InitGraph).
+    while (!m_DiscoveredNodes.empty())
     {
       numberOfNodesChecked++;
-      /*if ( (numberOfNodesChecked % (m_Graph_NumberOfNodes/100)) == 0)
-      {
-        MITK_INFO << "Checked " << ( numberOfNodesChecked / (m_Graph_NumberOfNodes/100) ) << "% List: " << myMap.size()
-      << "\n";
-      }*/
-
-      // Get element with lowest score
-      mainNodeListIndex = myMap.begin()->second->mainListIndex;
-      curNodeDistance = myMap.begin()->second->distance;
-      myMap.begin()->second->closed = true; // close it
-
-      // Debug:
-      // MITK_INFO << "INFO: size " << myMap.size();
-      /*
-      for (it = myMap.begin(); it != myMap.end(); ++it)
-      {
-      MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-      }
-      */
 
-      // Kicks out element with lowest score
-      myMap.erase(myMap.begin());
+      // Get element with lowest score and kick it out of the heap
+      ShortestPathNode *curNode = PopDiscoveredNode();
+      mainNodeListIndex = curNode->mainListIndex;
+      curNodeDistance = curNode->distance;
+      curNode->closed = true; // close it
 
       // if wanted, store vector order
       if (m_StoreVectorOrder)
@@ -523,138 +441,34 @@ namespace itk
       }
 
       // Check neighbors
-      std::vector<ShortestPathNode *> neighborNodes = GetNeighbors(mainNodeListIndex, m_Graph_fullNeighbors);
-      for (NodeNumType i = 0; i < neighborNodes.size(); i++)
+      IndexType coordCurNode = NodeToCoord(mainNodeListIndex);
+      GetNeighbors(mainNodeListIndex, m_Graph_fullNeighbors, m_Neighbors);
+      for (ShortestPathNode *neighborNode : m_Neighbors)
       {
-        if (neighborNodes[i]->closed)
+        if (neighborNode->closed)
           continue; // this nodes is already closed, go to next neighbor
 
-        IndexType coordCurNode = NodeToCoord(mainNodeListIndex);
-        IndexType coordNeighborNode = NodeToCoord(neighborNodes[i]->mainListIndex);
+        IndexType coordNeighborNode = NodeToCoord(neighborNode->mainListIndex);
 
         // calculate the new Distance to the current neighbor
         double newDistance = curNodeDistance + (m_CostFunction->GetCost(coordCurNode, coordNeighborNode));
 
-        // if it is shorter than any yet known path to this neighbor, than the current path is better. Save that!
-        if ((newDistance < neighborNodes[i]->distance) || (neighborNodes[i]->distance == -1))
+        // if that neighbornode is not in discoverednodeList yet, Push it there and update
+        if (neighborNode->distance == -1)
         {
-          // if that neighbornode is not in discoverednodeList yet, Push it there and update
-          if (neighborNodes[i]->distance == -1)
-          {
-            neighborNodes[i]->distance = newDistance;
-            neighborNodes[i]->distAndEst = newDistance + getEstimatedCostsToTarget(coordNeighborNode);
-            neighborNodes[i]->prevNode = mainNodeListIndex;
-            myMap.insert(std::pair<double, ShortestPathNode *>(m_Nodes[neighborNodes[i]->mainListIndex].distAndEst,
-                                                               &m_Nodes[neighborNodes[i]->mainListIndex]));
-            /*
-            MITK_INFO << "Inserted: " << m_Nodes[neighborNodes[i]->mainListIndex].distAndEst << "|" <<
-            m_Nodes[neighborNodes[i]->mainListIndex].mainListIndex;
-            MITK_INFO << "INFO: size " << myMap.size();
-            for (it = myMap.begin(); it != myMap.end(); ++it)
-            {
-            MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-            }
-            */
-          }
-          // or if is already in discoverednodelist, update
-          else
-          {
-            /*
-            it = myMap.find(neighborNodes[i]->distAndEst);
-            if (it == myMap.end() )
-            {
-            MITK_INFO << "Nothing!";
-            // look further
-            for (it = myMap.begin(); it != myMap.end(); ++it)
-            {
-            if ((*it).second->mainListIndex == lookForId)
-            {
-            MITK_INFO << "But it is there!!!";
-            MITK_INFO << "Searched for: " << lookFor << "   but had: " << (*it).second->distAndEst;
-            }
-
-            }
-            }
-            */
-
-            // 1st : find and delete old element
-            bool found = false;
-            ret = myMap.equal_range(neighborNodes[i]->distAndEst);
-
-            if ((ret.first == ret.second))
-            {
-              /*+++++++++++++ no exact match +++++++++++++*/
-              // MITK_INFO << "No exact match!"; // if this happens, you are screwed
-              /*
-              MITK_INFO << "Was looking for: " << lookFor << "  ID: " << lookForId;
-              if (ret.first != myMap.end() )
-              {
-              it = ret.first;
-              MITK_INFO << "Found: " << it->first << "  ID: " << it->second->mainListIndex;
-              ++it;
-              MITK_INFO << "Found: " << it->first << "  ID: " << it->second->mainListIndex;
-              --it;
-              --it;
-              MITK_INFO << "Found: " << it->first << "  ID: " << it->second->mainListIndex;
-              }
-
-              // look if that ID is found in the map
-              for (it = myMap.begin(); it != myMap.end(); ++it)
-              {
-              if ((*it).second->mainListIndex == lookForId)
-              {
-              MITK_INFO << "But it is there!!!";
-              MITK_INFO << "Searched dist: " << lookFor << "  found dist: " << (*it).second->distAndEst;
-              }
-
-              }
-              */
-            }
-            else
-            {
-              for (it = ret.first; it != ret.second; ++it)
-              {
-                if (it->second->mainListIndex == neighborNodes[i]->mainListIndex)
-                {
-                  found = true;
-                  myMap.erase(it);
-                  /*
-                  MITK_INFO << "INFO: size " << myMap.size();
-                  MITK_INFO << "Erase: " << it->first << "|" << it->second->mainListIndex;
-
-                  MITK_INFO << "INFO: size " << myMap.size();
-                  for (it = myMap.begin(); it != myMap.end(); ++it)
-                  {
-                  MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-                  }
-                  */
-                  break;
-                }
-              }
-            }
-
-            if (!found)
-            {
-              // MITK_INFO << "Could not find it! :(";
-              continue;
-            }
-
-            // 2nd: update and insert new element
-            neighborNodes[i]->distance = newDistance;
-            neighborNodes[i]->distAndEst = newDistance + getEstimatedCostsToTarget(coordNeighborNode);
-            neighborNodes[i]->prevNode = mainNodeListIndex;
-            // myMap.insert( std::pair<double,ShortestPathNode*> (neighborNodes[i]->distAndEst, neighborNodes[i]));
-            myMap.insert(std::pair<double, ShortestPathNode *>(m_Nodes[neighborNodes[i]->mainListIndex].distAndEst,
-                                                               &m_Nodes[neighborNodes[i]->mainListIndex]));
-
-            // MITK_INFO << "Re-Inserted: " << m_Nodes[neighborNodes[i]->mainListIndex].distAndEst << "|" <<
-            // m_Nodes[neighborNodes[i]->mainListIndex].mainListIndex;
-            // MITK_INFO << "INFO: size " << myMap.size();
-            /*for (it = myMap.begin(); it != myMap.end(); ++it)
-            {
-            MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-            }*/
-          }
+          neighborNode->distance = newDistance;
+          neighborNode->distAndEst = newDistance + getEstimatedCostsToTarget(coordNeighborNode);
+          neighborNode->prevNode = mainNodeListIndex;
+          PushDiscoveredNode(neighborNode);
+        }
+        // or if it is already discovered and the current path is shorter than any yet known path, update it
+        else if (newDistance < neighborNode->distance)
+        {
+          // the estimate does not change, so the key only decreases
+          neighborNode->distance = newDistance;
+          neighborNode->distAndEst = newDistance + getEstimatedCostsToTarget(coordNeighborNode);
+          neighborNode->prevNode = mainNodeListIndex;
+          DecreaseDiscoveredNode(neighborNode);
         }
       }
       // finished with checking all neighbors.
@@ -689,8 +503,9 @@ namespace itk
             }
             if (m_Graph_EndNode == mainNodeListIndex)
             {
-              // set new end
-              SetEndIndex(m_endPoints[0]);
+              // set new end, without modifying the filter while it is running
+              m_EndIndex = m_endPoints[0];
+              m_Graph_EndNode = CoordToNode(m_EndIndex);
             }
           }
         }
@@ -814,6 +629,7 @@ namespace itk
     // MITK_INFO << "Make ShortestPath Vec";
     if (m_useCostFunction == false)
     {
+      m_VectorPath.clear();
       m_VectorPath.push_back(NodeToCoord(m_Graph_StartNode));
       m_VectorPath.push_back(NodeToCoord(m_Graph_EndNode));
       return;
@@ -866,18 +682,23 @@ namespace itk
     m_VectorPath.clear();
     // TODO: if multiple Path, clear all multiple Paths
 
-    if (m_Nodes)
-      delete[] m_Nodes;
+    std::vector<ShortestPathNode>().swap(m_Nodes);
+    m_Graph_NumberOfNodes = 0;
+    m_DiscoveredNodes.clear();
+    m_Initialized = false;
   }
 
   template <class TInputImageType, class TOutputImageType>
   void ShortestPathImageFilter<TInputImageType, TOutputImageType>::GenerateData()
   {
-    // Build Graph
-    InitGraph();
+    if (m_useCostFunction)
+    {
+      // Build Graph
+      InitGraph();
 
-    // Calc Shortest Parth
-    StartShortestPathSearch();
+      // Calc Shortest Parth
+      StartShortestPathSearch();
+    }
 
     // Fill Shortest Path
     MakeShortestPathVector();
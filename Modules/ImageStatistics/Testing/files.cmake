@@ -5,6 +5,7 @@ set(MODULE_TESTS
   mitkImageStatisticsTextureAnalysisTest.cpp
   mitkImageStatisticsContainerTest.cpp
   mitkImageStatisticsContainerManagerTest.cpp
+  mitkIntensityProfileTest.cpp
 )
 
 set(MODULE_CUSTOM_TESTS
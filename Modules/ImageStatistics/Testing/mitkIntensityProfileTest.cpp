@@ -0,0 +1,179 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+// Testing
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+//MITK includes
+#include "mitkIntensityProfile.h"
+#include "mitkImageCast.h"
+#include "mitkImagePixelWriteAccessor.h"
+#include "mitkImageTimeSelector.h"
+#include "mitkPlaneGeometry.h"
+
+//ITK includes
+#include <itkLinearInterpolateImageFunction.h>
+#include <itkNearestNeighborInterpolateImageFunction.h>
+#include <itkWindowedSincInterpolateImageFunction.h>
+
+/**
+ * \brief Test class for the batched intensity profile sampling in mitkIntensityProfile
+ *
+ * The batched samplers are compared against a point by point evaluation of the respective
+ * ITK interpolate image functions for every time step of a dynamic image.
+ */
+class mitkIntensityProfileTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkIntensityProfileTestSuite);
+  MITK_TEST(ComputeIntensityProfiles_NearestNeighbor_EqualsITKInterpolation);
+  MITK_TEST(ComputeIntensityProfiles_Linear_EqualsITKInterpolation);
+  MITK_TEST(ComputeIntensityProfiles_WindowedSinc_EqualsITKInterpolation);
+  MITK_TEST(ComputeIntensityProfiles_PlanarFigure_EqualsProfilesOfTimeSteps);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<short, 3> VolumeType;
+
+  mitk::Image::Pointer m_Image;
+
+  static mitk::Image::Pointer CreateDynamicImage()
+  {
+    unsigned int dimensions[4] = { 11, 9, 7, 5 };
+
+    mitk::Image::Pointer image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 4, dimensions);
+
+    mitk::ImagePixelWriteAccessor<short, 4> writeAccess(image);
+    itk::Index<4> index;
+    itk::Index<4> end;
+
+    for (unsigned int d = 0; d < 4; ++d)
+      end[d] = dimensions[d];
+
+    for (index[3] = 0; index[3] < end[3]; ++index[3])
+      for (index[2] = 0; index[2] < end[2]; ++index[2])
+        for (index[1] = 0; index[1] < end[1]; ++index[1])
+          for (index[0] = 0; index[0] < end[0]; ++index[0])
+            writeAccess.SetPixelByIndex(index, static_cast<short>((index[0] * 7 + index[1] * 13 + index[2] * 29) % 101 - 50 + index[3] * 3));
+
+    return image;
+  }
+
+  static mitk::Image::Pointer GetTimeStep(mitk::Image::Pointer image, unsigned int timeStep)
+  {
+    mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
+    timeSelector->SetInput(image);
+    timeSelector->SetTimeNr(timeStep);
+    timeSelector->UpdateLargestPossibleRegion();
+
+    return timeSelector->GetOutput();
+  }
+
+  static VolumeType::Pointer GetVolume(mitk::Image::Pointer image, unsigned int timeStep)
+  {
+    VolumeType::Pointer volume;
+    mitk::CastToItkImage(GetTimeStep(image, timeStep), volume);
+    return volume;
+  }
+
+  void TestProfiles(itk::InterpolateImageFunction<VolumeType>::Pointer interpolateImageFunction, mitk::InterpolateImageFunction::Enum interpolator)
+  {
+    mitk::Point3D startPoint;
+    mitk::Point3D endPoint;
+    mitk::FillVector3D(startPoint, 0.3, 0.0, 0.8);
+    mitk::FillVector3D(endPoint, 10.0, 7.6, 6.0);
+
+    const unsigned int numSamples = 37;
+
+    std::vector<mitk::IntensityProfile::Pointer> profiles = mitk::ComputeIntensityProfiles(m_Image, startPoint, endPoint, numSamples, interpolator);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("One profile per time step", static_cast<std::size_t>(m_Image->GetDimension(3)), profiles.size());
+
+    for (unsigned int t = 0; t < profiles.size(); ++t)
+    {
+      CPPUNIT_ASSERT_EQUAL(static_cast<itk::SizeValueType>(numSamples), static_cast<itk::SizeValueType>(profiles[t]->Size()));
+
+      interpolateImageFunction->SetInputImage(GetVolume(m_Image, t));
+
+      for (unsigned int i = 0; i < numSamples; ++i)
+      {
+        const double input = static_cast<double>(i) / (numSamples - 1);
+        itk::ContinuousIndex<double, 3> sampleIndex;
+
+        for (unsigned int d = 0; d < 3; ++d)
+          sampleIndex[d] = startPoint[d] + (endPoint[d] - startPoint[d]) * input;
+
+        const double expected = interpolateImageFunction->EvaluateAtContinuousIndex(sampleIndex);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, profiles[t]->GetMeasurementVector(i)[0], 1e-9);
+      }
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = CreateDynamicImage();
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+  }
+
+  void ComputeIntensityProfiles_NearestNeighbor_EqualsITKInterpolation()
+  {
+    this->TestProfiles(itk::NearestNeighborInterpolateImageFunction<VolumeType>::New().GetPointer(), mitk::InterpolateImageFunction::NearestNeighbor);
+  }
+
+  void ComputeIntensityProfiles_Linear_EqualsITKInterpolation()
+  {
+    this->TestProfiles(itk::LinearInterpolateImageFunction<VolumeType>::New().GetPointer(), mitk::InterpolateImageFunction::Linear);
+  }
+
+  void ComputeIntensityProfiles_WindowedSinc_EqualsITKInterpolation()
+  {
+    this->TestProfiles(itk::WindowedSincInterpolateImageFunction<VolumeType, 3, itk::Function::LanczosWindowFunction<3> >::New().GetPointer(), mitk::InterpolateImageFunction::WindowedSinc_Lanczos_3);
+  }
+
+  void ComputeIntensityProfiles_PlanarFigure_EqualsProfilesOfTimeSteps()
+  {
+    mitk::PlaneGeometry::Pointer planeGeometry = mitk::PlaneGeometry::New();
+    planeGeometry->InitializeStandardPlane(m_Image->GetGeometry(), mitk::PlaneGeometry::Axial, 3);
+
+    mitk::Point2D startPoint;
+    mitk::Point2D endPoint;
+    startPoint[0] = 1.2;
+    startPoint[1] = 0.7;
+    endPoint[0] = 9.6;
+    endPoint[1] = 7.3;
+
+    mitk::PlanarLine::Pointer planarLine = mitk::PlanarLine::New();
+    planarLine->SetPlaneGeometry(planeGeometry);
+    planarLine->PlaceFigure(startPoint);
+    planarLine->SetCurrentControlPoint(endPoint);
+
+    std::vector<mitk::IntensityProfile::Pointer> profiles = mitk::ComputeIntensityProfiles(m_Image, planarLine.GetPointer());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("One profile per time step", static_cast<std::size_t>(m_Image->GetDimension(3)), profiles.size());
+
+    for (unsigned int t = 0; t < profiles.size(); ++t)
+    {
+      // Reference: the single profile of the extracted time step, as previously computed by the image statistics view
+      mitk::IntensityProfile::Pointer expectedProfile = mitk::ComputeIntensityProfile(GetTimeStep(m_Image, t), planarLine.GetPointer());
+      CPPUNIT_ASSERT(expectedProfile->Size() > 1);
+      CPPUNIT_ASSERT_EQUAL(static_cast<itk::SizeValueType>(expectedProfile->Size()), static_cast<itk::SizeValueType>(profiles[t]->Size()));
+
+      for (mitk::IntensityProfile::InstanceIdentifier i = 0; i < expectedProfile->Size(); ++i)
+        CPPUNIT_ASSERT_EQUAL(expectedProfile->GetMeasurementVector(i)[0], profiles[t]->GetMeasurementVector(i)[0]);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkIntensityProfile)
@@ -14,6 +14,8 @@ found in the LICENSE file.
 #include <itkNearestNeighborInterpolateImageFunction.h>
 #include <itkPolyLineParametricPath.h>
 #include <itkWindowedSincInterpolateImageFunction.h>
+#include <itkMath.h>
+#include <algorithm>
 #include <mitkImageAccessByItk.h>
 #include <mitkImagePixelReadAccessor.h>
 #include <mitkPixelTypeMultiplex.h>
@@ -78,6 +80,90 @@ static IntensityProfile::Pointer ComputeIntensityProfile(Image::Pointer image, i
   return intensityProfile;
 }
 
+/** Reads the pixels at the given spatial indices from every time step of an image. The buffer offsets are
+  * computed only once and are then applied to every volume of the image buffer. */
+template <class TPixel, unsigned int VImageDimension>
+static void ReadPixelsOfAllTimeSteps(itk::Image<TPixel, VImageDimension>* image, const std::vector<itk::Index<3>>& indices, std::vector<IntensityProfile::Pointer>& intensityProfiles)
+{
+  const unsigned int spatialDimension = std::min(VImageDimension, 3u);
+  const auto bufferedRegionSize = image->GetBufferedRegion().GetSize();
+
+  std::vector<itk::OffsetValueType> offsets;
+  offsets.reserve(indices.size());
+
+  itk::OffsetValueType volumeSize = 1;
+  for (unsigned int d = 0; d < spatialDimension; ++d)
+    volumeSize *= static_cast<itk::OffsetValueType>(bufferedRegionSize[d]);
+
+  for (const auto& index : indices)
+  {
+    itk::OffsetValueType offset = 0;
+    itk::OffsetValueType stride = 1;
+
+    for (unsigned int d = 0; d < spatialDimension; ++d)
+    {
+      const auto maxIndex = static_cast<itk::OffsetValueType>(bufferedRegionSize[d]) - 1;
+      offset += std::max(itk::OffsetValueType(0), std::min(maxIndex, static_cast<itk::OffsetValueType>(index[d]))) * stride;
+      stride *= static_cast<itk::OffsetValueType>(bufferedRegionSize[d]);
+    }
+
+    offsets.push_back(offset);
+  }
+
+  const itk::SizeValueType numTimeSteps = VImageDimension > 3 ? bufferedRegionSize[VImageDimension - 1] : 1;
+  const TPixel* buffer = image->GetBufferPointer();
+
+  intensityProfiles.reserve(numTimeSteps);
+
+  for (itk::SizeValueType t = 0; t < numTimeSteps; ++t)
+  {
+    IntensityProfile::Pointer intensityProfile = IntensityProfile::New();
+    IntensityProfile::MeasurementVectorType measurementVector;
+
+    for (const auto offset : offsets)
+    {
+      measurementVector[0] = static_cast<IntensityProfile::MeasurementType>(buffer[t * volumeSize + offset]);
+      intensityProfile->PushBack(measurementVector);
+    }
+
+    intensityProfiles.push_back(intensityProfile);
+  }
+}
+
+static std::vector<IntensityProfile::Pointer> ComputeIntensityProfiles(Image::Pointer image, itk::PolyLineParametricPath<3>::Pointer path)
+{
+  itk::PolyLineParametricPath<3>::InputType input = path->StartOfInput();
+  BaseGeometry* imageGeometry = image->GetGeometry();
+
+  itk::PolyLineParametricPath<3>::OffsetType offset;
+  Point3D worldPoint;
+  itk::Index<3> index;
+  std::vector<itk::Index<3>> indices;
+
+  // Same pixels as in ComputeIntensityProfile(image, path), but determined only once for all time steps
+  do
+  {
+    imageGeometry->IndexToWorld(path->Evaluate(input), worldPoint);
+    imageGeometry->WorldToIndex(worldPoint, index);
+    indices.push_back(index);
+
+    offset = path->IncrementInput(input);
+  } while ((offset[0] | offset[1] | offset[2]) != 0);
+
+  std::vector<IntensityProfile::Pointer> intensityProfiles;
+
+  if (image->GetDimension() == 4)
+  {
+    AccessFixedDimensionByItk_n(image, ReadPixelsOfAllTimeSteps, 4, (indices, intensityProfiles));
+  }
+  else
+  {
+    AccessByItk_n(image, ReadPixelsOfAllTimeSteps, (indices, intensityProfiles));
+  }
+
+  return intensityProfiles;
+}
+
 template <class TInputImage>
 static typename itk::InterpolateImageFunction<TInputImage>::Pointer CreateInterpolateImageFunction(InterpolateImageFunction::Enum interpolator)
 {
@@ -139,29 +225,226 @@ static typename itk::InterpolateImageFunction<TInputImage>::Pointer CreateInterp
   }
 }
 
-template <class TPixel, unsigned int VImageDimension>
-static void ComputeIntensityProfile(itk::Image<TPixel, VImageDimension>* image, itk::PolyLineParametricPath<3>::Pointer path, unsigned int numSamples, InterpolateImageFunction::Enum interpolator, IntensityProfile::Pointer intensityProfile)
-{
-  typename itk::InterpolateImageFunction<itk::Image<TPixel, VImageDimension> >::Pointer interpolateImageFunction = CreateInterpolateImageFunction<itk::Image<TPixel, VImageDimension> >(interpolator);
-  interpolateImageFunction->SetInputImage(image);
+typedef itk::PolyLineParametricPath<3>::ContinuousIndexType SampleIndexType;
+typedef std::vector<SampleIndexType> SampleIndexVectorType;
 
+/** Evaluates the path once for all samples, so that the continuous indices can be reused for each time step. */
+static SampleIndexVectorType ComputeSampleIndices(itk::PolyLineParametricPath<3>::Pointer path, unsigned int numSamples)
+{
   const itk::PolyLineParametricPath<3>::InputType startOfInput = path->StartOfInput();
   const itk::PolyLineParametricPath<3>::InputType delta = 1.0 / (numSamples - 1);
 
-  IntensityProfile::MeasurementVectorType measurementVector;
+  SampleIndexVectorType sampleIndices;
+  sampleIndices.reserve(numSamples);
 
   for (unsigned int i = 0; i < numSamples; ++i)
+    sampleIndices.push_back(path->Evaluate(startOfInput + i * delta));
+
+  return sampleIndices;
+}
+
+/** Batched nearest neighbor sampling of a single volume. The buffer offsets are precomputed by the caller,
+  * hence no virtual calls or index computations are necessary per sample. */
+template <class TPixel>
+static void SampleNearestNeighbor(const TPixel* buffer, const std::vector<itk::OffsetValueType>& offsets, IntensityProfile* intensityProfile)
+{
+  IntensityProfile::MeasurementVectorType measurementVector;
+
+  for (const auto offset : offsets)
+  {
+    measurementVector[0] = static_cast<IntensityProfile::MeasurementType>(buffer[offset]);
+    intensityProfile->PushBack(measurementVector);
+  }
+}
+
+/** Precomputed trilinear interpolation stencil of one sample. Neighbors beyond the buffer are clamped
+  * to the last voxel, which is equivalent to itk::LinearInterpolateImageFunction. */
+struct LinearSampleStencil
+{
+  itk::OffsetValueType offsets[8];
+  double weights[8];
+};
+
+static std::vector<LinearSampleStencil> ComputeLinearSampleStencils(const SampleIndexVectorType& sampleIndices, const itk::Size<3>& size)
+{
+  const itk::OffsetValueType strides[3] = { 1, static_cast<itk::OffsetValueType>(size[0]), static_cast<itk::OffsetValueType>(size[0] * size[1]) };
+
+  std::vector<LinearSampleStencil> stencils;
+  stencils.reserve(sampleIndices.size());
+
+  for (const auto& sampleIndex : sampleIndices)
+  {
+    itk::OffsetValueType lower[3];
+    itk::OffsetValueType upper[3];
+    double distance[3];
+
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      const auto maxIndex = static_cast<itk::OffsetValueType>(size[d]) - 1;
+      lower[d] = std::max(itk::OffsetValueType(0), std::min(maxIndex, itk::Math::Floor<itk::OffsetValueType>(sampleIndex[d])));
+      upper[d] = std::min(maxIndex, lower[d] + 1);
+      distance[d] = std::max(0.0, std::min(1.0, sampleIndex[d] - static_cast<double>(lower[d])));
+    }
+
+    LinearSampleStencil stencil;
+
+    for (unsigned int corner = 0; corner < 8; ++corner)
+    {
+      stencil.offsets[corner] = 0;
+      stencil.weights[corner] = 1.0;
+
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        const bool isUpper = (corner >> d) & 1;
+        stencil.offsets[corner] += (isUpper ? upper[d] : lower[d]) * strides[d];
+        stencil.weights[corner] *= isUpper ? distance[d] : 1.0 - distance[d];
+      }
+    }
+
+    stencils.push_back(stencil);
+  }
+
+  return stencils;
+}
+
+template <class TPixel>
+static void SampleLinear(const TPixel* buffer, const std::vector<LinearSampleStencil>& stencils, IntensityProfile* intensityProfile)
+{
+  IntensityProfile::MeasurementVectorType measurementVector;
+
+  for (const auto& stencil : stencils)
   {
-    measurementVector[0] = interpolateImageFunction->EvaluateAtContinuousIndex(path->Evaluate(startOfInput + i * delta));
+    double value = 0.0;
+
+    for (unsigned int corner = 0; corner < 8; ++corner)
+      value += stencil.weights[corner] * static_cast<double>(buffer[stencil.offsets[corner]]);
+
+    measurementVector[0] = value;
     intensityProfile->PushBack(measurementVector);
   }
 }
 
+/** Generic sampling of a single volume with an ITK interpolate image function (used for windowed sinc interpolation). */
+template <class TInputImage>
+static void SampleWithInterpolateImageFunction(const TInputImage* image, const SampleIndexVectorType& sampleIndices, InterpolateImageFunction::Enum interpolator, IntensityProfile* intensityProfile)
+{
+  typename itk::InterpolateImageFunction<TInputImage>::Pointer interpolateImageFunction = CreateInterpolateImageFunction<TInputImage>(interpolator);
+  interpolateImageFunction->SetInputImage(image);
+
+  IntensityProfile::MeasurementVectorType measurementVector;
+
+  for (const auto& sampleIndex : sampleIndices)
+  {
+    measurementVector[0] = interpolateImageFunction->EvaluateAtContinuousIndex(sampleIndex);
+    intensityProfile->PushBack(measurementVector);
+  }
+}
+
+/** Computes one intensity profile per time step of a three- or four-dimensional image. The sample positions and
+  * interpolation stencils are computed only once and are then applied to every volume of the image buffer. */
+template <class TPixel, unsigned int VImageDimension>
+static void ComputeIntensityProfiles(itk::Image<TPixel, VImageDimension>* image, const SampleIndexVectorType& sampleIndices, InterpolateImageFunction::Enum interpolator, std::vector<IntensityProfile::Pointer>& intensityProfiles)
+{
+  typedef itk::Image<TPixel, 3> VolumeType;
+
+  const auto bufferedRegionSize = image->GetBufferedRegion().GetSize();
+
+  itk::Size<3> size;
+  for (unsigned int d = 0; d < 3; ++d)
+    size[d] = bufferedRegionSize[d];
+
+  const itk::SizeValueType volumeSize = size[0] * size[1] * size[2];
+  const itk::SizeValueType numTimeSteps = VImageDimension > 3 ? bufferedRegionSize[VImageDimension - 1] : 1;
+
+  const TPixel* buffer = image->GetBufferPointer();
+
+  std::vector<itk::OffsetValueType> nearestNeighborOffsets;
+  std::vector<LinearSampleStencil> linearStencils;
+
+  if (interpolator == InterpolateImageFunction::NearestNeighbor)
+  {
+    nearestNeighborOffsets.reserve(sampleIndices.size());
+
+    for (const auto& sampleIndex : sampleIndices)
+    {
+      itk::OffsetValueType offset = 0;
+      itk::OffsetValueType stride = 1;
+
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        const auto maxIndex = static_cast<itk::OffsetValueType>(size[d]) - 1;
+        offset += std::max(itk::OffsetValueType(0), std::min(maxIndex, itk::Math::RoundHalfIntegerUp<itk::OffsetValueType>(sampleIndex[d]))) * stride;
+        stride *= static_cast<itk::OffsetValueType>(size[d]);
+      }
+
+      nearestNeighborOffsets.push_back(offset);
+    }
+  }
+  else if (interpolator == InterpolateImageFunction::Linear)
+  {
+    linearStencils = ComputeLinearSampleStencils(sampleIndices, size);
+  }
+
+  typename VolumeType::Pointer volume;
+
+  for (itk::SizeValueType t = 0; t < numTimeSteps; ++t)
+  {
+    const TPixel* volumeBuffer = buffer + t * volumeSize;
+
+    IntensityProfile::Pointer intensityProfile = IntensityProfile::New();
+
+    if (interpolator == InterpolateImageFunction::NearestNeighbor)
+    {
+      SampleNearestNeighbor(volumeBuffer, nearestNeighborOffsets, intensityProfile.GetPointer());
+    }
+    else if (interpolator == InterpolateImageFunction::Linear)
+    {
+      SampleLinear(volumeBuffer, linearStencils, intensityProfile.GetPointer());
+    }
+    else
+    {
+      // Wrap the volume of the current time step without copying its pixels
+      if (volume.IsNull())
+      {
+        volume = VolumeType::New();
+        volume->SetRegions(size);
+      }
+
+      volume->GetPixelContainer()->SetImportPointer(const_cast<TPixel*>(volumeBuffer), volumeSize, false);
+      SampleWithInterpolateImageFunction(volume.GetPointer(), sampleIndices, interpolator, intensityProfile.GetPointer());
+    }
+
+    intensityProfiles.push_back(intensityProfile);
+  }
+}
+
 static IntensityProfile::Pointer ComputeIntensityProfile(Image::Pointer image, itk::PolyLineParametricPath<3>::Pointer path, unsigned int numSamples, InterpolateImageFunction::Enum interpolator)
 {
-  IntensityProfile::Pointer intensityProfile = IntensityProfile::New();
-  AccessFixedDimensionByItk_n(image, ComputeIntensityProfile, 3, (path, numSamples, interpolator, intensityProfile));
-  return intensityProfile;
+  const SampleIndexVectorType sampleIndices = ComputeSampleIndices(path, numSamples);
+
+  std::vector<IntensityProfile::Pointer> intensityProfiles;
+  AccessFixedDimensionByItk_n(image, ComputeIntensityProfiles, 3, (sampleIndices, interpolator, intensityProfiles));
+
+  return intensityProfiles.front();
+}
+
+static std::vector<IntensityProfile::Pointer> ComputeIntensityProfiles(Image::Pointer image, itk::PolyLineParametricPath<3>::Pointer path, unsigned int numSamples, InterpolateImageFunction::Enum interpolator)
+{
+  const SampleIndexVectorType sampleIndices = ComputeSampleIndices(path, numSamples);
+
+  std::vector<IntensityProfile::Pointer> intensityProfiles;
+
+  if (image->GetDimension() == 4)
+  {
+    intensityProfiles.reserve(image->GetDimension(3));
+    AccessFixedDimensionByItk_n(image, ComputeIntensityProfiles, 4, (sampleIndices, interpolator, intensityProfiles));
+  }
+  else
+  {
+    AccessFixedDimensionByItk_n(image, ComputeIntensityProfiles, 3, (sampleIndices, interpolator, intensityProfiles));
+  }
+
+  return intensityProfiles;
 }
 
 class AddPolyLineElementToPath
@@ -229,6 +512,11 @@ IntensityProfile::Pointer mitk::ComputeIntensityProfile(Image::Pointer image, Pl
   return ::ComputeIntensityProfile(image, CreatePathFromPlanarFigure(image->GetGeometry(), planarFigure));
 }
 
+std::vector<IntensityProfile::Pointer> mitk::ComputeIntensityProfiles(Image::Pointer image, PlanarFigure::Pointer planarFigure)
+{
+  return ::ComputeIntensityProfiles(image, CreatePathFromPlanarFigure(image->GetGeometry(), planarFigure));
+}
+
 IntensityProfile::Pointer mitk::ComputeIntensityProfile(Image::Pointer image, PlanarLine::Pointer planarLine, unsigned int numSamples, InterpolateImageFunction::Enum interpolator)
 {
   return ::ComputeIntensityProfile(image, CreatePathFromPlanarFigure(image->GetGeometry(), planarLine.GetPointer()), numSamples, interpolator);
@@ -239,6 +527,16 @@ IntensityProfile::Pointer mitk::ComputeIntensityProfile(Image::Pointer image, co
   return ::ComputeIntensityProfile(image, CreatePathFromPoints(image->GetGeometry(), startPoint, endPoint), numSamples, interpolator);
 }
 
+std::vector<IntensityProfile::Pointer> mitk::ComputeIntensityProfiles(Image::Pointer image, PlanarLine::Pointer planarLine, unsigned int numSamples, InterpolateImageFunction::Enum interpolator)
+{
+  return ::ComputeIntensityProfiles(image, CreatePathFromPlanarFigure(image->GetGeometry(), planarLine.GetPointer()), numSamples, interpolator);
+}
+
+std::vector<IntensityProfile::Pointer> mitk::ComputeIntensityProfiles(Image::Pointer image, const Point3D& startPoint, const Point3D& endPoint, unsigned int numSamples, InterpolateImageFunction::Enum interpolator)
+{
+  return ::ComputeIntensityProfiles(image, CreatePathFromPoints(image->GetGeometry(), startPoint, endPoint), numSamples, interpolator);
+}
+
 IntensityProfile::InstanceIdentifier mitk::ComputeGlobalMaximum(IntensityProfile::ConstPointer intensityProfile, IntensityProfile::MeasurementType &max)
 {
   max = -vcl_numeric_limits<IntensityProfile::MeasurementType>::min();
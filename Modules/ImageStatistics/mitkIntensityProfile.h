@@ -32,6 +32,17 @@ namespace mitk
     */
   MITKIMAGESTATISTICS_EXPORT IntensityProfile::Pointer ComputeIntensityProfile(Image::Pointer image, PlanarFigure::Pointer planarFigure);
 
+  /** \brief Compute intensity profiles of all time steps of an image for each pixel along the first PolyLine of a given planar figure.
+    *
+    * The pixels along the PolyLine are determined once and read from every time step.
+    *
+    * \param[in] image A two-, three- or four-dimensional image which consists of single component pixels.
+    * \param[in] planarFigure A planar figure from which the first PolyLine is used to evaluate the intensity profiles.
+    *
+    * \return The computed intensity profiles (one per time step).
+    */
+  MITKIMAGESTATISTICS_EXPORT std::vector<IntensityProfile::Pointer> ComputeIntensityProfiles(Image::Pointer image, PlanarFigure::Pointer planarFigure);
+
   namespace InterpolateImageFunction
   {
     enum Enum
@@ -81,6 +92,33 @@ namespace mitk
     */
   MITKIMAGESTATISTICS_EXPORT IntensityProfile::Pointer ComputeIntensityProfile(Image::Pointer image, const Point3D& startPoint, const Point3D& endPoint, unsigned int numSamples, InterpolateImageFunction::Enum interpolator = InterpolateImageFunction::NearestNeighbor);
 
+  /** \brief Compute intensity profiles of all time steps of an image for each sample along a planar line.
+    *
+    * The sample positions and interpolation weights are computed once and reused for every time step.
+    *
+    * \param[in] image A three- or four-dimensional image which consists of single component pixels.
+    * \param[in] planarLine A planar line along which the intensity profiles will be evaluated.
+    * \param[in] numSamples Number of samples along the planar line (must be at least 2).
+    * \param[in] interpolator Image interpolation function which is used to read each sample.
+    *
+    * \return The computed intensity profiles (one per time step).
+    */
+  MITKIMAGESTATISTICS_EXPORT std::vector<IntensityProfile::Pointer> ComputeIntensityProfiles(Image::Pointer image, PlanarLine::Pointer planarLine, unsigned int numSamples, InterpolateImageFunction::Enum interpolator = InterpolateImageFunction::NearestNeighbor);
+
+  /** \brief Compute intensity profiles of all time steps of an image for each sample between two points.
+    *
+    * The sample positions and interpolation weights are computed once and reused for every time step.
+    *
+    * \param[in] image A three- or four-dimensional image which consists of single component pixels.
+    * \param[in] startPoint A point at which the first sample is to be read.
+    * \param[in] endPoint A point at which the last sample is to be read.
+    * \param[in] numSamples Number of samples between startPoint and endPoint (must be at least 2).
+    * \param[in] interpolator Image interpolation function which is used to read each sample.
+    *
+    * \return The computed intensity profiles (one per time step).
+    */
+  MITKIMAGESTATISTICS_EXPORT std::vector<IntensityProfile::Pointer> ComputeIntensityProfiles(Image::Pointer image, const Point3D& startPoint, const Point3D& endPoint, unsigned int numSamples, InterpolateImageFunction::Enum interpolator = InterpolateImageFunction::NearestNeighbor);
+
   /** \brief Compute global maximum of an intensity profile.
     *
     * \param[in] intensityProfile An intensity profile.
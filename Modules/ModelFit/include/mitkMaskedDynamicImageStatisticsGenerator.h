@@ -19,9 +19,11 @@ found in the LICENSE file.
 
 namespace mitk
 {
-/** Simple mitk based wrapper for the itk::MaskedNaryStatisticsImageFilter.
- * takes an input image and a mask image (both mitk::Images) and calculates the statistic
- * of the input image within the given mask (every pixel != 0).\n
+/** Takes an input image and a mask image (both mitk::Images) and calculates the statistic
+ * of the input image within the given mask (every pixel != 0). The results are equivalent to
+ * the itk::MaskedNaryStatisticsImageFilter, but the voxels covered by the mask are determined
+ * only once and all time steps are then processed in one multi-threaded pass over the
+ * dynamic image buffer.\n
  * The class assumes that the mask image is 3D (only one time step), if this is not the case
  * *only* the first time step will be used as mask.\n
  * If the input image has multiple time steps, the statistics will be calculated for each time
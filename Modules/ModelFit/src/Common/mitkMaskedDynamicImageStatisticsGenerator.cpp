@@ -15,7 +15,11 @@ found in the LICENSE file.
 #include "mitkImageTimeSelector.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
-#include "itkMaskedNaryStatisticsImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
 
 mitk::MaskedDynamicImageStatisticsGenerator::MaskedDynamicImageStatisticsGenerator()
 {
@@ -86,36 +90,51 @@ const mitk::MaskedDynamicImageStatisticsGenerator::ResultType& mitk::MaskedDynam
 };
 
 template <typename TPixel, unsigned int VDim>
-void mitk::MaskedDynamicImageStatisticsGenerator::DoCalculateStatistics(const itk::Image<TPixel, VDim>* /*image*/)
+void mitk::MaskedDynamicImageStatisticsGenerator::DoCalculateStatistics(const itk::Image<TPixel, VDim>* image)
 {
   typedef itk::Image<TPixel, VDim-1> InputFrameImageType;
-  typedef itk::MaskedNaryStatisticsImageFilter<InputFrameImageType, InternalMaskType> FilterType;
+  typedef typename itk::NumericTraits<TPixel>::RealType RealType;
 
-  typename FilterType::Pointer statFilter = FilterType::New();
+  const unsigned int timeSteps = this->m_DynamicImage->GetTimeSteps();
 
-  //add the time frames to the fit filter
-  unsigned int timeSteps = this->m_DynamicImage->GetTimeSteps();
-  std::vector<Image::Pointer> frameCache;
+  //Gather the (linear) buffer offsets of all voxels that are covered by the mask. This
+  //is done only once, because all frames share the same geometry.
+  typename InputFrameImageType::Pointer frameImage;
   mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
   imageTimeSelector->SetInput(this->m_DynamicImage);
-  for (unsigned int i = 0; i < timeSteps; ++i)
-  {
-    typename InputFrameImageType::Pointer frameImage;
-    imageTimeSelector->SetTimeNr(i);
-    imageTimeSelector->UpdateLargestPossibleRegion();
-
-    Image::Pointer frameMITKImage = imageTimeSelector->GetOutput();
-    frameCache.push_back(frameMITKImage);
-    mitk::CastToItkImage(frameMITKImage, frameImage);
-    statFilter->SetInput(i,frameImage);
-  }
+  imageTimeSelector->SetTimeNr(0);
+  imageTimeSelector->UpdateLargestPossibleRegion();
+  Image::Pointer frameMITKImage = imageTimeSelector->GetOutput();
+  mitk::CastToItkImage(frameMITKImage, frameImage);
 
-  if (this->m_InternalMask.IsNotNull())
+  const auto frameRegion = frameImage->GetLargestPossibleRegion();
+  const itk::SizeValueType frameSize = frameRegion.GetNumberOfPixels();
+
+  std::vector<itk::SizeValueType> voxelOffsets;
+  voxelOffsets.reserve(frameSize);
+
+  itk::ImageRegionConstIteratorWithIndex<InputFrameImageType> frameIt(frameImage, frameRegion);
+  for (frameIt.GoToBegin(); !frameIt.IsAtEnd(); ++frameIt)
   {
-    statFilter->SetMask(this->m_InternalMask);
-  }
+    bool isValid = true;
 
-  statFilter->Update();
+    if (this->m_InternalMask.IsNotNull())
+    {
+      //same semantic as itk::MaskedStatisticsImageFilter: voxels outside of the mask geometry are used.
+      typename InputFrameImageType::IndexType index = frameIt.GetIndex();
+      typename InputFrameImageType::PointType point;
+      frameImage->TransformIndexToPhysicalPoint(index, point);
+      if (this->m_InternalMask->TransformPhysicalPointToIndex(point, index))
+      {
+        isValid = this->m_InternalMask->GetPixel(index) > 0.0;
+      }
+    }
+
+    if (isValid)
+    {
+      voxelOffsets.push_back(frameImage->ComputeOffset(frameIt.GetIndex()));
+    }
+  }
 
   m_Maximum.SetSize(timeSteps);
   m_Minimum.SetSize(timeSteps);
@@ -124,14 +143,67 @@ void mitk::MaskedDynamicImageStatisticsGenerator::DoCalculateStatistics(const it
   m_Variance.SetSize(timeSteps);
   m_Sum.SetSize(timeSteps);
 
-  for (unsigned int i = 0; i < timeSteps; ++i)
+  //The 4D buffer stores the frames one after another, so each frame is a contiguous
+  //block of frameSize voxels. The frames are distributed over the threads; every
+  //thread only writes the result elements of its own frames.
+  const TPixel* buffer = image->GetBufferPointer();
+  const auto count = static_cast<RealType>(voxelOffsets.size());
+
+  auto calculateFrames = [&, this](unsigned int threadIndex, unsigned int numThreads)
+  {
+    for (unsigned int t = threadIndex; t < timeSteps; t += numThreads)
+    {
+      const TPixel* frame = buffer + t * frameSize;
+
+      RealType sum = itk::NumericTraits<RealType>::Zero;
+      RealType sumOfSquares = itk::NumericTraits<RealType>::Zero;
+      TPixel min = itk::NumericTraits<TPixel>::max();
+      TPixel max = itk::NumericTraits<TPixel>::NonpositiveMin();
+
+      for (const auto offset : voxelOffsets)
+      {
+        const TPixel value = frame[offset];
+        const auto realValue = static_cast<RealType>(value);
+        if (value < min)
+        {
+          min = value;
+        }
+        if (value > max)
+        {
+          max = value;
+        }
+        sum += realValue;
+        sumOfSquares += realValue * realValue;
+      }
+
+      //unbiased estimate (same as itk::MaskedStatisticsImageFilter)
+      const RealType variance = (sumOfSquares - (sum * sum / count)) / (count - 1);
+
+      m_Maximum.SetElement(t, max);
+      m_Minimum.SetElement(t, min);
+      m_Mean.SetElement(t, sum / count);
+      m_Sigma.SetElement(t, std::sqrt(variance));
+      m_Variance.SetElement(t, variance);
+      m_Sum.SetElement(t, sum);
+    }
+  };
+
+  const auto numThreads = std::max(1u, std::min(std::thread::hardware_concurrency(), timeSteps));
+
+  if (numThreads == 1)
   {
-    m_Maximum.SetElement(i,statFilter->GetMaximum()[i]);
-    m_Minimum.SetElement(i,statFilter->GetMinimum()[i]);
-    m_Mean.SetElement(i,statFilter->GetMean()[i]);
-    m_Sigma.SetElement(i,statFilter->GetSigma()[i]);
-    m_Variance.SetElement(i,statFilter->GetVariance()[i]);
-    m_Sum.SetElement(i,statFilter->GetSum()[i]);
+    calculateFrames(0, 1);
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+
+    for (unsigned int threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+      threads.emplace_back(calculateFrames, threadIndex, numThreads);
+
+    for (auto& thread : threads)
+      thread.join();
   }
 
   this->m_GenerationTimeStamp.Modified();
@@ -4,5 +4,11 @@ set(MODULE_TESTS
     mitkLabelSetImageTest.cpp
     mitkLabelSetImageIOTest.cpp
     mitkLabelSetImageSurfaceStampFilterTest.cpp
+    mitkLabelSetImageToSurfaceFilterTest.cpp
 )
 
+if(MITK_USE_DCMQI)
+  list(APPEND MODULE_TESTS
+    mitkDICOMSegmentationIOTest.cpp
+  )
+endif()
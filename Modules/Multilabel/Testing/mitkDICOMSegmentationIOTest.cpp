@@ -0,0 +1,240 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkDICOMQIPropertyHelper.h>
+#include <mitkDICOMSegmentationPropertyHelper.h>
+#include <mitkIOMimeTypes.h>
+#include <mitkIOUtil.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <dcmtk/dcmdata/dcdeftag.h>
+#include <dcmtk/dcmdata/dcfilefo.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+class mitkDICOMSegmentationIOTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMSegmentationIOTestSuite);
+  MITK_TEST(TestWriteReadWithEmptyLabel);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::LabelSetImage::PixelType PixelType;
+
+  std::string m_Directory;
+  mitk::LabelSetImage::Pointer m_Segmentation;
+
+  /** Selects the DICOM Seg reader, the DICOM image readers are applicable to the file, too. */
+  struct DICOMSegReaderSelector : public mitk::IOUtil::ReaderOptionsFunctorBase
+  {
+    bool operator()(mitk::IOUtil::LoadInfo &loadInfo) const override
+    {
+      for (const auto &item : loadInfo.m_ReaderSelector.Get())
+      {
+        if (item.GetMimeType().GetName() == DICOMSegMimeTypeName())
+          return loadInfo.m_ReaderSelector.Select(item);
+      }
+      return false;
+    }
+  };
+
+  /** Selects the autoselecting DICOM image reader, which loads all slices of the series of the file. */
+  struct DICOMSeriesReaderSelector : public mitk::IOUtil::ReaderOptionsFunctorBase
+  {
+    bool operator()(mitk::IOUtil::LoadInfo &loadInfo) const override
+    {
+      for (const auto &item : loadInfo.m_ReaderSelector.Get())
+      {
+        if (item.GetDescription() == "MITK DICOM Reader v2 (autoselect)")
+          return loadInfo.m_ReaderSelector.Select(item);
+      }
+      return false;
+    }
+  };
+
+  static std::string DICOMSegMimeTypeName()
+  {
+    return mitk::IOMimeTypes::DEFAULT_BASE_NAME() + ".image.dicom.seg";
+  }
+
+  static void AddLabel(mitk::LabelSetImage *segmentation, PixelType value, const std::string &name)
+  {
+    mitk::Label::Pointer label = mitk::Label::New();
+    label->SetValue(value);
+    label->SetName(name);
+    segmentation->GetActiveLabelSet()->AddLabel(label);
+  }
+
+  /** Returns the indices of all pixels of the active layer with the given value. */
+  static std::set<itk::IndexValueType> GetLabelPixels(mitk::LabelSetImage *segmentation, PixelType value)
+  {
+    mitk::ImagePixelReadAccessor<PixelType, 3> readAccess(segmentation);
+    const PixelType *buffer = readAccess.GetData();
+    const itk::IndexValueType numberOfPixels =
+      segmentation->GetDimension(0) * segmentation->GetDimension(1) * segmentation->GetDimension(2);
+
+    std::set<itk::IndexValueType> pixels;
+    for (itk::IndexValueType i = 0; i < numberOfPixels; ++i)
+    {
+      if (buffer[i] == value)
+        pixels.insert(i);
+    }
+    return pixels;
+  }
+
+  /** Returns the number of slices of the active layer that contain the given value. */
+  static unsigned int GetNumberOfLabeledSlices(mitk::LabelSetImage *segmentation, PixelType value)
+  {
+    const itk::IndexValueType sliceSize = segmentation->GetDimension(0) * segmentation->GetDimension(1);
+    std::set<itk::IndexValueType> slices;
+    for (const auto pixel : GetLabelPixels(segmentation, value))
+      slices.insert(pixel / sliceSize);
+    return static_cast<unsigned int>(slices.size());
+  }
+
+  /** Returns the number of frames of every segment of a DICOM Seg file, sorted ascending. */
+  static std::vector<unsigned int> GetNumberOfFramesPerSegment(const std::string &path)
+  {
+    DcmFileFormat fileFormat;
+    CPPUNIT_ASSERT_MESSAGE("Error loading DICOM Seg with DCMTK", fileFormat.loadFile(path.c_str()).good());
+    DcmDataset *dataset = fileFormat.getDataset();
+
+    std::map<Uint16, unsigned int> framesPerSegment;
+    DcmItem *frameItem = nullptr;
+    for (signed long frame = 0;
+         dataset->findAndGetSequenceItem(DCM_PerFrameFunctionalGroupsSequence, frameItem, frame).good();
+         ++frame)
+    {
+      DcmItem *segmentItem = nullptr;
+      Uint16 segmentNumber = 0;
+      CPPUNIT_ASSERT(frameItem->findAndGetSequenceItem(DCM_SegmentIdentificationSequence, segmentItem).good());
+      CPPUNIT_ASSERT(segmentItem->findAndGetUint16(DCM_ReferencedSegmentNumber, segmentNumber).good());
+      ++framesPerSegment[segmentNumber];
+    }
+
+    std::vector<unsigned int> numberOfFrames;
+    for (const auto &segment : framesPerSegment)
+      numberOfFrames.push_back(segment.second);
+    std::sort(numberOfFrames.begin(), numberOfFrames.end());
+    return numberOfFrames;
+  }
+
+public:
+  void setUp() override
+  {
+    DICOMSeriesReaderSelector readerSelector;
+    auto referenceImage = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("TinyCTAbdomen/100"), &readerSelector);
+    CPPUNIT_ASSERT_MESSAGE("Reference series has enough slices for labels that skip slices", referenceImage->GetDimension(2) >= 3);
+
+    m_Segmentation = mitk::LabelSetImage::New();
+    m_Segmentation->Initialize(referenceImage);
+
+    // Label 2 stays empty. Label 1 covers the slices 0 and 2, label 3 only slice 1, so both segments have empty
+    // frames that the writer skips.
+    AddLabel(m_Segmentation, 1, "Label1");
+    AddLabel(m_Segmentation, 2, "EmptyLabel");
+    AddLabel(m_Segmentation, 3, "Label3");
+
+    {
+      mitk::ImagePixelWriteAccessor<PixelType, 3> writeAccess(m_Segmentation);
+      itk::Index<3> index;
+      for (index[2] = 0; index[2] < static_cast<itk::IndexValueType>(m_Segmentation->GetDimension(2)); ++index[2])
+        for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(m_Segmentation->GetDimension(1)); ++index[1])
+          for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(m_Segmentation->GetDimension(0)); ++index[0])
+          {
+            PixelType value = 0;
+            if ((index[2] == 0 || index[2] == 2) && index[0] < 10 && index[1] < 10)
+              value = 1;
+            else if (index[2] == 1 && index[0] >= 5 && index[1] >= 5 && index[1] < 12)
+              value = 3;
+            writeAccess.SetPixelByIndex(index, value);
+          }
+    }
+
+    mitk::DICOMQIPropertyHelper::DeriveDICOMSourceProperties(referenceImage, m_Segmentation);
+    mitk::DICOMSegmentationPropertyHelper::DeriveDICOMSegmentationProperties(m_Segmentation);
+
+    m_Directory = mitk::IOUtil::CreateTemporaryDirectory("mitkDICOMSegmentationIOTest_XXXXXX");
+  }
+
+  void tearDown() override
+  {
+    m_Segmentation = nullptr;
+    itksys::SystemTools::RemoveADirectory(m_Directory);
+  }
+
+  void TestWriteReadWithEmptyLabel()
+  {
+    const std::string path = m_Directory + "/Segmentation.dcm";
+    mitk::IOUtil::Save(m_Segmentation, DICOMSegMimeTypeName(), path, false);
+    CPPUNIT_ASSERT_MESSAGE("Error writing DICOM Seg", itksys::SystemTools::FileExists(path.c_str()));
+
+    // Only the slices that contain a label are written as frames: one frame of label 3, two frames of label 1
+    const std::vector<unsigned int> expectedFramesPerSegment = {1, 2};
+    CPPUNIT_ASSERT_MESSAGE("Empty frames are not written", expectedFramesPerSegment == GetNumberOfFramesPerSegment(path));
+
+    DICOMSegReaderSelector readerSelector;
+    auto loadedSegmentation = mitk::IOUtil::Load<mitk::LabelSetImage>(path, &readerSelector);
+    CPPUNIT_ASSERT_MESSAGE("Error reading DICOM Seg", loadedSegmentation.IsNotNull());
+
+    for (unsigned int i = 0; i < 3; ++i)
+      CPPUNIT_ASSERT_EQUAL(m_Segmentation->GetDimension(i), loadedSegmentation->GetDimension(i));
+
+    std::map<PixelType, std::set<itk::IndexValueType>> expectedPixels;
+    expectedPixels[1] = GetLabelPixels(m_Segmentation, 1);
+    expectedPixels[3] = GetLabelPixels(m_Segmentation, 3);
+    CPPUNIT_ASSERT_EQUAL(2u, GetNumberOfLabeledSlices(m_Segmentation, 1));
+    CPPUNIT_ASSERT_EQUAL(1u, GetNumberOfLabeledSlices(m_Segmentation, 3));
+
+    // Every segment is read into a layer of its own. The empty label has no segment.
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Every non-empty label is read", 2u, loadedSegmentation->GetNumberOfLayers());
+
+    std::set<PixelType> foundLabels;
+    for (unsigned int layer = 0; layer < loadedSegmentation->GetNumberOfLayers(); ++layer)
+    {
+      loadedSegmentation->SetActiveLayer(layer);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Layer contains background and one label", 2u, loadedSegmentation->GetNumberOfLabels(layer));
+
+      // The label value has to be the pixel value of the segment
+      auto labelIter = loadedSegmentation->GetLabelSet(layer)->IteratorConstBegin();
+      // Ignore background label
+      ++labelIter;
+      const auto pixels = GetLabelPixels(loadedSegmentation, labelIter->first);
+      CPPUNIT_ASSERT_MESSAGE("Label value is the pixel value of the segment", !pixels.empty());
+
+      for (const auto &expected : expectedPixels)
+      {
+        if (expected.second == pixels)
+        {
+          foundLabels.insert(expected.first);
+          CPPUNIT_ASSERT_EQUAL_MESSAGE("Read segment covers the slices of its label",
+                                       GetNumberOfLabeledSlices(m_Segmentation, expected.first),
+                                       GetNumberOfLabeledSlices(loadedSegmentation, labelIter->first));
+        }
+      }
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Pixels of the non-empty labels are preserved", foundLabels == std::set<PixelType>({1, 3}));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMSegmentationIO)
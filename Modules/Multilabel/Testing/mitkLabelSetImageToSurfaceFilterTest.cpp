@@ -0,0 +1,150 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkLabelSetImageToSurfaceFilter.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkPolyData.h>
+
+class mitkLabelSetImageToSurfaceFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelSetImageToSurfaceFilterTestSuite);
+  MITK_TEST(TestGenerateRequestedLabel);
+  MITK_TEST(TestGenerateAllLabels);
+  MITK_TEST(TestMissingLabel);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::LabelSetImage::Pointer m_LabelSetImage;
+
+  /** Sets all pixels within [begin, end) to the given label. */
+  void FillBox(const unsigned int begin[3], const unsigned int end[3], mitk::LabelSetImage::PixelType label)
+  {
+    mitk::ImagePixelWriteAccessor<mitk::LabelSetImage::PixelType, 3> accessor(m_LabelSetImage);
+
+    for (unsigned int z = begin[2]; z < end[2]; ++z)
+    {
+      for (unsigned int y = begin[1]; y < end[1]; ++y)
+      {
+        for (unsigned int x = begin[0]; x < end[0]; ++x)
+        {
+          itk::Index<3> index;
+          index[0] = x;
+          index[1] = y;
+          index[2] = z;
+          accessor.SetPixelByIndex(index, label);
+        }
+      }
+    }
+  }
+
+  /** Checks that the surface lies within the box [begin, end) enlarged by one pixel. */
+  void CheckBounds(mitk::Surface *surface, const unsigned int begin[3], const unsigned int end[3])
+  {
+    CPPUNIT_ASSERT_MESSAGE("Surface has no points", surface->GetVtkPolyData()->GetNumberOfPoints() > 0);
+
+    double bounds[6];
+    surface->GetVtkPolyData()->GetBounds(bounds);
+
+    for (int i = 0; i < 3; ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Surface exceeds the label", bounds[2 * i] >= begin[i] - 1.0);
+      CPPUNIT_ASSERT_MESSAGE("Surface exceeds the label", bounds[2 * i + 1] <= end[i]);
+    }
+  }
+
+  const unsigned int m_FirstBegin[3] = {4, 4, 4};
+  const unsigned int m_FirstEnd[3] = {14, 12, 16};
+  const unsigned int m_SecondBegin[3] = {20, 6, 10};
+  const unsigned int m_SecondEnd[3] = {30, 18, 20};
+  const unsigned int m_ThirdBegin[3] = {8, 24, 24};
+  const unsigned int m_ThirdEnd[3] = {24, 34, 36};
+
+public:
+  void setUp() override
+  {
+    mitk::Image::Pointer regularImage = mitk::Image::New();
+    unsigned int dimensions[3] = {40, 40, 40};
+    regularImage->Initialize(mitk::MakeScalarPixelType<mitk::LabelSetImage::PixelType>(), 3, dimensions);
+
+    m_LabelSetImage = mitk::LabelSetImage::New();
+    m_LabelSetImage->Initialize(regularImage);
+
+    this->FillBox(m_FirstBegin, m_FirstEnd, 1);
+    this->FillBox(m_SecondBegin, m_SecondEnd, 2);
+    this->FillBox(m_ThirdBegin, m_ThirdEnd, 5);
+  }
+
+  void tearDown() override { m_LabelSetImage = nullptr; }
+
+  void TestGenerateRequestedLabel()
+  {
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(m_LabelSetImage);
+    filter->SetRequestedLabel(2);
+    filter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(1u, static_cast<unsigned int>(filter->GetNumberOfIndexedOutputs()));
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::LabelSetImage::PixelType>(2), filter->GetLabelOfOutput(0));
+    this->CheckBounds(filter->GetOutput(), m_SecondBegin, m_SecondEnd);
+  }
+
+  void TestGenerateAllLabels()
+  {
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(m_LabelSetImage);
+    filter->GenerateAllLabelsOn();
+    filter->SetNumberOfThreads(3);
+    filter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(3u, static_cast<unsigned int>(filter->GetNumberOfIndexedOutputs()));
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::LabelSetImage::PixelType>(1), filter->GetLabelOfOutput(0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::LabelSetImage::PixelType>(2), filter->GetLabelOfOutput(1));
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::LabelSetImage::PixelType>(5), filter->GetLabelOfOutput(2));
+
+    CPPUNIT_ASSERT_EQUAL(10ul * 8 * 12, filter->GetAvailableLabels().at(1));
+    CPPUNIT_ASSERT_EQUAL(10ul * 12 * 10, filter->GetAvailableLabels().at(2));
+    CPPUNIT_ASSERT_EQUAL(16ul * 10 * 12, filter->GetAvailableLabels().at(5));
+
+    this->CheckBounds(filter->GetOutput(0), m_FirstBegin, m_FirstEnd);
+    this->CheckBounds(filter->GetOutput(1), m_SecondBegin, m_SecondEnd);
+    this->CheckBounds(filter->GetOutput(2), m_ThirdBegin, m_ThirdEnd);
+
+    // Every label has to give the same surface as its single label extraction (both with one thread per label)
+    auto singleLabelFilter = mitk::LabelSetImageToSurfaceFilter::New();
+    singleLabelFilter->SetInput(m_LabelSetImage);
+    singleLabelFilter->SetRequestedLabel(5);
+    singleLabelFilter->SetNumberOfThreads(1);
+    singleLabelFilter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(singleLabelFilter->GetOutput()->GetVtkPolyData()->GetNumberOfPoints(),
+                         filter->GetOutput(2)->GetVtkPolyData()->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL(singleLabelFilter->GetOutput()->GetVtkPolyData()->GetNumberOfCells(),
+                         filter->GetOutput(2)->GetVtkPolyData()->GetNumberOfCells());
+
+    CPPUNIT_ASSERT_THROW(filter->GetLabelOfOutput(3), mitk::Exception);
+  }
+
+  void TestMissingLabel()
+  {
+    auto filter = mitk::LabelSetImageToSurfaceFilter::New();
+    filter->SetInput(m_LabelSetImage);
+    filter->SetRequestedLabel(3);
+
+    CPPUNIT_ASSERT_THROW(filter->Update(), itk::ExceptionObject);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImageToSurfaceFilter)
@@ -21,15 +21,13 @@ found in the LICENSE file.
 #include <mitkDICOMIOHelper.h>
 #include <mitkDICOMProperty.h>
 #include <mitkIDICOMTagsOfInterest.h>
+#include <mitkITKImageImport.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
 #include <mitkLocaleSwitch.h>
 #include <mitkPropertyNameHelper.h>
 
 
-// itk
-#include <itkThresholdImageFilter.h>
-
 // dcmqi
 #include <dcmqi/ImageSEGConverter.h>
 
@@ -37,6 +35,8 @@ found in the LICENSE file.
 #include <usGetModuleContext.h>
 #include <usModuleContext.h>
 
+#include <cstddef>
+
 namespace mitk
 {
   DICOMSegmentationIO::DICOMSegmentationIO()
@@ -159,6 +159,8 @@ namespace mitk
     for (unsigned int layer = 0; layer < input->GetNumberOfLayers(); ++layer)
     {
       vector<itkInternalImageType::Pointer> segmentations;
+      // Values of the labels that are written, in the order of the segmentation images
+      vector<LabelSetImage::PixelType> labelValues;
 
       try
       {
@@ -167,37 +169,62 @@ namespace mitk
         mitk::LabelSetImage *mitkLayerImage = const_cast<mitk::LabelSetImage *>(input);
         mitkLayerImage->SetActiveLayer(layer);
 
-        // Cast mitk layer image to itk
+        // Cast mitk layer image to itk (the itk image references the buffer of the mitk image)
         ImageToItk<itkInputImageType>::Pointer imageToItkFilter = ImageToItk<itkInputImageType>::New();
         imageToItkFilter->SetInput(mitkLayerImage);
-        // Cast from original itk type to dcmqi input itk image type
-        typedef itk::CastImageFilter<itkInputImageType, itkInternalImageType> castItkImageFilterType;
-        castItkImageFilterType::Pointer castFilter = castItkImageFilterType::New();
-        castFilter->SetInput(imageToItkFilter->GetOutput());
-        castFilter->Update();
-
-        itkInternalImageType::Pointer itkLabelImage = castFilter->GetOutput();
-        itkLabelImage->DisconnectPipeline();
+        imageToItkFilter->Update();
+        itkInputImageType::Pointer itkLabelImage = imageToItkFilter->GetOutput();
 
-        // Iterate over all labels. For each label a segmentation image will be created
         const LabelSet *labelSet = input->GetLabelSet(layer);
         auto labelIter = labelSet->IteratorConstBegin();
         // Ignore background label
         ++labelIter;
 
+        std::vector<bool> isLabel;
+        for (auto iter = labelIter; iter != labelSet->IteratorConstEnd(); ++iter)
+        {
+          if (isLabel.size() <= iter->first)
+            isLabel.resize(iter->first + 1, false);
+          isLabel[iter->first] = true;
+        }
+
+        // Distribute the labeled pixels to the segmentation images in a single pass over the layer, instead of
+        // thresholding the whole layer once for every label. The segmentation image of a label is allocated when
+        // its first pixel is found.
+        std::vector<itkInternalImageType::Pointer> segmentImages(isLabel.size());
+        std::vector<itkInternalImageType::PixelType *> segmentBuffers(isLabel.size(), nullptr);
+        const itkInputImageType::PixelType *labelBuffer = itkLabelImage->GetBufferPointer();
+        const std::size_t numberOfPixels = itkLabelImage->GetLargestPossibleRegion().GetNumberOfPixels();
+        for (std::size_t i = 0; i < numberOfPixels; ++i)
+        {
+          const auto value = labelBuffer[i];
+          if (value >= isLabel.size() || !isLabel[value])
+            continue;
+
+          if (segmentBuffers[value] == nullptr)
+          {
+            itkInternalImageType::Pointer segmentImage = itkInternalImageType::New();
+            segmentImage->CopyInformation(itkLabelImage);
+            segmentImage->SetRegions(itkLabelImage->GetLargestPossibleRegion());
+            segmentImage->Allocate(true);
+            segmentImages[value] = segmentImage;
+            segmentBuffers[value] = segmentImage->GetBufferPointer();
+          }
+          segmentBuffers[value][i] = static_cast<itkInternalImageType::PixelType>(value);
+        }
+
+        // For each label with segmented pixels a segmentation image will be written. dcmqi creates segments only for
+        // pixel values it finds, so an empty label cannot be stored as a segment.
         for (; labelIter != labelSet->IteratorConstEnd(); ++labelIter)
         {
-          // Thresold over the image with the given label value
-          itk::ThresholdImageFilter<itkInternalImageType>::Pointer thresholdFilter =
-            itk::ThresholdImageFilter<itkInternalImageType>::New();
-          thresholdFilter->SetInput(itkLabelImage);
-          thresholdFilter->ThresholdOutside(labelIter->first, labelIter->first);
-          thresholdFilter->SetOutsideValue(0);
-          thresholdFilter->Update();
-          itkInternalImageType::Pointer segmentImage = thresholdFilter->GetOutput();
-          segmentImage->DisconnectPipeline();
-
-          segmentations.push_back(segmentImage);
+          if (segmentImages[labelIter->first].IsNull())
+          {
+            MITK_WARN << "Label " << labelIter->first << " (" << labelIter->second->GetName() << ") of layer " << layer
+                      << " contains no segmented pixels and is not written to the DICOM Seg.";
+            continue;
+          }
+          segmentations.push_back(segmentImages[labelIter->first]);
+          labelValues.push_back(labelIter->first);
         }
       }
       catch (const itk::ExceptionObject &e)
@@ -206,8 +233,14 @@ namespace mitk
         return;
       }
 
+      if (segmentations.empty())
+      {
+        MITK_WARN << "Layer " << layer << " contains no segmented pixels and is not written to the DICOM Seg.";
+        continue;
+      }
+
       // Create segmentation meta information
-      const std::string tmpMetaInfoFile = this->CreateMetaDataJsonFile(layer);
+      const std::string tmpMetaInfoFile = this->CreateMetaDataJsonFile(layer, labelValues);
 
       MITK_INFO << "Writing image: " << path << std::endl;
       try
@@ -217,9 +250,9 @@ namespace mitk
         for (const auto& dcmDataSet : dcmDatasetsSourceImage)
           rawVecDataset.push_back(dcmDataSet.get());
 
-        // Convert itk segmentation images to dicom image
+        // Convert itk segmentation images to dicom image. Only frames that contain segmented pixels are written.
         std::unique_ptr<dcmqi::ImageSEGConverter> converter = std::make_unique<dcmqi::ImageSEGConverter>();
-        std::unique_ptr<DcmDataset> result(converter->itkimage2dcmSegmentation(rawVecDataset, segmentations, tmpMetaInfoFile, false));
+        std::unique_ptr<DcmDataset> result(converter->itkimage2dcmSegmentation(rawVecDataset, segmentations, tmpMetaInfoFile, true));
 
         // Write dicom file
         DcmFileFormat dcmFileFormat(result.get());
@@ -312,36 +345,36 @@ namespace mitk
       // For each itk image add a layer to the LabelSetImage output
       for (auto &element : segItkImages)
       {
-        // Get the labeled image and cast it to mitkImage
-        typedef itk::CastImageFilter<itkInternalImageType, itkInputImageType> castItkImageFilterType;
-        castItkImageFilterType::Pointer castFilter = castItkImageFilterType::New();
-        castFilter->SetInput(element.second);
-        castFilter->Update();
-
-        Image::Pointer layerImage;
-        CastToMitkImage(castFilter->GetOutput(), layerImage);
-
-        // Get pixel value of the label
-        itkInternalImageType::ValueType segValue = 1;
-        typedef itk::ImageRegionIterator<const itkInternalImageType> IteratorType;
-        // Iterate over the image to find the pixel value of the label
-        IteratorType iter(element.second, element.second->GetLargestPossibleRegion());
-        iter.GoToBegin();
-        while (!iter.IsAtEnd())
+        // Copy the segment image into the layer image in a single pass and take the label value from the segment
+        // pixels on the way. The mitk image takes over the buffer of the copy, so the segment is copied only once.
+        const itkInternalImageType *segmentImage = element.second;
+        itkInputImageType::Pointer itkLayerImage = itkInputImageType::New();
+        itkLayerImage->CopyInformation(segmentImage);
+        itkLayerImage->SetRegions(segmentImage->GetLargestPossibleRegion());
+        itkLayerImage->Allocate();
+
+        const itkInternalImageType::PixelType *segmentBuffer = segmentImage->GetBufferPointer();
+        itkInputImageType::PixelType *layerBuffer = itkLayerImage->GetBufferPointer();
+        const std::size_t numberOfPixels = segmentImage->GetLargestPossibleRegion().GetNumberOfPixels();
+        LabelSetImage::PixelType segValue = 0;
+        for (std::size_t i = 0; i < numberOfPixels; ++i)
         {
-          itkInputImageType::PixelType value = iter.Get();
-          if (value != 0)
-          {
-            segValue = value;
-            break;
-          }
-          ++iter;
+          layerBuffer[i] = static_cast<itkInputImageType::PixelType>(segmentBuffer[i]);
+          if (segValue == 0)
+            segValue = layerBuffer[i];
         }
+
+        Image::Pointer layerImage = GrabItkImageMemory(itkLayerImage.GetPointer());
+
         // Get Segment information map
         map<unsigned, dcmqi::SegmentAttributes *> segmentMap = (*segmentIter);
         map<unsigned, dcmqi::SegmentAttributes *>::const_iterator segmentMapIter = (*segmentIter).begin();
         dcmqi::SegmentAttributes *segmentAttribute = (*segmentMapIter).second;
 
+        // A segment without frames has no pixel value, so use the label ID of the segment
+        if (segValue == 0)
+          segValue = static_cast<LabelSetImage::PixelType>(segmentAttribute->getLabelID());
+
         OFString labelName;
 
         if (segmentAttribute->getSegmentedPropertyTypeCodeSequence() != nullptr)
@@ -445,7 +478,8 @@ namespace mitk
     return result;
   }
 
-  const std::string mitk::DICOMSegmentationIO::CreateMetaDataJsonFile(int layer)
+  const std::string mitk::DICOMSegmentationIO::CreateMetaDataJsonFile(
+    int layer, const std::vector<LabelSetImage::PixelType> &labelValues)
   {
     const mitk::LabelSetImage *image = dynamic_cast<const mitk::LabelSetImage *>(this->GetInput());
 
@@ -488,13 +522,11 @@ namespace mitk
     handler.setBodyPartExamined("");
 
     const LabelSet *labelSet = image->GetLabelSet(layer);
-    auto labelIter = labelSet->IteratorConstBegin();
-    // Ignore background label
-    ++labelIter;
 
-    for (; labelIter != labelSet->IteratorConstEnd(); ++labelIter)
+    // The segments have to be listed in the order of the segmentation images
+    for (const auto labelValue : labelValues)
     {
-      const Label *label = labelIter->second;
+      const Label *label = labelSet->GetLabel(labelValue);
 
       if (label != nullptr)
       {
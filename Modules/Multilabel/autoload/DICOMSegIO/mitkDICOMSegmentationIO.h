@@ -62,7 +62,7 @@ namespace mitk
     DICOMSegmentationIO *IOClone() const override;
 
     // -------------- DICOMSegmentationIO specific functions -------------
-    const std::string CreateMetaDataJsonFile(int layer);
+    const std::string CreateMetaDataJsonFile(int layer, const std::vector<LabelSetImage::PixelType> &labelValues);
     void SetLabelProperties(Label *label, dcmqi::SegmentAttributes *segmentAttribute);
   };
 } // end of namespace mitk
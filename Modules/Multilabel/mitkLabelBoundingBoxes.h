@@ -0,0 +1,105 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelBoundingBoxes_h
+#define mitkLabelBoundingBoxes_h
+
+#include <itkImage.h>
+#include <itkImageScanlineConstIterator.h>
+
+#include <algorithm>
+#include <map>
+
+namespace mitk
+{
+  /**
+   * \brief Bounding box of a label in index coordinates and the number of voxels of the label.
+   */
+  template <unsigned int VDimension>
+  struct LabelBoundingBox
+  {
+    itk::ImageRegion<VDimension> Region;
+    unsigned long NumberOfVoxels;
+  };
+
+  /**
+   * \brief Determines the bounding boxes of all labels (including the background) of a label image
+   * in a single pass.
+   *
+   * Runs of equal labels within a scanline are handled at once to keep the map lookups rare.
+   */
+  template <typename TPixel, unsigned int VDimension>
+  std::map<TPixel, LabelBoundingBox<VDimension>> ComputeLabelBoundingBoxes(const itk::Image<TPixel, VDimension> *image)
+  {
+    typedef itk::Image<TPixel, VDimension> ImageType;
+    typedef typename ImageType::IndexType IndexType;
+
+    struct Extent
+    {
+      IndexType Minimum;
+      IndexType Maximum;
+      unsigned long NumberOfVoxels;
+    };
+
+    std::map<TPixel, Extent> extents;
+
+    itk::ImageScanlineConstIterator<ImageType> it(image, image->GetLargestPossibleRegion());
+    while (!it.IsAtEnd())
+    {
+      while (!it.IsAtEndOfLine())
+      {
+        const IndexType runBegin = it.GetIndex();
+        const TPixel label = it.Get();
+
+        unsigned long runLength = 0;
+        do
+        {
+          ++it;
+          ++runLength;
+        } while (!it.IsAtEndOfLine() && it.Get() == label);
+
+        IndexType runEnd = runBegin;
+        runEnd[0] += static_cast<itk::IndexValueType>(runLength) - 1;
+
+        auto iter = extents.find(label);
+        if (iter == extents.end())
+        {
+          extents.emplace(label, Extent{runBegin, runEnd, runLength});
+        }
+        else
+        {
+          for (unsigned int dim = 0; dim < VDimension; ++dim)
+          {
+            iter->second.Minimum[dim] = std::min(iter->second.Minimum[dim], runBegin[dim]);
+            iter->second.Maximum[dim] = std::max(iter->second.Maximum[dim], runEnd[dim]);
+          }
+          iter->second.NumberOfVoxels += runLength;
+        }
+      }
+      it.NextLine();
+    }
+
+    std::map<TPixel, LabelBoundingBox<VDimension>> boundingBoxes;
+    for (const auto &extent : extents)
+    {
+      LabelBoundingBox<VDimension> &boundingBox = boundingBoxes[extent.first];
+      boundingBox.Region.SetIndex(extent.second.Minimum);
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+        boundingBox.Region.SetSize(dim, extent.second.Maximum[dim] - extent.second.Minimum[dim] + 1);
+      boundingBox.NumberOfVoxels = extent.second.NumberOfVoxels;
+    }
+
+    return boundingBoxes;
+  }
+}
+
+#endif
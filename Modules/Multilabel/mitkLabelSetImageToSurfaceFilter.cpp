@@ -15,24 +15,26 @@ found in the LICENSE file.
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
 
+#include <mitkExceptionMacro.h>
+#include <mitkLabelBoundingBoxes.h>
+
 // itk
 #include <itkAntiAliasBinaryImageFilter.h>
-#include <itkAutoCropLabelMapFilter.h>
-#include <itkBinaryThresholdImageFilter.h>
-#include <itkLabelImageToLabelMapFilter.h>
-#include <itkLabelMap.h>
-#include <itkLabelMapToLabelImageFilter.h>
-#include <itkLabelObject.h>
-#include <itkNumericTraits.h>
+#include <itkImageRegionIterator.h>
 #include <itkSmoothingRecursiveGaussianImageFilter.h>
 
 // vtk
 #include <vtkCleanPolyData.h>
-#include <vtkImageChangeInformation.h>
 #include <vtkImageData.h>
 #include <vtkLinearTransform.h>
 #include <vtkMarchingCubes.h>
-#include <vtkSmartPointer.h>
+#include <vtkPoints.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 mitk::LabelSetImageToSurfaceFilter::LabelSetImageToSurfaceFilter()
   : m_GenerateAllLabels(false), m_RequestedLabel(1), m_BackgroundLabel(0), m_UseSmoothing(0), m_Sigma(0.1)
@@ -82,57 +84,163 @@ void mitk::LabelSetImageToSurfaceFilter::GenerateData()
   AccessFixedDimensionByItk_1(inputImage, InternalProcessing, 3, outputSurface);
 }
 
+mitk::LabelSetImageToSurfaceFilter::LabelType mitk::LabelSetImageToSurfaceFilter::GetLabelOfOutput(
+  unsigned int index) const
+{
+  auto iter = m_IndexToLabels.find(index);
+  if (iter == m_IndexToLabels.end())
+    mitkThrow() << "There is no output with index " << index << ".";
+
+  return iter->second;
+}
+
 template <typename TPixel, unsigned int VDimension>
 void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPixel, VDimension> *input,
                                                             mitk::Surface * /*surface*/)
 {
   typedef itk::Image<TPixel, VDimension> ImageType;
+  typedef typename ImageType::RegionType RegionType;
 
-  typedef itk::BinaryThresholdImageFilter<ImageType, ImageType> BinaryThresholdFilterType;
-  typedef itk::LabelObject<TPixel, VDimension> LabelObjectType;
-  typedef itk::LabelMap<LabelObjectType> LabelMapType;
-  typedef itk::LabelImageToLabelMapFilter<ImageType, LabelMapType> Image2LabelMapType;
-  typedef itk::AutoCropLabelMapFilter<LabelMapType> AutoCropType;
-  typedef itk::LabelMapToLabelImageFilter<LabelMapType, ImageType> LabelMap2ImageType;
+  const auto requestedLabel = static_cast<TPixel>(m_RequestedLabel);
+  const auto backgroundLabel = static_cast<TPixel>(m_BackgroundLabel);
 
-  typedef itk::Image<float, VDimension> RealImageType;
+  // Determine the bounding boxes of all labels in a single pass over the image
+  const auto boundingBoxes = ComputeLabelBoundingBoxes(input);
 
-  typedef itk::AntiAliasBinaryImageFilter<ImageType, RealImageType> AntiAliasFilterType;
-  typedef itk::SmoothingRecursiveGaussianImageFilter<RealImageType, RealImageType> GaussianFilterType;
+  m_AvailableLabels.clear();
+  m_IndexToLabels.clear();
+
+  std::vector<TPixel> labels;
+  std::vector<RegionType> regions;
+
+  for (const auto &boundingBox : boundingBoxes)
+  {
+    if (m_GenerateAllLabels ? boundingBox.first == backgroundLabel : boundingBox.first != requestedLabel)
+      continue;
+
+    m_IndexToLabels[static_cast<unsigned int>(labels.size())] = static_cast<LabelType>(boundingBox.first);
+    m_AvailableLabels[static_cast<LabelType>(boundingBox.first)] = boundingBox.second.NumberOfVoxels;
+
+    labels.push_back(boundingBox.first);
+    regions.push_back(boundingBox.second.Region);
+  }
+
+  const auto numberOfLabels = static_cast<unsigned int>(labels.size());
+
+  if (0 == numberOfLabels)
+  {
+    if (m_GenerateAllLabels)
+      itkExceptionMacro(<< "labelset image does not contain any label.");
+
+    itkExceptionMacro(<< "labelset image does not contain the requested label " << m_RequestedLabel << ".");
+  }
+
+  this->SetNumberOfIndexedOutputs(numberOfLabels);
+  for (unsigned int i = 0; i < numberOfLabels; ++i)
+  {
+    if (nullptr == this->GetOutput(i))
+      this->SetNthOutput(i, this->MakeOutput(i));
+  }
+
+  // Maps index coordinates scaled by the spacing (i.e. the coordinates of the marching cubes
+  // result) to world coordinates
+  const mitk::BaseGeometry *geometry = this->GetInput()->GetGeometry();
+  const mitk::Vector3D spacing = geometry->GetSpacing();
+
+  vtkSmartPointer<vtkMatrix4x4> indexToWorld = vtkSmartPointer<vtkMatrix4x4>::New();
+  geometry->GetVtkTransform()->GetMatrix(indexToWorld);
+
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      indexToWorld->Element[i][j] /= spacing[j];
+
+  // Process the labels on up to GetNumberOfThreads() threads. If there are less labels than
+  // threads, the remaining threads are used by the ITK filters of each label.
+  const unsigned int availableThreads = std::max(1u, static_cast<unsigned int>(this->GetNumberOfThreads()));
+  const unsigned int numberOfThreads = std::min(availableThreads, numberOfLabels);
+  const unsigned int threadsPerLabel = std::max(1u, availableThreads / numberOfThreads);
+
+  std::vector<vtkSmartPointer<vtkPolyData>> surfaces(numberOfLabels);
+  std::atomic<unsigned int> nextLabel(0);
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+
+  auto processLabels = [&]() {
+    for (unsigned int i = nextLabel++; i < numberOfLabels; i = nextLabel++)
+    {
+      try
+      {
+        surfaces[i] = this->CreateLabelSurface(input, labels[i], regions[i], indexToWorld, threadsPerLabel);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!exception)
+          exception = std::current_exception();
+        nextLabel = numberOfLabels;
+      }
+    }
+  };
+
+  if (1 == numberOfThreads)
+  {
+    processLabels();
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(numberOfThreads);
+    for (unsigned int thread = 0; thread < numberOfThreads; ++thread)
+      threads.emplace_back(processLabels);
 
-  typename BinaryThresholdFilterType::Pointer thresholdFilter = BinaryThresholdFilterType::New();
-  thresholdFilter->SetInput(input);
-  thresholdFilter->SetLowerThreshold(m_RequestedLabel);
-  thresholdFilter->SetUpperThreshold(m_RequestedLabel);
-  thresholdFilter->SetOutsideValue(0);
-  thresholdFilter->SetInsideValue(1);
-  //  thresholdFilter->ReleaseDataFlagOn();
-  thresholdFilter->Update();
+    for (auto &thread : threads)
+      thread.join();
+  }
 
-  typename Image2LabelMapType::Pointer image2label = Image2LabelMapType::New();
-  image2label->SetInput(thresholdFilter->GetOutput());
+  if (exception)
+    std::rethrow_exception(exception);
+
+  for (unsigned int i = 0; i < numberOfLabels; ++i)
+    this->GetOutput(i)->SetVtkPolyData(surfaces[i], 0);
+}
+
+template <typename TPixel, unsigned int VDimension>
+vtkSmartPointer<vtkPolyData> mitk::LabelSetImageToSurfaceFilter::CreateLabelSurface(
+  const itk::Image<TPixel, VDimension> *input,
+  TPixel label,
+  const itk::ImageRegion<VDimension> &boundingBox,
+  vtkMatrix4x4 *indexToWorld,
+  unsigned int numberOfThreads) const
+{
+  typedef itk::Image<TPixel, VDimension> ImageType;
+  typedef itk::Image<float, VDimension> RealImageType;
 
-  typename AutoCropType::SizeType border;
-  border[0] = 3;
-  border[1] = 3;
-  border[2] = 3;
+  typedef itk::AntiAliasBinaryImageFilter<ImageType, RealImageType> AntiAliasFilterType;
+  typedef itk::SmoothingRecursiveGaussianImageFilter<RealImageType, RealImageType> GaussianFilterType;
 
-  typename AutoCropType::Pointer autoCropFilter = AutoCropType::New();
-  autoCropFilter->SetInput(image2label->GetOutput());
-  autoCropFilter->SetCropBorder(border);
-  autoCropFilter->InPlaceOn();
+  typename ImageType::RegionType cropRegion = boundingBox;
+  cropRegion.PadByRadius(3);
+  cropRegion.Crop(input->GetLargestPossibleRegion());
 
-  typename LabelMap2ImageType::Pointer label2image = LabelMap2ImageType::New();
-  label2image->SetInput(autoCropFilter->GetOutput());
+  typename ImageType::Pointer binaryImage = ImageType::New();
+  binaryImage->SetRegions(cropRegion);
+  binaryImage->SetSpacing(input->GetSpacing());
+  binaryImage->SetOrigin(input->GetOrigin());
+  binaryImage->SetDirection(input->GetDirection());
+  binaryImage->Allocate();
 
-  label2image->Update();
+  itk::ImageRegionConstIterator<ImageType> inputIt(input, cropRegion);
+  itk::ImageRegionIterator<ImageType> binaryIt(binaryImage, cropRegion);
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++binaryIt)
+    binaryIt.Set(inputIt.Get() == label ? 1 : 0);
 
   typename AntiAliasFilterType::Pointer antiAliasFilter = AntiAliasFilterType::New();
-  antiAliasFilter->SetInput(label2image->GetOutput());
+  antiAliasFilter->SetInput(binaryImage);
   antiAliasFilter->SetMaximumRMSError(0.001);
   antiAliasFilter->SetNumberOfLayers(3);
   antiAliasFilter->SetUseImageSpacing(false);
   antiAliasFilter->SetNumberOfIterations(40);
+  antiAliasFilter->SetNumberOfThreads(numberOfThreads);
 
   antiAliasFilter->Update();
 
@@ -143,6 +251,7 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
     typename GaussianFilterType::Pointer gaussianFilter = GaussianFilterType::New();
     gaussianFilter->SetSigma(m_Sigma);
     gaussianFilter->SetInput(antiAliasFilter->GetOutput());
+    gaussianFilter->SetNumberOfThreads(numberOfThreads);
     gaussianFilter->Update();
     result = gaussianFilter->GetOutput();
   }
@@ -153,32 +262,24 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
 
   result->DisconnectPipeline();
 
-  typename ImageType::RegionType cropRegion;
-  cropRegion = autoCropFilter->GetOutput()->GetLargestPossibleRegion();
-
   const typename ImageType::IndexType &cropIndex = cropRegion.GetIndex();
-
-  m_ResultImage = mitk::Image::New();
-  mitk::CastToMitkImage(result, m_ResultImage);
-
-  mitk::BaseGeometry *newGeometry = m_ResultImage->GetSlicedGeometry();
-  mitk::Point3D origin;
-  vtk2itk(cropIndex, origin);
-  this->GetInput()->GetGeometry()->IndexToWorld(origin, origin);
-  newGeometry->SetOrigin(origin);
-
-  auto *vtkimage = m_ResultImage->GetVtkImageData(0);
-
-  vtkSmartPointer<vtkImageChangeInformation> indexCoordinatesImageFilter =
-    vtkSmartPointer<vtkImageChangeInformation>::New();
-  indexCoordinatesImageFilter->SetInputData(vtkimage);
-  indexCoordinatesImageFilter->SetOutputOrigin(0.0, 0.0, 0.0);
+  const typename ImageType::SizeType &cropSize = cropRegion.GetSize();
+  const typename ImageType::SpacingType &spacing = input->GetSpacing();
+
+  vtkSmartPointer<vtkImageData> vtkimage = vtkSmartPointer<vtkImageData>::New();
+  vtkimage->SetDimensions(cropSize[0], cropSize[1], cropSize[2]);
+  vtkimage->SetSpacing(spacing[0], spacing[1], spacing[2]);
+  vtkimage->SetOrigin(0.0, 0.0, 0.0);
+  vtkimage->AllocateScalars(VTK_FLOAT, 1);
+  std::copy(result->GetBufferPointer(),
+            result->GetBufferPointer() + cropRegion.GetNumberOfPixels(),
+            static_cast<float *>(vtkimage->GetScalarPointer()));
 
   vtkSmartPointer<vtkMarchingCubes> marching = vtkSmartPointer<vtkMarchingCubes>::New();
   marching->ComputeScalarsOff();
   marching->ComputeNormalsOn();
   marching->ComputeGradientsOn();
-  marching->SetInputConnection(indexCoordinatesImageFilter->GetOutputPort());
+  marching->SetInputData(vtkimage);
   marching->SetValue(0, 0.0);
 
   marching->Update();
@@ -186,29 +287,27 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   vtkPolyData *polydata = marching->GetOutput();
 
   if ((!polydata) || (!polydata->GetNumberOfPoints()))
-    throw itk::ExceptionObject(__FILE__, __LINE__, "marching cubes has failed.");
+    itkExceptionMacro(<< "marching cubes has failed for label " << static_cast<LabelType>(label) << ".");
 
-  mitk::Vector3D spacing = newGeometry->GetSpacing();
+  // The marching cubes result is relative to the crop region
+  double cropOffset[3];
+  for (int i = 0; i < 3; ++i)
+    cropOffset[i] = cropIndex[i] * spacing[i];
 
   vtkPoints *points = polydata->GetPoints();
-  vtkMatrix4x4 *vtkmatrix = vtkMatrix4x4::New();
-  newGeometry->GetVtkTransform()->GetMatrix(vtkmatrix);
-  double(*matrix)[4] = vtkmatrix->Element;
-
-  for (int i = 0; i < 3; ++i)
-    for (int j = 0; j < 3; ++j)
-      matrix[i][j] /= spacing[j];
+  double(*matrix)[4] = indexToWorld->Element;
 
-  unsigned int n = points->GetNumberOfPoints();
+  const vtkIdType n = points->GetNumberOfPoints();
   double point[3];
 
-  for (unsigned int i = 0; i < n; i++)
+  for (vtkIdType i = 0; i < n; i++)
   {
     points->GetPoint(i, point);
+    for (int j = 0; j < 3; ++j)
+      point[j] += cropOffset[j];
     mitkVtkLinearTransformPoint(matrix, point, point);
     points->SetPoint(i, point);
   }
-  vtkmatrix->Delete();
 
   vtkSmartPointer<vtkCleanPolyData> cleanPolyDataFilter = vtkSmartPointer<vtkCleanPolyData>::New();
   cleanPolyDataFilter->SetInputData(polydata);
@@ -219,6 +318,5 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   cleanPolyDataFilter->PointMergingOn();
   cleanPolyDataFilter->Update();
 
-  mitk::Surface::Pointer output = this->GetOutput(0);
-  output->SetVtkPolyData(cleanPolyDataFilter->GetOutput(), 0);
+  return cleanPolyDataFilter->GetOutput();
 }
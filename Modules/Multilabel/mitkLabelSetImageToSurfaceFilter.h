@@ -19,6 +19,8 @@ found in the LICENSE file.
 #include <mitkSurfaceSource.h>
 
 #include <vtkMatrix4x4.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
 
 #include <itkImage.h>
 
@@ -29,7 +31,12 @@ namespace mitk
   /**
    * Generates surface meshes from a labelset image.
    * If you want to calculate a surface representation for all available labels,
-   * you may call GenerateAllLabelsOn().
+   * you may call GenerateAllLabelsOn(). In that case, the filter has one output
+   * per label (see GetLabelOfOutput()).
+   *
+   * The bounding boxes of all labels are determined in a single pass over the image.
+   * Afterwards, every label is thresholded, anti-aliased and meshed within its own
+   * bounding box only. The labels are distributed to up to GetNumberOfThreads() threads.
    */
   class MITKMULTILABEL_EXPORT LabelSetImageToSurfaceFilter : public SurfaceSource
   {
@@ -105,6 +112,17 @@ namespace mitk
      */
     itkSetMacro(Sigma, float);
 
+    /**
+     * Returns the label whose surface is stored in the output with the given index.
+     * Throws an exception if there is no such output.
+     */
+    LabelType GetLabelOfOutput(unsigned int index) const;
+
+    /**
+     * Returns the labels found in the input during the last update together with their number of voxels.
+     */
+    const LabelMapType &GetAvailableLabels() const { return m_AvailableLabels; }
+
   protected:
     LabelSetImageToSurfaceFilter();
 
@@ -124,11 +142,21 @@ namespace mitk
       out[2] = z;
     }
 
-    mitk::Image::Pointer m_ResultImage;
-
     template <typename TPixel, unsigned int VImageDimension>
     void InternalProcessing(const itk::Image<TPixel, VImageDimension> *input, mitk::Surface *surface);
 
+    /**
+    * Creates the surface of a single label within the given region of the input.
+    * Points are transformed to world coordinates by indexToWorld, which has to map
+    * index coordinates scaled by the spacing of the input to world coordinates.
+    */
+    template <typename TPixel, unsigned int VImageDimension>
+    vtkSmartPointer<vtkPolyData> CreateLabelSurface(const itk::Image<TPixel, VImageDimension> *input,
+                                                    TPixel label,
+                                                    const itk::ImageRegion<VImageDimension> &boundingBox,
+                                                    vtkMatrix4x4 *indexToWorld,
+                                                    unsigned int numberOfThreads) const;
+
     bool m_GenerateAllLabels;
 
     int m_RequestedLabel;
@@ -92,6 +92,21 @@ namespace mitk
                                                      const std::vector<unsigned char> *body = {},
                                                      const std::map<utility::string_t, utility::string_t> headers = {}) = 0;
 
+    /**
+     * @brief Executes a HTTP GET request in the mitkRESTClient class without extracting the response body
+     *
+     * The returned task finishes as soon as the response headers were received. The body can then be read
+     * chunk by chunk from web::http::http_response::body() while it is still being received, e.g. to parse
+     * large multipart responses without keeping them in memory completely.
+     *
+     * @param uri defines the URI the request is send to
+     * @param headers the headers for the request (optional)
+     * @return task to wait for, which throws mitk::Exception if the response status is not OK
+     */
+    virtual pplx::task<web::http::http_response> SendStreamingRequest(
+      const web::uri &uri,
+      const std::map<utility::string_t, utility::string_t> headers = {}) = 0;
+
     /**
      * @brief starts listening for requests if there isn't another observer listening and the port is free
      *
@@ -49,6 +49,19 @@ namespace mitk
                                      const utility::string_t &filePath,
                                      const std::map<utility::string_t, utility::string_t> headers);
 
+    /**
+     * @brief Executes a HTTP GET request with the given uri and returns a task waiting for the response headers
+     *
+     * The body is not extracted, it can be read from the response while it is still being received.
+     *
+     * @throw mitk::Exception if request went wrong or the response status is not OK
+     * @param uri the URI resulting the target of the HTTP request
+     * @param headers the additional headers to be set to the HTTP request
+     * @return task to wait for with the response
+     */
+    pplx::task<web::http::http_response> GetStream(const web::uri &uri,
+                                                   const std::map<utility::string_t, utility::string_t> headers);
+
     /**
      * @brief Executes a HTTP PUT request with given uri and the content given as json
      *
@@ -120,6 +120,40 @@ pplx::task<web::json::value> mitk::RESTClient::Get(const web::uri &uri,
     .then([=]() { return web::json::value(); });
 }
 
+pplx::task<http_response> mitk::RESTClient::GetStream(const web::uri &uri,
+                                                      const std::map<utility::string_t, utility::string_t> headers)
+{
+  auto client = std::make_shared<http_client>(uri, m_ClientConfig);
+  auto request = InitRequest(headers);
+  request.set_method(methods::GET);
+
+  // the client is captured to stay alive until the response headers are received
+  return client->request(request).then([client](pplx::task<http_response> responseTask) {
+    try
+    {
+      auto response = responseTask.get();
+
+      auto status = response.status_code();
+      if (status_codes::OK != status)
+      {
+        MITK_WARN << "Status: " << status;
+        mitkThrow() << "Streaming request answered with status " << status;
+      }
+
+      return response;
+    }
+    catch (const mitk::Exception &)
+    {
+      throw;
+    }
+    catch (const std::exception &e)
+    {
+      MITK_INFO << e.what();
+      mitkThrow() << "Getting response went wrong: " << e.what();
+    }
+  });
+}
+
 pplx::task<web::json::value> mitk::RESTClient::Put(const web::uri &uri, const web::json::value *content)
 {
   auto client = new http_client(uri, m_ClientConfig);
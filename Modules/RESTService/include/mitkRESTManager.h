@@ -79,6 +79,17 @@ namespace mitk
       const std::vector<unsigned char> *body = {},
       const std::map<utility::string_t, utility::string_t> headers = {}) override;
 
+    /**
+     * @brief Executes a HTTP GET request in the mitkRESTClient class without extracting the response body
+     *
+     * @param uri defines the URI the request is send to
+     * @param headers the headers for the request (optional)
+     * @return task to wait for, which unfolds the response as soon as its headers were received
+     */
+    pplx::task<web::http::http_response> SendStreamingRequest(
+      const web::uri &uri,
+      const std::map<utility::string_t, utility::string_t> headers = {}) override;
+
     /**
      * @brief starts listening for requests if there isn't another observer listening and the port is free
      *
@@ -30,8 +30,7 @@ found in the LICENSE file.
 
 #include <dcmtk/dcmrt/drtdose.h>
 
-#include <itkShiftScaleImageFilter.h>
-#include <itkCastImageFilter.h>
+#include <algorithm>
 
 namespace mitk
 {
@@ -48,24 +47,18 @@ namespace mitk
   RTDoseReaderService::~RTDoseReaderService() {}
 
   template<typename TPixel, unsigned int VImageDimension>
-  void RTDoseReaderService::MultiplyGridScaling(itk::Image<TPixel, VImageDimension>* image, float gridscale)
+  void RTDoseReaderService::DetermineMaxDose(itk::Image<TPixel, VImageDimension>* image, double gridscale)
   {
-    typedef itk::Image<Float32, VImageDimension> OutputImageType;
-    typedef itk::Image<TPixel, VImageDimension> InputImageType;
-
-    typedef itk::CastImageFilter<InputImageType, OutputImageType> CastFilterType;
-    typedef itk::ShiftScaleImageFilter<OutputImageType, OutputImageType> ScaleFilterType;
-    typename CastFilterType::Pointer castFilter = CastFilterType::New();
-    typename ScaleFilterType::Pointer scaleFilter = ScaleFilterType::New();
-
-    castFilter->SetInput(image);
-    scaleFilter->SetInput(castFilter->GetOutput());
-    scaleFilter->SetScale(gridscale);
-    scaleFilter->Update();
-    typename OutputImageType::Pointer scaledOutput = scaleFilter->GetOutput();
-    this->scaledDoseImage = mitk::Image::New();
-
-    mitk::CastToMitkImage(scaledOutput, this->scaledDoseImage);
+    // The stored pixel values are kept, the maximum dose is determined in a single pass over them
+    const TPixel* buffer = image->GetBufferPointer();
+    const std::size_t numberOfPixels = image->GetLargestPossibleRegion().GetNumberOfPixels();
+
+    TPixel maxValue = 0;
+    for (std::size_t i = 0; i < numberOfPixels; ++i)
+    {
+      maxValue = std::max(maxValue, buffer[i]);
+    }
+    this->m_MaxDose = static_cast<double>(maxValue) * gridscale;
   }
 
   std::vector<itk::SmartPointer<BaseData> > RTDoseReaderService::DoRead()
@@ -150,17 +143,16 @@ namespace mitk
       gridScaling = boost::lexical_cast<double>(findingsGridScaling.front().value);
     }
 
-    AccessByItk_1(originalImage, MultiplyGridScaling, gridScaling);
-
-    auto statistics = this->scaledDoseImage->GetStatistics();
-    double maxDose = statistics->GetScalarValueMax();
+    // The dose image keeps the stored pixel values. The dose grid scaling is attached as property and applied by
+    // the dose mappers and when dose values are derived from the image.
+    AccessByItk_1(originalImage, DetermineMaxDose, gridScaling);
 
-    this->scaledDoseImage->SetPropertyList(originalImage->GetPropertyList());
-    this->scaledDoseImage->SetProperty(mitk::RTConstants::PRESCRIBED_DOSE_PROPERTY_NAME.c_str(), mitk::DoubleProperty::New(0.8*maxDose));
+    originalImage->SetProperty(mitk::RTConstants::DOSE_GRID_SCALING_PROPERTY_NAME.c_str(), mitk::DoubleProperty::New(gridScaling));
+    originalImage->SetProperty(mitk::RTConstants::PRESCRIBED_DOSE_PROPERTY_NAME.c_str(), mitk::DoubleProperty::New(0.8*m_MaxDose));
     auto findings = ExtractPathsOfInterest(tagsOfInterestList, frames);
-    SetProperties(this->scaledDoseImage, findings);
+    SetProperties(originalImage, findings);
 
-    result.push_back(this->scaledDoseImage.GetPointer());
+    result.push_back(originalImage.GetPointer());
     return result;
   }
 
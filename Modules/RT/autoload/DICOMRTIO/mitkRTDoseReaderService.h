@@ -38,9 +38,9 @@ namespace mitk
     protected:
       /**
       * @brief Reads a dicom dataset from a RTDOSE file
-      * The method reads the PixelData from the DicomRT dose file and scales
-      * them with a factor for getting Gray-values instead of pixel-values.
-      * The Gray-values are stored in a mitkImage with a vtkColorTransferFunc.
+      * The method reads the PixelData from the DicomRT dose file and keeps the
+      * stored pixel values. The factor for getting Gray-values instead of pixel-values
+      * (Dose Grid Scaling) is stored in the property RTConstants::DOSE_GRID_SCALING_PROPERTY_NAME.
       * Relative values are used for coloring the image. The relative values are
       * relative to a PrescriptionDose defined in the RT-Plan. If there is no
       * RT-Plan file PrescriptionDose is set to 80% of the maximum dose.
@@ -50,14 +50,14 @@ namespace mitk
     private:
       RTDoseReaderService* Clone() const override;
         /**
-        * \brief Scales an image with a factor
+        * \brief Determines the maximum dose of an image with stored pixel values
         *
-        * \param gridscale the factor to scale with
+        * \param gridscale the factor that converts the pixel values into dose
         */
         template<typename TPixel, unsigned int VImageDimension>
-        void MultiplyGridScaling(itk::Image< TPixel, VImageDimension>* image, float gridscale);
+        void DetermineMaxDose(itk::Image< TPixel, VImageDimension>* image, double gridscale);
 
-        mitk::Image::Pointer scaledDoseImage;
+        double m_MaxDose = 0.0;
         us::ServiceRegistration<mitk::IFileReader> m_FileReaderServiceReg;
   };
 
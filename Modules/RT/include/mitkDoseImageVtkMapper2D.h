@@ -27,6 +27,10 @@ found in the LICENSE file.
 #include <vtkPropAssembly.h>
 #include <vtkCellArray.h>
 
+#include <array>
+#include <map>
+#include <vector>
+
 class vtkActor;
 class vtkPolyDataMapper;
 class vtkPlaneSource;
@@ -175,6 +179,15 @@ namespace mitk {
       For instance, if you zoom or pann, there is no need to recompute the contour. */
       vtkSmartPointer<vtkPolyData> m_OutlinePolyData;
 
+      /** \brief Origin and axes of the slice plane and the spacing of the slice, identifies the slice of an outline. */
+      typedef std::array<mitk::ScalarType, 11> OutlineCacheKeyType;
+      /** \brief Outlines of the slices rendered before. Scrolling back to a slice reuses its outline instead of
+      recomputing it. The cache is cleared whenever m_OutlineCacheState changes. */
+      std::map<OutlineCacheKeyType, vtkSmartPointer<vtkPolyData>> m_OutlineCache;
+      /** \brief Everything except the slice the cached outlines depend on, e.g. the modification times of the
+      data, the node and the iso dose levels, the reference dose and the reslice parameters. */
+      std::vector<double> m_OutlineCacheState;
+
       /** \brief Timestamp of last update of stored data. */
       itk::TimeStamp m_LastUpdateTime;
 
@@ -294,7 +307,18 @@ namespace mitk {
     bool RenderingGeometryIntersectsImage( const PlaneGeometry* renderingGeometry, SlicedGeometry3D* imageGeometry );
 
   private:
-    void CreateLevelOutline(mitk::BaseRenderer* renderer, const mitk::IsoDoseLevel* level, float pref, vtkSmartPointer<vtkPoints> points, vtkSmartPointer<vtkCellArray> lines,  vtkSmartPointer<vtkUnsignedCharArray> colors);
+    /** \brief Returns the outline of the current slice from the cache of the renderer, generates it with
+    CreateOutlinePolyData() if it is not cached.
+    \param resliceState: Reslice parameters the current slice was generated with
+    */
+    vtkSmartPointer<vtkPolyData> GetCachedOutlinePolyData(mitk::BaseRenderer* renderer,
+                                                          const PlaneGeometry* planeGeometry,
+                                                          const std::vector<double>& resliceState);
+
+    /** \brief Adds the outline of an iso dose level to the given poly data arrays.
+    \param doseSlice: The current slice converted into dose (Gy) as float image
+    */
+    void CreateLevelOutline(mitk::BaseRenderer* renderer, vtkImageData* doseSlice, const mitk::IsoDoseLevel* level, float pref, vtkSmartPointer<vtkPoints> points, vtkSmartPointer<vtkCellArray> lines,  vtkSmartPointer<vtkUnsignedCharArray> colors);
 
   };
 
@@ -31,6 +31,9 @@ namespace mitk
     mitk::DoseValueAbs referenceDose,
     bool showIsolinesGlobal = true);
 
+  /**Returns the factor that converts the stored pixel values of a dose image into dose (see
+  RTConstants::DOSE_GRID_SCALING_PROPERTY_NAME). It is 1.0 if the image stores the dose directly.*/
+  mitk::DoseValueAbs MITKRT_EXPORT GetDoseGridScaling(const mitk::BaseData* doseData);
 
 }
 
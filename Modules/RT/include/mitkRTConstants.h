@@ -34,6 +34,12 @@ struct MITKRT_EXPORT RTConstants
       */
   static const std::string PRESCRIBED_DOSE_PROPERTY_NAME;
 
+  /**
+      * Name of the property that encodes the factor that converts the stored pixel values of a dose image into dose (Gy).
+      * It is the value of the tag (3004,000E) - Dose Grid Scaling. Images without this property store the dose directly.
+      */
+  static const std::string DOSE_GRID_SCALING_PROPERTY_NAME;
+
   /**
       * Name of the property that encodes the reference dose that should be used for relative dose vizualization/evaluation purpose.
       * It is often the prescribed dose but may differ e.g. when to dose distributions sould be compared using the same reference.
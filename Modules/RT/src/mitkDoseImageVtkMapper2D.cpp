@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkPropertyNameHelper.h"
 #include <mitkAbstractTransformGeometry.h>
 #include <mitkDataNode.h>
+#include <mitkDoseNodeHelper.h>
 #include <mitkImageSliceSelector.h>
 #include <mitkIsoDoseLevelSetProperty.h>
 #include <mitkIsoDoseLevelVectorProperty.h>
@@ -46,6 +47,7 @@ found in the LICENSE file.
 #include <vtkImageData.h>
 #include <vtkImageExtractComponents.h>
 #include <vtkImageReslice.h>
+#include <vtkImageShiftScale.h>
 #include <vtkLookupTable.h>
 #include <vtkMatrix4x4.h>
 #include <vtkPlaneSource.h>
@@ -164,12 +166,12 @@ void mitk::DoseImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *ren
 
   // Initialize the interpolation mode for resampling; switch to nearest
   // neighbor if the input image is too small.
+  int interpolationMode = VTK_RESLICE_NEAREST;
   if ((input->GetDimension() >= 3) && (input->GetDimension(2) > 1))
   {
     VtkResliceInterpolationProperty *resliceInterpolationProperty;
     datanode->GetProperty(resliceInterpolationProperty, "reslice interpolation");
 
-    int interpolationMode = VTK_RESLICE_NEAREST;
     if (resliceInterpolationProperty != nullptr)
     {
       interpolationMode = resliceInterpolationProperty->GetInterpolation();
@@ -327,8 +329,12 @@ void mitk::DoseImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *ren
 
   if (showIsoLines) // contour rendering
   {
-    // generate contours/outlines
-    localStorage->m_OutlinePolyData = CreateOutlinePolyData(renderer);
+    // generate contours/outlines, unless they were generated for this slice before
+    const std::vector<double> resliceState = {static_cast<double>(interpolationMode),
+                                              static_cast<double>(thickSlicesMode),
+                                              static_cast<double>(thickSlicesNum),
+                                              inPlaneResampleExtentByGeometry ? 1.0 : 0.0};
+    localStorage->m_OutlinePolyData = this->GetCachedOutlinePolyData(renderer, planeGeometry, resliceState);
 
     float binaryOutlineWidth(1.0);
     if (datanode->GetFloatProperty("outline width", binaryOutlineWidth, renderer))
@@ -842,6 +848,108 @@ mitk::DoseImageVtkMapper2D::LocalStorage *mitk::DoseImageVtkMapper2D::GetLocalSt
   return m_LSH.GetLocalStorage(renderer);
 }
 
+vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::GetCachedOutlinePolyData(
+  mitk::BaseRenderer *renderer, const PlaneGeometry *planeGeometry, const std::vector<double> &resliceState)
+{
+  LocalStorage *localStorage = this->GetLocalStorage(renderer);
+
+  // the outlines of slices on non-planar geometries are not cached
+  if (planeGeometry == nullptr)
+  {
+    localStorage->m_OutlineCache.clear();
+    return this->CreateOutlinePolyData(renderer);
+  }
+
+  mitk::DataNode *datanode = this->GetDataNode();
+
+  // in-place changes of properties and iso dose levels do not modify the property lists,
+  // so their modification times are part of the state as well
+  std::vector<double> state = resliceState;
+  state.push_back(static_cast<double>(datanode->GetMTime()));
+  state.push_back(static_cast<double>(datanode->GetPropertyList()->GetMTime()));
+  state.push_back(static_cast<double>(datanode->GetPropertyList(renderer)->GetMTime()));
+  state.push_back(static_cast<double>(this->GetTimestep()));
+  state.push_back(this->CalculateLayerDepth(renderer));
+
+  float pref = 0.0f;
+  datanode->GetFloatProperty(mitk::RTConstants::REFERENCE_DOSE_PROPERTY_NAME.c_str(), pref);
+  state.push_back(pref);
+  state.push_back(mitk::GetDoseGridScaling(this->GetInput()));
+
+  mitk::IsoDoseLevelSetProperty::Pointer propIsoSet = dynamic_cast<mitk::IsoDoseLevelSetProperty *>(
+    datanode->GetProperty(mitk::RTConstants::DOSE_ISO_LEVELS_PROPERTY_NAME.c_str()));
+  if (propIsoSet.IsNotNull())
+  {
+    state.push_back(static_cast<double>(propIsoSet->GetMTime()));
+    mitk::IsoDoseLevelSet::Pointer isoDoseLevelSet = propIsoSet->GetValue();
+    if (isoDoseLevelSet.IsNotNull())
+    {
+      state.push_back(static_cast<double>(isoDoseLevelSet->GetMTime()));
+      for (mitk::IsoDoseLevelSet::ConstIterator doseIT = isoDoseLevelSet->Begin(); doseIT != isoDoseLevelSet->End();
+           ++doseIT)
+      {
+        state.push_back(static_cast<double>(doseIT->GetMTime()));
+      }
+    }
+  }
+
+  mitk::IsoDoseLevelVectorProperty::Pointer propfreeIsoVec = dynamic_cast<mitk::IsoDoseLevelVectorProperty *>(
+    datanode->GetProperty(mitk::RTConstants::DOSE_FREE_ISO_VALUES_PROPERTY_NAME.c_str()));
+  if (propfreeIsoVec.IsNotNull())
+  {
+    state.push_back(static_cast<double>(propfreeIsoVec->GetMTime()));
+    mitk::IsoDoseLevelVector::Pointer freeIsoDoseLevelVec = propfreeIsoVec->GetValue();
+    if (freeIsoDoseLevelVec.IsNotNull())
+    {
+      state.push_back(static_cast<double>(freeIsoDoseLevelVec->GetMTime()));
+      for (mitk::IsoDoseLevelVector::ConstIterator freeDoseIT = freeIsoDoseLevelVec->Begin();
+           freeDoseIT != freeIsoDoseLevelVec->End();
+           ++freeDoseIT)
+      {
+        state.push_back(static_cast<double>(freeDoseIT->Value()->GetMTime()));
+      }
+    }
+  }
+
+  if (state != localStorage->m_OutlineCacheState)
+  {
+    localStorage->m_OutlineCache.clear();
+    localStorage->m_OutlineCacheState = state;
+  }
+
+  const mitk::Point3D origin = planeGeometry->GetOrigin();
+  const mitk::Vector3D axis0 = planeGeometry->GetAxisVector(0);
+  const mitk::Vector3D axis1 = planeGeometry->GetAxisVector(1);
+  const LocalStorage::OutlineCacheKeyType key = {{origin[0],
+                                                  origin[1],
+                                                  origin[2],
+                                                  axis0[0],
+                                                  axis0[1],
+                                                  axis0[2],
+                                                  axis1[0],
+                                                  axis1[1],
+                                                  axis1[2],
+                                                  localStorage->m_mmPerPixel[0],
+                                                  localStorage->m_mmPerPixel[1]}};
+
+  auto finding = localStorage->m_OutlineCache.find(key);
+  if (finding != localStorage->m_OutlineCache.end())
+  {
+    return finding->second;
+  }
+
+  // limit the memory that is spent on outlines, e.g. when rotating or swiveling the planes
+  const std::size_t maxNumberOfCachedOutlines = 256;
+  if (localStorage->m_OutlineCache.size() >= maxNumberOfCachedOutlines)
+  {
+    localStorage->m_OutlineCache.clear();
+  }
+
+  vtkSmartPointer<vtkPolyData> polyData = this->CreateOutlinePolyData(renderer);
+  localStorage->m_OutlineCache.emplace(key, polyData);
+  return polyData;
+}
+
 vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(mitk::BaseRenderer *renderer)
 {
   vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();      // the points to draw
@@ -853,6 +961,15 @@ vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m
   float pref;
   this->GetDataNode()->GetFloatProperty(mitk::RTConstants::REFERENCE_DOSE_PROPERTY_NAME.c_str(), pref);
 
+  // The dose image keeps its stored pixel values, so the slice is converted into dose (Gy) with the dose grid scaling.
+  // Only the slice is converted, not the whole dose image.
+  vtkSmartPointer<vtkImageShiftScale> doseScaler = vtkSmartPointer<vtkImageShiftScale>::New();
+  doseScaler->SetInputData(this->GetLocalStorage(renderer)->m_ReslicedImage);
+  doseScaler->SetScale(mitk::GetDoseGridScaling(this->GetInput()));
+  doseScaler->SetOutputScalarTypeToFloat();
+  doseScaler->Update();
+  vtkImageData *doseSlice = doseScaler->GetOutput();
+
   mitk::IsoDoseLevelSetProperty::Pointer propIsoSet = dynamic_cast<mitk::IsoDoseLevelSetProperty *>(
     GetDataNode()->GetProperty(mitk::RTConstants::DOSE_ISO_LEVELS_PROPERTY_NAME.c_str()));
   mitk::IsoDoseLevelSet::Pointer isoDoseLevelSet = propIsoSet->GetValue();
@@ -862,7 +979,7 @@ vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m
   {
     if (doseIT->GetVisibleIsoLine())
     {
-      this->CreateLevelOutline(renderer, &(doseIT.Value()), pref, points, lines, colors);
+      this->CreateLevelOutline(renderer, doseSlice, &(doseIT.Value()), pref, points, lines, colors);
     } // end of if visible dose value
   }   // end of loop over all does values
 
@@ -876,7 +993,7 @@ vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m
   {
     if (freeDoseIT->Value()->GetVisibleIsoLine())
     {
-      this->CreateLevelOutline(renderer, freeDoseIT->Value(), pref, points, lines, colors);
+      this->CreateLevelOutline(renderer, doseSlice, freeDoseIT->Value(), pref, points, lines, colors);
     } // end of if visible dose value
   }   // end of loop over all does values
 
@@ -891,6 +1008,7 @@ vtkSmartPointer<vtkPolyData> mitk::DoseImageVtkMapper2D::CreateOutlinePolyData(m
 }
 
 void mitk::DoseImageVtkMapper2D::CreateLevelOutline(mitk::BaseRenderer *renderer,
+                                                    vtkImageData *doseSlice,
                                                     const mitk::IsoDoseLevel *level,
                                                     float pref,
                                                     vtkSmartPointer<vtkPoints> points,
@@ -900,13 +1018,13 @@ void mitk::DoseImageVtkMapper2D::CreateLevelOutline(mitk::BaseRenderer *renderer
   LocalStorage *localStorage = this->GetLocalStorage(renderer);
 
   // get the min and max index values of each direction
-  int *extent = localStorage->m_ReslicedImage->GetExtent();
+  int *extent = doseSlice->GetExtent();
   int xMin = extent[0];
   int xMax = extent[1];
   int yMin = extent[2];
   int yMax = extent[3];
 
-  int *dims = localStorage->m_ReslicedImage->GetDimensions(); // dimensions of the image
+  int *dims = doseSlice->GetDimensions(); // dimensions of the image
   int line = dims[0];                                         // how many pixels per line?
   // get the depth for each contour
   float depth = CalculateLayerDepth(renderer);
@@ -922,7 +1040,7 @@ void mitk::DoseImageVtkMapper2D::CreateLevelOutline(mitk::BaseRenderer *renderer
   float *currentPixel;
 
   // We take the pointer to the first pixel of the image
-  currentPixel = static_cast<float *>(localStorage->m_ReslicedImage->GetScalarPointer());
+  currentPixel = static_cast<float *>(doseSlice->GetScalarPointer());
 
   if (!currentPixel){
     mitkThrow() << "currentPixel invalid";
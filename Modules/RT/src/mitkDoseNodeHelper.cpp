@@ -25,6 +25,7 @@ found in the LICENSE file.
 #include <mitkTransferFunction.h>
 #include <mitkTransferFunctionProperty.h>
 #include <mitkRenderingModeProperty.h>
+#include <mitkProperties.h>
 
 
 void mitk::ConfigureNodeAsDoseNode(mitk::DataNode* doseNode, const mitk::IsoDoseLevelSet* colorPreset, mitk::DoseValueAbs referenceDose, bool showColorWashGlobal)
@@ -49,7 +50,8 @@ void mitk::ConfigureNodeAsDoseNode(mitk::DataNode* doseNode, const mitk::IsoDose
 
     if (showColorWashGlobal)
     {
-      //Generating the color wash
+      //Generating the color wash; the transfer function maps the stored pixel values of the image
+      const mitk::DoseValueAbs gridScaling = mitk::GetDoseGridScaling(doseImage);
       vtkSmartPointer<vtkColorTransferFunction> transferFunction = vtkSmartPointer<vtkColorTransferFunction>::New();
 
       for (mitk::IsoDoseLevelSet::ConstIterator itIsoDoseLevel = colorPreset->Begin(); itIsoDoseLevel != colorPreset->End(); ++itIsoDoseLevel)
@@ -59,7 +61,7 @@ void mitk::ConfigureNodeAsDoseNode(mitk::DataNode* doseNode, const mitk::IsoDose
         vtkSmartPointer<vtkMath> cCalc = vtkSmartPointer<vtkMath>::New();
         if (itIsoDoseLevel->GetVisibleColorWash()){
           cCalc->RGBToHSV(itIsoDoseLevel->GetColor()[0], itIsoDoseLevel->GetColor()[1], itIsoDoseLevel->GetColor()[2], &hsv[0], &hsv[1], &hsv[2]);
-          transferFunction->AddHSVPoint(itIsoDoseLevel->GetDoseValue()*referenceDose, hsv[0], hsv[1], hsv[2], 1.0, 1.0);
+          transferFunction->AddHSVPoint(itIsoDoseLevel->GetDoseValue()*referenceDose/gridScaling, hsv[0], hsv[1], hsv[2], 1.0, 1.0);
         }
       }
 
@@ -114,3 +116,18 @@ void mitk::ConfigureNodeAsIsoLineNode(mitk::DataNode* doseOutlineNode, const mit
     }
   }
 };
+
+mitk::DoseValueAbs mitk::GetDoseGridScaling(const mitk::BaseData* doseData)
+{
+  mitk::DoseValueAbs gridScaling = 1.0;
+  if (doseData != nullptr)
+  {
+    auto gridScalingProp = dynamic_cast<const mitk::DoubleProperty*>(
+      doseData->GetProperty(mitk::RTConstants::DOSE_GRID_SCALING_PROPERTY_NAME.c_str()).GetPointer());
+    if (gridScalingProp != nullptr && gridScalingProp->GetValue() > 0.0)
+    {
+      gridScaling = gridScalingProp->GetValue();
+    }
+  }
+  return gridScaling;
+}
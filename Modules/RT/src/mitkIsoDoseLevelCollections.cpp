@@ -89,6 +89,8 @@ void mitk::IsoDoseLevelSet::SetIsoDoseLevel(const IsoDoseLevel* level)
   this->m_IsoLevels.push_back(level->Clone());
 
   std::sort(this->m_IsoLevels.begin(), this->m_IsoLevels.end(),lesserIsoDoseLevel);
+
+  this->Modified();
 }
 
 bool mitk::IsoDoseLevelSet::DoseLevelExists(IsoLevelIndexType index) const
@@ -110,6 +112,7 @@ void mitk::IsoDoseLevelSet::DeleteIsoDoseLevel(DoseValueType value)
   if (pos != this->m_IsoLevels.end())
   {
     this->m_IsoLevels.erase(pos);
+    this->Modified();
   }
 }
 
@@ -118,6 +121,7 @@ void mitk::IsoDoseLevelSet::DeleteIsoDoseLevel(IsoLevelIndexType index)
   if (DoseLevelExists(index))
   {
     this->m_IsoLevels.erase(this->m_IsoLevels.begin()+index);
+    this->Modified();
   }
 }
 
@@ -139,4 +143,5 @@ mitk::IsoDoseLevelSet::IsoLevelIndexType mitk::IsoDoseLevelSet::Size(void) const
 void mitk::IsoDoseLevelSet::Reset(void)
 {
   this->m_IsoLevels.clear();
+  this->Modified();
 }
@@ -14,6 +14,7 @@ found in the LICENSE file.
 
 const std::string mitk::RTConstants::DOSE_PROPERTY_NAME = "dose";
 const std::string mitk::RTConstants::PRESCRIBED_DOSE_PROPERTY_NAME = "dose.PrescribedDose";
+const std::string mitk::RTConstants::DOSE_GRID_SCALING_PROPERTY_NAME = "dose.GridScaling";
 const std::string mitk::RTConstants::REFERENCE_DOSE_PROPERTY_NAME = "dose.ReferenceDose";
 const std::string mitk::RTConstants::REFERENCE_STRUCTURE_SET_PROPERTY_NAME = "plan.ReferenceStructureSet";
 const std::string mitk::RTConstants::REFERENCE_DESCRIPTION_DOSE_PROPERTY_NAME = "dose.ReferenceDescription";
@@ -14,10 +14,14 @@ found in the LICENSE file.
 #include <mitkTestFixture.h>
 
 #include <mitkRTConstants.h>
+#include <mitkDoseNodeHelper.h>
+#include <mitkImageCast.h>
 #include <mitkProperties.h>
 #include "mitkTemporoSpatialStringProperty.h"
 #include <mitkIOUtil.h>
 
+#include <itkImageRegionConstIterator.h>
+
 class mitkRTDoseReaderServiceTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkRTDoseReaderServiceTestSuite);
@@ -40,7 +44,31 @@ public:
   void TestDoseImage()
   {
       CPPUNIT_ASSERT_EQUAL_MESSAGE("image should not be null", m_doseImage.IsNotNull(), true);
-      CPPUNIT_ASSERT_EQUAL_MESSAGE("reference image and image should be equal", true, mitk::Equal(*m_doseImage, *m_referenceImage, mitk::eps, true));
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("image should keep the stored integer pixel values", true,
+        m_doseImage->GetPixelType().GetComponentType() != itk::ImageIOBase::FLOAT &&
+        m_doseImage->GetPixelType().GetComponentType() != itk::ImageIOBase::DOUBLE);
+
+      auto gridScalingProperty = dynamic_cast<mitk::DoubleProperty*>(m_doseImage->GetProperty(mitk::RTConstants::DOSE_GRID_SCALING_PROPERTY_NAME.c_str()).GetPointer());
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("grid scaling property should exist", gridScalingProperty != nullptr, true);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("grid scaling property is not as expected", 0.0010494648, gridScalingProperty->GetValue(), 1e-10);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("grid scaling helper is not as expected", 0.0010494648, mitk::GetDoseGridScaling(m_doseImage), 1e-10);
+
+      // the stored pixel values scaled with the grid scaling are the dose of the reference image
+      typedef itk::Image<double, 3> DoseImageType;
+      DoseImageType::Pointer storedValues;
+      DoseImageType::Pointer referenceDose;
+      mitk::CastToItkImage(m_doseImage, storedValues);
+      mitk::CastToItkImage(m_referenceImage, referenceDose);
+
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("reference image and image should have the same size", referenceDose->GetLargestPossibleRegion().GetSize(), storedValues->GetLargestPossibleRegion().GetSize());
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("reference image and image should have the same geometry", true, mitk::Equal(*(m_doseImage->GetGeometry()), *(m_referenceImage->GetGeometry()), mitk::eps, true));
+
+      itk::ImageRegionConstIterator<DoseImageType> storedIt(storedValues, storedValues->GetLargestPossibleRegion());
+      itk::ImageRegionConstIterator<DoseImageType> referenceIt(referenceDose, referenceDose->GetLargestPossibleRegion());
+      for (; !storedIt.IsAtEnd(); ++storedIt, ++referenceIt)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("dose is not as expected", referenceIt.Get(), storedIt.Get() * gridScalingProperty->GetValue(), 1e-5);
+      }
   }
 
   void TestProperties() {
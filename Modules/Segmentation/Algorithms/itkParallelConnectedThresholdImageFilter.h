@@ -0,0 +1,139 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#ifndef __itkParallelConnectedThresholdImageFilter_h
+#define __itkParallelConnectedThresholdImageFilter_h
+
+#include "itkImage.h"
+#include "itkImageToImageFilter.h"
+
+#include <functional>
+#include <vector>
+
+namespace itk
+{
+  /** \class ParallelConnectedThresholdImageFilter
+  * \brief Multi-threaded replacement for the itk::ConnectedThresholdImageFilter.
+  *
+  * Labels all pixels that are face connected to one of the seeds and whose values lie
+  * within [Lower, Upper] with the ReplaceValue. All other pixels are set to zero. The result
+  * is identical to the one of itk::ConnectedThresholdImageFilter with FaceConnectivity.
+  *
+  * Instead of a pixel wise flood fill, the image is split into slabs along its last
+  * dimension. Each thread collects the runs of thresholded pixels of the scanlines in its
+  * slab and merges overlapping runs of neighboring scanlines with a union-find structure.
+  * Afterwards the slab boundaries are merged and all runs that belong to a seed component
+  * are written to the output in parallel.
+  *
+  * The filter reports progress after each stage and can be aborted with AbortGenerateDataOn(),
+  * in which case an itk::ProcessAborted exception is thrown.
+  *
+  * \ingroup RegionGrowingSegmentation
+  */
+  template <class TInputImage, class TOutputImage>
+  class ITK_EXPORT ParallelConnectedThresholdImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+  {
+  public:
+    /** Standard class typedefs. */
+    typedef ParallelConnectedThresholdImageFilter Self;
+    typedef ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+    typedef SmartPointer<Self> Pointer;
+    typedef SmartPointer<const Self> ConstPointer;
+
+    /** Method for creation through the object factory. */
+    itkNewMacro(Self);
+
+    /** Run-time type information (and related methods).  */
+    itkTypeMacro(ParallelConnectedThresholdImageFilter, ImageToImageFilter);
+
+    typedef TInputImage InputImageType;
+    typedef typename InputImageType::PixelType InputImagePixelType;
+    typedef typename InputImageType::IndexType IndexType;
+    typedef typename InputImageType::SizeType SizeType;
+
+    typedef TOutputImage OutputImageType;
+    typedef typename OutputImageType::PixelType OutputImagePixelType;
+    typedef typename OutputImageType::RegionType OutputImageRegionType;
+
+    typedef std::vector<IndexType> SeedContainerType;
+
+    itkStaticConstMacro(ImageDimension, unsigned int, TInputImage::ImageDimension);
+
+    /** Set seed point. This will clear all seeds before. */
+    void SetSeed(const IndexType &seed);
+    void AddSeed(const IndexType &seed);
+    void ClearSeeds();
+    const SeedContainerType &GetSeeds() const { return m_Seeds; }
+
+    itkSetMacro(Lower, InputImagePixelType);
+    itkGetConstMacro(Lower, InputImagePixelType);
+    itkSetMacro(Upper, InputImagePixelType);
+    itkGetConstMacro(Upper, InputImagePixelType);
+
+    /** Value of the pixels that are connected to the seeds (default 1). */
+    itkSetMacro(ReplaceValue, OutputImagePixelType);
+    itkGetConstMacro(ReplaceValue, OutputImagePixelType);
+
+  protected:
+    ParallelConnectedThresholdImageFilter();
+    ~ParallelConnectedThresholdImageFilter() override{};
+
+    void PrintSelf(std::ostream &os, Indent indent) const override;
+
+    void GenerateInputRequestedRegion() override;
+    void EnlargeOutputRequestedRegion(DataObject *output) override;
+
+    void GenerateData() override;
+
+  private:
+    ParallelConnectedThresholdImageFilter(const Self &); // purposely not implemented
+    void operator=(const Self &);                        // purposely not implemented
+
+    /** A run of consecutive pixels [Begin, End) within one scanline that lie within the thresholds. */
+    struct Run
+    {
+      IndexValueType Begin;
+      IndexValueType End;
+    };
+
+    typedef SizeValueType RunIdType;
+
+    /** Calls function(sliceBegin, sliceEnd, chunk) for disjoint ranges of the last image dimension
+    * in parallel. Every chunk is processed by its own thread. */
+    void ParallelizeOverSlices(const std::function<void(IndexValueType, IndexValueType, unsigned int)> &function);
+
+    RunIdType FindRoot(RunIdType id);
+    void Union(RunIdType a, RunIdType b);
+
+    /** Unites all overlapping runs of the two given scanlines. */
+    void UniteScanlines(SizeValueType line, SizeValueType neighborLine);
+
+    void CheckAbort();
+
+    SeedContainerType m_Seeds;
+    InputImagePixelType m_Lower;
+    InputImagePixelType m_Upper;
+    OutputImagePixelType m_ReplaceValue;
+
+    unsigned int m_NumberOfChunks;
+
+    std::vector<Run> m_Runs;
+    std::vector<RunIdType> m_LineRunBegin;
+    std::vector<RunIdType> m_Parents;
+  };
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkParallelConnectedThresholdImageFilter.txx"
+#endif
+
+#endif
@@ -0,0 +1,368 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#ifndef _itkParallelConnectedThresholdImageFilter_txx
+#define _itkParallelConnectedThresholdImageFilter_txx
+
+#include "itkParallelConnectedThresholdImageFilter.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace itk
+{
+  template <class TInputImage, class TOutputImage>
+  ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::ParallelConnectedThresholdImageFilter()
+    : m_Lower(NumericTraits<InputImagePixelType>::NonpositiveMin()),
+      m_Upper(NumericTraits<InputImagePixelType>::max()),
+      m_ReplaceValue(NumericTraits<OutputImagePixelType>::OneValue()),
+      m_NumberOfChunks(1)
+  {
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::SetSeed(const IndexType &seed)
+  {
+    m_Seeds.clear();
+    this->AddSeed(seed);
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::AddSeed(const IndexType &seed)
+  {
+    m_Seeds.push_back(seed);
+    this->Modified();
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::ClearSeeds()
+  {
+    if (!m_Seeds.empty())
+    {
+      m_Seeds.clear();
+      this->Modified();
+    }
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+  {
+    Superclass::GenerateInputRequestedRegion();
+
+    if (this->GetInput())
+    {
+      auto *input = const_cast<InputImageType *>(this->GetInput());
+      input->SetRequestedRegionToLargestPossibleRegion();
+    }
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject *output)
+  {
+    Superclass::EnlargeOutputRequestedRegion(output);
+    output->SetRequestedRegionToLargestPossibleRegion();
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::ParallelizeOverSlices(
+    const std::function<void(IndexValueType, IndexValueType, unsigned int)> &function)
+  {
+    const auto numberOfSlices = static_cast<IndexValueType>(this->GetInput()->GetBufferedRegion().GetSize(ImageDimension - 1));
+
+    if (m_NumberOfChunks == 1)
+    {
+      function(0, numberOfSlices, 0);
+    }
+    else
+    {
+      std::vector<std::thread> threads;
+      threads.reserve(m_NumberOfChunks);
+
+      for (unsigned int chunk = 0; chunk < m_NumberOfChunks; ++chunk)
+      {
+        const IndexValueType sliceBegin = chunk * numberOfSlices / m_NumberOfChunks;
+        const IndexValueType sliceEnd = (chunk + 1) * numberOfSlices / m_NumberOfChunks;
+        threads.emplace_back(function, sliceBegin, sliceEnd, chunk);
+      }
+
+      for (auto &thread : threads)
+        thread.join();
+    }
+
+    this->CheckAbort();
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::CheckAbort()
+  {
+    if (this->GetAbortGenerateData())
+    {
+      ProcessAborted e(__FILE__, __LINE__);
+      e.SetLocation(ITK_LOCATION);
+      e.SetDescription("Region growing aborted by user.");
+      throw e;
+    }
+  }
+
+  template <class TInputImage, class TOutputImage>
+  typename ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::RunIdType
+    ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::FindRoot(RunIdType id)
+  {
+    // path halving keeps the invariant m_Parents[id] <= id
+    while (m_Parents[id] != id)
+    {
+      m_Parents[id] = m_Parents[m_Parents[id]];
+      id = m_Parents[id];
+    }
+
+    return id;
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::Union(RunIdType a, RunIdType b)
+  {
+    a = this->FindRoot(a);
+    b = this->FindRoot(b);
+
+    // always link to the smaller id, so that all ids of a component are >= its root
+    if (a < b)
+    {
+      m_Parents[b] = a;
+    }
+    else if (b < a)
+    {
+      m_Parents[a] = b;
+    }
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::UniteScanlines(SizeValueType line,
+                                                                                        SizeValueType neighborLine)
+  {
+    RunIdType i = m_LineRunBegin[line];
+    const RunIdType iEnd = m_LineRunBegin[line + 1];
+    RunIdType j = m_LineRunBegin[neighborLine];
+    const RunIdType jEnd = m_LineRunBegin[neighborLine + 1];
+
+    while (i < iEnd && j < jEnd)
+    {
+      const Run &run = m_Runs[i];
+      const Run &neighborRun = m_Runs[j];
+
+      if (run.Begin < neighborRun.End && neighborRun.Begin < run.End)
+      {
+        this->Union(i, j);
+      }
+
+      if (run.End < neighborRun.End)
+      {
+        ++i;
+      }
+      else
+      {
+        ++j;
+      }
+    }
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::GenerateData()
+  {
+    this->AllocateOutputs();
+
+    const InputImageType *input = this->GetInput();
+    OutputImageType *output = this->GetOutput();
+
+    const auto region = input->GetBufferedRegion();
+    const SizeType size = region.GetSize();
+
+    // A scanline is a line of pixels along the first dimension. Its id is the linear index
+    // of its position in the remaining dimensions.
+    SizeValueType lineStrides[ImageDimension];
+    lineStrides[0] = 0;
+    lineStrides[1] = 1;
+    for (unsigned int d = 2; d < ImageDimension; ++d)
+      lineStrides[d] = lineStrides[d - 1] * size[d - 1];
+
+    const auto numberOfSlices = static_cast<IndexValueType>(size[ImageDimension - 1]);
+    const SizeValueType linesPerSlice = lineStrides[ImageDimension - 1];
+    const SizeValueType numberOfLines = linesPerSlice * numberOfSlices;
+    const auto lineLength = static_cast<IndexValueType>(size[0]);
+
+    m_NumberOfChunks = std::max(1u, std::min(static_cast<unsigned int>(this->GetNumberOfThreads()), static_cast<unsigned int>(numberOfSlices)));
+
+    m_Runs.clear();
+    m_LineRunBegin.assign(numberOfLines + 1, 0);
+    m_Parents.clear();
+
+    // 1. Collect the runs of each scanline (the run count of line l is stored at l + 1)
+    const InputImagePixelType *inputBuffer = input->GetBufferPointer();
+    std::vector<std::vector<Run>> chunkRuns(m_NumberOfChunks);
+
+    this->ParallelizeOverSlices([&](IndexValueType sliceBegin, IndexValueType sliceEnd, unsigned int chunk) {
+      auto &runs = chunkRuns[chunk];
+
+      for (IndexValueType slice = sliceBegin; slice < sliceEnd; ++slice)
+      {
+        if (this->GetAbortGenerateData())
+          return;
+
+        for (SizeValueType line = slice * linesPerSlice; line < (slice + 1) * linesPerSlice; ++line)
+        {
+          const InputImagePixelType *pixels = inputBuffer + line * lineLength;
+          const auto firstRun = runs.size();
+          IndexValueType x = 0;
+
+          while (x < lineLength)
+          {
+            while (x < lineLength && !(m_Lower <= pixels[x] && pixels[x] <= m_Upper))
+              ++x;
+
+            if (x == lineLength)
+              break;
+
+            Run run;
+            run.Begin = x;
+
+            while (x < lineLength && m_Lower <= pixels[x] && pixels[x] <= m_Upper)
+              ++x;
+
+            run.End = x;
+            runs.push_back(run);
+          }
+
+          m_LineRunBegin[line + 1] = runs.size() - firstRun;
+        }
+      }
+    });
+
+    for (SizeValueType line = 0; line < numberOfLines; ++line)
+      m_LineRunBegin[line + 1] += m_LineRunBegin[line];
+
+    const RunIdType numberOfRuns = m_LineRunBegin[numberOfLines];
+    m_Runs.resize(numberOfRuns);
+    m_Parents.resize(numberOfRuns);
+
+    this->UpdateProgress(0.25f);
+
+    // 2. Merge overlapping runs of neighboring scanlines within each slab
+    this->ParallelizeOverSlices([&](IndexValueType sliceBegin, IndexValueType sliceEnd, unsigned int chunk) {
+      const SizeValueType firstLine = sliceBegin * linesPerSlice;
+      const SizeValueType endLine = sliceEnd * linesPerSlice;
+      const RunIdType firstRun = m_LineRunBegin[firstLine];
+
+      std::copy(chunkRuns[chunk].begin(), chunkRuns[chunk].end(), m_Runs.begin() + firstRun);
+      std::vector<Run>().swap(chunkRuns[chunk]);
+
+      for (RunIdType id = firstRun; id < m_LineRunBegin[endLine]; ++id)
+        m_Parents[id] = id;
+
+      for (SizeValueType line = firstLine; line < endLine; ++line)
+      {
+        if (this->GetAbortGenerateData())
+          return;
+
+        for (unsigned int d = 1; d < ImageDimension; ++d)
+        {
+          // neighbor scanlines of the previous slice belong to the previous slab and are merged afterwards
+          if ((line / lineStrides[d]) % size[d] > 0 && line - lineStrides[d] >= firstLine)
+            this->UniteScanlines(line, line - lineStrides[d]);
+        }
+      }
+    });
+
+    // 3. Merge the slab boundaries
+    for (unsigned int chunk = 1; chunk < m_NumberOfChunks; ++chunk)
+    {
+      this->CheckAbort();
+
+      const IndexValueType sliceBegin = chunk * numberOfSlices / m_NumberOfChunks;
+
+      for (SizeValueType line = sliceBegin * linesPerSlice; line < (sliceBegin + 1) * linesPerSlice; ++line)
+        this->UniteScanlines(line, line - linesPerSlice);
+    }
+
+    // Runs are only linked to smaller ids, so a single ascending pass resolves all roots
+    for (RunIdType id = 0; id < numberOfRuns; ++id)
+      m_Parents[id] = m_Parents[m_Parents[id]];
+
+    this->UpdateProgress(0.5f);
+    this->CheckAbort();
+
+    // 4. Determine the components that contain a seed
+    std::vector<char> isSelected(numberOfRuns, 0);
+
+    for (const auto &seed : m_Seeds)
+    {
+      if (!region.IsInside(seed))
+        continue;
+
+      SizeValueType line = 0;
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+        line += (seed[d] - region.GetIndex(d)) * lineStrides[d];
+
+      const IndexValueType x = seed[0] - region.GetIndex(0);
+      const auto lineBegin = m_Runs.begin() + m_LineRunBegin[line];
+      const auto lineEnd = m_Runs.begin() + m_LineRunBegin[line + 1];
+      const auto runIt = std::upper_bound(lineBegin, lineEnd, x, [](IndexValueType value, const Run &run) { return value < run.Begin; });
+
+      if (runIt != lineBegin && x < (runIt - 1)->End)
+        isSelected[m_Parents[(runIt - 1) - m_Runs.begin()]] = 1;
+    }
+
+    this->UpdateProgress(0.75f);
+
+    // 5. Write the selected runs to the output
+    OutputImagePixelType *outputBuffer = output->GetBufferPointer();
+
+    this->ParallelizeOverSlices([&](IndexValueType sliceBegin, IndexValueType sliceEnd, unsigned int) {
+      for (IndexValueType slice = sliceBegin; slice < sliceEnd; ++slice)
+      {
+        if (this->GetAbortGenerateData())
+          return;
+
+        for (SizeValueType line = slice * linesPerSlice; line < (slice + 1) * linesPerSlice; ++line)
+        {
+          OutputImagePixelType *pixels = outputBuffer + line * lineLength;
+          std::fill(pixels, pixels + lineLength, NumericTraits<OutputImagePixelType>::ZeroValue());
+
+          for (RunIdType id = m_LineRunBegin[line]; id < m_LineRunBegin[line + 1]; ++id)
+          {
+            if (isSelected[m_Parents[id]])
+              std::fill(pixels + m_Runs[id].Begin, pixels + m_Runs[id].End, m_ReplaceValue);
+          }
+        }
+      }
+    });
+
+    m_Runs.clear();
+    m_Runs.shrink_to_fit();
+    m_LineRunBegin.clear();
+    m_LineRunBegin.shrink_to_fit();
+    m_Parents.clear();
+    m_Parents.shrink_to_fit();
+
+    this->UpdateProgress(1.0f);
+  }
+
+  template <class TInputImage, class TOutputImage>
+  void ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream &os, Indent indent) const
+  {
+    Superclass::PrintSelf(os, indent);
+    os << indent << "Lower: " << static_cast<typename NumericTraits<InputImagePixelType>::PrintType>(m_Lower) << std::endl;
+    os << indent << "Upper: " << static_cast<typename NumericTraits<InputImagePixelType>::PrintType>(m_Upper) << std::endl;
+    os << indent << "ReplaceValue: " << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(m_ReplaceValue) << std::endl;
+    os << indent << "Number of seeds: " << m_Seeds.size() << std::endl;
+  }
+
+} // end namespace itk
+
+#endif
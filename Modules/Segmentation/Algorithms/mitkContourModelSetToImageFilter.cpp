@@ -13,16 +13,351 @@ found in the LICENSE file.
 #include "mitkContourModelSetToImageFilter.h"
 
 #include <mitkContourModelSet.h>
-#include <mitkContourModelUtils.h>
-#include <mitkExtractSliceFilter.h>
 #include <mitkImageWriteAccessor.h>
+#include <mitkPixelTypeMultiplex.h>
 #include <mitkProgressBar.h>
 #include <mitkTimeHelper.h>
 
-#include <mitkVtkImageOverwrite.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <thread>
+
+#include <vtkImageData.h>
+
+namespace
+{
+  struct Point2D
+  {
+    double U;
+    double V;
+  };
+
+  typedef std::vector<Point2D> Polygon2D;
+
+  /** All contours that lie in one slice of the output image, in index coordinates of the slice. */
+  struct SliceContours
+  {
+    unsigned int Axis;
+    itk::IndexValueType Index;
+    std::vector<Polygon2D> Polygons;
+  };
+
+  struct RasterizationSettings
+  {
+    mitk::ContourModelSetToImageFilter::FillRule Rule;
+    unsigned int PartialVolumeSamples; // 0 if only pixel centers are tested
+    unsigned int NumberOfThreads;
+  };
+
+  struct Edge
+  {
+    Point2D Begin;
+    Point2D End;
+    double MinimumV;
+    double MaximumV;
+    std::size_t Polygon;
+  };
+
+  struct Crossing
+  {
+    double U;
+    int Direction;
+    std::size_t Polygon;
+  };
+
+  typedef std::pair<double, double> Span;
+
+  // Pixel centers closer to a contour than this (in pixels) are filled, like vtkPolyDataToImageStencil does
+  const double BoundaryTolerance = 1e-6;
+
+  /** Walks over the scanlines of one slice in ascending order and keeps track of the edges that touch the current
+  scanline. */
+  class ScanlineRasterizer
+  {
+  public:
+    ScanlineRasterizer(const std::vector<Polygon2D> &polygons, mitk::ContourModelSetToImageFilter::FillRule rule)
+      : m_Rule(rule), m_NextEdge(0)
+    {
+      for (std::size_t p = 0; p < polygons.size(); ++p)
+      {
+        const auto &polygon = polygons[p];
+        for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+        {
+          const auto &a = polygon[j];
+          const auto &b = polygon[i];
+          m_Edges.push_back({a, b, std::min(a.V, b.V), std::max(a.V, b.V), p});
+        }
+      }
+
+      std::sort(m_Edges.begin(), m_Edges.end(), [](const Edge &a, const Edge &b) { return a.MinimumV < b.MinimumV; });
+    }
+
+    double GetMinimumV() const { return m_Edges.empty() ? 0.0 : m_Edges.front().MinimumV; }
+
+    double GetMaximumV() const
+    {
+      double maximum = m_Edges.empty() ? 0.0 : m_Edges.front().MaximumV;
+      for (const auto &edge : m_Edges)
+        maximum = std::max(maximum, edge.MaximumV);
+      return maximum;
+    }
+
+    /** Moves to the scanline v, which must not be less than the previous one. */
+    void SetScanline(double v)
+    {
+      while (m_NextEdge < m_Edges.size() && m_Edges[m_NextEdge].MinimumV - BoundaryTolerance <= v)
+        m_ActiveEdges.push_back(&m_Edges[m_NextEdge++]);
+
+      m_ActiveEdges.erase(std::remove_if(m_ActiveEdges.begin(),
+                                         m_ActiveEdges.end(),
+                                         [v](const Edge *edge) { return edge->MaximumV + BoundaryTolerance < v; }),
+                          m_ActiveEdges.end());
+      m_V = v;
+    }
+
+    /** Appends the intervals of the current scanline that lie inside the contours according to the fill rule. */
+    void GetInsideSpans(std::vector<Span> &spans)
+    {
+      m_Crossings.clear();
+      for (const auto *edge : m_ActiveEdges)
+      {
+        const auto &a = edge->Begin;
+        const auto &b = edge->End;
+        if ((a.V <= m_V) != (b.V <= m_V))
+          m_Crossings.push_back({a.U + (m_V - a.V) * (b.U - a.U) / (b.V - a.V), b.V > a.V ? 1 : -1, edge->Polygon});
+      }
+
+      if (m_Rule == mitk::ContourModelSetToImageFilter::Union)
+      {
+        // Every polygon crosses the scanline an even number of times
+        std::sort(m_Crossings.begin(), m_Crossings.end(), [](const Crossing &a, const Crossing &b) {
+          return a.Polygon < b.Polygon || (a.Polygon == b.Polygon && a.U < b.U);
+        });
+
+        for (std::size_t i = 0; i + 1 < m_Crossings.size(); i += 2)
+          spans.emplace_back(m_Crossings[i].U, m_Crossings[i + 1].U);
+      }
+      else
+      {
+        std::sort(m_Crossings.begin(), m_Crossings.end(), [](const Crossing &a, const Crossing &b) { return a.U < b.U; });
+
+        int winding = 0;
+        double begin = 0.0;
+        for (const auto &crossing : m_Crossings)
+        {
+          const bool wasInside = this->IsInside(winding);
+          winding += m_Rule == mitk::ContourModelSetToImageFilter::EvenOdd ? 1 : crossing.Direction;
+          const bool isInside = this->IsInside(winding);
+
+          if (!wasInside && isInside)
+            begin = crossing.U;
+          else if (wasInside && !isInside)
+            spans.emplace_back(begin, crossing.U);
+        }
+      }
+    }
+
+    /** Appends the intervals of the current scanline that are covered by the contour lines themselves. */
+    void GetBoundarySpans(std::vector<Span> &spans) const
+    {
+      for (const auto *edge : m_ActiveEdges)
+      {
+        const auto &a = edge->Begin;
+        const auto &b = edge->End;
+        const double dv = b.V - a.V;
+
+        double t0 = 0.0;
+        double t1 = 1.0;
+        if (dv != 0.0)
+        {
+          t0 = (m_V - BoundaryTolerance - a.V) / dv;
+          t1 = (m_V + BoundaryTolerance - a.V) / dv;
+          if (t0 > t1)
+            std::swap(t0, t1);
+          t0 = std::max(t0, 0.0);
+          t1 = std::min(t1, 1.0);
+        }
+
+        if (t0 <= t1)
+        {
+          const double u0 = a.U + t0 * (b.U - a.U);
+          const double u1 = a.U + t1 * (b.U - a.U);
+          spans.emplace_back(std::min(u0, u1), std::max(u0, u1));
+        }
+      }
+    }
+
+  private:
+    bool IsInside(int winding) const
+    {
+      return m_Rule == mitk::ContourModelSetToImageFilter::EvenOdd ? (winding & 1) != 0 : winding != 0;
+    }
+
+    mitk::ContourModelSetToImageFilter::FillRule m_Rule;
+    std::vector<Edge> m_Edges;
+    std::size_t m_NextEdge;
+    std::vector<const Edge *> m_ActiveEdges;
+    std::vector<Crossing> m_Crossings;
+    double m_V = 0.0;
+  };
+
+  /** Sorts the spans and merges overlapping ones. */
+  void MergeSpans(std::vector<Span> &spans)
+  {
+    if (spans.empty())
+      return;
+
+    std::sort(spans.begin(), spans.end());
+
+    std::size_t last = 0;
+    for (std::size_t i = 1; i < spans.size(); ++i)
+    {
+      if (spans[i].first <= spans[last].second)
+        spans[last].second = std::max(spans[last].second, spans[i].second);
+      else
+        spans[++last] = spans[i];
+    }
+    spans.resize(last + 1);
+  }
+
+  template <typename TPixel>
+  void RasterizeSlice(TPixel *volume,
+                      const unsigned int *dimensions,
+                      const SliceContours &slice,
+                      const RasterizationSettings &settings)
+  {
+    const std::size_t strides[3] = {1, dimensions[0], static_cast<std::size_t>(dimensions[0]) * dimensions[1]};
+    const unsigned int uAxis = slice.Axis == 0 ? 1 : 0;
+    const unsigned int vAxis = slice.Axis == 2 ? 1 : 2;
+    const auto width = static_cast<itk::IndexValueType>(dimensions[uAxis]);
+    const auto height = static_cast<itk::IndexValueType>(dimensions[vAxis]);
+
+    ScanlineRasterizer rasterizer(slice.Polygons, settings.Rule);
+
+    const auto firstRow =
+      std::max<itk::IndexValueType>(0, static_cast<itk::IndexValueType>(std::ceil(rasterizer.GetMinimumV() - 1.0)));
+    const auto lastRow = std::min<itk::IndexValueType>(
+      height - 1, static_cast<itk::IndexValueType>(std::floor(rasterizer.GetMaximumV() + 1.0)));
+
+    const unsigned int samples = settings.PartialVolumeSamples;
+    std::vector<Span> spans;
+    std::vector<double> coverage(samples > 0 ? width : 0);
+
+    for (auto row = firstRow; row <= lastRow; ++row)
+    {
+      TPixel *line = volume + slice.Index * strides[slice.Axis] + row * strides[vAxis];
+      const std::size_t step = strides[uAxis];
+
+      if (samples == 0)
+      {
+        spans.clear();
+        rasterizer.SetScanline(row);
+        rasterizer.GetInsideSpans(spans);
+        rasterizer.GetBoundarySpans(spans);
+
+        for (const auto &span : spans)
+        {
+          const auto begin = std::max<itk::IndexValueType>(
+            0, static_cast<itk::IndexValueType>(std::ceil(span.first - BoundaryTolerance)));
+          const auto end = std::min<itk::IndexValueType>(
+            width - 1, static_cast<itk::IndexValueType>(std::floor(span.second + BoundaryTolerance)));
+          for (auto u = begin; u <= end; ++u)
+            line[u * step] = 1;
+        }
+      }
+      else
+      {
+        // Sample positions are (k + 0.5) / samples - 0.5 for the k-th sample of a scanline
+        std::fill(coverage.begin(), coverage.end(), 0.0);
+        const auto lastSample = static_cast<itk::IndexValueType>(width) * samples - 1;
+
+        for (unsigned int subRow = 0; subRow < samples; ++subRow)
+        {
+          spans.clear();
+          rasterizer.SetScanline(row - 0.5 + (subRow + 0.5) / samples);
+          rasterizer.GetInsideSpans(spans);
+          MergeSpans(spans);
+
+          for (const auto &span : spans)
+          {
+            const auto begin = std::max<itk::IndexValueType>(
+              0, static_cast<itk::IndexValueType>(std::ceil((span.first + 0.5) * samples - 0.5)));
+            const auto end = std::min<itk::IndexValueType>(
+              lastSample, static_cast<itk::IndexValueType>(std::floor((span.second + 0.5) * samples - 0.5)));
+            for (auto k = begin; k <= end; ++k)
+              coverage[k / samples] += 1.0;
+          }
+        }
+
+        const double sampleWeight = 1.0 / (samples * samples);
+        for (itk::IndexValueType u = 0; u < width; ++u)
+        {
+          if (coverage[u] > 0.0)
+            line[u * step] = std::max(line[u * step], static_cast<TPixel>(coverage[u] * sampleWeight));
+        }
+      }
+    }
+  }
+
+  template <typename TPixel>
+  void RasterizeSlices(const mitk::PixelType &,
+                       void *volume,
+                       const unsigned int *dimensions,
+                       const std::vector<SliceContours> &slices,
+                       const RasterizationSettings &settings)
+  {
+    auto *buffer = static_cast<TPixel *>(volume);
+
+    // Slices of different orientations intersect, so only slices of the same orientation are processed concurrently
+    auto sliceBegin = slices.begin();
+    while (sliceBegin != slices.end())
+    {
+      const auto axis = sliceBegin->Axis;
+      const auto sliceEnd =
+        std::find_if(sliceBegin, slices.end(), [axis](const SliceContours &slice) { return slice.Axis != axis; });
+
+      std::atomic<std::size_t> nextSlice(0);
+      const auto numberOfSlices = static_cast<std::size_t>(sliceEnd - sliceBegin);
+
+      auto rasterize = [&]() {
+        for (std::size_t i = nextSlice++; i < numberOfSlices; i = nextSlice++)
+          RasterizeSlice(buffer, dimensions, *(sliceBegin + i), settings);
+      };
+
+      const auto numberOfThreads =
+        static_cast<std::size_t>(std::max(1u, std::min<unsigned int>(settings.NumberOfThreads, numberOfSlices)));
+
+      if (numberOfThreads == 1)
+      {
+        rasterize();
+      }
+      else
+      {
+        std::vector<std::thread> threads;
+        threads.reserve(numberOfThreads);
+        for (std::size_t thread = 0; thread < numberOfThreads; ++thread)
+          threads.emplace_back(rasterize);
+
+        for (auto &thread : threads)
+          thread.join();
+      }
+
+      sliceBegin = sliceEnd;
+    }
+  }
+}
 
 mitk::ContourModelSetToImageFilter::ContourModelSetToImageFilter()
-  : m_MakeOutputBinary(true), m_TimeStep(0), m_ReferenceImage(nullptr)
+  : m_MakeOutputBinary(true),
+    m_TimeStep(0),
+    m_FillRule(Union),
+    m_PartialVolume(false),
+    m_PartialVolumeSamples(4),
+    m_NumberOfThreads(0),
+    m_ReferenceImage(nullptr)
 {
   // Create the output.
   itk::DataObject::Pointer output = this->MakeOutput(0);
@@ -54,7 +389,11 @@ void mitk::ContourModelSetToImageFilter::GenerateOutputInformation()
       (m_ReferenceImage->GetTimeGeometry() == nullptr))
     return;
 
-  if (m_MakeOutputBinary)
+  if (m_PartialVolume)
+  {
+    output->Initialize(mitk::MakeScalarPixelType<float>(), *m_ReferenceImage->GetTimeGeometry(), 1);
+  }
+  else if (m_MakeOutputBinary)
   {
     output->Initialize(mitk::MakeScalarPixelType<unsigned char>(), *m_ReferenceImage->GetTimeGeometry(), 1);
   }
@@ -111,6 +450,11 @@ void mitk::ContourModelSetToImageFilter::GenerateData()
 {
   auto *contourSet = const_cast<mitk::ContourModelSet *>(this->GetInput());
 
+  if (!contourSet || contourSet->GetContourModelList()->size() == 0)
+  {
+    mitkThrow() << "No contours specified!";
+  }
+
   // Initializing progressbar
   unsigned int num_contours = contourSet->GetContourModelList()->size();
   mitk::ProgressBar::GetInstance()->AddStepsToDo(num_contours);
@@ -125,113 +469,92 @@ void mitk::ContourModelSetToImageFilter::GenerateData()
     mitkThrow() << "Error creating output for specified image!";
   }
 
-  if (!contourSet || contourSet->GetContourModelList()->size() == 0)
-  {
-    mitkThrow() << "No contours specified!";
-  }
-
   mitk::BaseGeometry *outputImageGeo = outputImage->GetGeometry(m_TimeStep);
 
-  // Create mitkVtkImageOverwrite which is needed to write the slice back into the volume
-  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+  const unsigned int dimensions[3] = {
+    outputImage->GetDimension(0), outputImage->GetDimension(1), outputImage->GetDimension(2)};
 
-  // Create ExtractSliceFilter for extracting the corresponding slices from the volume
-  mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-  extractor->SetInput(outputImage);
-  extractor->SetTimeStep(m_TimeStep);
-  extractor->SetResliceTransformByGeometry(outputImageGeo);
+  // Sort the contours by slice, so that all contours of a slice are rasterized at once
+  std::map<std::pair<unsigned int, itk::IndexValueType>, std::vector<Polygon2D>> contoursBySlice;
 
-  // Fill each contour of the contourmodelset into the image
-  auto it = contourSet->Begin();
-  auto end = contourSet->End();
-  while (it != end)
+  for (auto it = contourSet->Begin(); it != contourSet->End(); ++it)
   {
     mitk::ContourModel *contour = it->GetPointer();
 
-    // 1. Create slice geometry using the contour points
-    mitk::PlaneGeometry::Pointer plane = mitk::PlaneGeometry::New();
-    mitk::Point3D point3D, tempPoint;
-    mitk::Vector3D normal;
+    if (contour->GetNumberOfVertices() < 3)
+      continue;
 
-    mitk::Image::Pointer slice;
+    std::vector<mitk::Point3D> indexPoints;
+    indexPoints.reserve(contour->GetNumberOfVertices());
 
-    int sliceIndex;
-    bool isFrontside = true;
-    bool isRotated = false;
+    mitk::Point3D minimum, maximum;
+    minimum.Fill(std::numeric_limits<double>::max());
+    maximum.Fill(std::numeric_limits<double>::lowest());
 
-    // Determine plane orientation
-    point3D = contour->GetVertexAt(0)->Coordinates;
-    tempPoint = contour->GetVertexAt(contour->GetNumberOfVertices() * 0.25)->Coordinates;
-    mitk::Vector3D vec = point3D - tempPoint;
-    vec.Normalize();
-    outputImageGeo->WorldToIndex(point3D, point3D);
-
-    mitk::PlaneGeometry::PlaneOrientation orientation;
-    if (mitk::Equal(vec[0], 0))
-    {
-      orientation = mitk::PlaneGeometry::Sagittal;
-      sliceIndex = point3D[0];
-    }
-    else if (mitk::Equal(vec[1], 0))
+    for (auto vertexIt = contour->Begin(); vertexIt != contour->End(); ++vertexIt)
     {
-      orientation = mitk::PlaneGeometry::Frontal;
-      sliceIndex = point3D[1];
+      mitk::Point3D indexPoint;
+      outputImageGeo->WorldToIndex((*vertexIt)->Coordinates, indexPoint);
+      indexPoints.push_back(indexPoint);
+
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        minimum[i] = std::min(minimum[i], indexPoint[i]);
+        maximum[i] = std::max(maximum[i], indexPoint[i]);
+      }
     }
-    else if (mitk::Equal(vec[2], 0))
+
+    // Determine plane orientation
+    unsigned int axis = 0;
+    for (unsigned int i = 1; i < 3; ++i)
     {
-      orientation = mitk::PlaneGeometry::Axial;
-      sliceIndex = point3D[2];
+      if (maximum[i] - minimum[i] < maximum[axis] - minimum[axis])
+        axis = i;
     }
-    else
+
+    if (maximum[axis] - minimum[axis] > 0.5)
     {
       // TODO Maybe rotate geometry to extract slice?
       MITK_ERROR
         << "Cannot detect correct slice number! Only axial, sagittal and frontal oriented contours are supported!";
-      return;
+      continue;
     }
 
-    // Initialize plane using the detected orientation
-    plane->InitializeStandardPlane(outputImageGeo, orientation, sliceIndex, isFrontside, isRotated);
-    point3D = plane->GetOrigin();
-    normal = plane->GetNormal();
-    normal.Normalize();
-    point3D += normal * 0.5; // pixelspacing is 1, so half the spacing is 0.5
-    plane->SetOrigin(point3D);
-
-    // 2. Extract slice at the given position
-    extractor->SetWorldGeometry(plane);
-    extractor->SetVtkOutputRequest(false);
-    reslice->SetOverwriteMode(false);
+    const auto sliceIndex = static_cast<itk::IndexValueType>(std::lround(0.5 * (minimum[axis] + maximum[axis])));
+    if (sliceIndex < 0 || sliceIndex >= static_cast<itk::IndexValueType>(dimensions[axis]))
+      continue;
 
-    extractor->Modified();
-    extractor->Update();
+    const unsigned int uAxis = axis == 0 ? 1 : 0;
+    const unsigned int vAxis = axis == 2 ? 1 : 2;
 
-    slice = extractor->GetOutput();
-    slice->DisconnectPipeline();
+    Polygon2D polygon;
+    polygon.reserve(indexPoints.size());
+    for (const auto &indexPoint : indexPoints)
+      polygon.push_back({indexPoint[uAxis], indexPoint[vAxis]});
 
-    // 3. Fill contour into slice
-    mitk::ContourModel::Pointer projectedContour =
-      mitk::ContourModelUtils::ProjectContourTo2DSlice(slice, contour);
-    mitk::ContourModelUtils::FillContourInSlice(projectedContour, slice, outputImage);
-
-    // 4. Write slice back into image volume
-    reslice->SetInputSlice(slice->GetVtkImageData());
-
-    // set overwrite mode to true to write back to the image volume
-    reslice->SetOverwriteMode(true);
-    reslice->Modified();
+    contoursBySlice[std::make_pair(axis, sliceIndex)].push_back(std::move(polygon));
+  }
 
-    extractor->Modified();
-    extractor->Update();
+  std::vector<SliceContours> slices;
+  slices.reserve(contoursBySlice.size());
+  for (auto &slice : contoursBySlice)
+    slices.push_back({slice.first.first, slice.first.second, std::move(slice.second)});
 
-    reslice->SetInputSlice(nullptr);
+  RasterizationSettings settings;
+  settings.Rule = m_FillRule;
+  settings.PartialVolumeSamples = m_PartialVolume ? m_PartialVolumeSamples : 0;
+  settings.NumberOfThreads = m_NumberOfThreads > 0 ? m_NumberOfThreads : std::thread::hardware_concurrency();
 
-    // Progress
-    mitk::ProgressBar::GetInstance()->Progress();
+  {
+    mitk::ImageWriteAccessor writeAccess(outputImage, outputImage->GetVolumeData(m_TimeStep));
+    void *volume = writeAccess.GetData();
+    const mitk::PixelType pixelType = outputImage->GetPixelType();
 
-    ++it;
+    mitkPixelTypeMultiplex4(RasterizeSlices, pixelType, volume, dimensions, slices, settings);
   }
 
+  mitk::ProgressBar::GetInstance()->Progress(num_contours);
+
   outputImage->Modified();
   outputImage->GetVtkImageData()->Modified();
 }
@@ -22,6 +22,20 @@ namespace mitk
 
   /**
     * @brief Fills a given mitk::ContourModelSet into a given mitk::Image
+    *
+    * Every contour has to lie in an axial, frontal or sagittal slice of the reference image. The contours
+    * are sorted by slice and all contours of a slice are rasterized at once with a scanline algorithm.
+    * The slices are distributed over several threads.
+    *
+    * The FillRule determines how the contours of one slice are combined:
+    * - Union (default): every contour is filled on its own and the results are combined.
+    * - EvenOdd: pixels that are enclosed by an odd number of contours are filled, so nested contours form holes.
+    * - NonZero: pixels around which the contours have a non-zero winding number are filled, so holes
+    *   have to be oriented opposite to the enclosing contour.
+    *
+    * By default a pixel is filled if its center lies inside or on a contour. If PartialVolume is
+    * enabled, the output is a float image that holds the fraction of each pixel that is covered by the
+    * contours, estimated with PartialVolumeSamples x PartialVolumeSamples samples per pixel.
     * @ingroup Process
     */
   class MITKSEGMENTATION_EXPORT ContourModelSetToImageFilter : public ImageSource
@@ -36,6 +50,29 @@ namespace mitk
 
     itkSetMacro(TimeStep, unsigned int);
 
+    enum FillRule
+    {
+      Union,
+      EvenOdd,
+      NonZero
+    };
+
+    itkSetEnumMacro(FillRule, FillRule);
+    itkGetEnumMacro(FillRule, FillRule);
+
+    /** @brief If true, the output holds the fraction of each pixel that is covered by the contours. */
+    itkSetMacro(PartialVolume, bool);
+    itkGetMacro(PartialVolume, bool);
+    itkBooleanMacro(PartialVolume);
+
+    /** @brief Number of samples per pixel and direction used to estimate the partial volume (default 4). */
+    itkSetClampMacro(PartialVolumeSamples, unsigned int, 1, 64);
+    itkGetMacro(PartialVolumeSamples, unsigned int);
+
+    /** @brief Number of threads used for rasterization. 0 (default) uses the number of hardware threads. */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetMacro(NumberOfThreads, unsigned int);
+
     /**
        * Allocates a new output object and returns it. Currently the
        * index idx is not evaluated.
@@ -85,6 +122,14 @@ namespace mitk
 
     unsigned int m_TimeStep;
 
+    FillRule m_FillRule;
+
+    bool m_PartialVolume;
+
+    unsigned int m_PartialVolumeSamples;
+
+    unsigned int m_NumberOfThreads;
+
     const mitk::Image *m_ReferenceImage;
   };
 }
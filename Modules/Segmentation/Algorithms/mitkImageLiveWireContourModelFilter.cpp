@@ -27,6 +27,7 @@ mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
   m_CostFunction = CostFunctionType::New();
   m_ShortestPathFilter = ShortestPathImageFilterType::New();
   m_ShortestPathFilter->SetCostFunction(m_CostFunction);
+  m_ShortestPathFilter->SetReuseSearchTree(true);
   m_UseDynamicCostMap = false;
   m_TimeStep = 0;
 }
@@ -131,11 +132,13 @@ void mitk::ImageLiveWireContourModelFilter::ItkPreProcessImage(const itk::Image<
 void mitk::ImageLiveWireContourModelFilter::ClearRepulsivePoints()
 {
   m_CostFunction->ClearRepulsivePoints();
+  this->Modified();
 }
 
 void mitk::ImageLiveWireContourModelFilter::AddRepulsivePoint(const itk::Index<2> &idx)
 {
   m_CostFunction->AddRepulsivePoint(idx);
+  this->Modified();
 }
 
 void mitk::ImageLiveWireContourModelFilter::DumpMaskImage()
@@ -149,6 +152,7 @@ void mitk::ImageLiveWireContourModelFilter::DumpMaskImage()
 void mitk::ImageLiveWireContourModelFilter::RemoveRepulsivePoint(const itk::Index<2> &idx)
 {
   m_CostFunction->RemoveRepulsivePoint(idx);
+  this->Modified();
 }
 
 void mitk::ImageLiveWireContourModelFilter::SetRepulsivePoints(const ShortestPathType &points)
@@ -160,11 +164,11 @@ void mitk::ImageLiveWireContourModelFilter::SetRepulsivePoints(const ShortestPat
   {
     m_CostFunction->AddRepulsivePoint((*iter));
   }
+  this->Modified();
 }
 
 void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
 {
-  // compute the requested region for itk filters
   InternalImageType::IndexType startPoint, endPoint;
 
   startPoint[0] = m_StartPointInIndex[0];
@@ -173,29 +177,15 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
   endPoint[0] = m_EndPointInIndex[0];
   endPoint[1] = m_EndPointInIndex[1];
 
-  // minimum value in each direction for startRegion
-  InternalImageType::IndexType startRegion;
-  startRegion[0] = startPoint[0] < endPoint[0] ? startPoint[0] : endPoint[0];
-  startRegion[1] = startPoint[1] < endPoint[1] ? startPoint[1] : endPoint[1];
-
-  // maximum value in each direction for size
-  InternalImageType::SizeType size;
-  size[0] = std::abs(startPoint[0] - endPoint[0]) + 1;
-  size[1] = std::abs(startPoint[1] - endPoint[1]) + 1;
-
-  CostFunctionType::RegionType region;
-  region.SetSize(size);
-  region.SetIndex(startRegion);
-
-  // inputImage->SetRequestedRegion(region);
-
   // extracts features from image and calculates costs
   // m_CostFunction->SetImage(m_InternalImage);
   m_CostFunction->SetStartIndex(startPoint);
   m_CostFunction->SetEndIndex(endPoint);
-  m_CostFunction->SetRequestedRegion(region);
   m_CostFunction->SetUseCostMap(m_UseDynamicCostMap);
 
+  // Nothing above modifies the cost function as long as the start point and the cost map stay the same. The shortest
+  // path filter then continues the search of the last update instead of starting over for every new end point.
+
   // calculate shortest path between start and end point
   m_ShortestPathFilter->SetFullNeighborsMode(true);
   // m_ShortestPathFilter->SetInput( m_CostFunction->SetImage(m_InternalImage) );
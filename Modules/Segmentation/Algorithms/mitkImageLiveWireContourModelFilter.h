@@ -39,6 +39,10 @@ namespace mitk
    \note On the fly training will only be used for next update.
    The computation uses the last calculated segment to map cost according to features in the area of the segment.
 
+   The costs of the input image are computed once per input. As long as only the end point changes between two
+   updates (e.g. while the mouse is moved), the search of the last update is continued, so the path to a new end
+   point is usually available by just tracing it back.
+
    Caution: time support currently not available. Filter will always work on the first
    timestep in its current implementation.
 
@@ -14,10 +14,15 @@ found in the LICENSE file.
 
 #include <mitkManualSegmentationToSurfaceFilter.h>
 
+#include <vtkImageClip.h>
 #include <vtkImageShiftScale.h>
 #include <vtkImageConstantPad.h>
+#include <vtkImageReslice.h>
 #include <vtkSmartPointer.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "mitkProgressBar.h"
 
 mitk::ManualSegmentationToSurfaceFilter::ManualSegmentationToSurfaceFilter()
@@ -71,18 +76,29 @@ void mitk::ManualSegmentationToSurfaceFilter::GenerateData()
 
       auto padFilter = vtkSmartPointer<vtkImageConstantPad>::New();
       padFilter->SetInputData(vtkimage);
+      padFilter->SetNumberOfThreads(this->GetNumberOfThreads());
       padFilter->SetOutputWholeExtent(extent.data());
       padFilter->UpdateInformation();
       padFilter->Update();
       vtkimage = padFilter->GetOutput();
     }
 
+    if (m_BlockSize > 0)
+    {
+      // The image is pre-processed block by block, see CreateBlock()
+      ProgressBar::GetInstance()->Progress(3);
+      CreateSurface(t, vtkimage, surface, thresholdExpanded);
+      ProgressBar::GetInstance()->Progress();
+      continue;
+    }
+
     // Median -->smooth 3D
     // MITK_INFO << (m_MedianFilter3D ? "Applying median..." : "No median filtering");
     if (m_MedianFilter3D)
     {
       vtkImageMedian3D *median = vtkImageMedian3D::New();
       median->SetInputData(vtkimage);                                                       // RC++ (VTK < 5.0)
+      median->SetNumberOfThreads(this->GetNumberOfThreads());
       median->SetKernelSize(m_MedianKernelSizeX, m_MedianKernelSizeY, m_MedianKernelSizeZ); // Std: 3x3x3
       median->ReleaseDataFlagOn();
       median->UpdateInformation();
@@ -98,6 +114,7 @@ void mitk::ManualSegmentationToSurfaceFilter::GenerateData()
     {
       vtkImageResample *imageresample = vtkImageResample::New();
       imageresample->SetInputData(vtkimage);
+      imageresample->SetNumberOfThreads(this->GetNumberOfThreads());
 
       // Set Spacing Manual to 1mm in each direction (Original spacing is lost during image processing)
       imageresample->SetAxisOutputSpacing(0, m_InterpolationX);
@@ -116,10 +133,12 @@ void mitk::ManualSegmentationToSurfaceFilter::GenerateData()
       vtkImageShiftScale *scalefilter = vtkImageShiftScale::New();
       scalefilter->SetScale(100);
       scalefilter->SetInputData(vtkimage);
+      scalefilter->SetNumberOfThreads(this->GetNumberOfThreads());
       scalefilter->Update();
 
       vtkImageGaussianSmooth *gaussian = vtkImageGaussianSmooth::New();
       gaussian->SetInputConnection(scalefilter->GetOutputPort());
+      gaussian->SetNumberOfThreads(this->GetNumberOfThreads());
       gaussian->SetDimensionality(3);
       gaussian->SetRadiusFactor(0.49);
       gaussian->SetStandardDeviation(m_GaussianStandardDeviation);
@@ -169,6 +188,122 @@ void mitk::ManualSegmentationToSurfaceFilter::GenerateData()
   }
 };
 
+void mitk::ManualSegmentationToSurfaceFilter::GetBlockGrid(vtkImageData *vtkimage, int extent[6], double spacing[3])
+{
+  Superclass::GetBlockGrid(vtkimage, extent, spacing);
+
+  if (!m_Interpolation)
+    return;
+
+  // Sample the resampled grid only within the input image
+  const double outputSpacing[3] = {m_InterpolationX, m_InterpolationY, m_InterpolationZ};
+
+  for (int i = 0; i < 3; ++i)
+  {
+    const double factor = spacing[i] / outputSpacing[i];
+    extent[2 * i] = static_cast<int>(std::ceil(extent[2 * i] * factor - 1e-6));
+    extent[2 * i + 1] = static_cast<int>(std::floor(extent[2 * i + 1] * factor + 1e-6));
+    spacing[i] = outputSpacing[i];
+  }
+}
+
+vtkSmartPointer<vtkImageData> mitk::ManualSegmentationToSurfaceFilter::CreateBlock(vtkImageData *vtkimage,
+                                                                                    const int extent[6])
+{
+  int gridExtent[6];
+  double gridSpacing[3];
+  this->GetBlockGrid(vtkimage, gridExtent, gridSpacing);
+
+  int inputExtent[6];
+  double inputSpacing[3];
+  vtkimage->GetExtent(inputExtent);
+  vtkimage->GetSpacing(inputSpacing);
+
+  // The Gaussian filter works on the (resampled) grid and needs a margin of its kernel radius
+  const int gaussianRadius =
+    m_UseGaussianImageSmooth ? static_cast<int>(m_GaussianStandardDeviation * 0.49) + 1 : 0;
+
+  int smoothedExtent[6];
+  for (int i = 0; i < 3; ++i)
+  {
+    smoothedExtent[2 * i] = std::max(extent[2 * i] - gaussianRadius, gridExtent[2 * i]);
+    smoothedExtent[2 * i + 1] = std::min(extent[2 * i + 1] + gaussianRadius, gridExtent[2 * i + 1]);
+  }
+
+  // The median filter works on the input grid and needs a margin of its kernel radius,
+  // the linear interpolation needs one more voxel
+  const int medianRadius[3] = {m_MedianFilter3D ? m_MedianKernelSizeX / 2 : 0,
+                               m_MedianFilter3D ? m_MedianKernelSizeY / 2 : 0,
+                               m_MedianFilter3D ? m_MedianKernelSizeZ / 2 : 0};
+
+  int inputBlockExtent[6];
+  for (int i = 0; i < 3; ++i)
+  {
+    const double factor = gridSpacing[i] / inputSpacing[i];
+    inputBlockExtent[2 * i] = std::max(
+      static_cast<int>(std::floor(smoothedExtent[2 * i] * factor)) - medianRadius[i] - 1, inputExtent[2 * i]);
+    inputBlockExtent[2 * i + 1] = std::min(
+      static_cast<int>(std::ceil(smoothedExtent[2 * i + 1] * factor)) + medianRadius[i] + 1, inputExtent[2 * i + 1]);
+  }
+
+  vtkSmartPointer<vtkImageClip> inputClipFilter = vtkSmartPointer<vtkImageClip>::New();
+  inputClipFilter->SetInputData(vtkimage);
+  inputClipFilter->SetOutputWholeExtent(inputBlockExtent);
+  inputClipFilter->ClipDataOn();
+  inputClipFilter->Update();
+
+  vtkSmartPointer<vtkImageData> block = inputClipFilter->GetOutput();
+
+  if (m_MedianFilter3D)
+  {
+    vtkSmartPointer<vtkImageMedian3D> median = vtkSmartPointer<vtkImageMedian3D>::New();
+    median->SetInputData(block);
+    median->SetNumberOfThreads(this->GetNumberOfThreads());
+    median->SetKernelSize(m_MedianKernelSizeX, m_MedianKernelSizeY, m_MedianKernelSizeZ);
+    median->Update();
+    block = median->GetOutput();
+  }
+
+  if (m_Interpolation)
+  {
+    // Resample explicitly onto the grid of GetBlockGrid(), so that neighboring blocks match
+    vtkSmartPointer<vtkImageReslice> reslice = vtkSmartPointer<vtkImageReslice>::New();
+    reslice->SetInputData(block);
+    reslice->SetNumberOfThreads(this->GetNumberOfThreads());
+    reslice->SetInterpolationModeToLinear();
+    reslice->SetOutputOrigin(vtkimage->GetOrigin());
+    reslice->SetOutputSpacing(gridSpacing);
+    reslice->SetOutputExtent(smoothedExtent);
+    reslice->Update();
+    block = reslice->GetOutput();
+  }
+
+  if (m_UseGaussianImageSmooth)
+  {
+    vtkSmartPointer<vtkImageShiftScale> scalefilter = vtkSmartPointer<vtkImageShiftScale>::New();
+    scalefilter->SetScale(100);
+    scalefilter->SetInputData(block);
+    scalefilter->SetNumberOfThreads(this->GetNumberOfThreads());
+
+    vtkSmartPointer<vtkImageGaussianSmooth> gaussian = vtkSmartPointer<vtkImageGaussianSmooth>::New();
+    gaussian->SetInputConnection(scalefilter->GetOutputPort());
+    gaussian->SetNumberOfThreads(this->GetNumberOfThreads());
+    gaussian->SetDimensionality(3);
+    gaussian->SetRadiusFactor(0.49);
+    gaussian->SetStandardDeviation(m_GaussianStandardDeviation);
+    gaussian->Update();
+    block = gaussian->GetOutput();
+  }
+
+  vtkSmartPointer<vtkImageClip> clipFilter = vtkSmartPointer<vtkImageClip>::New();
+  clipFilter->SetInputData(block);
+  clipFilter->SetOutputWholeExtent(const_cast<int *>(extent));
+  clipFilter->ClipDataOn();
+  clipFilter->Update();
+
+  return clipFilter->GetOutput();
+}
+
 void mitk::ManualSegmentationToSurfaceFilter::SetMedianKernelSize(int x, int y, int z)
 {
   m_MedianKernelSizeX = x;
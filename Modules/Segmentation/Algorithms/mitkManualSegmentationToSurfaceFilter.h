@@ -33,6 +33,14 @@ namespace mitk
    * resulting isotropic image has 1mm isotropic voxel by default. But
    * can be varied freely.
    *
+   * If a block size is set (see ImageToSurfaceFilter::SetBlockSize()), the median filter, the
+   * interpolation and the Gaussian filter are applied block by block as well. Every block is
+   * pre-processed together with a margin that covers the filter kernels, so that the peak memory
+   * only depends on the block size.
+   *
+   * The multi-threaded VTK image filters of the pre-processing use GetNumberOfThreads() threads, so
+   * callers that run several of these filters concurrently can restrict each of them.
+   *
    * @ingroup ImageFilters
    * @ingroup Process
    */
@@ -149,6 +157,9 @@ namespace mitk
     ManualSegmentationToSurfaceFilter();
     ~ManualSegmentationToSurfaceFilter() override;
 
+    void GetBlockGrid(vtkImageData *vtkimage, int extent[6], double spacing[3]) override;
+    vtkSmartPointer<vtkImageData> CreateBlock(vtkImageData *vtkimage, const int extent[6]) override;
+
     bool m_MedianFilter3D;
     int m_MedianKernelSizeX, m_MedianKernelSizeY, m_MedianKernelSizeZ;
     bool m_UseGaussianImageSmooth; // Gaussian Filter
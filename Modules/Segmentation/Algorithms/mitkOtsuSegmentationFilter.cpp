@@ -11,14 +11,24 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkOtsuSegmentationFilter.h"
-#include "itkOtsuMultipleThresholdsImageFilter.h"
+#include "itkOtsuMultipleThresholdsCalculator.h"
+#include "itkScalarImageToHistogramGenerator.h"
+#include "itkThresholdLabelerImageFilter.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
 
 struct paramContainer
 {
-  paramContainer(unsigned int numThresholds, bool useValley, unsigned int numBins, mitk::Image::Pointer image)
-    : m_NumberOfThresholds(numThresholds), m_ValleyEmphasis(useValley), m_NumberOfBins(numBins), m_Image(image)
+  paramContainer(unsigned int numThresholds,
+                 bool useValley,
+                 unsigned int numBins,
+                 mitk::Image::Pointer image,
+                 itk::DataObject::ConstPointer *histogram)
+    : m_NumberOfThresholds(numThresholds),
+      m_ValleyEmphasis(useValley),
+      m_NumberOfBins(numBins),
+      m_Image(image),
+      m_Histogram(histogram)
   {
   }
 
@@ -26,6 +36,8 @@ struct paramContainer
   bool m_ValleyEmphasis;
   unsigned int m_NumberOfBins;
   mitk::Image::Pointer m_Image;
+  /** Cached histogram of the input. Is (re)computed if it is null or of another type.*/
+  itk::DataObject::ConstPointer *m_Histogram;
 };
 
 template <typename TPixel, unsigned int VImageDimension>
@@ -33,31 +45,52 @@ void AccessItkOtsuFilter(const itk::Image<TPixel, VImageDimension> *itkImage, pa
 {
   typedef itk::Image<TPixel, VImageDimension> itkInputImageType;
   typedef itk::Image<mitk::OtsuSegmentationFilter::OutputPixelType, VImageDimension> itkOutputImageType;
-  typedef itk::OtsuMultipleThresholdsImageFilter<itkInputImageType, itkOutputImageType> OtsuFilterType;
-
-  typename OtsuFilterType::Pointer filter = OtsuFilterType::New();
-  filter->SetNumberOfThresholds(params.m_NumberOfThresholds);
-  filter->SetInput(itkImage);
-  filter->SetValleyEmphasis(params.m_ValleyEmphasis);
-  filter->SetNumberOfHistogramBins(params.m_NumberOfBins);
+  typedef itk::Statistics::ScalarImageToHistogramGenerator<itkInputImageType> HistogramGeneratorType;
+  typedef typename HistogramGeneratorType::HistogramType HistogramType;
+  typedef itk::OtsuMultipleThresholdsCalculator<HistogramType> CalculatorType;
+  typedef itk::ThresholdLabelerImageFilter<itkInputImageType, itkOutputImageType> LabelerType;
 
+  // The same steps as in itk::OtsuMultipleThresholdsImageFilter, but the histogram is kept, because
+  // it does not depend on the number of thresholds or the valley emphasis.
   try
   {
-    filter->Update();
+    typename HistogramType::ConstPointer histogram = dynamic_cast<const HistogramType *>(params.m_Histogram->GetPointer());
+    if (histogram.IsNull())
+    {
+      typename HistogramGeneratorType::Pointer histogramGenerator = HistogramGeneratorType::New();
+      histogramGenerator->SetInput(itkImage);
+      histogramGenerator->SetNumberOfBins(params.m_NumberOfBins);
+      histogramGenerator->Compute();
+
+      histogram = histogramGenerator->GetOutput();
+      *params.m_Histogram = histogram.GetPointer();
+    }
+
+    typename CalculatorType::Pointer calculator = CalculatorType::New();
+    calculator->SetInputHistogram(histogram);
+    calculator->SetNumberOfThresholds(params.m_NumberOfThresholds);
+    calculator->SetValleyEmphasis(params.m_ValleyEmphasis);
+    calculator->Compute();
+
+    typename LabelerType::Pointer labeler = LabelerType::New();
+    labeler->SetInput(itkImage);
+    labeler->SetRealThresholds(calculator->GetOutput());
+    labeler->SetLabelOffset(0);
+    labeler->Update();
+
+    mitk::CastToMitkImage<itkOutputImageType>(labeler->GetOutput(), params.m_Image);
   }
   catch (...)
   {
+    *params.m_Histogram = nullptr;
     mitkThrow() << "itkOtsuFilter error.";
   }
-
-  mitk::CastToMitkImage<itkOutputImageType>(filter->GetOutput(), params.m_Image);
-  return;
 }
 
 namespace mitk
 {
   OtsuSegmentationFilter::OtsuSegmentationFilter()
-    : m_NumberOfThresholds(2), m_ValleyEmphasis(false), m_NumberOfBins(128)
+    : m_NumberOfThresholds(2), m_ValleyEmphasis(false), m_NumberOfBins(128), m_HistogramNumberOfBins(0)
   {
   }
 
@@ -65,8 +98,18 @@ namespace mitk
   void OtsuSegmentationFilter::GenerateData()
   {
     mitk::Image::ConstPointer mitkImage = GetInput();
+
+    if (m_Histogram.IsNotNull() &&
+        (mitkImage.GetPointer() != m_HistogramInput.GetPointer() || mitkImage->GetMTime() > m_Histogram->GetMTime() ||
+         m_NumberOfBins != m_HistogramNumberOfBins))
+    {
+      m_Histogram = nullptr;
+    }
+    m_HistogramInput = mitkImage;
+    m_HistogramNumberOfBins = m_NumberOfBins;
+
     AccessByItk_n(mitkImage,
                   AccessItkOtsuFilter,
-                  (paramContainer(m_NumberOfThresholds, m_ValleyEmphasis, m_NumberOfBins, this->GetOutput())));
+                  (paramContainer(m_NumberOfThresholds, m_ValleyEmphasis, m_NumberOfBins, this->GetOutput(), &m_Histogram)));
   }
 }
@@ -29,7 +29,9 @@ namespace mitk
 
     This class being an mitk::ImageToImageFilter performs a multiple threshold otsu image segmentation based on the
     image histogram.
-    Internally, the itk::OtsuMultipleThresholdsImageFilter is used.
+    Internally, the same steps as in itk::OtsuMultipleThresholdsImageFilter are performed. The histogram
+    of the input is kept as long as the input and the number of bins do not change, so changing only the
+    number of thresholds or the valley emphasis of a reused filter does not need to revisit the image.
 
     $Author: somebody$
   */
@@ -52,10 +54,21 @@ namespace mitk
         MITK_WARN << "Tried to set an invalid number of thresholds in the OtsuSegmentationFilter.";
         return;
       }
-      m_NumberOfThresholds = number;
+      if (m_NumberOfThresholds != number)
+      {
+        m_NumberOfThresholds = number;
+        this->Modified();
+      }
     }
 
-    void SetValleyEmphasis(bool useValley) { m_ValleyEmphasis = useValley; }
+    void SetValleyEmphasis(bool useValley)
+    {
+      if (m_ValleyEmphasis != useValley)
+      {
+        m_ValleyEmphasis = useValley;
+        this->Modified();
+      }
+    }
     void SetNumberOfBins(unsigned int number)
     {
       if (number < 1)
@@ -63,7 +76,11 @@ namespace mitk
         MITK_WARN << "Tried to set an invalid number of bins in the OtsuSegmentationFilter.";
         return;
       }
-      m_NumberOfBins = number;
+      if (m_NumberOfBins != number)
+      {
+        m_NumberOfBins = number;
+        this->Modified();
+      }
     }
 
   protected:
@@ -77,6 +94,11 @@ namespace mitk
     bool m_ValleyEmphasis;
     unsigned int m_NumberOfBins;
 
+    itk::DataObject::ConstPointer m_Histogram;
+    /** Input the histogram was computed for. It is held, so that a new input can not be mistaken for it
+      * just because it was allocated at the address of a freed one.*/
+    Image::ConstPointer m_HistogramInput;
+    unsigned int m_HistogramNumberOfBins;
   }; // class
 
 } // namespace
@@ -0,0 +1,293 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkRegionGrowing3DAlgorithm.h"
+#include "itkParallelConnectedThresholdImageFilter.h"
+
+#include <mitkITKImageImport.h>
+#include <mitkImageAccessByItk.h>
+#include <mitkImageTimeSelector.h>
+#include <mitkPointSet.h>
+
+#include <itkCommand.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace mitk
+{
+  RegionGrowing3DAlgorithm::RegionGrowing3DAlgorithm()
+    : m_Mutex(itk::FastMutexLock::New()),
+      m_Progress(0.0f),
+      m_CancelRequested(false),
+      m_WorkerStarted(false),
+      m_WorkerJoined(false)
+  {
+  }
+
+  RegionGrowing3DAlgorithm::~RegionGrowing3DAlgorithm()
+  {
+  }
+
+  void RegionGrowing3DAlgorithm::Initialize(const NonBlockingAlgorithm *other)
+  {
+    Superclass::Initialize(other);
+
+    double lowerThreshold(std::numeric_limits<double>::lowest());
+    double upperThreshold(std::numeric_limits<double>::max());
+    unsigned int timeStep(0);
+
+    if (other)
+    {
+      other->GetParameter("Lower threshold", lowerThreshold);
+      other->GetParameter("Upper threshold", upperThreshold);
+      other->GetParameter("Time step", timeStep);
+    }
+
+    SetParameter("Lower threshold", lowerThreshold);
+    SetParameter("Upper threshold", upperThreshold);
+    SetParameter("Time step", timeStep);
+  }
+
+  bool RegionGrowing3DAlgorithm::ReadyToRun()
+  {
+    try
+    {
+      Image::Pointer image;
+      GetPointerParameter("Input", image);
+
+      PointSet::Pointer seedPoints;
+      GetPointerParameter("Seed points", seedPoints);
+
+      const bool readyToRun = image.IsNotNull() && image->GetDimension() >= 3 && seedPoints.IsNotNull() && seedPoints->GetSize() > 0;
+
+      if (readyToRun)
+      {
+        // StartAlgorithm() spawns the worker thread right after this check
+        m_Mutex->Lock();
+        m_WorkerStarted = true;
+        m_Mutex->Unlock();
+      }
+
+      return readyToRun;
+    }
+    catch (std::invalid_argument &)
+    {
+      return false;
+    }
+  }
+
+  Image::Pointer RegionGrowing3DAlgorithm::GetResult() const
+  {
+    m_Mutex->Lock();
+    Image::Pointer result = m_Result;
+    m_Mutex->Unlock();
+
+    return result;
+  }
+
+  float RegionGrowing3DAlgorithm::GetProgress() const
+  {
+    m_Mutex->Lock();
+    float progress = m_Progress;
+    m_Mutex->Unlock();
+
+    return progress;
+  }
+
+  void RegionGrowing3DAlgorithm::Cancel()
+  {
+    m_Mutex->Lock();
+    if (!m_WorkerStarted || m_WorkerJoined)
+    {
+      // no worker thread, or StopAlgorithm() would join the already joined thread again
+      m_Mutex->Unlock();
+      return;
+    }
+    m_CancelRequested = true;
+    if (m_RunningFilter.IsNotNull())
+      m_RunningFilter->AbortGenerateDataOn();
+    m_Mutex->Unlock();
+
+    StopAlgorithm();
+
+    // the worker thread has finished, so the next run starts normally
+    m_Mutex->Lock();
+    m_CancelRequested = false;
+    m_WorkerJoined = true;
+    m_Mutex->Unlock();
+  }
+
+  void RegionGrowing3DAlgorithm::ThreadedUpdateSuccessful()
+  {
+    m_Mutex->Lock();
+    m_WorkerStarted = false;
+    m_WorkerJoined = false;
+    m_Mutex->Unlock();
+
+    Superclass::ThreadedUpdateSuccessful();
+  }
+
+  void RegionGrowing3DAlgorithm::ThreadedUpdateFailed()
+  {
+    m_Mutex->Lock();
+    m_WorkerStarted = false;
+    m_WorkerJoined = false;
+    m_Mutex->Unlock();
+
+    Superclass::ThreadedUpdateFailed();
+  }
+
+  void RegionGrowing3DAlgorithm::OnFilterProgress(itk::Object *caller, const itk::EventObject &)
+  {
+    auto filter = dynamic_cast<itk::ProcessObject *>(caller);
+
+    if (nullptr != filter)
+    {
+      m_Mutex->Lock();
+      m_Progress = filter->GetProgress();
+      // Update() resets the abort flag before the first progress event, so a Cancel() that
+      // came before the filter was started is applied here
+      if (m_CancelRequested)
+        filter->AbortGenerateDataOn();
+      m_Mutex->Unlock();
+
+      InvokeEvent(itk::ProgressEvent());
+    }
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void RegionGrowing3DAlgorithm::StartRegionGrowing(const itk::Image<TPixel, VImageDimension> *itkImage,
+                                                    const BaseGeometry *imageGeometry,
+                                                    const PointSet *seedPoints,
+                                                    double lowerThreshold,
+                                                    double upperThreshold,
+                                                    Image::Pointer &result)
+  {
+    typedef itk::Image<TPixel, VImageDimension> InputImageType;
+    typedef itk::Image<DefaultSegmentationDataType, VImageDimension> OutputImageType;
+    typedef itk::ParallelConnectedThresholdImageFilter<InputImageType, OutputImageType> RegionGrowingFilterType;
+
+    typename RegionGrowingFilterType::Pointer regionGrower = RegionGrowingFilterType::New();
+    regionGrower->SetInput(itkImage);
+
+    // Clamp the thresholds to the range of the pixel type
+    lowerThreshold = std::max(lowerThreshold, static_cast<double>(itk::NumericTraits<TPixel>::NonpositiveMin()));
+    upperThreshold = std::min(upperThreshold, static_cast<double>(itk::NumericTraits<TPixel>::max()));
+    regionGrower->SetLower(static_cast<TPixel>(lowerThreshold));
+    regionGrower->SetUpper(static_cast<TPixel>(upperThreshold));
+
+    for (auto it = seedPoints->Begin(); it != seedPoints->End(); ++it)
+    {
+      itk::Index<3> seedIndex;
+      imageGeometry->WorldToIndex(it->Value(), seedIndex);
+
+      typename InputImageType::IndexType itkSeedIndex;
+      for (unsigned int d = 0; d < VImageDimension; ++d)
+        itkSeedIndex[d] = seedIndex[d];
+
+      regionGrower->AddSeed(itkSeedIndex);
+    }
+
+    auto command = itk::MemberCommand<RegionGrowing3DAlgorithm>::New();
+    command->SetCallbackFunction(this, &RegionGrowing3DAlgorithm::OnFilterProgress);
+    regionGrower->AddObserver(itk::ProgressEvent(), command);
+
+    m_Mutex->Lock();
+    m_RunningFilter = regionGrower.GetPointer();
+    m_Mutex->Unlock();
+
+    try
+    {
+      regionGrower->Update();
+    }
+    catch (...)
+    {
+      m_Mutex->Lock();
+      m_RunningFilter = nullptr;
+      m_Mutex->Unlock();
+      throw;
+    }
+
+    m_Mutex->Lock();
+    m_RunningFilter = nullptr;
+    m_Mutex->Unlock();
+
+    result = GrabItkImageMemory(regionGrower->GetOutput());
+  }
+
+  bool RegionGrowing3DAlgorithm::ThreadedUpdateFunction()
+  {
+    Image::Pointer image;
+    GetPointerParameter("Input", image);
+
+    PointSet::Pointer seedPoints;
+    GetPointerParameter("Seed points", seedPoints);
+
+    double lowerThreshold(0.0);
+    GetParameter("Lower threshold", lowerThreshold);
+
+    double upperThreshold(0.0);
+    GetParameter("Upper threshold", upperThreshold);
+
+    unsigned int timeStep(0);
+    GetParameter("Time step", timeStep);
+
+    m_Mutex->Lock();
+    m_Progress = 0.0f;
+    const bool cancelRequested = m_CancelRequested;
+    m_Mutex->Unlock();
+
+    if (cancelRequested)
+    {
+      MITK_INFO << "3D region growing was cancelled.";
+      return false;
+    }
+
+    Image::Pointer volume = image;
+
+    if (image->GetDimension() > 3)
+    {
+      auto timeSelector = ImageTimeSelector::New();
+      timeSelector->SetInput(image);
+      timeSelector->SetTimeNr(timeStep);
+      timeSelector->UpdateLargestPossibleRegion();
+      volume = timeSelector->GetOutput();
+    }
+
+    Image::Pointer result;
+
+    try
+    {
+      AccessFixedDimensionByItk_n(volume, StartRegionGrowing, 3, (volume->GetGeometry(), seedPoints.GetPointer(), lowerThreshold, upperThreshold, result));
+    }
+    catch (const itk::ProcessAborted &)
+    {
+      MITK_INFO << "3D region growing was cancelled.";
+      return false;
+    }
+    catch (const itk::ExceptionObject &e)
+    {
+      MITK_ERROR << "3D region growing failed: " << e.GetDescription();
+      return false;
+    }
+
+    result->SetGeometry(volume->GetGeometry()->Clone());
+
+    m_Mutex->Lock();
+    m_Result = result;
+    m_Mutex->Unlock();
+
+    return true;
+  }
+
+} // namespace
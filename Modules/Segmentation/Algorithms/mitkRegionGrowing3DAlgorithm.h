@@ -0,0 +1,90 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkRegionGrowing3DAlgorithm_h
+#define mitkRegionGrowing3DAlgorithm_h
+
+#include "mitkNonBlockingAlgorithm.h"
+#include <MitkSegmentationExports.h>
+
+#include <itkFastMutexLock.h>
+#include <itkProcessObject.h>
+
+namespace mitk
+{
+  /**
+    \brief Non-blocking 3D region growing based on the itk::ParallelConnectedThresholdImageFilter.
+
+    Parameters:
+      - "Input" (Image): the (reference) image. For images with multiple time steps, "Time step" selects the volume.
+      - "Seed points" (PointSet): seed points in world coordinates.
+      - "Lower threshold", "Upper threshold" (double): inclusive threshold window.
+      - "Time step" (unsigned int, default 0).
+
+    The region growing itself runs multi-threaded. Observers of this object receive itk::ProgressEvent
+    during the computation (from the worker thread) and ResultAvailable / ProcessingError afterwards
+    (from the GUI thread). A running computation can be stopped with Cancel().
+  */
+  class MITKSEGMENTATION_EXPORT RegionGrowing3DAlgorithm : public NonBlockingAlgorithm
+  {
+  public:
+    mitkClassMacro(RegionGrowing3DAlgorithm, NonBlockingAlgorithm);
+    mitkAlgorithmNewMacro(RegionGrowing3DAlgorithm);
+
+    /** \brief Result of the last successful run (binary image with the geometry of the input volume). */
+    Image::Pointer GetResult() const;
+
+    /** \brief Current progress in [0, 1]. */
+    float GetProgress() const;
+
+    /** \brief Aborts a running or requested region growing and waits for the worker thread to finish.
+      A cancelled run reports ProcessingError and does not change the result of the last successful run.
+      Calling Cancel() again before that report has arrived does nothing. */
+    void Cancel();
+
+  protected:
+    RegionGrowing3DAlgorithm(); // use smart pointers
+    ~RegionGrowing3DAlgorithm() override;
+
+    void Initialize(const NonBlockingAlgorithm *other = nullptr) override;
+    bool ReadyToRun() override;
+
+    bool ThreadedUpdateFunction() override; // will be called from a thread after calling StartAlgorithm
+    void ThreadedUpdateSuccessful() override;
+    void ThreadedUpdateFailed() override;
+
+  private:
+    template <typename TPixel, unsigned int VImageDimension>
+    void StartRegionGrowing(const itk::Image<TPixel, VImageDimension> *itkImage,
+                            const BaseGeometry *imageGeometry,
+                            const PointSet *seedPoints,
+                            double lowerThreshold,
+                            double upperThreshold,
+                            Image::Pointer &result);
+
+    void OnFilterProgress(itk::Object *caller, const itk::EventObject &event);
+
+    itk::FastMutexLock::Pointer m_Mutex;
+    itk::ProcessObject::Pointer m_RunningFilter;
+    Image::Pointer m_Result;
+    float m_Progress;
+    bool m_CancelRequested;
+    /** A worker thread was requested by StartAlgorithm() and not yet released by the base class (which happens
+      from the GUI thread, after ThreadedUpdateSuccessful() or ThreadedUpdateFailed()). */
+    bool m_WorkerStarted;
+    /** The worker thread was joined by Cancel() and must not be joined again before it is released. */
+    bool m_WorkerJoined;
+  };
+
+} // namespace
+
+#endif
@@ -28,13 +28,13 @@ mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::Interpolate(
   Image::ConstPointer upperSlice,
   unsigned int upperSliceIndex,
   unsigned int requestedIndex,
-  unsigned int /*sliceDimension*/, // commented variables are not used
+  unsigned int sliceDimension,
   Image::Pointer resultImage,
-  unsigned int /*timeStep*/,
-  Image::ConstPointer /*referenceImage*/)
+  unsigned int timeStep,
+  Image::ConstPointer /*referenceImage*/) // commented variables are not used
 {
-  auto lowerDistanceImage = this->ComputeDistanceMap(lowerSliceIndex, lowerSlice);
-  auto upperDistanceImage = this->ComputeDistanceMap(upperSliceIndex, upperSlice);
+  auto lowerDistanceImage = this->ComputeDistanceMap(sliceDimension, lowerSliceIndex, timeStep, lowerSlice);
+  auto upperDistanceImage = this->ComputeDistanceMap(sliceDimension, upperSliceIndex, timeStep, upperSlice);
 
   // calculate where the current slice is in comparison to the lower and upper neighboring slices
   float ratio = (float)(requestedIndex - lowerSliceIndex) / (float)(upperSliceIndex - lowerSliceIndex);
@@ -43,15 +43,16 @@ mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::Interpolate(
   return resultImage;
 }
 
-mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(unsigned int sliceIndex, Image::ConstPointer slice)
+mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep, Image::ConstPointer slice)
 {
   static const auto MAX_CACHE_SIZE = 2 * std::thread::hardware_concurrency();
+  const auto key = std::make_tuple(sliceDimension, sliceIndex, timeStep);
 
   {
     std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
 
-    if (0 != m_DistanceImageCache.count(sliceIndex))
-      return m_DistanceImageCache[sliceIndex];
+    if (0 != m_DistanceImageCache.count(key))
+      return m_DistanceImageCache[key];
 
     if (MAX_CACHE_SIZE < m_DistanceImageCache.size())
       m_DistanceImageCache.clear();
@@ -62,11 +63,33 @@ mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(
 
   std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
 
-  m_DistanceImageCache[sliceIndex] = distanceImage;
+  m_DistanceImageCache[key] = distanceImage;
 
   return distanceImage;
 }
 
+void mitk::ShapeBasedInterpolationAlgorithm::InvalidateDistanceImageCache(unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep)
+{
+  std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+
+  for (auto iter = m_DistanceImageCache.begin(); iter != m_DistanceImageCache.end();)
+  {
+    const bool isAffected = std::get<2>(iter->first) == timeStep &&
+      (std::get<0>(iter->first) != sliceDimension || std::get<1>(iter->first) == sliceIndex);
+
+    if (isAffected)
+      iter = m_DistanceImageCache.erase(iter);
+    else
+      ++iter;
+  }
+}
+
+void mitk::ShapeBasedInterpolationAlgorithm::ClearDistanceImageCache()
+{
+  std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+  m_DistanceImageCache.clear();
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 void mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *binaryImage,
                                                                 mitk::Image::Pointer &result)
@@ -18,6 +18,7 @@ found in the LICENSE file.
 
 #include <map>
 #include <mutex>
+#include <tuple>
 
 namespace mitk
 {
@@ -50,13 +51,19 @@ namespace mitk
                                  unsigned int timeStep,
                                  Image::ConstPointer referenceImage) override;
 
+    /** Removes the cached distance maps that are affected by a change of the given slice, i.e. the one of
+     * the slice itself and the ones of all slices of the other two dimensions of the same time step.*/
+    void InvalidateDistanceImageCache(unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep);
+
+    void ClearDistanceImageCache();
+
   private:
     typedef itk::Image<mitk::ScalarType, 2> DistanceFilterImageType;
 
     template <typename TPixel, unsigned int VImageDimension>
     void ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *, mitk::Image::Pointer &result);
 
-    Image::Pointer ComputeDistanceMap(unsigned int sliceIndex, Image::ConstPointer slice);
+    Image::Pointer ComputeDistanceMap(unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep, Image::ConstPointer slice);
 
     template <typename TPixel, unsigned int VImageDimension>
     void InterpolateIntermediateSlice(itk::Image<TPixel, VImageDimension> *result,
@@ -64,7 +71,8 @@ namespace mitk
                                       const mitk::Image::Pointer &upperDistanceImage,
                                       float ratio);
 
-    std::map<unsigned int, Image::Pointer> m_DistanceImageCache;
+    /** Key is (slice dimension, slice index, time step).*/
+    std::map<std::tuple<unsigned int, unsigned int, unsigned int>, Image::Pointer> m_DistanceImageCache;
     std::mutex m_DistanceImageCacheMutex;
   };
 
@@ -14,9 +14,65 @@ found in the LICENSE file.
 #include "mitkManualSegmentationToSurfaceFilter.h"
 #include "mitkVtkRepresentationProperty.h"
 #include <mitkCoreObjectFactory.h>
+#include <mitkImageCast.h>
+#include <mitkLabelBoundingBoxes.h>
 #include <mitkLabelSetImage.h>
 #include <vtkPolyDataNormals.h>
 
+#include <itkImageRegionIterator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+  typedef mitk::LabelSetImage::PixelType LabelPixelType;
+  typedef itk::Image<LabelPixelType, 3> LabelImageType;
+  typedef std::map<LabelPixelType, mitk::LabelBoundingBox<3>> LabelBoundingBoxMap;
+
+  /** A label whose surface is created. If LayerImage is set, the mask of the label is
+      restricted to Region of it, otherwise the full mask is created by the label set image. */
+  struct LabelSurfaceTask
+  {
+    mitk::Label::ConstPointer Label;
+    unsigned int LayerIndex;
+    LabelImageType::ConstPointer LayerImage;
+    LabelImageType::RegionType Region;
+  };
+
+  /** Creates a binary mask of the given label restricted to the given region of the layer image. */
+  mitk::Image::Pointer CreateCroppedLabelMask(const LabelImageType *layerImage,
+                                              LabelPixelType label,
+                                              const LabelImageType::RegionType &region)
+  {
+    LabelImageType::RegionType maskRegion;
+    maskRegion.SetSize(region.GetSize());
+
+    LabelImageType::PointType origin;
+    layerImage->TransformIndexToPhysicalPoint(region.GetIndex(), origin);
+
+    auto mask = LabelImageType::New();
+    mask->SetRegions(maskRegion);
+    mask->SetSpacing(layerImage->GetSpacing());
+    mask->SetOrigin(origin);
+    mask->SetDirection(layerImage->GetDirection());
+    mask->Allocate();
+
+    itk::ImageRegionConstIterator<LabelImageType> layerIt(layerImage, region);
+    itk::ImageRegionIterator<LabelImageType> maskIt(mask, maskRegion);
+    for (; !layerIt.IsAtEnd(); ++layerIt, ++maskIt)
+      maskIt.Set(layerIt.Get() == label ? 1 : 0);
+
+    mitk::Image::Pointer result;
+    mitk::CastToMitkImage(mask, result);
+    return result;
+  }
+}
+
 namespace mitk
 {
   ShowSegmentationAsSurface::ShowSegmentationAsSurface()
@@ -98,42 +154,138 @@ namespace mitk
 
     if (nullptr != labelSetImage)
     {
+      // The label masks are cropped to the bounding box of each label (plus a margin covering the
+      // median and gaussian kernels), which are all determined in a single pass per layer. The
+      // masks are converted to surfaces in parallel.
+      const int margin = static_cast<int>(medianKernelSize / 2 + std::ceil(gaussianSD)) + 2;
+
+      std::vector<LabelSurfaceTask> tasks;
       auto numberOfLayers = labelSetImage->GetNumberOfLayers();
 
       for (decltype(numberOfLayers) layerIndex = 0; layerIndex < numberOfLayers; ++layerIndex)
       {
         auto labelSet = labelSetImage->GetLabelSet(layerIndex);
+        // The pixels of the active layer are only up to date in the label set image itself
+        Image *layerImage = layerIndex == labelSetImage->GetActiveLayer()
+          ? labelSetImage
+          : labelSetImage->GetLayerImage(layerIndex);
+        const bool cropMasks = 3 == labelSetImage->GetDimension();
+
+        LabelImageType::Pointer itkLayerImage;
+        LabelBoundingBoxMap boundingBoxes;
+
+        if (cropMasks)
+        {
+          CastToItkImage(layerImage, itkLayerImage);
+          boundingBoxes = ComputeLabelBoundingBoxes(itkLayerImage.GetPointer());
+        }
 
         for (auto labelIter = labelSet->IteratorConstBegin(); labelIter != labelSet->IteratorConstEnd(); ++labelIter)
         {
           if (0 == labelIter->first)
             continue; // Do not process background label
 
-          auto labelImage = labelSetImage->CreateLabelMask(labelIter->first, false, layerIndex);
+          LabelSurfaceTask task;
+          task.Label = labelIter->second;
+          task.LayerIndex = layerIndex;
+
+          if (cropMasks)
+          {
+            auto boundingBox = boundingBoxes.find(labelIter->first);
 
-          if (labelImage.IsNull())
-            continue;
+            if (boundingBox == boundingBoxes.end())
+              continue; // Label is empty
 
-          auto labelSurface = this->ConvertBinaryImageToSurface(labelImage);
+            task.LayerImage = itkLayerImage;
+            task.Region = boundingBox->second.Region;
+            task.Region.PadByRadius(margin);
+            task.Region.Crop(itkLayerImage->GetLargestPossibleRegion());
+          }
 
-          if (labelSurface.IsNull())
-            continue;
+          tasks.push_back(task);
+        }
+      }
 
-          auto* polyData = labelSurface->GetVtkPolyData();
+      // CreateLabelMask() temporarily switches the active layer and must not run concurrently
+      const bool allMasksCropped = std::all_of(tasks.begin(), tasks.end(), [](const LabelSurfaceTask &task) {
+        return task.LayerImage.IsNotNull();
+      });
+
+      // Each label is processed by multi-threaded filters, so the available threads are shared between the
+      // concurrently processed labels instead of starting the default number of threads per label
+      const unsigned int availableThreads = std::max(1u, std::thread::hardware_concurrency());
+      const auto numberOfThreads = allMasksCropped ? std::min<std::size_t>(availableThreads, tasks.size()) : 1;
+      const auto threadsPerTask = numberOfThreads > 1
+        ? std::max(1u, availableThreads / static_cast<unsigned int>(numberOfThreads))
+        : 0u;
+
+      std::vector<Surface::Pointer> surfaces(tasks.size());
+      std::atomic<std::size_t> nextTask(0);
+      std::exception_ptr exception;
+      std::mutex exceptionMutex;
+
+      auto processTasks = [&]() {
+        for (std::size_t i = nextTask++; i < tasks.size(); i = nextTask++)
+        {
+          try
+          {
+            const auto &task = tasks[i];
+            auto labelImage = task.LayerImage.IsNotNull()
+              ? CreateCroppedLabelMask(task.LayerImage, task.Label->GetValue(), task.Region)
+              : labelSetImage->CreateLabelMask(task.Label->GetValue(), false, task.LayerIndex);
 
-          if (smooth && (polyData->GetNumberOfPoints() < 1 || polyData->GetNumberOfCells() < 1))
+            if (labelImage.IsNotNull())
+              surfaces[i] = this->ConvertBinaryImageToSurface(labelImage, threadsPerTask);
+          }
+          catch (...)
           {
-            MITK_WARN << "Label \"" << labelIter->second->GetName() << "\" didn't produce any smoothed surface data (try again without smoothing).";
-            continue;
+            std::lock_guard<std::mutex> lock(exceptionMutex);
+            if (!exception)
+              exception = std::current_exception();
+            nextTask = tasks.size();
           }
+        }
+      };
 
-          auto node = DataNode::New();
-          node->SetData(labelSurface);
-          node->SetColor(labelIter->second->GetColor());
-          node->SetName(labelIter->second->GetName());
+      if (numberOfThreads <= 1)
+      {
+        processTasks();
+      }
+      else
+      {
+        std::vector<std::thread> threads;
+        threads.reserve(numberOfThreads);
+        for (std::size_t thread = 0; thread < numberOfThreads; ++thread)
+          threads.emplace_back(processTasks);
 
-          m_SurfaceNodes.push_back(node);
+        for (auto &thread : threads)
+          thread.join();
+      }
+
+      if (exception)
+        std::rethrow_exception(exception);
+
+      for (std::size_t i = 0; i < tasks.size(); ++i)
+      {
+        auto labelSurface = surfaces[i];
+
+        if (labelSurface.IsNull())
+          continue;
+
+        auto* polyData = labelSurface->GetVtkPolyData();
+
+        if (smooth && (polyData->GetNumberOfPoints() < 1 || polyData->GetNumberOfCells() < 1))
+        {
+          MITK_WARN << "Label \"" << tasks[i].Label->GetName() << "\" didn't produce any smoothed surface data (try again without smoothing).";
+          continue;
         }
+
+        auto node = DataNode::New();
+        node->SetData(labelSurface);
+        node->SetColor(tasks[i].Label->GetColor());
+        node->SetName(tasks[i].Label->GetName());
+
+        m_SurfaceNodes.push_back(node);
       }
     }
     else
@@ -250,7 +402,8 @@ namespace mitk
     Superclass::ThreadedUpdateSuccessful();
   }
 
-  Surface::Pointer ShowSegmentationAsSurface::ConvertBinaryImageToSurface(Image::Pointer binaryImage)
+  Surface::Pointer ShowSegmentationAsSurface::ConvertBinaryImageToSurface(Image::Pointer binaryImage,
+                                                                          unsigned int numberOfThreads)
   {
     bool smooth = true;
     GetParameter("Smooth", smooth);
@@ -272,6 +425,10 @@ namespace mitk
 
     auto filter = ManualSegmentationToSurfaceFilter::New();
     filter->SetInput(binaryImage);
+
+    if (0 != numberOfThreads)
+      filter->SetNumberOfThreads(numberOfThreads);
+
     filter->SetThreshold(0.5);
     filter->SetUseGaussianImageSmooth(smooth);
     filter->SetSmooth(smooth);
@@ -38,7 +38,8 @@ namespace mitk
     void ThreadedUpdateSuccessful() override; // will be called from a thread after calling StartAlgorithm
 
   private:
-    mitk::Surface::Pointer ConvertBinaryImageToSurface(mitk::Image::Pointer binaryImage);
+    /** numberOfThreads restricts the multi-threaded pre-processing filters, 0 keeps their default. */
+    mitk::Surface::Pointer ConvertBinaryImageToSurface(mitk::Image::Pointer binaryImage, unsigned int numberOfThreads = 0);
 
     UIDGenerator m_UIDGeneratorSurfaces;
 
@@ -28,6 +28,7 @@ found in the LICENSE file.
 
 #include "vtkDataSetAttributes.h"
 #include "vtkGarbageCollector.h"
+#include "vtkHomogeneousTransform.h"
 #include "vtkImageData.h"
 #include "vtkImageStencilData.h"
 #include "vtkInformation.h"
@@ -44,6 +45,7 @@ found in the LICENSE file.
 #undef VTK_USE_UINT64
 #define VTK_USE_UINT64 0
 
+#include <algorithm>
 #include <cfloat>
 #include <climits>
 #include <cmath>
@@ -475,6 +477,304 @@ static void vtkGetResliceInterpFunc(mitkVtkImageOverwrite *self,
   }
 }
 
+//----------------------------------------------------------------------------
+// Nearest-neighbor copy of one output row for affine mappings. The input
+// index of output voxel idX is origin + idX * step, so neither the matrix
+// nor the transform has to be applied per voxel. Rows with integer steps
+// (slices parallel to the image axes) are copied as strided blocks.
+// Out-of-bounds voxels are set to 'background' like in
+// vtkNearestNeighborInterpolation.
+
+// tolerance for treating a step along the row as an integer
+#define VTK_RESLICE_STEP_TOLERANCE 1e-9
+
+inline int vtkResliceFloorDivide(int a, int b)
+{
+  return a >= 0 ? a / b : -((b - 1 - a) / b);
+}
+
+template <class T>
+struct vtkImageResliceAffineRow
+{
+  static void Execute(void *&outPtrV,
+                      void *inPtrV,
+                      const int inExt[6],
+                      const vtkIdType inInc[3],
+                      int numscalars,
+                      const double origin[3],
+                      const double step[3],
+                      int idXmin,
+                      int idXmax,
+                      const void *backgroundV,
+                      bool overwrite)
+  {
+    T *outPtr = static_cast<T *>(outPtrV);
+    T *inPtr = static_cast<T *>(inPtrV);
+    const T *background = static_cast<const T *>(backgroundV);
+
+    int intStep[3];
+    bool isIntegerStep = true;
+    for (int k = 0; k < 3; ++k)
+    {
+      intStep[k] = vtkResliceRound(step[k]);
+      isIntegerStep = isIntegerStep && std::abs(step[k] - intStep[k]) < VTK_RESLICE_STEP_TOLERANCE;
+    }
+
+    if (isIntegerStep)
+    {
+      AxisAligned(outPtr, inPtr, inExt, inInc, numscalars, origin, step, intStep, idXmin, idXmax, background, overwrite);
+    }
+    else
+    {
+      Oblique(outPtr, inPtr, inExt, inInc, numscalars, origin, step, idXmin, idXmax, background, overwrite);
+    }
+
+    outPtrV = outPtr;
+  }
+
+  static void SetBackground(T *&outPtr, const T *background, int numscalars, int n)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      for (int c = 0; c < numscalars; ++c)
+      {
+        *outPtr++ = background[c];
+      }
+    }
+  }
+
+  static void AxisAligned(T *&outPtr,
+                          T *inPtr,
+                          const int inExt[6],
+                          const vtkIdType inInc[3],
+                          int numscalars,
+                          const double origin[3],
+                          const double step[3],
+                          const int intStep[3],
+                          int idXmin,
+                          int idXmax,
+                          const T *background,
+                          bool overwrite)
+  {
+    // determine the range [first, last) of the row that lies inside of the input extent
+    int n = idXmax - idXmin + 1;
+    int first = 0;
+    int last = n;
+    int inId[3];
+    for (int k = 0; k < 3 && first < last; ++k)
+    {
+      inId[k] = vtkResliceRound(origin[k] + idXmin * step[k]) - inExt[2 * k];
+      int inExtK = inExt[2 * k + 1] - inExt[2 * k] + 1;
+
+      if (intStep[k] == 0)
+      {
+        if (inId[k] < 0 || inId[k] >= inExtK)
+        {
+          last = first;
+        }
+      }
+      else if (intStep[k] > 0)
+      {
+        first = std::max(first, -vtkResliceFloorDivide(inId[k], intStep[k]));
+        last = std::min(last, vtkResliceFloorDivide(inExtK - 1 - inId[k], intStep[k]) + 1);
+      }
+      else
+      {
+        first = std::max(first, -vtkResliceFloorDivide(inExtK - 1 - inId[k], -intStep[k]));
+        last = std::min(last, vtkResliceFloorDivide(inId[k], -intStep[k]) + 1);
+      }
+    }
+
+    if (first >= last)
+    {
+      SetBackground(outPtr, background, numscalars, n);
+      return;
+    }
+
+    SetBackground(outPtr, background, numscalars, first);
+
+    T *inRowPtr = inPtr;
+    vtkIdType inStep = 0;
+    for (int k = 0; k < 3; ++k)
+    {
+      inRowPtr += (inId[k] + first * intStep[k]) * inInc[k];
+      inStep += intStep[k] * inInc[k];
+    }
+
+    int count = last - first;
+    if (numscalars == 1)
+    {
+      if (inStep == 1)
+      {
+        if (overwrite)
+        {
+          std::copy(outPtr, outPtr + count, inRowPtr);
+        }
+        else
+        {
+          std::copy(inRowPtr, inRowPtr + count, outPtr);
+        }
+      }
+      else if (overwrite)
+      {
+        for (int i = 0; i < count; ++i)
+        {
+          inRowPtr[i * inStep] = outPtr[i];
+        }
+      }
+      else
+      {
+        for (int i = 0; i < count; ++i)
+        {
+          outPtr[i] = inRowPtr[i * inStep];
+        }
+      }
+      outPtr += count;
+    }
+    else
+    {
+      for (int i = 0; i < count; ++i, inRowPtr += inStep)
+      {
+        for (int c = 0; c < numscalars; ++c)
+        {
+          if (overwrite)
+          {
+            inRowPtr[c] = *outPtr++;
+          }
+          else
+          {
+            *outPtr++ = inRowPtr[c];
+          }
+        }
+      }
+    }
+
+    SetBackground(outPtr, background, numscalars, n - last);
+  }
+
+  static void Oblique(T *&outPtr,
+                      T *inPtr,
+                      const int inExt[6],
+                      const vtkIdType inInc[3],
+                      int numscalars,
+                      const double origin[3],
+                      const double step[3],
+                      int idXmin,
+                      int idXmax,
+                      const T *background,
+                      bool overwrite)
+  {
+    // unsigned comparisons check both bounds at once
+    const unsigned int inExtX = inExt[1] - inExt[0] + 1;
+    const unsigned int inExtY = inExt[3] - inExt[2] + 1;
+    const unsigned int inExtZ = inExt[5] - inExt[4] + 1;
+
+    for (int idX = idXmin; idX <= idXmax; ++idX)
+    {
+      const auto inIdX = static_cast<unsigned int>(vtkResliceRound(origin[0] + idX * step[0]) - inExt[0]);
+      const auto inIdY = static_cast<unsigned int>(vtkResliceRound(origin[1] + idX * step[1]) - inExt[2]);
+      const auto inIdZ = static_cast<unsigned int>(vtkResliceRound(origin[2] + idX * step[2]) - inExt[4]);
+
+      if (inIdX >= inExtX || inIdY >= inExtY || inIdZ >= inExtZ)
+      {
+        SetBackground(outPtr, background, numscalars, 1);
+        continue;
+      }
+
+      T *voxelPtr = inPtr + inIdX * inInc[0] + inIdY * inInc[1] + inIdZ * inInc[2];
+      for (int c = 0; c < numscalars; ++c)
+      {
+        if (overwrite)
+        {
+          voxelPtr[c] = *outPtr++;
+        }
+        else
+        {
+          *outPtr++ = voxelPtr[c];
+        }
+      }
+    }
+  }
+};
+
+typedef void (*vtkResliceAffineRowFunc)(void *&outPtr,
+                                        void *inPtr,
+                                        const int inExt[6],
+                                        const vtkIdType inInc[3],
+                                        int numscalars,
+                                        const double origin[3],
+                                        const double step[3],
+                                        int idXmin,
+                                        int idXmax,
+                                        const void *background,
+                                        bool overwrite);
+
+// get the affine row function that is appropriate for the data type
+static void vtkGetResliceAffineRowFunc(mitkVtkImageOverwrite *self, vtkResliceAffineRowFunc *affineRow)
+{
+  switch (self->GetOutput()->GetScalarType())
+  {
+    vtkTemplateAliasMacro(*affineRow = &vtkImageResliceAffineRow<VTK_TT>::Execute);
+    default:
+      *affineRow = nullptr;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Compute the matrix that maps output voxel indices to input voxel indices,
+// i.e. the concatenation of the output geometry, the ResliceAxes, the
+// ResliceTransform and the input geometry. Returns false if the mapping is
+// not affine (non-linear transform or perspective matrix).
+static bool vtkGetResliceIndexMatrix(mitkVtkImageOverwrite *self,
+                                     vtkImageData *inData,
+                                     vtkImageData *outData,
+                                     double indexMatrix[16])
+{
+  vtkAbstractTransform *transform = self->GetResliceTransform();
+  vtkHomogeneousTransform *homogeneousTransform = vtkHomogeneousTransform::SafeDownCast(transform);
+  if (transform && !homogeneousTransform)
+  {
+    return false;
+  }
+
+  double *inOrigin = inData->GetOrigin();
+  double *inSpacing = inData->GetSpacing();
+  double *outOrigin = outData->GetOrigin();
+  double *outSpacing = outData->GetSpacing();
+
+  double outIndexToWorld[16];
+  double inWorldToIndex[16];
+  vtkMatrix4x4::Identity(outIndexToWorld);
+  vtkMatrix4x4::Identity(inWorldToIndex);
+  for (int k = 0; k < 3; ++k)
+  {
+    outIndexToWorld[5 * k] = outSpacing[k];
+    outIndexToWorld[4 * k + 3] = outOrigin[k];
+    inWorldToIndex[5 * k] = 1.0 / inSpacing[k];
+    inWorldToIndex[4 * k + 3] = -inOrigin[k] / inSpacing[k];
+  }
+
+  double tmp[16];
+  std::copy(outIndexToWorld, outIndexToWorld + 16, indexMatrix);
+
+  if (vtkMatrix4x4 *matrix = self->GetResliceAxes())
+  {
+    vtkMatrix4x4::Multiply4x4(matrix->GetData(), indexMatrix, tmp);
+    std::copy(tmp, tmp + 16, indexMatrix);
+  }
+
+  if (homogeneousTransform)
+  {
+    vtkMatrix4x4::Multiply4x4(homogeneousTransform->GetMatrix()->GetData(), indexMatrix, tmp);
+    std::copy(tmp, tmp + 16, indexMatrix);
+  }
+
+  vtkMatrix4x4::Multiply4x4(inWorldToIndex, indexMatrix, tmp);
+  std::copy(tmp, tmp + 16, indexMatrix);
+
+  return indexMatrix[12] == 0.0 && indexMatrix[13] == 0.0 && indexMatrix[14] == 0.0 && indexMatrix[15] == 1.0;
+}
+
 //----------------------------------------------------------------------------
 // Some helper functions for 'RequestData'
 //----------------------------------------------------------------------------
@@ -769,6 +1069,16 @@ static void vtkImageResliceExecute(mitkVtkImageOverwrite *self,
   // get the stencil
   vtkImageStencilData *stencil = self->GetStencil();
 
+  // use the affine row function unless the boundary mode needs the general interpolation
+  double indexMatrix[16];
+  vtkResliceAffineRowFunc affineRow = nullptr;
+  if ((mode == VTK_RESLICE_BACKGROUND || mode == VTK_RESLICE_BORDER) &&
+      vtkGetResliceIndexMatrix(self, inData, outData, indexMatrix))
+  {
+    vtkGetResliceAffineRowFunc(self, &affineRow);
+  }
+  bool overwrite = self->IsOverwriteMode();
+
   // Loop through output voxels
   for (idZ = outExt[4]; idZ <= outExt[5]; idZ++)
   {
@@ -787,6 +1097,19 @@ static void vtkImageResliceExecute(mitkVtkImageOverwrite *self,
       while (vtkResliceGetNextExtent(
         stencil, idXmin, idXmax, outExt[0], outExt[1], idY, idZ, outPtr, background, numscalars, setpixels, iter))
       {
+        if (affineRow)
+        {
+          double rowOrigin[3];
+          double rowStep[3];
+          for (int k = 0; k < 3; ++k)
+          {
+            rowOrigin[k] = indexMatrix[4 * k + 3] + idY * indexMatrix[4 * k + 1] + idZ * indexMatrix[4 * k + 2];
+            rowStep[k] = indexMatrix[4 * k];
+          }
+          affineRow(outPtr, inPtr, inExt, inInc, numscalars, rowOrigin, rowStep, idXmin, idXmax, background, overwrite);
+          continue;
+        }
+
         for (idX = idXmin; idX <= idXmax; idX++)
         {
           // convert to data coordinates
@@ -23,6 +23,8 @@ nearest
   neighbor and uses the non optimized execute function of vtkImageReslice. Note that any interpolation doesn't make
 sense
 for round trip use extract->edit->overwrite, because it is nearly impossible to invert the interolation.
+  If the mapping from slice to volume is affine (no perspective ResliceAxes, linear ResliceTransform), whole rows are copied with
+  precomputed index steps instead, and slices parallel to the volume axes are copied as strided blocks.
   There are two use cases for the Filter which are specified by the overwritemode property:
 
   1)Extract slices from a 3D volume.
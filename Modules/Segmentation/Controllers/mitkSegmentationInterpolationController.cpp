@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "mitkImageCast.h"
 #include "mitkImageReadAccessor.h"
 #include "mitkImageTimeSelector.h"
+#include <mitkPixelTypeMultiplex.h>
 #include <mitkExtractSliceFilter.h>
 #include <mitkImageAccessByItk.h>
 //#include <mitkPlaneGeometry.h>
@@ -37,6 +38,34 @@ namespace
       object->RemoveObserver(observerTag);
     }
   }
+
+  /// copies a slice of the volume buffer, ordered like the slices passed to SetChangedSlice()
+  template <typename TPixel>
+  void CopySliceContentOfVolume(const mitk::PixelType &,
+                                const void *volume,
+                                const unsigned int *dimensions,
+                                unsigned int sliceDimension,
+                                unsigned int sliceIndex,
+                                std::vector<int> &content)
+  {
+    const unsigned int dim0 = 0 == sliceDimension ? 1 : 0;
+    const unsigned int dim1 = 2 == sliceDimension ? 1 : 2;
+
+    const std::size_t strides[3] = {1, dimensions[0], static_cast<std::size_t>(dimensions[0]) * dimensions[1]};
+
+    content.resize(static_cast<std::size_t>(dimensions[dim0]) * dimensions[dim1]);
+
+    const auto *slice = static_cast<const TPixel *>(volume) + sliceIndex * strides[sliceDimension];
+    auto pixel = content.begin();
+
+    for (unsigned int v = 0; v < dimensions[dim1]; ++v)
+    {
+      const TPixel *row = slice + v * strides[dim1];
+
+      for (unsigned int u = 0; u < dimensions[dim0]; ++u, ++pixel)
+        *pixel = static_cast<int>(row[u * strides[dim0]]);
+    }
+  }
 }
 
 mitk::SegmentationInterpolationController::InterpolatorMapType
@@ -60,7 +89,9 @@ mitk::SegmentationInterpolationController::SegmentationInterpolationController()
   : m_SegmentationModifiedObserverTag(std::make_pair(0UL, false)),
     m_BlockModified(false),
     m_2DInterpolationActivated(false),
-    m_EnableSliceImageCache(false)
+    m_EnableSliceImageCache(false),
+    m_CacheEpoch(0),
+    m_NumberOfVolumeScans(0)
 {
 }
 
@@ -97,7 +128,13 @@ void mitk::SegmentationInterpolationController::OnImageModified(const itk::Event
 {
   if (!m_BlockModified && m_Segmentation.IsNotNull() && m_2DInterpolationActivated)
   {
-    SetSegmentationVolume(m_Segmentation);
+    if (!this->ScanPreparedSliceChanges())
+      SetSegmentationVolume(m_Segmentation);
+  }
+  else
+  {
+    std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+    m_PreparedSliceChanges.clear();
   }
 }
 
@@ -108,8 +145,12 @@ void mitk::SegmentationInterpolationController::BlockModified(bool block)
 
 void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Image *segmentation)
 {
+  std::unique_lock<std::mutex> lock(m_InterpolationMutex);
+
   // clear old information (remove all time steps
   m_SegmentationCountInSlice.clear();
+  m_PreparedSliceChanges.clear();
+  m_LastRescannedSlices.clear();
 
   // delete this from the list of interpolators
   auto iter = s_InterpolatorForImage.find(segmentation);
@@ -124,9 +165,12 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
     m_SegmentationModifiedObserverTag.second = false;
   }
 
+  this->ClearCaches();
+
   if (nullptr == segmentation || !segmentation->IsInitialized())
   {
     m_Segmentation = nullptr;
+    lock.unlock();
     this->InvokeEvent(itk::AbortEvent());
     return;
   }
@@ -159,25 +203,32 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
 
   // for all timesteps
   // scan whole image
+  ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
+  timeSelector->SetInput(m_Segmentation);
   for (unsigned int timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
   {
-    ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
-    timeSelector->SetInput(m_Segmentation);
     timeSelector->SetTimeNr(timeStep);
     timeSelector->UpdateLargestPossibleRegion();
     Image::Pointer segmentation3D = timeSelector->GetOutput();
     AccessFixedDimensionByItk_2(segmentation3D, ScanWholeVolume, 3, m_Segmentation, timeStep);
   }
 
+  ++m_NumberOfVolumeScans;
+
   // PrintStatus();
 
-  SetReferenceVolume(m_ReferenceImage);
+  const auto referenceImage = m_ReferenceImage;
+  lock.unlock();
+
+  SetReferenceVolume(referenceImage);
 
   Modified();
 }
 
 void mitk::SegmentationInterpolationController::SetReferenceVolume(const Image *referenceImage)
 {
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+
   m_ReferenceImage = referenceImage;
 
   if (m_ReferenceImage.IsNull())
@@ -212,7 +263,11 @@ void mitk::SegmentationInterpolationController::SetChangedVolume(const Image *sl
   if (sliceDiff->GetDimension() != 3)
     return;
 
-  AccessFixedDimensionByItk_1(sliceDiff, ScanChangedVolume, 3, timeStep);
+  {
+    std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+    AccessFixedDimensionByItk_1(sliceDiff, ScanChangedVolume, 3, timeStep);
+    this->ClearCaches();
+  }
 
   // PrintStatus();
   Modified();
@@ -227,6 +282,9 @@ void mitk::SegmentationInterpolationController::SetChangedSlice(const Image *sli
     return;
   if (sliceDimension > 2)
     return;
+
+  std::unique_lock<std::mutex> lock(m_InterpolationMutex);
+
   if (timeStep >= m_SegmentationCountInSlice.size())
     return;
   if (sliceIndex >= m_SegmentationCountInSlice[timeStep][sliceDimension].size())
@@ -261,7 +319,139 @@ void mitk::SegmentationInterpolationController::SetChangedSlice(const Image *sli
   AccessFixedDimensionByItk_1(
     sliceDiff, ScanChangedSlice, 2, SetChangedSliceOptions(sliceDimension, sliceIndex, dim0, dim1, timeStep, rawSlice));
 
+  this->InvalidateCaches(sliceDimension, sliceIndex, timeStep);
+
+  lock.unlock();
+
+  Modified();
+}
+
+void mitk::SegmentationInterpolationController::PrepareSliceChange(unsigned int sliceDimension,
+                                                                   unsigned int sliceIndex,
+                                                                   unsigned int timeStep)
+{
+  if (sliceDimension > 2 || !m_2DInterpolationActivated)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+
+  if (m_Segmentation.IsNull() || timeStep >= m_SegmentationCountInSlice.size() ||
+      sliceIndex >= m_SegmentationCountInSlice[timeStep][sliceDimension].size())
+    return;
+
+  for (const auto &change : m_PreparedSliceChanges)
+  {
+    // the first copy is the content before the modification
+    if (change.SliceDimension == sliceDimension && change.SliceIndex == sliceIndex && change.TimeStep == timeStep)
+      return;
+  }
+
+  PreparedSliceChange change;
+  change.SliceDimension = sliceDimension;
+  change.SliceIndex = sliceIndex;
+  change.TimeStep = timeStep;
+
+  if (this->CopySliceContent(sliceDimension, sliceIndex, timeStep, change.OriginalContent))
+    m_PreparedSliceChanges.push_back(std::move(change));
+}
+
+std::vector<std::tuple<unsigned int, unsigned int, unsigned int>>
+  mitk::SegmentationInterpolationController::GetLastRescannedSlices() const
+{
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+  return m_LastRescannedSlices;
+}
+
+unsigned int mitk::SegmentationInterpolationController::GetNumberOfVolumeScans() const
+{
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+  return m_NumberOfVolumeScans;
+}
+
+bool mitk::SegmentationInterpolationController::ScanPreparedSliceChanges()
+{
+  std::unique_lock<std::mutex> lock(m_InterpolationMutex);
+
+  std::vector<PreparedSliceChange> changes;
+  changes.swap(m_PreparedSliceChanges);
+
+  if (changes.empty() || m_SegmentationCountInSlice.size() != m_Segmentation->GetTimeSteps())
+    return false;
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    // the segmentation was initialized anew
+    if (m_SegmentationCountInSlice[0][dim].size() != m_Segmentation->GetDimension(dim))
+      return false;
+  }
+
+  // rescanning the changed slices must not leave the counts half updated
+  std::vector<std::vector<int>> differences(changes.size());
+
+  for (std::size_t i = 0; i < changes.size(); ++i)
+  {
+    if (!this->CopySliceContent(changes[i].SliceDimension, changes[i].SliceIndex, changes[i].TimeStep, differences[i]) ||
+        differences[i].size() != changes[i].OriginalContent.size())
+      return false;
+
+    for (std::size_t pixel = 0; pixel < differences[i].size(); ++pixel)
+      differences[i][pixel] -= changes[i].OriginalContent[pixel];
+  }
+
+  m_LastRescannedSlices.clear();
+
+  for (std::size_t i = 0; i < changes.size(); ++i)
+  {
+    const unsigned int sliceDimension = changes[i].SliceDimension;
+    const unsigned int dim0 = 0 == sliceDimension ? 1 : 0;
+    const unsigned int dim1 = 2 == sliceDimension ? 1 : 2;
+
+    ScanChangedSlice<int>(nullptr,
+                          SetChangedSliceOptions(
+                            sliceDimension, changes[i].SliceIndex, dim0, dim1, changes[i].TimeStep, differences[i].data()));
+
+    this->InvalidateCaches(sliceDimension, changes[i].SliceIndex, changes[i].TimeStep);
+    m_LastRescannedSlices.emplace_back(sliceDimension, changes[i].SliceIndex, changes[i].TimeStep);
+  }
+
+  lock.unlock();
+
   Modified();
+
+  return true;
+}
+
+bool mitk::SegmentationInterpolationController::CopySliceContent(unsigned int sliceDimension,
+                                                                 unsigned int sliceIndex,
+                                                                 unsigned int timeStep,
+                                                                 std::vector<int> &content)
+{
+  if (m_Segmentation->GetPixelType().GetNumberOfComponents() != 1)
+  {
+    MITK_ERROR << "Cannot scan changed slice: segmentation has more than one component";
+    return false;
+  }
+
+  unsigned int dimensions[3];
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    dimensions[dim] = m_Segmentation->GetDimension(dim);
+
+  try
+  {
+    // reads the slice directly from the volume of the time step, no time selection of the whole volume is needed
+    ImageReadAccessor accessor(m_Segmentation, m_Segmentation->GetVolumeData(timeStep));
+    const void *volume = accessor.GetData();
+    const PixelType pixelType = m_Segmentation->GetPixelType();
+
+    mitkPixelTypeMultiplex5(CopySliceContentOfVolume, pixelType, volume, dimensions, sliceDimension, sliceIndex, content);
+  }
+  catch (const Exception &e)
+  {
+    MITK_ERROR << "Cannot scan changed slice: " << e.what();
+    return false;
+  }
+
+  return true;
 }
 
 template <typename DATATYPE>
@@ -459,6 +649,8 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
                                                                             unsigned int timeStep,
                                                                             ShapeBasedInterpolationAlgorithm::Pointer algorithm)
 {
+  std::unique_lock<std::mutex> lock(m_InterpolationMutex);
+
   if (m_Segmentation.IsNull() || nullptr == currentPlane)
     return nullptr;
 
@@ -514,6 +706,17 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
 
   // We have found two neighboring slices with segmentations and made sure that the current slice does not contain anything
 
+  // keep the images, the rest does not need the lock anymore
+  const Image::ConstPointer segmentation = m_Segmentation;
+  const Image::ConstPointer referenceImage = m_ReferenceImage;
+
+  if (algorithm.IsNull() && m_EnableSliceImageCache)
+    algorithm = m_CachingAlgorithm;
+
+  const unsigned long cacheEpoch = m_CacheEpoch;
+
+  lock.unlock();
+
   mitk::Image::Pointer lowerSlice;
   mitk::Image::Pointer upperSlice;
   mitk::Image::Pointer resultImage;
@@ -521,32 +724,32 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
   try
   {
     // Extract current slice
-    resultImage = this->ExtractSlice(currentPlane, sliceIndex, timeStep);
+    resultImage = this->ExtractSlice(segmentation, currentPlane, sliceDimension, sliceIndex, timeStep);
 
     // Creating PlaneGeometry for lower slice
     auto reslicePlane = currentPlane->Clone();
 
     // Transforming the current origin so that it matches the lower slice
     auto origin = currentPlane->GetOrigin();
-    m_Segmentation->GetSlicedGeometry(timeStep)->WorldToIndex(origin, origin);
+    segmentation->GetSlicedGeometry(timeStep)->WorldToIndex(origin, origin);
     origin[sliceDimension] = lowerBound;
-    m_Segmentation->GetSlicedGeometry(timeStep)->IndexToWorld(origin, origin);
+    segmentation->GetSlicedGeometry(timeStep)->IndexToWorld(origin, origin);
     reslicePlane->SetOrigin(origin);
 
     // Extract lower slice
-    lowerSlice = this->ExtractSlice(reslicePlane, lowerBound, timeStep, true);
+    lowerSlice = this->ExtractSlice(segmentation, reslicePlane, sliceDimension, lowerBound, timeStep, true, cacheEpoch);
 
     if (lowerSlice.IsNull())
       return nullptr;
 
     // Transforming the current origin so that it matches the upper slice
-    m_Segmentation->GetSlicedGeometry(timeStep)->WorldToIndex(origin, origin);
+    segmentation->GetSlicedGeometry(timeStep)->WorldToIndex(origin, origin);
     origin[sliceDimension] = upperBound;
-    m_Segmentation->GetSlicedGeometry(timeStep)->IndexToWorld(origin, origin);
+    segmentation->GetSlicedGeometry(timeStep)->IndexToWorld(origin, origin);
     reslicePlane->SetOrigin(origin);
 
     // Extract the upper slice
-    upperSlice = this->ExtractSlice(reslicePlane, upperBound, timeStep, true);
+    upperSlice = this->ExtractSlice(segmentation, reslicePlane, sliceDimension, upperBound, timeStep, true, cacheEpoch);
 
     if (upperSlice.IsNull())
       return nullptr;
@@ -569,7 +772,7 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
   if (algorithm.IsNull())
     algorithm = mitk::ShapeBasedInterpolationAlgorithm::New();
 
-  return algorithm->Interpolate(
+  auto interpolation = algorithm->Interpolate(
     lowerSlice.GetPointer(),
     lowerBound,
     upperSlice.GetPointer(),
@@ -578,13 +781,23 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
     sliceDimension,
     resultImage,
     timeStep,
-    m_ReferenceImage);
+    referenceImage);
+
+  if (cacheEpoch != m_CacheEpoch)
+  {
+    // the segmentation changed while interpolating, thus the distance maps cached by the algorithm may be outdated
+    lock.lock();
+    if (algorithm == m_CachingAlgorithm)
+      algorithm->ClearDistanceImageCache();
+  }
+
+  return interpolation;
 }
 
-mitk::Image::Pointer mitk::SegmentationInterpolationController::ExtractSlice(const PlaneGeometry* planeGeometry, unsigned int sliceIndex, unsigned int timeStep, bool cache)
+mitk::Image::Pointer mitk::SegmentationInterpolationController::ExtractSlice(const Image* segmentation, const PlaneGeometry* planeGeometry, unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep, bool cache, unsigned long cacheEpoch)
 {
   static const auto MAX_CACHE_SIZE = 2 * std::thread::hardware_concurrency();
-  const auto key = std::make_pair(sliceIndex, timeStep);
+  const auto key = std::make_tuple(sliceDimension, sliceIndex, timeStep);
 
   if (cache && m_EnableSliceImageCache)
   {
@@ -598,9 +811,9 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::ExtractSlice(con
   }
 
   auto extractor = ExtractSliceFilter::New();
-  extractor->SetInput(m_Segmentation);
+  extractor->SetInput(segmentation);
   extractor->SetTimeStep(timeStep);
-  extractor->SetResliceTransformByGeometry(m_Segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
+  extractor->SetResliceTransformByGeometry(segmentation->GetTimeGeometry()->GetGeometryForTimeStep(timeStep));
   extractor->SetVtkOutputRequest(false);
   extractor->SetWorldGeometry(planeGeometry);
   extractor->Update();
@@ -608,19 +821,72 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::ExtractSlice(con
   if (cache && m_EnableSliceImageCache)
   {
     std::lock_guard<std::mutex> lock(m_SliceImageCacheMutex);
-    m_SliceImageCache[key] = extractor->GetOutput();
+
+    if (cacheEpoch == m_CacheEpoch)
+      m_SliceImageCache[key] = extractor->GetOutput();
   }
 
   return extractor->GetOutput();
 }
 
+void mitk::SegmentationInterpolationController::InvalidateCaches(unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep)
+{
+  ++m_CacheEpoch;
+
+  {
+    std::lock_guard<std::mutex> lock(m_SliceImageCacheMutex);
+
+    for (auto iter = m_SliceImageCache.begin(); iter != m_SliceImageCache.end();)
+    {
+      // a changed slice intersects all slices of the other two dimensions
+      const bool isAffected = std::get<2>(iter->first) == timeStep &&
+        (std::get<0>(iter->first) != sliceDimension || std::get<1>(iter->first) == sliceIndex);
+
+      if (isAffected)
+        iter = m_SliceImageCache.erase(iter);
+      else
+        ++iter;
+    }
+  }
+
+  if (m_CachingAlgorithm.IsNotNull())
+    m_CachingAlgorithm->InvalidateDistanceImageCache(sliceDimension, sliceIndex, timeStep);
+}
+
+void mitk::SegmentationInterpolationController::ClearCaches()
+{
+  ++m_CacheEpoch;
+
+  {
+    std::lock_guard<std::mutex> lock(m_SliceImageCacheMutex);
+    m_SliceImageCache.clear();
+  }
+
+  if (m_CachingAlgorithm.IsNotNull())
+    m_CachingAlgorithm->ClearDistanceImageCache();
+}
+
 void mitk::SegmentationInterpolationController::EnableSliceImageCache()
 {
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+
   m_EnableSliceImageCache = true;
+
+  if (m_CachingAlgorithm.IsNull())
+    m_CachingAlgorithm = ShapeBasedInterpolationAlgorithm::New();
 }
 
 void mitk::SegmentationInterpolationController::DisableSliceImageCache()
 {
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+
   m_EnableSliceImageCache = false;
-  m_SliceImageCache.clear();
+  this->ClearCaches();
+  m_CachingAlgorithm = nullptr;
+}
+
+bool mitk::SegmentationInterpolationController::IsSliceImageCacheEnabled() const
+{
+  std::lock_guard<std::mutex> lock(m_InterpolationMutex);
+  return m_EnableSliceImageCache;
 }
@@ -21,8 +21,10 @@ found in the LICENSE file.
 #include <itkImage.h>
 #include <itkObjectFactory.h>
 
+#include <atomic>
 #include <map>
 #include <mutex>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -126,6 +128,27 @@ namespace mitk
                          unsigned int timeStep);
     void SetChangedVolume(const Image *sliceDiff, unsigned int timeStep);
 
+    /**
+      \brief Announces that a slice of the segmentation is about to be overwritten.
+
+      Keeps a copy of the current content of the slice. The next Modified() of the segmentation is then
+      handled like SetChangedSlice() for all announced slices instead of rescanning the whole volume.
+      Tools that write single slices call this right before they write to the segmentation.
+    */
+    void PrepareSliceChange(unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep);
+
+    /**
+      \brief Slices that were rescanned for the last modification of the segmentation, mainly for testing.
+
+      Each entry is (slice dimension, slice index, time step). Empty if the whole volume was scanned instead.
+    */
+    std::vector<std::tuple<unsigned int, unsigned int, unsigned int>> GetLastRescannedSlices() const;
+
+    /**
+      \brief Number of scans of the whole segmentation volume since construction, mainly for testing.
+    */
+    unsigned int GetNumberOfVolumeScans() const;
+
     /**
       \brief Generates an interpolated image for the given slice.
 
@@ -154,6 +177,9 @@ namespace mitk
 
     /**
      * Enable slice extraction cache for upper and lower slices.
+     * While the cache is enabled, Interpolate() also keeps the distance maps of the upper and lower slices
+     * if no algorithm instance is passed. Cached entries are invalidated slice-wise by SetChangedSlice() and
+     * completely by SetChangedVolume() or a new scan of the segmentation.
     */
     void EnableSliceImageCache();
 
@@ -162,6 +188,8 @@ namespace mitk
     */
     void DisableSliceImageCache();
 
+    bool IsSliceImageCacheEnabled() const;
+
     /**
       \brief Get existing instance or create a new one
     */
@@ -207,12 +235,29 @@ namespace mitk
     template <typename DATATYPE>
     void ScanWholeVolume(const itk::Image<DATATYPE, 3> *, const Image *volume, unsigned int timeStep);
 
+    /// copies a slice of the segmentation, ordered like the slices passed to SetChangedSlice()
+    bool CopySliceContent(unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep, std::vector<int> &content);
+
+    /// scans the slices announced by PrepareSliceChange(), returns false if a scan of the whole volume is needed
+    bool ScanPreparedSliceChanges();
+
     void PrintStatus();
 
     /**
      * Extract a slice and optionally use a caching mechanism if enabled.
     */
-    mitk::Image::Pointer ExtractSlice(const PlaneGeometry* planeGeometry, unsigned int sliceIndex, unsigned int timeStep, bool cache = false);
+    mitk::Image::Pointer ExtractSlice(const Image* segmentation, const PlaneGeometry* planeGeometry, unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep, bool cache = false, unsigned long cacheEpoch = 0);
+
+    /**
+     * Remove all cached slices and distance maps that are affected by a change of the given slice,
+     * i.e. the slice itself and all slices of the other two dimensions of the same time step.
+    */
+    void InvalidateCaches(unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep);
+
+    /**
+     * Remove all cached slices and distance maps.
+    */
+    void ClearCaches();
 
     /**
       An array of flags. One for each dimension of the image. A flag is set, when a slice in a certain dimension
@@ -234,8 +279,31 @@ namespace mitk
     bool m_2DInterpolationActivated;
 
     bool m_EnableSliceImageCache;
-    std::map<std::pair<unsigned int, unsigned int>, Image::Pointer> m_SliceImageCache;
+    /** Cached slices, key is (slice dimension, slice index, time step).*/
+    std::map<std::tuple<unsigned int, unsigned int, unsigned int>, Image::Pointer> m_SliceImageCache;
     std::mutex m_SliceImageCacheMutex;
+    /** Algorithm instance used by Interpolate() while the cache is enabled, to keep its distance maps.*/
+    ShapeBasedInterpolationAlgorithm::Pointer m_CachingAlgorithm;
+    /** Incremented whenever cache entries are invalidated. Slices extracted before are not cached anymore.*/
+    std::atomic<unsigned long> m_CacheEpoch;
+
+    struct PreparedSliceChange
+    {
+      unsigned int SliceDimension;
+      unsigned int SliceIndex;
+      unsigned int TimeStep;
+      std::vector<int> OriginalContent;
+    };
+
+    /** Slices announced by PrepareSliceChange() that were not scanned yet.*/
+    std::vector<PreparedSliceChange> m_PreparedSliceChanges;
+
+    /** (slice dimension, slice index, time step) of the slices rescanned by the last ScanPreparedSliceChanges().*/
+    std::vector<std::tuple<unsigned int, unsigned int, unsigned int>> m_LastRescannedSlices;
+    unsigned int m_NumberOfVolumeScans;
+
+    /** Guards the segmentation count and the images, as Interpolate() may be called from worker threads.*/
+    mutable std::mutex m_InterpolationMutex;
   };
 
 } // namespace
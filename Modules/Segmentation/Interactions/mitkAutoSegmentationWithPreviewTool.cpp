@@ -18,12 +18,15 @@ found in the LICENSE file.
 #include "mitkLevelWindowProperty.h"
 #include "mitkProperties.h"
 
+#include "mitkBaseRenderer.h"
+#include "mitkCallbackFromGUIThread.h"
 #include "mitkDataStorage.h"
 #include "mitkRenderingManager.h"
 #include <mitkSliceNavigationController.h>
 
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
+#include "mitkImageReadAccessor.h"
 #include "mitkImageStatisticsHolder.h"
 #include "mitkImageTimeSelector.h"
 #include "mitkLabelSetImage.h"
@@ -32,19 +35,72 @@ found in the LICENSE file.
 #include "mitkNodePredicateGeometry.h"
 #include "mitkSegTool2D.h"
 
+#include <itkCommand.h>
+
+#include <cassert>
+
+struct mitk::AutoSegmentationWithPreviewTool::FullPreviewReceiver
+{
+  std::mutex Mutex;
+  AutoSegmentationWithPreviewTool* Tool;
+};
+
+class mitk::AutoSegmentationWithPreviewTool::FullPreviewAvailableCommand : public itk::Command
+{
+public:
+  typedef FullPreviewAvailableCommand Self;
+  typedef itk::SmartPointer<Self> Pointer;
+  itkNewMacro(Self);
+
+  void SetReceiver(const std::shared_ptr<FullPreviewReceiver>& receiver) { m_Receiver = receiver; }
+
+  void Execute(itk::Object*, const itk::EventObject&) override { this->ApplyFullPreview(); }
+  void Execute(const itk::Object*, const itk::EventObject&) override { this->ApplyFullPreview(); }
+
+private:
+  void ApplyFullPreview()
+  {
+    std::lock_guard<std::mutex> lock(m_Receiver->Mutex);
+    if (nullptr != m_Receiver->Tool)
+      m_Receiver->Tool->ApplyFullPreview();
+  }
+
+  std::shared_ptr<FullPreviewReceiver> m_Receiver;
+};
+
 mitk::AutoSegmentationWithPreviewTool::AutoSegmentationWithPreviewTool(bool lazyDynamicPreviews): m_LazyDynamicPreviews(lazyDynamicPreviews)
 {
-  m_ProgressCommand = mitk::ToolCommand::New();
+  this->InitializeCommands();
 }
 
 mitk::AutoSegmentationWithPreviewTool::AutoSegmentationWithPreviewTool(bool lazyDynamicPreviews, const char* interactorType, const us::Module* interactorModule) : AutoSegmentationTool(interactorType, interactorModule), m_LazyDynamicPreviews(lazyDynamicPreviews)
 {
-  m_ProgressCommand = mitk::ToolCommand::New();
+  this->InitializeCommands();
 }
 
 
 mitk::AutoSegmentationWithPreviewTool::~AutoSegmentationWithPreviewTool()
 {
+  {
+    std::lock_guard<std::mutex> lock(m_FullPreviewReceiver->Mutex);
+    m_FullPreviewReceiver->Tool = nullptr;
+  }
+
+  // The worker calls DoUpdatePreview() of the derived class, whose members are already destroyed here.
+  // Thus it has to be stopped by Deactivated() or the destructor of the derived class.
+  assert(!m_FullPreviewWorker.joinable());
+}
+
+void mitk::AutoSegmentationWithPreviewTool::InitializeCommands()
+{
+  m_ProgressCommand = mitk::ToolCommand::New();
+
+  auto abortCommand = itk::MemberCommand<AutoSegmentationWithPreviewTool>::New();
+  abortCommand->SetCallbackFunction(this, &AutoSegmentationWithPreviewTool::OnFullPreviewFilterProgress);
+  m_FullPreviewAbortCommand = abortCommand;
+
+  m_FullPreviewReceiver = std::make_shared<FullPreviewReceiver>();
+  m_FullPreviewReceiver->Tool = this;
 }
 
 bool mitk::AutoSegmentationWithPreviewTool::CanHandle(const BaseData* referenceData, const BaseData* workingData) const
@@ -108,6 +164,8 @@ void mitk::AutoSegmentationWithPreviewTool::Activated()
 
 void mitk::AutoSegmentationWithPreviewTool::Deactivated()
 {
+  this->StopFullPreviewWorker();
+
   this->GetToolManager()->RoiDataChanged -=
     mitk::MessageDelegate<mitk::AutoSegmentationWithPreviewTool>(this, &mitk::AutoSegmentationWithPreviewTool::OnRoiDataChanged);
 
@@ -141,6 +199,8 @@ void mitk::AutoSegmentationWithPreviewTool::Deactivated()
 
 void mitk::AutoSegmentationWithPreviewTool::ConfirmSegmentation()
 {
+  this->WaitForFullPreview();
+
   if (m_LazyDynamicPreviews && m_CreateAllTimeSteps)
   { // The tool should create all time steps but is currently in lazy mode,
     // thus ensure that a preview for all time steps is available.
@@ -200,6 +260,8 @@ const mitk::Image* mitk::AutoSegmentationWithPreviewTool::GetReferenceData() con
 
 void mitk::AutoSegmentationWithPreviewTool::ResetPreviewNode()
 {
+  this->CancelFullPreview();
+
   itk::RGBPixel<float> previewColor;
   previewColor[0] = 0.0f;
   previewColor[1] = 1.0f;
@@ -459,6 +521,8 @@ void mitk::AutoSegmentationWithPreviewTool::UpdatePreview(bool ignoreLazyPreview
 
       if (previewImage->GetTimeSteps() > 1 && (ignoreLazyPreviewSetting || !m_LazyDynamicPreviews))
       {
+        this->CancelFullPreview();
+
         for (unsigned int timeStep = 0; timeStep < previewImage->GetTimeSteps(); ++timeStep)
         {
           Image::ConstPointer feedBackImage;
@@ -499,7 +563,22 @@ void mitk::AutoSegmentationWithPreviewTool::UpdatePreview(bool ignoreLazyPreview
 
         auto timeStep = previewImage->GetTimeGeometry()->TimePointToTimeStep(timePoint);
 
-        this->DoUpdatePreview(feedBackImage, currentSegImage, previewImage, timeStep);
+        const bool useIncrementalPreview = m_IncrementalPreview && !ignoreLazyPreviewSetting
+          && feedBackImage.IsNotNull()
+          && nullptr == this->GetWorkingPlaneGeometry()
+          && m_SegmentationInputNode.GetPointer() == m_ReferenceDataNode.GetPointer()
+          && previewImage->GetDimension() > 2 && previewImage->GetDimension(2) > 1;
+
+        if (useIncrementalPreview)
+        { //first the slices the user currently looks at, the rest of the volume in the background.
+          this->UpdateVisibleSlicesPreview(inputImage, workingImage, previewImage, timePoint, timeStep);
+          this->RequestFullPreview(feedBackImage, currentSegImage, previewImage, timeStep);
+        }
+        else
+        {
+          this->CancelFullPreview();
+          this->DoUpdatePreview(feedBackImage, currentSegImage, previewImage, timeStep);
+        }
       }
       RenderingManager::GetInstance()->RequestUpdateAll();
     }
@@ -533,6 +612,193 @@ bool mitk::AutoSegmentationWithPreviewTool::IsUpdating() const
   return m_IsUpdating;
 }
 
+void mitk::AutoSegmentationWithPreviewTool::UpdateVisibleSlicesPreview(const Image* inputImage, const Image* workingImage, Image* previewImage, TimePointType timePoint, TimeStepType timeStep)
+{
+  const auto inputGeometry = inputImage->GetTimeGeometry()->GetGeometryForTimePoint(timePoint);
+  if (inputGeometry.IsNull())
+    return;
+
+  for (auto renderWindow : RenderingManager::GetInstance()->GetAllRegisteredRenderWindows())
+  {
+    auto renderer = BaseRenderer::GetInstance(renderWindow);
+    if (nullptr == renderer || BaseRenderer::Standard2D != renderer->GetMapperID())
+      continue;
+
+    const auto planeGeometry = renderer->GetCurrentWorldPlaneGeometry();
+    if (nullptr == planeGeometry || !inputGeometry->IsInside(planeGeometry->GetCenter()))
+      continue;
+
+    auto inputSlice = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(planeGeometry, inputImage, timePoint);
+    auto oldSegSlice = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(planeGeometry, workingImage, timePoint);
+
+    auto previewSlice = Image::New();
+    previewSlice->Initialize(previewImage->GetPixelType(), *(inputSlice->GetTimeGeometry()), 1, 1);
+
+    this->DoUpdatePreview(inputSlice, oldSegSlice, previewSlice, 0);
+
+    SegTool2D::WriteSliceToVolume(previewImage, planeGeometry, previewSlice, timeStep, false);
+  }
+}
+
+void mitk::AutoSegmentationWithPreviewTool::RequestFullPreview(const Image* inputAtTimeStep, const Image* oldSegAtTimeStep, const Image* previewImage, TimeStepType timeStep)
+{
+  std::unique_ptr<FullPreviewJob> job(new FullPreviewJob);
+  job->Input = inputAtTimeStep;
+  job->OldSegmentation = oldSegAtTimeStep;
+  job->Result = Image::New();
+  job->Result->Initialize(previewImage->GetPixelType(), *(inputAtTimeStep->GetGeometry()));
+  job->TimeStep = timeStep;
+
+  {
+    std::lock_guard<std::mutex> lock(m_FullPreviewMutex);
+    job->Generation = ++m_FullPreviewGeneration;
+    m_QueuedFullPreviewJob = std::move(job);
+    m_FinishedFullPreviewJob.reset();
+
+    if (!m_FullPreviewWorker.joinable())
+    {
+      m_StopFullPreviewWorker = false;
+      m_FullPreviewWorker = std::thread(&AutoSegmentationWithPreviewTool::FullPreviewWorkerLoop, this);
+    }
+  }
+  m_FullPreviewCondition.notify_all();
+}
+
+void mitk::AutoSegmentationWithPreviewTool::CancelFullPreview()
+{
+  std::lock_guard<std::mutex> lock(m_FullPreviewMutex);
+  ++m_FullPreviewGeneration;
+  m_QueuedFullPreviewJob.reset();
+  m_FinishedFullPreviewJob.reset();
+}
+
+void mitk::AutoSegmentationWithPreviewTool::StopFullPreviewWorker()
+{
+  this->CancelFullPreview();
+
+  {
+    std::lock_guard<std::mutex> lock(m_FullPreviewMutex);
+    m_StopFullPreviewWorker = true;
+  }
+  m_FullPreviewCondition.notify_all();
+
+  if (m_FullPreviewWorker.joinable())
+  {
+    m_FullPreviewWorker.join();
+  }
+}
+
+void mitk::AutoSegmentationWithPreviewTool::FullPreviewWorkerLoop()
+{
+  std::unique_lock<std::mutex> lock(m_FullPreviewMutex);
+
+  while (true)
+  {
+    m_FullPreviewCondition.wait(lock, [this] { return m_StopFullPreviewWorker || nullptr != m_QueuedFullPreviewJob; });
+
+    if (m_StopFullPreviewWorker)
+      break;
+
+    auto job = std::move(m_QueuedFullPreviewJob);
+    m_RunningFullPreviewGeneration = job->Generation;
+    m_FullPreviewRunning = true;
+    lock.unlock();
+
+    bool success = false;
+    try
+    {
+      this->DoUpdatePreview(job->Input, job->OldSegmentation, job->Result, 0);
+      success = true;
+    }
+    catch (const itk::ProcessAborted&)
+    {
+      // the job became obsolete while it was computed
+    }
+    catch (const itk::ExceptionObject& e)
+    {
+      MITK_ERROR << "Error while computing the full preview: " << e.GetDescription();
+    }
+    catch (...)
+    {
+      MITK_ERROR << "Unknown error while computing the full preview.";
+    }
+
+    lock.lock();
+    m_FullPreviewRunning = false;
+
+    const bool isCurrent = success && job->Generation == m_FullPreviewGeneration;
+    if (isCurrent)
+    {
+      m_FinishedFullPreviewJob = std::move(job);
+    }
+    m_FullPreviewCondition.notify_all();
+
+    if (isCurrent)
+    {
+      lock.unlock();
+      auto command = FullPreviewAvailableCommand::New();
+      command->SetReceiver(m_FullPreviewReceiver);
+      CallbackFromGUIThread::GetInstance()->CallThisFromGUIThread(command);
+      lock.lock();
+    }
+  }
+}
+
+bool mitk::AutoSegmentationWithPreviewTool::IsFullPreviewCancelled() const
+{
+  std::lock_guard<std::mutex> lock(m_FullPreviewMutex);
+  return m_FullPreviewRunning && std::this_thread::get_id() == m_FullPreviewWorker.get_id()
+    && m_RunningFullPreviewGeneration != m_FullPreviewGeneration;
+}
+
+void mitk::AutoSegmentationWithPreviewTool::OnFullPreviewFilterProgress(itk::Object* caller, const itk::EventObject&)
+{
+  auto filter = dynamic_cast<itk::ProcessObject*>(caller);
+
+  if (nullptr != filter && this->IsFullPreviewCancelled())
+  {
+    filter->AbortGenerateDataOn();
+  }
+}
+
+void mitk::AutoSegmentationWithPreviewTool::ApplyFullPreview()
+{
+  std::unique_ptr<FullPreviewJob> job;
+  {
+    std::lock_guard<std::mutex> lock(m_FullPreviewMutex);
+    if (nullptr != m_FinishedFullPreviewJob && m_FinishedFullPreviewJob->Generation == m_FullPreviewGeneration)
+    {
+      job = std::move(m_FinishedFullPreviewJob);
+    }
+    m_FinishedFullPreviewJob.reset();
+  }
+
+  auto previewImage = this->GetPreviewSegmentation();
+  if (nullptr == job || nullptr == previewImage || job->TimeStep >= previewImage->GetTimeSteps())
+    return;
+
+  ImageReadAccessor resultAccessor(job->Result);
+  previewImage->SetVolume(resultAccessor.GetData(), job->TimeStep);
+
+  RenderingManager::GetInstance()->RequestUpdateAll();
+}
+
+bool mitk::AutoSegmentationWithPreviewTool::IsFullPreviewPending() const
+{
+  std::lock_guard<std::mutex> lock(m_FullPreviewMutex);
+  return nullptr != m_QueuedFullPreviewJob || m_FullPreviewRunning || nullptr != m_FinishedFullPreviewJob;
+}
+
+void mitk::AutoSegmentationWithPreviewTool::WaitForFullPreview()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_FullPreviewMutex);
+    m_FullPreviewCondition.wait(lock, [this] { return !m_FullPreviewRunning && (nullptr == m_QueuedFullPreviewJob || m_StopFullPreviewWorker); });
+  }
+
+  this->ApplyFullPreview();
+}
+
 void mitk::AutoSegmentationWithPreviewTool::UpdatePrepare()
 {
   // default implementation does nothing
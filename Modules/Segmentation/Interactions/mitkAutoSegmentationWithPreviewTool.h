@@ -19,6 +19,11 @@ found in the LICENSE file.
 #include "mitkToolCommand.h"
 #include <MitkSegmentationExports.h>
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace mitk
 {
   /**
@@ -62,6 +67,18 @@ namespace mitk
     itkGetMacro(ResetsToEmptyPreview, bool);
     itkBooleanMacro(ResetsToEmptyPreview);
 
+    /** Controls the incremental preview mode. If it is active, UpdatePreview() first computes
+     * the preview only for the slices currently shown in the 2D render windows and
+     * finishes the full volume asynchronously. A new update request discards all results of
+     * pending or running full volume updates.
+     * Only tools that compute the preview voxel wise (the result of a voxel only depends
+     * on the input at this voxel) and whose DoUpdatePreview() may be called from a worker
+     * thread should activate this mode. Such a tool has to call StopFullPreviewWorker() in its
+     * destructor, because the worker may call DoUpdatePreview() until it is stopped.*/
+    itkSetMacro(IncrementalPreview, bool);
+    itkGetMacro(IncrementalPreview, bool);
+    itkBooleanMacro(IncrementalPreview);
+
     bool CanHandle(const BaseData* referenceData, const BaseData* workingData) const override;
 
     /** Triggers the actualization of the preview
@@ -76,9 +93,23 @@ namespace mitk
     /** Indicate if currently UpdatePreview is triggered (true) or not (false).*/
     bool IsUpdating() const;
 
+    /** Indicate if an asynchronous full volume update of the preview (see IncrementalPreview)
+     * is not yet transfered into the preview.*/
+    bool IsFullPreviewPending() const;
+
+    /** Blocks until the asynchronous full volume update of the preview is finished and
+     * transfers its result into the preview. Does nothing if no update is pending.*/
+    void WaitForFullPreview();
+
   protected:
     mitk::ToolCommand::Pointer m_ProgressCommand;
 
+    /** Derived classes should let the filters used in DoUpdatePreview report itk::ProgressEvent to
+     * this command. If DoUpdatePreview is computing a full preview in the background that became
+     * obsolete (e.g. because the parameters changed again), the command aborts the filter
+     * (itk::ProcessAborted) instead of letting it finish.*/
+    itk::Command::Pointer m_FullPreviewAbortCommand;
+
     /** Member is always called if GetSegmentationInput() has changed
      * (e.g. because a new ROI was defined, or on activation) to give derived
      * classes the posibility to initiate their state accordingly.
@@ -130,10 +161,18 @@ namespace mitk
 
     TimePointType GetLastTimePointOfUpdate() const;
 
+    /** Discards all full volume updates of the preview and stops the worker thread that computes
+     * them (see IncrementalPreview). Blocks until a running DoUpdatePreview() of the worker returned.
+     * It is called by Deactivated(). Derived classes that activate the incremental preview have to
+     * call it in their destructor, the destructor of this class only checks that the worker is stopped.*/
+    void StopFullPreviewWorker();
+
     itkSetObjectMacro(WorkingPlaneGeometry, PlaneGeometry);
     itkGetConstObjectMacro(WorkingPlaneGeometry, PlaneGeometry);
 
   private:
+    void InitializeCommands();
+
     void TransferImageAtTimeStep(const Image* sourceImage, Image* destinationImage, const TimeStepType timeStep);
 
     void CreateResultSegmentationFromPreview();
@@ -141,6 +180,36 @@ namespace mitk
     void OnRoiDataChanged();
     void OnTimePointChanged();
 
+    /** Computes the preview for all slices of the passed time step that are currently
+     * displayed by a 2D render window and writes them into the preview image.*/
+    void UpdateVisibleSlicesPreview(const Image* inputImage, const Image* workingImage, Image* previewImage, TimePointType timePoint, TimeStepType timeStep);
+
+    /** Queues a full volume update of the preview. A job that is queued but not yet started is replaced.*/
+    void RequestFullPreview(const Image* inputAtTimeStep, const Image* oldSegAtTimeStep, const Image* previewImage, TimeStepType timeStep);
+    /** Discards the results of all queued or running full volume updates.*/
+    void CancelFullPreview();
+    void FullPreviewWorkerLoop();
+    /** Indicates if the calling thread is the worker and its current job became obsolete.*/
+    bool IsFullPreviewCancelled() const;
+    void OnFullPreviewFilterProgress(itk::Object* caller, const itk::EventObject&);
+    /** Transfers the result of the last full volume update into the preview, if it is still current.*/
+    void ApplyFullPreview();
+
+    struct FullPreviewJob
+    {
+      Image::ConstPointer Input;
+      Image::ConstPointer OldSegmentation;
+      Image::Pointer Result;
+      TimeStepType TimeStep;
+      unsigned long Generation;
+    };
+
+    /** Target of the commands the worker posts to the GUI thread. It is shared with these commands
+     * and revoked by the destructor, so commands that are still pending afterwards do nothing.*/
+    struct FullPreviewReceiver;
+    class FullPreviewAvailableCommand;
+    std::shared_ptr<FullPreviewReceiver> m_FullPreviewReceiver;
+
     /** Node that containes the preview data generated and managed by this class or derived ones.*/
     DataNode::Pointer m_PreviewSegmentationNode;
     /** The reference data recieved from ToolManager::GetReferenceData when tool was activated.*/
@@ -173,6 +242,22 @@ namespace mitk
 
     bool m_IsUpdating = false;
 
+    bool m_IncrementalPreview = false;
+
+    std::thread m_FullPreviewWorker;
+    mutable std::mutex m_FullPreviewMutex;
+    std::condition_variable m_FullPreviewCondition;
+    /** Job that waits to be processed by the worker.*/
+    std::unique_ptr<FullPreviewJob> m_QueuedFullPreviewJob;
+    /** Job that is computed but not yet transfered into the preview.*/
+    std::unique_ptr<FullPreviewJob> m_FinishedFullPreviewJob;
+    /** Incremented on every update request; results of older jobs are discarded.*/
+    unsigned long m_FullPreviewGeneration = 0;
+    /** Generation of the job the worker is computing.*/
+    unsigned long m_RunningFullPreviewGeneration = 0;
+    bool m_FullPreviewRunning = false;
+    bool m_StopFullPreviewWorker = false;
+
     /** This variable indicates if for the tool a working plane geometry is defined.
      * If a working plane is defined the tool will only work an the slice of the input
      * and the segmentation. Thus only the relevant input slice will be passed to
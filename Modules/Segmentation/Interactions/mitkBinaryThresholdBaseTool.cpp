@@ -25,10 +25,14 @@ mitk::BinaryThresholdBaseTool::BinaryThresholdBaseTool()
     m_CurrentLowerThresholdValue(1),
     m_CurrentUpperThresholdValue(1)
 {
+  // thresholding is voxel wise, thus the visible slices can be previewed independently of the volume.
+  this->IncrementalPreviewOn();
 }
 
 mitk::BinaryThresholdBaseTool::~BinaryThresholdBaseTool()
 {
+  // the full preview worker uses the threshold values, see DoUpdatePreview()
+  this->StopFullPreviewWorker();
 }
 
 void mitk::BinaryThresholdBaseTool::SetThresholdValues(double lower, double upper)
@@ -45,8 +49,11 @@ void mitk::BinaryThresholdBaseTool::SetThresholdValues(double lower, double uppe
     return;
   }
 
-  m_CurrentLowerThresholdValue = lower;
-  m_CurrentUpperThresholdValue = upper;
+  {
+    std::lock_guard<std::mutex> lock(m_ThresholdMutex);
+    m_CurrentLowerThresholdValue = lower;
+    m_CurrentUpperThresholdValue = upper;
+  }
 
   if (nullptr != this->GetPreviewSegmentation())
   {
@@ -68,6 +75,7 @@ void mitk::BinaryThresholdBaseTool::InitiateToolByInput()
       m_SensibleMaximumThresholdValue = std::max(m_SensibleMaximumThresholdValue, static_cast<double>(statistics->GetScalarValueMax()));
     }
 
+    std::unique_lock<std::mutex> lock(m_ThresholdMutex);
     if (m_LockedUpperThreshold)
     {
       m_CurrentLowerThresholdValue = (m_SensibleMaximumThresholdValue + m_SensibleMinimumThresholdValue) / 2.0;
@@ -79,6 +87,7 @@ void mitk::BinaryThresholdBaseTool::InitiateToolByInput()
       m_CurrentLowerThresholdValue = m_SensibleMinimumThresholdValue + range / 3.0;
       m_CurrentUpperThresholdValue = m_SensibleMinimumThresholdValue + 2 * range / 3.0;
     }
+    lock.unlock();
 
     bool isFloatImage = false;
     if ((referenceImage->GetPixelType().GetPixelType() == itk::ImageIOBase::SCALAR) &&
@@ -98,7 +107,8 @@ static void ITKThresholding(const itk::Image<TPixel, VImageDimension> *originalI
                             mitk::Image *segmentation,
                             double lower,
                             double upper,
-                            unsigned int timeStep)
+                            unsigned int timeStep,
+                            itk::Command *abortCommand)
 {
   typedef itk::Image<TPixel, VImageDimension> ImageType;
   typedef itk::Image<mitk::Tool::DefaultSegmentationDataType, VImageDimension> SegmentationType;
@@ -110,6 +120,7 @@ static void ITKThresholding(const itk::Image<TPixel, VImageDimension> *originalI
   filter->SetUpperThreshold(upper);
   filter->SetInsideValue(1);
   filter->SetOutsideValue(0);
+  filter->AddObserver(itk::ProgressEvent(), abortCommand);
   filter->Update();
 
   segmentation->SetVolume((void *)(filter->GetOutput()->GetPixelContainer()->GetBufferPointer()), timeStep);
@@ -119,8 +130,13 @@ void mitk::BinaryThresholdBaseTool::DoUpdatePreview(const Image* inputAtTimeStep
 {
   if (nullptr != inputAtTimeStep && nullptr != previewImage)
   {
-      AccessByItk_n(inputAtTimeStep,
-        ITKThresholding,
-        (previewImage, m_CurrentLowerThresholdValue, m_CurrentUpperThresholdValue, timeStep));
+    ScalarType lower, upper;
+    {
+      std::lock_guard<std::mutex> lock(m_ThresholdMutex);
+      lower = m_CurrentLowerThresholdValue;
+      upper = m_CurrentUpperThresholdValue;
+    }
+
+    AccessByItk_n(inputAtTimeStep, ITKThresholding, (previewImage, lower, upper, timeStep, m_FullPreviewAbortCommand.GetPointer()));
   }
 }
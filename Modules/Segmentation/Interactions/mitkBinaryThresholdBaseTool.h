@@ -21,6 +21,8 @@ found in the LICENSE file.
 #include <itkBinaryThresholdImageFilter.h>
 #include <itkImage.h>
 
+#include <mutex>
+
 namespace mitk
 {
   /**
@@ -59,6 +61,8 @@ namespace mitk
     ScalarType m_SensibleMaximumThresholdValue;
     ScalarType m_CurrentLowerThresholdValue;
     ScalarType m_CurrentUpperThresholdValue;
+    /** Guards the current threshold values, as DoUpdatePreview is also called by the full preview worker.*/
+    std::mutex m_ThresholdMutex;
 
     /** Indicates if the tool should behave like a single threshold tool (true)
       or like a upper/lower threshold tool (false)*/
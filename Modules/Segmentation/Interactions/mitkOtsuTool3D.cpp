@@ -34,6 +34,7 @@ void mitk::OtsuTool3D::Activated()
   m_NumberOfBins = 128;
   m_NumberOfRegions = 2;
   m_UseValley = false;
+  m_OtsuFilter = nullptr;
 }
 
 const char **mitk::OtsuTool3D::GetXPM() const
@@ -57,24 +58,31 @@ mitk::LabelSetImage::Pointer mitk::OtsuTool3D::ComputeMLPreview(const Image* inp
 {
   int numberOfThresholds = m_NumberOfRegions - 1;
 
-  mitk::OtsuSegmentationFilter::Pointer otsuFilter = mitk::OtsuSegmentationFilter::New();
-  otsuFilter->SetNumberOfThresholds(numberOfThresholds);
-  otsuFilter->SetValleyEmphasis(m_UseValley);
-  otsuFilter->SetNumberOfBins(m_NumberOfBins);
-  otsuFilter->SetInput(inputAtTimeStep);
-  otsuFilter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
+  // The filter is kept, so that it can reuse the histogram of the input if only
+  // the number of regions or the valley emphasis are changed.
+  if (m_OtsuFilter.IsNull())
+  {
+    m_OtsuFilter = mitk::OtsuSegmentationFilter::New();
+    m_OtsuFilter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
+  }
+
+  m_OtsuFilter->SetNumberOfThresholds(numberOfThresholds);
+  m_OtsuFilter->SetValleyEmphasis(m_UseValley);
+  m_OtsuFilter->SetNumberOfBins(m_NumberOfBins);
+  m_OtsuFilter->SetInput(inputAtTimeStep);
 
   try
   {
-    otsuFilter->Update();
+    m_OtsuFilter->Update();
   }
   catch (...)
   {
+    m_OtsuFilter = nullptr;
     mitkThrow() << "itkOtsuFilter error (image dimension must be in {2, 3} and image must not be RGB)";
   }
 
   auto otsuResultImage = mitk::LabelSetImage::New();
-  otsuResultImage->InitializeByLabeledImage(otsuFilter->GetOutput());
+  otsuResultImage->InitializeByLabeledImage(m_OtsuFilter->GetOutput());
   return otsuResultImage;
 }
 
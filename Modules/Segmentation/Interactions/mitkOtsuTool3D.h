@@ -13,6 +13,7 @@ found in the LICENSE file.
 #define MITKOTSUTOOL3D_H
 
 #include "mitkAutoMLSegmentationWithPreviewTool.h"
+#include "mitkOtsuSegmentationFilter.h"
 #include <MitkSegmentationExports.h>
 
 namespace us
@@ -59,6 +60,9 @@ namespace mitk
     unsigned int m_NumberOfBins = 128;
     unsigned int m_NumberOfRegions = 2;
     bool m_UseValley = false;
+
+  private:
+    OtsuSegmentationFilter::Pointer m_OtsuFilter;
   }; // class
 } // namespace
 #endif
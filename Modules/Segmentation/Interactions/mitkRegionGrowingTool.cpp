@@ -11,11 +11,20 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkRegionGrowingTool.h"
+#include "mitkApplyDiffImageOperation.h"
 #include "mitkBaseRenderer.h"
+#include "mitkContourModelUtils.h"
+#include "mitkDiffImageApplier.h"
+#include "mitkImagePixelReadAccessor.h"
+#include "mitkImagePixelWriteAccessor.h"
 #include "mitkImageToContourModelFilter.h"
+#include "mitkLabelSetImage.h"
+#include "mitkOperationEvent.h"
+#include "mitkPointSet.h"
 #include "mitkRegionGrowingTool.xpm"
 #include "mitkRenderingManager.h"
 #include "mitkToolManager.h"
+#include "mitkUndoController.h"
 
 // us
 #include <usGetModuleContext.h>
@@ -27,12 +36,15 @@ found in the LICENSE file.
 #include "mitkITKImageImport.h"
 #include "mitkImageAccessByItk.h"
 #include <itkConnectedComponentImageFilter.h>
-#include <itkConnectedThresholdImageFilter.h>
+#include <itkParallelConnectedThresholdImageFilter.h>
 #include <itkNeighborhoodIterator.h>
 
+#include <itkCommand.h>
 #include <itkImageDuplicator.h>
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 namespace mitk
 {
@@ -49,12 +61,21 @@ mitk::RegionGrowingTool::RegionGrowingTool()
     m_MouseDistanceScaleFactor(0.5),
     m_PaintingPixelValue(0),
     m_FillFeedbackContour(true),
-    m_ConnectedComponentValue(1)
+    m_ConnectedComponentValue(1),
+    m_Use3DRegionGrowing(false),
+    m_RegionGrowing3DTimeStep(0),
+    m_RegionGrowing3DPaintingPixelValue(0)
 {
 }
 
 mitk::RegionGrowingTool::~RegionGrowingTool()
 {
+  if (m_RegionGrowing3D.IsNotNull())
+  {
+    // a result that is already queued for the GUI thread must not reach this tool anymore
+    m_RegionGrowing3D->RemoveAllObservers();
+    m_RegionGrowing3D->Cancel();
+  }
 }
 
 void mitk::RegionGrowingTool::ConnectActionsAndFunctions()
@@ -95,9 +116,29 @@ void mitk::RegionGrowingTool::Activated()
 
 void mitk::RegionGrowingTool::Deactivated()
 {
+  this->Cancel3DRegionGrowing();
   Superclass::Deactivated();
 }
 
+bool mitk::RegionGrowingTool::Is3DRegionGrowingRunning() const
+{
+  return m_RegionGrowing3D.IsNotNull();
+}
+
+void mitk::RegionGrowingTool::Cancel3DRegionGrowing()
+{
+  if (m_RegionGrowing3D.IsNull())
+    return;
+
+  // a result that is already queued for the GUI thread must not reach this tool anymore
+  m_RegionGrowing3D->RemoveAllObservers();
+  m_RegionGrowing3D->Cancel();
+  m_RegionGrowing3D = nullptr;
+  m_RegionGrowing3DWorkingNode = nullptr;
+
+  this->CurrentlyBusy.Send(false);
+}
+
 // Get the average pixel value of square/cube with radius=neighborhood around index
 template <typename TPixel, unsigned int imageDimension>
 void mitk::RegionGrowingTool::GetNeighborhoodAverage(const itk::Image<TPixel, imageDimension> *itkImage,
@@ -176,7 +217,7 @@ void mitk::RegionGrowingTool::IsInsideSegmentation(const itk::Image<TPixel, imag
   }
 }
 
-// Do the region growing (i.e. call an ITK filter that does it)
+// Do the region growing (i.e. call a multi-threaded ITK filter that does it)
 template <typename TPixel, unsigned int imageDimension>
 void mitk::RegionGrowingTool::StartRegionGrowing(const itk::Image<TPixel, imageDimension> *inputImage,
                                                  const itk::Index<imageDimension>& seedIndex,
@@ -189,7 +230,7 @@ void mitk::RegionGrowingTool::StartRegionGrowing(const itk::Image<TPixel, imageD
   typedef itk::Image<TPixel, imageDimension> InputImageType;
   typedef itk::Image<DefaultSegmentationDataType, imageDimension> OutputImageType;
 
-  typedef itk::ConnectedThresholdImageFilter<InputImageType, OutputImageType> RegionGrowingFilterType;
+  typedef itk::ParallelConnectedThresholdImageFilter<InputImageType, OutputImageType> RegionGrowingFilterType;
   typename RegionGrowingFilterType::Pointer regionGrower = RegionGrowingFilterType::New();
 
   // perform region growing in desired segmented region
@@ -310,6 +351,7 @@ void mitk::RegionGrowingTool::OnMousePressed(StateMachineAction *, InteractionEv
   m_LastEventSender = positionEvent->GetSender();
   m_LastEventSlice = m_LastEventSender->GetSlice();
   m_LastScreenPosition = Point2I(positionEvent->GetPointerPositionOnScreen());
+  m_SeedPointInWorld = positionEvent->GetPositionInWorld();
 
   // ReferenceSlice is from the underlying image, WorkingSlice from the active segmentation (can be empty)
   m_ReferenceSlice = FeedbackContourTool::GetAffectedReferenceSlice(positionEvent);
@@ -502,9 +544,164 @@ void mitk::RegionGrowingTool::OnMouseReleased(StateMachineAction *, InteractionE
 
   if (m_WorkingSlice.IsNotNull() && m_FillFeedbackContour && positionEvent)
   {
-    this->WriteBackFeedbackContourAsSegmentationResult(positionEvent, m_PaintingPixelValue);
+    if (m_Use3DRegionGrowing && this->Start3DRegionGrowing(positionEvent))
+    {
+      FeedbackContourTool::SetFeedbackContourVisible(false);
+      mitk::RenderingManager::GetInstance()->RequestUpdateAll();
+    }
+    else
+    {
+      this->WriteBackFeedbackContourAsSegmentationResult(positionEvent, m_PaintingPixelValue);
+    }
 
     m_ScreenYDifference = 0;
     m_ScreenXDifference = 0;
   }
 }
+
+bool mitk::RegionGrowingTool::Start3DRegionGrowing(const InteractionPositionEvent *positionEvent)
+{
+  DataNode *referenceNode = this->GetToolManager()->GetReferenceData(0);
+  DataNode *workingNode = this->GetToolManager()->GetWorkingData(0);
+  auto *referenceImage = nullptr != referenceNode ? dynamic_cast<Image *>(referenceNode->GetData()) : nullptr;
+  auto *workingImage = nullptr != workingNode ? dynamic_cast<Image *>(workingNode->GetData()) : nullptr;
+
+  if (nullptr == referenceImage || nullptr == workingImage || referenceImage->GetDimension() < 3)
+    return false;
+
+  // only one region growing at a time, a new one replaces the running one
+  this->Cancel3DRegionGrowing();
+
+  auto seedPoints = PointSet::New();
+  seedPoints->InsertPoint(0, m_SeedPointInWorld);
+
+  m_RegionGrowing3D = RegionGrowing3DAlgorithm::New();
+  m_RegionGrowing3D->SetPointerParameter("Input", referenceImage);
+  m_RegionGrowing3D->SetPointerParameter("Seed points", seedPoints);
+  m_RegionGrowing3D->SetParameter("Lower threshold", static_cast<double>(m_Thresholds[0]));
+  m_RegionGrowing3D->SetParameter("Upper threshold", static_cast<double>(m_Thresholds[1]));
+  m_RegionGrowing3D->SetParameter("Time step", static_cast<unsigned int>(positionEvent->GetSender()->GetTimeStep(referenceImage)));
+
+  m_RegionGrowing3DWorkingNode = workingNode;
+  m_RegionGrowing3DTimeStep = positionEvent->GetSender()->GetTimeStep(workingImage);
+  m_RegionGrowing3DPaintingPixelValue = m_PaintingPixelValue;
+
+  auto resultCommand = itk::SimpleMemberCommand<RegionGrowingTool>::New();
+  resultCommand->SetCallbackFunction(this, &RegionGrowingTool::On3DRegionGrowingFinished);
+  m_RegionGrowing3D->AddObserver(ResultAvailable(), resultCommand);
+
+  auto errorCommand = itk::SimpleMemberCommand<RegionGrowingTool>::New();
+  errorCommand->SetCallbackFunction(this, &RegionGrowingTool::On3DRegionGrowingFailed);
+  m_RegionGrowing3D->AddObserver(ProcessingError(), errorCommand);
+
+  this->CurrentlyBusy.Send(true);
+  m_RegionGrowing3D->StartAlgorithm();
+
+  return true;
+}
+
+void mitk::RegionGrowingTool::On3DRegionGrowingFinished()
+{
+  if (m_RegionGrowing3D.IsNull())
+    return;
+
+  Image::Pointer result = m_RegionGrowing3D->GetResult();
+  DataNode::Pointer workingNode = m_RegionGrowing3DWorkingNode;
+  const TimeStepType timeStep = m_RegionGrowing3DTimeStep;
+
+  m_RegionGrowing3D = nullptr;
+  m_RegionGrowing3DWorkingNode = nullptr;
+  this->CurrentlyBusy.Send(false);
+
+  auto *workingImage = workingNode.IsNotNull() ? dynamic_cast<Image *>(workingNode->GetData()) : nullptr;
+
+  if (result.IsNull() || nullptr == workingImage)
+    return;
+
+  if (workingImage->GetPixelType() != MakeScalarPixelType<DefaultSegmentationDataType>() ||
+      timeStep >= workingImage->GetTimeSteps() || workingImage->GetDimension(0) != result->GetDimension(0) ||
+      workingImage->GetDimension(1) != result->GetDimension(1) || workingImage->GetDimension(2) != result->GetDimension(2))
+  {
+    MITK_ERROR << "Result of the 3D region growing does not match the segmentation.";
+    this->ErrorMessage.Send("The result of the 3D region growing does not match the segmentation.");
+    return;
+  }
+
+  // Like the 2D write back (see ContourModelUtils::FillSliceInSlice), painting does not overwrite locked labels
+  // and erasing only removes the active label
+  const auto activePixelValue = static_cast<DefaultSegmentationDataType>(ContourModelUtils::GetActivePixelValue(workingImage));
+  const auto paintingPixelValue = static_cast<DefaultSegmentationDataType>(m_RegionGrowing3DPaintingPixelValue * activePixelValue);
+  std::vector<bool> isLocked(static_cast<std::size_t>(std::numeric_limits<DefaultSegmentationDataType>::max()) + 1, false);
+  bool eraseActiveLabelOnly = false;
+
+  auto *labelSetImage = dynamic_cast<LabelSetImage *>(workingImage);
+  if (nullptr != labelSetImage)
+  {
+    const LabelSet *labelSet = labelSetImage->GetLabelSet(labelSetImage->GetActiveLayer());
+    for (auto it = labelSet->IteratorConstBegin(); it != labelSet->IteratorConstEnd(); ++it)
+      isLocked[it->first] = it->second->GetLocked();
+
+    if (paintingPixelValue == labelSetImage->GetExteriorLabel()->GetValue())
+    {
+      eraseActiveLabelOnly = true;
+      std::fill(isLocked.begin(), isLocked.end(), true);
+      isLocked[activePixelValue] = false;
+    }
+  }
+
+  // The changes are applied as difference image, so that they can be undone like the 2D write back
+  auto diffImage = Image::New();
+  diffImage->Initialize(result);
+  std::size_t numberOfChangedVoxels = 0;
+
+  {
+    ImagePixelReadAccessor<DefaultSegmentationDataType, 3> resultAccessor(result);
+    ImagePixelReadAccessor<DefaultSegmentationDataType, 3> workingAccessor(workingImage, workingImage->GetVolumeData(timeStep));
+    ImagePixelWriteAccessor<DefaultSegmentationDataType, 3> diffAccessor(diffImage);
+
+    const DefaultSegmentationDataType *resultBuffer = resultAccessor.GetData();
+    const DefaultSegmentationDataType *workingBuffer = workingAccessor.GetData();
+    DefaultSegmentationDataType *diffBuffer = diffAccessor.GetData();
+    const std::size_t numberOfVoxels = static_cast<std::size_t>(result->GetDimension(0)) * result->GetDimension(1) * result->GetDimension(2);
+
+    for (std::size_t i = 0; i < numberOfVoxels; ++i)
+    {
+      diffBuffer[i] = 0;
+
+      if (0 != resultBuffer[i] && !isLocked[workingBuffer[i]] && workingBuffer[i] != paintingPixelValue)
+      {
+        // wraps around for unsigned pixel types, which DiffImageApplier reverts when adding the difference
+        diffBuffer[i] = static_cast<DefaultSegmentationDataType>(paintingPixelValue - workingBuffer[i]);
+        ++numberOfChangedVoxels;
+      }
+    }
+  }
+
+  if (0 == numberOfChangedVoxels)
+    return;
+
+  auto *doOp = new ApplyDiffImageOperation(OpTEST, workingImage, diffImage, timeStep);
+  auto *undoOp = new ApplyDiffImageOperation(OpTEST, workingImage, diffImage, timeStep);
+  undoOp->SetFactor(-1.0);
+
+  auto *undoStackItem = new OperationEvent(DiffImageApplier::GetInstanceForUndo(), doOp, undoOp,
+    eraseActiveLabelOnly ? "3D region growing (erase)" : "3D region growing");
+
+  OperationEvent::IncCurrGroupEventId();
+  OperationEvent::IncCurrObjectEventId();
+  UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
+
+  DiffImageApplier::GetInstanceForUndo()->ExecuteOperation(doOp);
+}
+
+void mitk::RegionGrowingTool::On3DRegionGrowingFailed()
+{
+  if (m_RegionGrowing3D.IsNull())
+    return;
+
+  m_RegionGrowing3D = nullptr;
+  m_RegionGrowing3DWorkingNode = nullptr;
+  this->CurrentlyBusy.Send(false);
+
+  this->ErrorMessage.Send("3D region growing failed.");
+}
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkRegionGrowingTool_h_Included
 
 #include "mitkFeedbackContourTool.h"
+#include "mitkRegionGrowing3DAlgorithm.h"
 #include <MitkSegmentationExports.h>
 #include <array>
 
@@ -45,6 +46,11 @@ namespace mitk
     If the first click is <i>inside</i> a segmentation, nothing will happen (other behaviour, for example removal of a
     region, can be implemented via OnMousePressedInside()).
 
+    With Use3DRegionGrowing enabled, the threshold window is still chosen on the slice, but releasing the button grows
+    the region in the whole volume. The 3D region growing runs in the background (see RegionGrowing3DAlgorithm), the
+    result is written to the working image once it is available, as one undoable operation. CurrentlyBusy is sent
+    while it is running.
+
     \warning Only to be instantiated by mitk::ToolManager.
 
     $Author$
@@ -62,6 +68,20 @@ namespace mitk
 
     const char *GetName() const override;
 
+    /**
+     * @brief Whether releasing the mouse button grows the region in the whole volume instead of the current slice
+     * (default: off).
+     */
+    itkSetMacro(Use3DRegionGrowing, bool);
+    itkGetConstMacro(Use3DRegionGrowing, bool);
+    itkBooleanMacro(Use3DRegionGrowing);
+
+    /** @brief Whether a 3D region growing is running in the background. */
+    bool Is3DRegionGrowingRunning() const;
+
+    /** @brief Stops a running 3D region growing, the working image is left unchanged. */
+    void Cancel3DRegionGrowing();
+
   protected:
     RegionGrowingTool(); // purposely hidden
     ~RegionGrowingTool() override;
@@ -103,6 +123,22 @@ namespace mitk
      */
     virtual void OnMouseReleased(StateMachineAction *, InteractionEvent *interactionEvent);
 
+    /**
+     * @brief Starts the 3D region growing from the current seed point with the current thresholds.
+     * @return false if the reference image is no volume, the slice result should be written back then.
+     */
+    bool Start3DRegionGrowing(const InteractionPositionEvent *positionEvent);
+
+    /**
+     * @brief Writes the result of the 3D region growing to the working image (called from the GUI thread).
+     */
+    void On3DRegionGrowingFinished();
+
+    /**
+     * @brief Called from the GUI thread if the 3D region growing failed or was cancelled.
+     */
+    void On3DRegionGrowingFailed();
+
     /**
      * @brief Template to calculate average pixel value around index using a square/cube with radius neighborhood.
      * Example: 1 = 3x3 pixels, 2 = 5x5 pixels, etc.
@@ -139,6 +175,8 @@ namespace mitk
     Image::Pointer m_ReferenceSlice;
     Image::Pointer m_WorkingSlice;
 
+    Point3D m_SeedPointInWorld;
+
     ScalarType m_SeedValue;
     itk::Index<3> m_SeedPoint;
     std::array<ScalarType, 2> m_ThresholdExtrema;
@@ -153,6 +191,12 @@ namespace mitk
     int m_PaintingPixelValue;
     bool m_FillFeedbackContour;
     int m_ConnectedComponentValue;
+
+    bool m_Use3DRegionGrowing;
+    RegionGrowing3DAlgorithm::Pointer m_RegionGrowing3D;
+    DataNode::Pointer m_RegionGrowing3DWorkingNode;
+    TimeStepType m_RegionGrowing3DTimeStep;
+    int m_RegionGrowing3DPaintingPixelValue;
   };
 
 } // namespace
@@ -27,6 +27,7 @@ found in the LICENSE file.
 // Includes for 3DSurfaceInterpolation
 #include "mitkImageTimeSelector.h"
 #include "mitkImageToContourFilter.h"
+#include "mitkSegmentationInterpolationController.h"
 #include "mitkSurfaceInterpolationController.h"
 
 // includes for resling and overwriting
@@ -46,6 +47,11 @@ found in the LICENSE file.
 
 #include "itkImageRegionIterator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <thread>
+
 #define ROUND(a) ((a) > 0 ? (int)((a) + 0.5) : -(int)(0.5 - (a)))
 
 bool mitk::SegTool2D::m_SurfaceInterpolationEnabled = true;
@@ -526,12 +532,9 @@ void mitk::SegTool2D::WriteBackSegmentationResults(const DataNode* workingNode,
     mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
   }
 
-  for (const auto& sliceInfo : sliceList)
+  if (writeSliceToVolume)
   {
-    if (writeSliceToVolume && nullptr != sliceInfo.plane && sliceInfo.slice.IsNotNull())
-    {
-      mitk::SegTool2D::WriteSliceToVolume(image, sliceInfo, true);
-    }
+    mitk::SegTool2D::WriteSlicesToVolume(image, sliceList, true);
   }
 
   mitk::SegTool2D::UpdateSurfaceInterpolation(sliceList, image, false);
@@ -550,28 +553,159 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const PlaneGeometr
 }
 
 void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInformation &sliceInfo, bool allowUndo)
+{
+  WriteSlicesToVolume(workingImage, { sliceInfo }, allowUndo);
+}
+
+void mitk::SegTool2D::WriteSlicesToVolume(Image* workingImage, const std::vector<SliceInformation>& sliceList, bool allowUndo)
 {
   if (nullptr == workingImage)
   {
     mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
   }
 
-  DiffSliceOperation* undoOperation = nullptr;
+  std::vector<const SliceInformation*> slices;
+  for (const auto& sliceInfo : sliceList)
+  {
+    if (nullptr != sliceInfo.plane && sliceInfo.slice.IsNotNull())
+      slices.push_back(&sliceInfo);
+  }
+
+  if (slices.empty())
+    return;
+
+  // Slices can be written concurrently if they lie in different image slices of the same orientation and time step
+  bool writeInParallel = slices.size() > 1;
+  int commonDimension = -1;
+  std::set<int> affectedSlices;
+
+  for (auto sliceIter = slices.begin(); writeInParallel && sliceIter != slices.end(); ++sliceIter)
+  {
+    int affectedDimension = -1;
+    int affectedSlice = -1;
+
+    writeInParallel = DetermineAffectedImageSlice(workingImage, (*sliceIter)->plane, affectedDimension, affectedSlice) &&
+                      (-1 == commonDimension || affectedDimension == commonDimension) &&
+                      (*sliceIter)->timestep == slices.front()->timestep &&
+                      affectedSlices.insert(affectedSlice).second;
+
+    commonDimension = affectedDimension;
+  }
+
+  // Let the 2D interpolation rescan only the written slices instead of the whole volume
+  if (auto* interpolator = SegmentationInterpolationController::InterpolatorForImage(workingImage))
+  {
+    std::vector<std::pair<int, int>> affectedImageSlices;
+
+    for (const auto* sliceInfo : slices)
+    {
+      int affectedDimension = -1;
+      int affectedSlice = -1;
+
+      if (!DetermineAffectedImageSlice(workingImage, sliceInfo->plane, affectedDimension, affectedSlice))
+      {
+        // an oblique slice changes several image slices, so the whole volume has to be scanned
+        affectedImageSlices.clear();
+        break;
+      }
+
+      affectedImageSlices.emplace_back(affectedDimension, affectedSlice);
+    }
+
+    for (std::size_t index = 0; index < affectedImageSlices.size(); ++index)
+    {
+      interpolator->PrepareSliceChange(affectedImageSlices[index].first, affectedImageSlices[index].second, slices[index]->timestep);
+    }
+  }
+
+  std::vector<Image::Pointer> originalSlices(slices.size());
+  std::vector<Image::Pointer> writtenSlices(slices.size());
+
+  auto writeSlice = [&](std::size_t index) {
+    if (allowUndo)
+    {
+      // Create undo operation by caching the not yet modified slices
+      originalSlices[index] = GetAffectedImageSliceAs2DImage(slices[index]->plane, workingImage, slices[index]->timestep);
+    }
+
+    writtenSlices[index] = OverwriteSlice(workingImage, *slices[index]);
+  };
+
+  if (writeInParallel)
+  {
+    // Make sure that the vtk representation of the volume exists before the threads share it
+    workingImage->GetVtkImageData(slices.front()->timestep);
+
+    std::atomic<std::size_t> nextSlice(0);
+    auto writeSlices = [&]() {
+      for (std::size_t index = nextSlice++; index < slices.size(); index = nextSlice++)
+        writeSlice(index);
+    };
+
+    const auto numberOfThreads =
+      std::min<std::size_t>(slices.size(), std::max(1u, std::thread::hardware_concurrency()));
+
+    std::vector<std::thread> threads;
+    threads.reserve(numberOfThreads);
+    for (std::size_t thread = 0; thread < numberOfThreads; ++thread)
+      threads.emplace_back(writeSlices);
+
+    for (auto& thread : threads)
+      thread.join();
+  }
+  else
+  {
+    for (std::size_t index = 0; index < slices.size(); ++index)
+      writeSlice(index);
+  }
+
+  // the image was modified within the pipeline, but not marked so
+  workingImage->Modified();
+  workingImage->GetVtkImageData()->Modified();
 
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
-    // Create undo operation by caching the not yet modified slices
-    mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
-    undoOperation =
-      new DiffSliceOperation(workingImage,
-        originalSlice,
-        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
-        sliceInfo.timestep,
-        sliceInfo.plane);
+    // All operation events share the current object event id, so that the whole batch is one undo step
+    std::vector<OperationEvent*> undoStackItems;
+    undoStackItems.reserve(slices.size());
+
+    for (std::size_t index = 0; index < slices.size(); ++index)
+    {
+      const auto* sliceInfo = slices[index];
+
+      auto* undoOperation =
+        new DiffSliceOperation(workingImage,
+          originalSlices[index],
+          dynamic_cast<SlicedGeometry3D*>(originalSlices[index]->GetGeometry()),
+          sliceInfo->timestep,
+          sliceInfo->plane);
+
+      // specify the redo operation with the edited slice
+      auto* doOperation =
+        new DiffSliceOperation(workingImage,
+          writtenSlices[index],
+          dynamic_cast<SlicedGeometry3D*>(sliceInfo->slice->GetGeometry()),
+          sliceInfo->timestep,
+          sliceInfo->plane);
+
+      // create an operation event for the undo stack
+      undoStackItems.push_back(
+        new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation"));
+    }
+
+    // add them to the undo controller
+    UndoStackItem::IncCurrObjectEventId();
+    UndoStackItem::IncCurrGroupEventId();
+
+    for (auto* undoStackItem : undoStackItems)
+      UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
     /*============= END undo/redo feature block ========================*/
   }
+}
 
+mitk::Image::Pointer mitk::SegTool2D::OverwriteSlice(Image* workingImage, const SliceInformation& sliceInfo)
+{
   // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
   // reslicer
   vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
@@ -598,32 +732,7 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   extractor->Modified();
   extractor->Update();
 
-  // the image was modified within the pipeline, but not marked so
-  workingImage->Modified();
-  workingImage->GetVtkImageData()->Modified();
-
-  if (allowUndo)
-  {
-    /*============= BEGIN undo/redo feature block ========================*/
-    // specify the redo operation with the edited slice
-    auto* doOperation =
-      new DiffSliceOperation(workingImage,
-        extractor->GetOutput(),
-        dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
-        sliceInfo.timestep,
-        sliceInfo.plane);
-
-    // create an operation event for the undo stack
-    OperationEvent* undoStackItem =
-      new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation");
-
-    // add it to the undo controller
-    UndoStackItem::IncCurrObjectEventId();
-    UndoStackItem::IncCurrGroupEventId();
-    UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
-    /*============= END undo/redo feature block ========================*/
-  }
-
+  return extractor->GetOutput();
 }
 
 
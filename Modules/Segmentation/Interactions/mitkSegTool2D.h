@@ -256,6 +256,16 @@ namespace mitk
     * @pre workingImage must point to a valid instance.*/
     static void WriteSliceToVolume(Image* workingImage, const SliceInformation &sliceInfo, bool allowUndo);
 
+    /** Writes all provided slices into the passed working image. The result is the same as calling
+    * WriteSliceToVolume for every slice in the given order, but the image is marked as modified only once
+    * and, if asked for, all slices are reverted by one undo step. Slices that lie in different image slices
+    * of the same orientation and time step are written in parallel.
+    * @param workingImage Pointer to the image that is the target of the write operation.
+    * @param sliceList Slices that should be written. Entries without slice image or plane geometry are ignored.
+    * @param allowUndo Indicates if undo/redo operations should be registered for the write operations.
+    * @pre workingImage must point to a valid instance.*/
+    static void WriteSlicesToVolume(Image* workingImage, const std::vector<SliceInformation>& sliceList, bool allowUndo);
+
     /**
       \brief Adds a new node called Contourmarker to the datastorage which holds a mitk::PlanarFigure.
       By selecting this node the slicestack will be reoriented according to the passed
@@ -278,6 +288,10 @@ namespace mitk
 
     static void  RemoveContourFromInterpolator(const SliceInformation& sliceInfo);
 
+    /** Writes the slice into the working image with mitkVtkImageOverwrite. The image is not marked as modified.
+     * @return The slice as it was written into the image.*/
+    static Image::Pointer OverwriteSlice(Image* workingImage, const SliceInformation& sliceInfo);
+
     // The prefix of the contourmarkername. Suffix is a consecutive number
     const std::string m_Contourmarkername;
 
@@ -53,7 +53,7 @@ void mitk::WatershedTool::Activated()
   m_Level = 0.0;
   m_Threshold = 0.0;
 
-  m_MagFilter = nullptr;
+  m_GradientMagnitude = nullptr;
   m_WatershedFilter = nullptr;
   m_LastFilterInput = nullptr;
 }
@@ -75,31 +75,38 @@ const char *mitk::WatershedTool::GetName() const
   return "Watershed";
 }
 
-mitk::LabelSetImage::Pointer mitk::WatershedTool::ComputeMLPreview(const Image* inputAtTimeStep, TimeStepType /*timeStep*/)
+mitk::LabelSetImage::Pointer mitk::WatershedTool::ComputeMLPreview(const Image* inputAtTimeStep, TimeStepType timeStep)
 {
   mitk::LabelSetImage::Pointer labelSetOutput;
 
+  const Image* filterInput = this->GetSegmentationInput();
+  if (nullptr == filterInput)
+    filterInput = inputAtTimeStep;
+
   try
   {
     mitk::Image::Pointer output;
-    bool inputChanged = inputAtTimeStep != m_LastFilterInput;
+    bool inputChanged = filterInput != m_LastFilterInput.GetPointer() || timeStep != m_LastFilterTimeStep ||
+                        filterInput->GetMTime() != m_LastFilterInputMTime;
     // create and run itk filter pipeline
     AccessByItk_2(inputAtTimeStep, ITKWatershed, output, inputChanged);
 
     labelSetOutput = mitk::LabelSetImage::New();
     labelSetOutput->InitializeByLabeledImage(output);
+
+    m_LastFilterInput = filterInput;
+    m_LastFilterTimeStep = timeStep;
+    m_LastFilterInputMTime = filterInput->GetMTime();
   }
   catch (itk::ExceptionObject & e)
   {
     //force reset of filters as they might be in an invalid state now.
-    m_MagFilter = nullptr;
+    m_GradientMagnitude = nullptr;
     m_WatershedFilter = nullptr;
     m_LastFilterInput = nullptr;
 
     MITK_ERROR << "Watershed Filter Error: " << e.GetDescription();
   }
-  
-  m_LastFilterInput = inputAtTimeStep;
 
   return labelSetOutput;
 }
@@ -108,29 +115,30 @@ template <typename TPixel, unsigned int VImageDimension>
 void mitk::WatershedTool::ITKWatershed(const itk::Image<TPixel, VImageDimension>* originalImage,
   mitk::Image::Pointer& segmentation, bool inputChanged)
 {
-  typedef itk::WatershedImageFilter<itk::Image<float, VImageDimension>> WatershedFilter;
-  typedef itk::GradientMagnitudeRecursiveGaussianImageFilter<itk::Image<TPixel, VImageDimension>,
-    itk::Image<float, VImageDimension>>
+  typedef itk::Image<float, VImageDimension> MagnitudeImageType;
+  typedef itk::WatershedImageFilter<MagnitudeImageType> WatershedFilter;
+  typedef itk::GradientMagnitudeRecursiveGaussianImageFilter<itk::Image<TPixel, VImageDimension>, MagnitudeImageType>
     MagnitudeFilter;
 
-  // We create the filter pipeline only once (if needed) and not everytime we
+  // The gradient magnitude is kept and the watershed filter is created only once (if needed) and not everytime we
   // generate the ml image preview.
-  // Reason: If only the levels are changed the update of the pipe line is very
+  // Reason: If only the levels are changed the update of the watershed filter is very
   // fast and we want to profit from this feature.
 
-  // at first add a gradient magnitude filter
-  typename MagnitudeFilter::Pointer magnitude = dynamic_cast<MagnitudeFilter*>(m_MagFilter.GetPointer());
-  if (magnitude.IsNull())
+  // at first compute the gradient magnitude, if the input changed
+  typename MagnitudeImageType::Pointer magnitudeImage = dynamic_cast<MagnitudeImageType*>(m_GradientMagnitude.GetPointer());
+  if (inputChanged || magnitudeImage.IsNull())
   {
-    magnitude = MagnitudeFilter::New();
+    typename MagnitudeFilter::Pointer magnitude = MagnitudeFilter::New();
     magnitude->SetSigma(1.0);
+    magnitude->SetInput(originalImage);
     magnitude->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
-    m_MagFilter = magnitude.GetPointer();
-  }
+    magnitude->Update();
 
-  if (inputChanged)
-  {
-    magnitude->SetInput(originalImage);
+    // the input of the filter is only valid during this call, so keep the result without the pipeline
+    magnitudeImage = magnitude->GetOutput();
+    magnitudeImage->DisconnectPipeline();
+    m_GradientMagnitude = magnitudeImage.GetPointer();
   }
 
   // then add the watershed filter to the pipeline
@@ -138,11 +146,11 @@ void mitk::WatershedTool::ITKWatershed(const itk::Image<TPixel, VImageDimension>
   if (watershed.IsNull())
   {
     watershed = WatershedFilter::New();
-    watershed->SetInput(magnitude->GetOutput());
     watershed->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
     m_WatershedFilter = watershed.GetPointer();
   }
 
+  watershed->SetInput(magnitudeImage);
   watershed->SetThreshold(m_Threshold);
   watershed->SetLevel(m_Level);
   watershed->Update();
@@ -67,16 +67,26 @@ namespace mitk
 private:
     /** \brief Creates and runs an ITK filter pipeline consisting of the filters: GradientMagnitude-, Watershed- and
      * CastImageFilter.
+      *
+      * The gradient magnitude is only computed if the input changed, otherwise the kept one is used. Thus
+      * changing only the threshold or the level does not recompute it.
       *
       * \param originalImage The input image, which is delivered by the AccessByItk macro.
       * \param segmentation A pointer to the output image, which will point to the pipeline output after execution.
+      * \param inputChanged Indicates if the gradient magnitude has to be recomputed.
       */
     template <typename TPixel, unsigned int VImageDimension>
     void ITKWatershed(const itk::Image<TPixel, VImageDimension>* originalImage, itk::SmartPointer<mitk::Image>& segmentation, bool inputChanged);
 
-    itk::ProcessObject::Pointer m_MagFilter;
+    /** Gradient magnitude of the last input (disconnected from its filter).*/
+    itk::DataObject::Pointer m_GradientMagnitude;
     itk::ProcessObject::Pointer m_WatershedFilter;
+    /** Segmentation input, time step and modification time the gradient magnitude was computed for.
+     * The input at a time step is a new image for every call in case of dynamic images, thus it cannot
+     * be used to detect changes.*/
     mitk::Image::ConstPointer m_LastFilterInput;
+    TimeStepType m_LastFilterTimeStep = 0;
+    itk::ModifiedTimeType m_LastFilterInputMTime = 0;
   };
 
 } // namespace
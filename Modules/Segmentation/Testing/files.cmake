@@ -5,9 +5,15 @@ set(MODULE_TESTS
   mitkDataNodeSegmentationTest.cpp
   mitkFeatureBasedEdgeDetectionFilterTest.cpp
   mitkImageToContourFilterTest.cpp
+  mitkImageLiveWireContourModelFilterTest.cpp
+  mitkShortestPathImageFilterTest.cpp
   mitkSegmentationInterpolationTest.cpp
   mitkOverwriteSliceFilterTest.cpp
   mitkOverwriteSliceFilterObliquePlaneTest.cpp
+  mitkParallelConnectedThresholdImageFilterTest.cpp
+  mitkRegionGrowing3DAlgorithmTest.cpp
+  mitkSegTool2DTest.cpp
+  mitkVtkImageOverwriteTest.cpp
 #  mitkToolManagerTest.cpp
   mitkToolManagerProviderTest.cpp
   mitkManualSegmentationToSurfaceFilterTest.cpp #new cpp unit style
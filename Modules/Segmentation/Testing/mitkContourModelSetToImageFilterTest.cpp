@@ -14,6 +14,7 @@ found in the LICENSE file.
 #include <mitkContourModelSetToImageFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImage.h>
+#include <mitkImagePixelReadAccessor.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
@@ -21,11 +22,55 @@ class mitkContourModelSetToImageFilterTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkContourModelSetToImageFilterTestSuite);
   MITK_TEST(TestFillContourSetIntoImage);
+  MITK_TEST(TestFillRules);
+  MITK_TEST(TestPartialVolume);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   mitk::ContourModelSetToImageFilter::Pointer m_ContourFiller;
 
+  static mitk::Image::Pointer CreateReferenceImage()
+  {
+    auto image = mitk::Image::New();
+    unsigned int dimensions[3] = {20, 20, 5};
+    image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+    return image;
+  }
+
+  /** Axial square with the given corners in index coordinates. */
+  static mitk::ContourModel::Pointer CreateSquare(double from, double to, double slice, bool clockwise = false)
+  {
+    auto contour = mitk::ContourModel::New();
+    const double u[4] = {from, to, to, from};
+    const double v[4] = {from, from, to, to};
+    for (int i = 0; i < 4; ++i)
+    {
+      const int j = clockwise ? 3 - i : i;
+      mitk::Point3D point;
+      point[0] = u[j];
+      point[1] = v[j];
+      point[2] = slice;
+      contour->AddVertex(point);
+    }
+    contour->Close();
+    return contour;
+  }
+
+  template <typename TPixel>
+  static double SumOfSlice(mitk::Image *image, int slice)
+  {
+    mitk::ImagePixelReadAccessor<TPixel, 3> readAccess(image);
+    double sum = 0.0;
+    itk::Index<3> index;
+    index[2] = slice;
+    for (index[1] = 0; index[1] < 20; ++index[1])
+    {
+      for (index[0] = 0; index[0] < 20; ++index[0])
+        sum += readAccess.GetPixelByIndex(index);
+    }
+    return sum;
+  }
+
 public:
   void setUp() override
   {
@@ -51,6 +96,58 @@ public:
 
     MITK_ASSERT_EQUAL(refImage, filledImage, "Error filling contours into image");
   }
+
+  void TestFillRules()
+  {
+    auto contours = mitk::ContourModelSet::New();
+    contours->AddContourModel(CreateSquare(2, 12, 1));
+    contours->AddContourModel(CreateSquare(5, 9, 1, true));
+    contours->AddContourModel(CreateSquare(14, 17, 3));
+
+    m_ContourFiller->SetImage(CreateReferenceImage());
+    m_ContourFiller->SetInput(contours);
+    m_ContourFiller->SetNumberOfThreads(2);
+
+    // pixel centers on the contour are filled
+    m_ContourFiller->Update();
+    CPPUNIT_ASSERT_EQUAL(121.0, SumOfSlice<unsigned char>(m_ContourFiller->GetOutput(), 1));
+    CPPUNIT_ASSERT_EQUAL(16.0, SumOfSlice<unsigned char>(m_ContourFiller->GetOutput(), 3));
+    CPPUNIT_ASSERT_EQUAL(0.0, SumOfSlice<unsigned char>(m_ContourFiller->GetOutput(), 2));
+
+    // the inner square is a hole, its contour pixels still belong to the segmentation
+    m_ContourFiller->SetFillRule(mitk::ContourModelSetToImageFilter::EvenOdd);
+    m_ContourFiller->Update();
+    CPPUNIT_ASSERT_EQUAL(112.0, SumOfSlice<unsigned char>(m_ContourFiller->GetOutput(), 1));
+
+    // the inner square is oriented opposite to the outer one
+    m_ContourFiller->SetFillRule(mitk::ContourModelSetToImageFilter::NonZero);
+    m_ContourFiller->Update();
+    CPPUNIT_ASSERT_EQUAL(112.0, SumOfSlice<unsigned char>(m_ContourFiller->GetOutput(), 1));
+  }
+
+  void TestPartialVolume()
+  {
+    auto contours = mitk::ContourModelSet::New();
+    contours->AddContourModel(CreateSquare(2.5, 12.5, 1));
+    contours->AddContourModel(CreateSquare(5.25, 8.75, 1, true));
+
+    m_ContourFiller->SetImage(CreateReferenceImage());
+    m_ContourFiller->SetInput(contours);
+    m_ContourFiller->PartialVolumeOn();
+    m_ContourFiller->SetFillRule(mitk::ContourModelSetToImageFilter::EvenOdd);
+    m_ContourFiller->Update();
+
+    mitk::Image::Pointer coverage = m_ContourFiller->GetOutput();
+    CPPUNIT_ASSERT(coverage->GetPixelType().GetComponentType() == itk::ImageIOBase::FLOAT);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(100.0 - 3.5 * 3.5, SumOfSlice<float>(coverage, 1), 1e-4);
+
+    mitk::ImagePixelReadAccessor<float, 3> readAccess(coverage);
+    itk::Index<3> index;
+    index[0] = 5;
+    index[1] = 7;
+    index[2] = 1;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.75, readAccess.GetPixelByIndex(index), 1e-4);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkContourModelSetToImageFilter)
@@ -0,0 +1,148 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkITKImageImport.h>
+#include <mitkImageLiveWireContourModelFilter.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <algorithm>
+#include <random>
+
+class mitkImageLiveWireContourModelFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageLiveWireContourModelFilterTestSuite);
+  MITK_TEST(TestMovingEndPointEqualsSingleUpdates);
+  MITK_TEST(TestRepulsivePointsAreAvoided);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<float, 2> ImageType;
+
+  mitk::Image::Pointer m_Image;
+
+  mitk::Point3D IndexToWorld(double x, double y)
+  {
+    mitk::Point3D point;
+    point[0] = x;
+    point[1] = y;
+    point[2] = 0.0;
+    m_Image->GetGeometry()->IndexToWorld(point, point);
+    return point;
+  }
+
+  static std::vector<mitk::Point3D> GetVertices(mitk::ContourModel *contour)
+  {
+    std::vector<mitk::Point3D> vertices;
+    for (auto it = contour->IteratorBegin(); it != contour->IteratorEnd(); ++it)
+      vertices.push_back((*it)->Coordinates);
+    return vertices;
+  }
+
+  std::vector<mitk::Point3D> ComputeSingleLiveWire(const mitk::Point3D &start, const mitk::Point3D &end)
+  {
+    auto filter = mitk::ImageLiveWireContourModelFilter::New();
+    filter->SetInput(m_Image);
+    filter->SetStartPoint(start);
+    filter->SetEndPoint(end);
+    filter->Update();
+    return GetVertices(filter->GetOutput());
+  }
+
+public:
+  void setUp() override
+  {
+    // bright disk on a noisy background, so that there are no paths with equal costs
+    auto image = ImageType::New();
+    ImageType::SizeType size;
+    size.Fill(48);
+    image->SetRegions(size);
+    image->Allocate();
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> noise(0.0f, 20.0f);
+
+    itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const double dx = it.GetIndex()[0] - 24.0;
+      const double dy = it.GetIndex()[1] - 24.0;
+      it.Set((dx * dx + dy * dy < 14.0 * 14.0 ? 200.0f : 0.0f) + noise(generator));
+    }
+
+    m_Image = mitk::GrabItkImageMemory(image);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void TestMovingEndPointEqualsSingleUpdates()
+  {
+    const mitk::Point3D start = IndexToWorld(10, 24);
+
+    auto filter = mitk::ImageLiveWireContourModelFilter::New();
+    filter->SetInput(m_Image);
+    filter->SetStartPoint(start);
+
+    // the last end point was reached by an earlier update already
+    const std::vector<mitk::Point3D> endPoints = {
+      IndexToWorld(24, 10), IndexToWorld(38, 24), IndexToWorld(30, 40), IndexToWorld(12, 30), IndexToWorld(24, 10)};
+
+    for (const auto &end : endPoints)
+    {
+      filter->SetEndPoint(end);
+      filter->Update();
+
+      auto expected = ComputeSingleLiveWire(start, end);
+      auto actual = GetVertices(filter->GetOutput());
+
+      CPPUNIT_ASSERT_EQUAL(expected.size(), actual.size());
+      for (std::size_t i = 0; i < expected.size(); ++i)
+        CPPUNIT_ASSERT_MESSAGE("Live wire differs from a single update", mitk::Equal(expected[i], actual[i]));
+    }
+  }
+
+  void TestRepulsivePointsAreAvoided()
+  {
+    auto filter = mitk::ImageLiveWireContourModelFilter::New();
+    filter->SetInput(m_Image);
+    filter->SetStartPoint(IndexToWorld(10, 24));
+    filter->SetEndPoint(IndexToWorld(24, 10));
+    filter->Update();
+
+    auto path = GetVertices(filter->GetOutput());
+    CPPUNIT_ASSERT(path.size() > 4);
+
+    std::vector<itk::Index<2>> repulsivePoints;
+    for (std::size_t i = 2; i + 2 < path.size(); ++i)
+    {
+      itk::Index<2> index;
+      m_Image->GetGeometry()->WorldToIndex(path[i], index);
+      repulsivePoints.push_back(index);
+      filter->AddRepulsivePoint(index);
+    }
+
+    // same start and end point, but the costs changed
+    filter->Update();
+
+    for (const auto &vertex : GetVertices(filter->GetOutput()))
+    {
+      itk::Index<2> index;
+      m_Image->GetGeometry()->WorldToIndex(vertex, index);
+      CPPUNIT_ASSERT_MESSAGE("Live wire passes a repulsive point",
+                             std::find(repulsivePoints.begin(), repulsivePoints.end(), index) == repulsivePoints.end());
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageLiveWireContourModelFilter)
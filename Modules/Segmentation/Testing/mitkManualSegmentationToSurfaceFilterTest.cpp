@@ -31,6 +31,9 @@ class mitkManualSegmentationToSurfaceFilterTestSuite : public mitk::TestFixture
   MITK_PARAMETERIZED_TEST_2(Update_BallBinaryAndSmooth_OutputEqualsReference,
                             "BallBinary30x30x30.nrrd",
                             "BallBinary30x30x30SmoothReference.vtp");
+  MITK_PARAMETERIZED_TEST_2(Update_BallBinaryBlockwise_OutputEqualsWholeImageOutput,
+                            "BallBinary30x30x30.nrrd",
+                            "BallBinary30x30x30Reference.vtp");
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -82,5 +85,25 @@ public:
 
     MITK_ASSERT_EQUAL(computedOutput, m_ReferenceSurface, "Computed equals the reference?");
   }
+
+  void Update_BallBinaryBlockwise_OutputEqualsWholeImageOutput()
+  {
+    m_Filter->MedianFilter3DOn();
+    m_Filter->SetGaussianStandardDeviation(1.5);
+    m_Filter->UseGaussianImageSmoothOn();
+    m_Filter->SetThreshold(1);
+    m_Filter->Update();
+    mitk::Surface::Pointer wholeImageOutput = m_Filter->GetOutput()->Clone();
+
+    // The margins of the blocks cover the median and Gaussian kernels, hence the result must not change
+    m_Filter->SetBlockSize(10);
+    m_Filter->Update();
+    mitk::Surface::Pointer blockwiseOutput = m_Filter->GetOutput()->Clone();
+
+    CPPUNIT_ASSERT_EQUAL(wholeImageOutput->GetVtkPolyData()->GetNumberOfPoints(),
+                         blockwiseOutput->GetVtkPolyData()->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL(wholeImageOutput->GetVtkPolyData()->GetNumberOfCells(),
+                         blockwiseOutput->GetVtkPolyData()->GetNumberOfCells());
+  }
 };
 MITK_TEST_SUITE_REGISTRATION(mitkManualSegmentationToSurfaceFilter)
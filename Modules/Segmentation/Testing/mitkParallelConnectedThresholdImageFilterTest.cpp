@@ -0,0 +1,171 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <itkParallelConnectedThresholdImageFilter.h>
+
+#include <mitkIOUtil.h>
+#include <mitkImageCast.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkConnectedThresholdImageFilter.h>
+#include <itkImageRegionConstIterator.h>
+
+#include <cmath>
+
+class mitkParallelConnectedThresholdImageFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkParallelConnectedThresholdImageFilterTestSuite);
+  MITK_TEST(TestEquivalence3D);
+  MITK_TEST(TestEquivalence2D);
+  MITK_TEST(TestSeedOutsideOfThresholds);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<short, 3> ImageType;
+  typedef itk::Image<unsigned char, 3> MaskType;
+  typedef itk::Image<short, 2> Image2DType;
+  typedef itk::Image<unsigned char, 2> Mask2DType;
+
+  ImageType::Pointer m_Image;
+
+  template <class TImage, class TMask>
+  static bool AreEqual(const TMask *expected, const TMask *actual)
+  {
+    itk::ImageRegionConstIterator<TMask> expectedIt(expected, expected->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<TMask> actualIt(actual, actual->GetLargestPossibleRegion());
+
+    for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+    {
+      if (actualIt.IsAtEnd() || expectedIt.Get() != actualIt.Get())
+        return false;
+    }
+
+    return actualIt.IsAtEnd();
+  }
+
+  template <class TImage, class TMask>
+  static void CheckEquivalence(const TImage *image,
+                               const std::vector<typename TImage::IndexType> &seeds,
+                               typename TImage::PixelType lower,
+                               typename TImage::PixelType upper)
+  {
+    auto reference = itk::ConnectedThresholdImageFilter<TImage, TMask>::New();
+    reference->SetInput(image);
+    reference->SetLower(lower);
+    reference->SetUpper(upper);
+    reference->SetConnectivity(itk::ConnectedThresholdImageFilter<TImage, TMask>::FaceConnectivity);
+    for (const auto &seed : seeds)
+      reference->AddSeed(seed);
+    reference->Update();
+
+    for (itk::ThreadIdType numberOfThreads : {1u, 3u, 8u})
+    {
+      auto parallel = itk::ParallelConnectedThresholdImageFilter<TImage, TMask>::New();
+      parallel->SetInput(image);
+      parallel->SetLower(lower);
+      parallel->SetUpper(upper);
+      parallel->SetNumberOfThreads(numberOfThreads);
+      for (const auto &seed : seeds)
+        parallel->AddSeed(seed);
+      parallel->Update();
+
+      CPPUNIT_ASSERT_MESSAGE("Parallel region growing differs from itk::ConnectedThresholdImageFilter",
+                             (AreEqual<TImage, TMask>(reference->GetOutput(), parallel->GetOutput())));
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    auto image = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Pic3D.nrrd"));
+    mitk::CastToItkImage(image, m_Image);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+  }
+
+  void TestEquivalence3D()
+  {
+    const auto size = m_Image->GetLargestPossibleRegion().GetSize();
+
+    ImageType::IndexType center;
+    for (unsigned int d = 0; d < 3; ++d)
+      center[d] = size[d] / 2;
+
+    ImageType::IndexType corner;
+    corner.Fill(0);
+
+    const short centerValue = m_Image->GetPixel(center);
+    const short cornerValue = m_Image->GetPixel(corner);
+
+    CheckEquivalence<ImageType, MaskType>(m_Image, { center }, centerValue - 20, centerValue + 20);
+    CheckEquivalence<ImageType, MaskType>(m_Image, { center }, centerValue - 200, centerValue + 200);
+    CheckEquivalence<ImageType, MaskType>(m_Image, { center, corner }, std::min(centerValue, cornerValue) - 50, std::max(centerValue, cornerValue) + 50);
+  }
+
+  void TestEquivalence2D()
+  {
+    Image2DType::Pointer image = Image2DType::New();
+    Image2DType::SizeType size;
+    size[0] = 97;
+    size[1] = 61;
+    image->SetRegions(size);
+    image->Allocate();
+
+    // concentric rings with gaps, so that components are only connected along winding paths
+    Image2DType::IndexType index;
+    for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(size[1]); ++index[1])
+    {
+      for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(size[0]); ++index[0])
+      {
+        const auto dx = index[0] - 48;
+        const auto dy = index[1] - 30;
+        const auto ring = static_cast<short>(std::sqrt(static_cast<double>(dx * dx + dy * dy))) / 4;
+        image->SetPixel(index, (ring % 2 == 0 || (dx > 0 && dy == 0)) ? 100 : 0);
+      }
+    }
+
+    Image2DType::IndexType seed;
+    seed[0] = 48;
+    seed[1] = 30;
+
+    CheckEquivalence<Image2DType, Mask2DType>(image, { seed }, 50, 150);
+    CheckEquivalence<Image2DType, Mask2DType>(image, { seed }, -10, 10);
+  }
+
+  void TestSeedOutsideOfThresholds()
+  {
+    ImageType::IndexType seed;
+    seed.Fill(0);
+
+    const short value = m_Image->GetPixel(seed);
+
+    auto parallel = itk::ParallelConnectedThresholdImageFilter<ImageType, MaskType>::New();
+    parallel->SetInput(m_Image);
+    parallel->SetLower(value + 1);
+    parallel->SetUpper(value + 100);
+    parallel->SetSeed(seed);
+    parallel->Update();
+
+    itk::ImageRegionConstIterator<MaskType> it(parallel->GetOutput(), parallel->GetOutput()->GetLargestPossibleRegion());
+    bool isEmpty = true;
+    for (; !it.IsAtEnd() && isEmpty; ++it)
+      isEmpty = it.Get() == 0;
+
+    CPPUNIT_ASSERT_MESSAGE("Seed outside of thresholds must not grow a region", isEmpty);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkParallelConnectedThresholdImageFilter)
@@ -0,0 +1,293 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkRegionGrowing3DAlgorithm.h>
+
+#include <mitkCallbackFromGUIThread.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkNonBlockingAlgorithmEvents.h>
+#include <mitkPointSet.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkCommand.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  /** Collects the commands of the worker thread and executes them when the test asks for it,
+      like an event loop of the GUI thread would do. */
+  class QueuedCallbackFromGUIThread : public mitk::CallbackFromGUIThreadImplementation
+  {
+  public:
+    ~QueuedCallbackFromGUIThread() override
+    {
+      for (auto &call : m_Calls)
+        delete call.second;
+    }
+
+    void CallThisFromGUIThread(itk::Command *command, itk::EventObject *event) override
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Calls.emplace_back(command, event);
+    }
+
+    void ProcessEvents()
+    {
+      std::vector<std::pair<itk::Command::Pointer, itk::EventObject *>> calls;
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        calls.swap(m_Calls);
+      }
+
+      for (auto &call : calls)
+      {
+        if (nullptr != call.second)
+        {
+          call.first->Execute(static_cast<const itk::Object *>(nullptr), *call.second);
+          delete call.second;
+        }
+        else
+        {
+          call.first->Execute(static_cast<const itk::Object *>(nullptr), itk::NoEvent());
+        }
+      }
+    }
+
+  private:
+    std::mutex m_Mutex;
+    std::vector<std::pair<itk::Command::Pointer, itk::EventObject *>> m_Calls;
+  };
+}
+
+class mitkRegionGrowing3DAlgorithmTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkRegionGrowing3DAlgorithmTestSuite);
+  MITK_TEST(TestResultContainsSeededRegionOnly);
+  MITK_TEST(TestCancelDuringRegionGrowing);
+  MITK_TEST(TestRunAfterCancel);
+  MITK_TEST(TestCancelTwice);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static const unsigned int Size = 48;
+
+  QueuedCallbackFromGUIThread *m_GUIThread;
+  mitk::Image::Pointer m_Image;
+  mitk::RegionGrowing3DAlgorithm::Pointer m_Algorithm;
+
+  unsigned int m_NumberOfResults;
+  unsigned int m_NumberOfErrors;
+
+  std::atomic<bool> m_HoldWorker;
+  std::atomic<bool> m_WorkerHeld;
+
+  static bool IsInFirstBlob(unsigned int x, unsigned int y, unsigned int z)
+  {
+    return x >= 4 && x < 20 && y >= 4 && y < 20 && z >= 4 && z < 20;
+  }
+
+  static bool IsInSecondBlob(unsigned int x, unsigned int y, unsigned int z)
+  {
+    return x >= 26 && x < 44 && y >= 4 && y < 44 && z >= 26 && z < 44;
+  }
+
+  void OnResultAvailable() { ++m_NumberOfResults; }
+
+  void OnProcessingError() { ++m_NumberOfErrors; }
+
+  void OnProgress()
+  {
+    // keeps the worker thread inside of the filter until the test released it
+    if (!m_HoldWorker)
+      return;
+
+    m_WorkerHeld = true;
+
+    for (unsigned int i = 0; m_HoldWorker && i < 1000; ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  void StartRegionGrowing()
+  {
+    auto seedPoints = mitk::PointSet::New();
+    mitk::Point3D seed;
+    mitk::FillVector3D(seed, 10.0, 12.0, 8.0);
+    seedPoints->InsertPoint(0, seed);
+
+    m_Algorithm->SetPointerParameter("Input", m_Image);
+    m_Algorithm->SetPointerParameter("Seed points", seedPoints);
+    m_Algorithm->SetParameter("Lower threshold", 50.0);
+    m_Algorithm->SetParameter("Upper threshold", 150.0);
+    m_Algorithm->StartAlgorithm();
+  }
+
+public:
+  void setUp() override
+  {
+    m_GUIThread = new QueuedCallbackFromGUIThread;
+    mitk::CallbackFromGUIThread::RegisterImplementation(m_GUIThread);
+
+    unsigned int dimensions[3] = {Size, Size, Size};
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+
+    {
+      mitk::ImagePixelWriteAccessor<short, 3> writeAccess(m_Image);
+      itk::Index<3> index;
+
+      for (unsigned int z = 0; z < Size; ++z)
+        for (unsigned int y = 0; y < Size; ++y)
+          for (unsigned int x = 0; x < Size; ++x)
+          {
+            index[0] = x;
+            index[1] = y;
+            index[2] = z;
+            writeAccess.SetPixelByIndex(index, IsInFirstBlob(x, y, z) || IsInSecondBlob(x, y, z) ? 100 : 0);
+          }
+    }
+
+    m_NumberOfResults = 0;
+    m_NumberOfErrors = 0;
+    m_HoldWorker = false;
+    m_WorkerHeld = false;
+
+    m_Algorithm = mitk::RegionGrowing3DAlgorithm::New();
+
+    auto resultCommand = itk::SimpleMemberCommand<mitkRegionGrowing3DAlgorithmTestSuite>::New();
+    resultCommand->SetCallbackFunction(this, &mitkRegionGrowing3DAlgorithmTestSuite::OnResultAvailable);
+    m_Algorithm->AddObserver(mitk::ResultAvailable(), resultCommand);
+
+    auto errorCommand = itk::SimpleMemberCommand<mitkRegionGrowing3DAlgorithmTestSuite>::New();
+    errorCommand->SetCallbackFunction(this, &mitkRegionGrowing3DAlgorithmTestSuite::OnProcessingError);
+    m_Algorithm->AddObserver(mitk::ProcessingError(), errorCommand);
+
+    auto progressCommand = itk::SimpleMemberCommand<mitkRegionGrowing3DAlgorithmTestSuite>::New();
+    progressCommand->SetCallbackFunction(this, &mitkRegionGrowing3DAlgorithmTestSuite::OnProgress);
+    m_Algorithm->AddObserver(itk::ProgressEvent(), progressCommand);
+  }
+
+  void tearDown() override
+  {
+    m_HoldWorker = false;
+    m_Algorithm->StopAlgorithm();
+    m_GUIThread->ProcessEvents();
+    m_Algorithm->RemoveAllObservers();
+    m_Algorithm = nullptr;
+    m_Image = nullptr;
+
+    mitk::CallbackFromGUIThread::RegisterImplementation(nullptr);
+    delete m_GUIThread;
+  }
+
+  void TestResultContainsSeededRegionOnly()
+  {
+    this->StartRegionGrowing();
+    m_Algorithm->StopAlgorithm();
+    m_GUIThread->ProcessEvents();
+
+    CPPUNIT_ASSERT_EQUAL(1u, m_NumberOfResults);
+    CPPUNIT_ASSERT_EQUAL(0u, m_NumberOfErrors);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, m_Algorithm->GetProgress(), mitk::eps);
+
+    mitk::Image::Pointer result = m_Algorithm->GetResult();
+    CPPUNIT_ASSERT(result.IsNotNull());
+    CPPUNIT_ASSERT(mitk::Equal(*m_Image->GetGeometry(), *result->GetGeometry(), mitk::eps, true));
+
+    mitk::ImagePixelReadAccessor<mitk::DefaultSegmentationDataType, 3> readAccess(result);
+    itk::Index<3> index;
+
+    for (unsigned int z = 0; z < Size; ++z)
+      for (unsigned int y = 0; y < Size; ++y)
+        for (unsigned int x = 0; x < Size; ++x)
+        {
+          index[0] = x;
+          index[1] = y;
+          index[2] = z;
+          CPPUNIT_ASSERT_EQUAL(IsInFirstBlob(x, y, z), readAccess.GetPixelByIndex(index) != 0);
+        }
+  }
+
+  void TestCancelDuringRegionGrowing()
+  {
+    m_HoldWorker = true;
+    this->StartRegionGrowing();
+
+    for (unsigned int i = 0; !m_WorkerHeld && i < 1000; ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    CPPUNIT_ASSERT_MESSAGE("Region growing started", m_WorkerHeld);
+
+    // Cancel() waits for the worker thread, so it is called from another thread while this one releases the worker
+    std::thread canceller([this]() { m_Algorithm->Cancel(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    m_HoldWorker = false;
+    canceller.join();
+
+    m_GUIThread->ProcessEvents();
+
+    CPPUNIT_ASSERT_EQUAL(0u, m_NumberOfResults);
+    CPPUNIT_ASSERT_EQUAL(1u, m_NumberOfErrors);
+    CPPUNIT_ASSERT(m_Algorithm->GetResult().IsNull());
+  }
+
+  void TestRunAfterCancel()
+  {
+    m_Algorithm->Cancel();
+
+    this->StartRegionGrowing();
+    m_Algorithm->StopAlgorithm();
+    m_GUIThread->ProcessEvents();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("A finished Cancel() does not affect the next run", 1u, m_NumberOfResults);
+    CPPUNIT_ASSERT_EQUAL(0u, m_NumberOfErrors);
+    CPPUNIT_ASSERT(m_Algorithm->GetResult().IsNotNull());
+  }
+
+  void TestCancelTwice()
+  {
+    m_HoldWorker = true;
+    this->StartRegionGrowing();
+
+    for (unsigned int i = 0; !m_WorkerHeld && i < 1000; ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    CPPUNIT_ASSERT_MESSAGE("Region growing started", m_WorkerHeld);
+
+    std::thread canceller([this]() { m_Algorithm->Cancel(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    m_HoldWorker = false;
+    canceller.join();
+
+    // The worker thread is joined, but not yet released by the GUI thread. It must not be joined again.
+    m_Algorithm->Cancel();
+    m_GUIThread->ProcessEvents();
+
+    CPPUNIT_ASSERT_EQUAL(0u, m_NumberOfResults);
+    CPPUNIT_ASSERT_EQUAL(1u, m_NumberOfErrors);
+
+    this->StartRegionGrowing();
+    m_Algorithm->StopAlgorithm();
+    m_GUIThread->ProcessEvents();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("The algorithm runs again after the cancelled run was released", 1u, m_NumberOfResults);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkRegionGrowing3DAlgorithm)
@@ -0,0 +1,188 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkSegTool2D.h>
+#include <mitkSliceNavigationController.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+#include <mitkUndoController.h>
+#include <mitkVerboseLimitedLinearUndo.h>
+
+#include <algorithm>
+
+namespace
+{
+  /** Gives access to the protected slice writing API of SegTool2D. */
+  class SegTool2DAccess : public mitk::SegTool2D
+  {
+  public:
+    using mitk::SegTool2D::SliceInformation;
+    using mitk::SegTool2D::WriteSlicesToVolume;
+  };
+}
+
+class mitkSegTool2DTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSegTool2DTestSuite);
+  MITK_TEST(TestWriteSlicesToVolume);
+  MITK_TEST(TestWriteSlicesToVolumeCreatesOneUndoStep);
+  MITK_TEST(TestWriteSlicesToVolumeKeepsOrderOfSameSlice);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::Tool::DefaultSegmentationDataType PixelType;
+
+  mitk::Image::Pointer m_Image;
+  std::vector<mitk::PlaneGeometry::Pointer> m_Planes;
+
+  mitk::Image::Pointer CreateSlice(int sliceIndex, PixelType value)
+  {
+    auto slice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(m_Planes[sliceIndex], m_Image, 0);
+
+    mitk::ImageWriteAccessor accessor(slice);
+    auto *data = static_cast<PixelType *>(accessor.GetData());
+    std::fill(data, data + slice->GetDimension(0) * slice->GetDimension(1), value);
+
+    return slice;
+  }
+
+  PixelType GetPixel(int x, int y, int z)
+  {
+    mitk::ImagePixelReadAccessor<PixelType, 3> readAccess(m_Image);
+    itk::Index<3> index;
+    index[0] = x;
+    index[1] = y;
+    index[2] = z;
+    return readAccess.GetPixelByIndex(index);
+  }
+
+  bool SliceEquals(int z, PixelType value)
+  {
+    mitk::ImagePixelReadAccessor<PixelType, 3> readAccess(m_Image);
+    itk::Index<3> index;
+    index[2] = z;
+    for (index[1] = 0; index[1] < 10; ++index[1])
+    {
+      for (index[0] = 0; index[0] < 12; ++index[0])
+      {
+        if (readAccess.GetPixelByIndex(index) != value)
+          return false;
+      }
+    }
+    return true;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::Image::New();
+    unsigned int dimensions[3] = {12, 10, 8};
+    m_Image->Initialize(mitk::MakeScalarPixelType<PixelType>(), 3, dimensions);
+    {
+      mitk::ImageWriteAccessor accessor(m_Image);
+      std::fill_n(static_cast<PixelType *>(accessor.GetData()), 12 * 10 * 8, 0);
+    }
+
+    auto navigationController = mitk::SliceNavigationController::New();
+    navigationController->SetInputWorldTimeGeometry(m_Image->GetTimeGeometry());
+    navigationController->Update(mitk::SliceNavigationController::Axial);
+
+    m_Planes.clear();
+    for (int z = 0; z < 8; ++z)
+    {
+      mitk::Point3D index;
+      index[0] = 5;
+      index[1] = 5;
+      index[2] = z;
+      mitk::Point3D point;
+      m_Image->GetGeometry()->IndexToWorld(index, point);
+      navigationController->SelectSliceByPoint(point);
+      m_Planes.push_back(navigationController->GetCurrentPlaneGeometry()->Clone());
+    }
+  }
+
+  void tearDown() override
+  {
+    m_Planes.clear();
+    m_Image = nullptr;
+  }
+
+  void TestWriteSlicesToVolume()
+  {
+    std::vector<SegTool2DAccess::SliceInformation> slices;
+    for (int z = 1; z < 8; z += 2)
+      slices.emplace_back(CreateSlice(z, z), m_Planes[z], 0);
+
+    SegTool2DAccess::WriteSlicesToVolume(m_Image, slices, false);
+
+    for (int z = 0; z < 8; ++z)
+    {
+      const PixelType expected = z % 2 == 1 ? z : 0;
+      CPPUNIT_ASSERT_EQUAL(expected, GetPixel(0, 0, z));
+      CPPUNIT_ASSERT_EQUAL(expected, GetPixel(11, 9, z));
+      CPPUNIT_ASSERT_EQUAL(expected, GetPixel(6, 3, z));
+    }
+  }
+
+  void TestWriteSlicesToVolumeCreatesOneUndoStep()
+  {
+    mitk::UndoController undoController(mitk::UndoController::VERBOSE_LIMITEDLINEARUNDO);
+    auto undoModel = dynamic_cast<mitk::VerboseLimitedLinearUndo *>(mitk::UndoController::GetCurrentUndoModel());
+    CPPUNIT_ASSERT(nullptr != undoModel);
+    undoModel->Clear();
+
+    std::vector<SegTool2DAccess::SliceInformation> slices;
+    for (int z = 0; z < 4; ++z)
+      slices.emplace_back(CreateSlice(z, 1), m_Planes[z], 0);
+
+    SegTool2DAccess::WriteSlicesToVolume(m_Image, slices, true);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), undoModel->GetUndoDescriptions().size());
+
+    std::vector<SegTool2DAccess::SliceInformation> laterSlices;
+    laterSlices.emplace_back(CreateSlice(0, 7), m_Planes[0], 0);
+    SegTool2DAccess::WriteSlicesToVolume(m_Image, laterSlices, true);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), undoModel->GetUndoDescriptions().size());
+    CPPUNIT_ASSERT(SliceEquals(0, 7));
+
+    // the single slice step is undone on its own
+    undoController.Undo();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), undoModel->GetUndoDescriptions().size());
+    for (int z = 0; z < 4; ++z)
+      CPPUNIT_ASSERT_MESSAGE("Slice of the batch is kept by undoing the later step", SliceEquals(z, 1));
+
+    // undoing the batch restores all of its slices at once
+    undoController.Undo();
+    CPPUNIT_ASSERT(undoModel->GetUndoDescriptions().empty());
+    for (int z = 0; z < 8; ++z)
+      CPPUNIT_ASSERT_MESSAGE("Slice has its original content after undo", SliceEquals(z, 0));
+
+    undoModel->Clear();
+  }
+
+  void TestWriteSlicesToVolumeKeepsOrderOfSameSlice()
+  {
+    // both slices hit the same image slice, so the last one has to win
+    std::vector<SegTool2DAccess::SliceInformation> slices;
+    slices.emplace_back(CreateSlice(3, 1), m_Planes[3], 0);
+    slices.emplace_back(CreateSlice(5, 4), m_Planes[5], 0);
+    slices.emplace_back(CreateSlice(3, 2), m_Planes[3], 0);
+
+    SegTool2DAccess::WriteSlicesToVolume(m_Image, slices, false);
+
+    CPPUNIT_ASSERT_EQUAL(PixelType(2), GetPixel(4, 4, 3));
+    CPPUNIT_ASSERT_EQUAL(PixelType(4), GetPixel(4, 4, 5));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSegTool2D)
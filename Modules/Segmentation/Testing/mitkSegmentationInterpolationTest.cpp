@@ -31,6 +31,7 @@ class mitkSegmentationInterpolationTestSuite : public mitk::TestFixture
   MITK_TEST(Equal_Axial_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Frontal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Sagittal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(PrepareSliceChange_ChangedSlices_AreRescanned);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -199,6 +200,77 @@ public:
     mitk::SliceNavigationController::ViewDirection viewDirection = mitk::SliceNavigationController::Sagittal;
     testRoutine(viewDirection);
   }
+
+  void PrepareSliceChange_ChangedSlices_AreRescanned()
+  {
+    const unsigned int dim = 2;
+
+    auto setPixel = [this](int sliceOffset, mitk::Tool::DefaultSegmentationDataType value) {
+      mitk::ImagePixelWriteAccessor<mitk::Tool::DefaultSegmentationDataType, 3> writeAccessor(m_SegmentationImage);
+      itk::Index<3> point = m_CenterPoint;
+      point[dim] += sliceOffset;
+      writeAccessor.SetPixelByIndexSafe(point, value);
+    };
+
+    setPixel(-1, 1);
+
+    auto interpolationController = mitk::SegmentationInterpolationController::New();
+    interpolationController->Activate2DInterpolation(true);
+    interpolationController->SetSegmentationVolume(m_SegmentationImage);
+
+    mitk::SliceNavigationController::Pointer navigationController = mitk::SliceNavigationController::New();
+    navigationController->SetInputWorldTimeGeometry(m_SegmentationImage->GetTimeGeometry());
+    navigationController->Update(mitk::SliceNavigationController::Axial);
+    mitk::Point3D pointMM;
+    m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0)->IndexToWorld(m_CenterPoint, pointMM);
+    navigationController->SelectSliceByPoint(pointMM);
+    auto plane = navigationController->GetCurrentPlaneGeometry();
+
+    CPPUNIT_ASSERT_MESSAGE("No segmentation above the slice",
+                           interpolationController->Interpolate(dim, m_CenterPoint[dim], plane, 0).IsNull());
+
+    const auto numberOfVolumeScans = interpolationController->GetNumberOfVolumeScans();
+    const std::vector<std::tuple<unsigned int, unsigned int, unsigned int>> expectedRescannedSlices = {
+      std::make_tuple(dim, static_cast<unsigned int>(m_CenterPoint[dim] + 1), 0u)};
+
+    // a tool writes a slice above the center without a difference image
+    interpolationController->PrepareSliceChange(dim, m_CenterPoint[dim] + 1, 0);
+    // announcing the same slice twice keeps the content before the first announcement
+    interpolationController->PrepareSliceChange(dim, m_CenterPoint[dim] + 1, 0);
+    setPixel(1, 1);
+    m_SegmentationImage->Modified();
+
+    CPPUNIT_ASSERT_MESSAGE("Only the announced slice is rescanned",
+                           expectedRescannedSlices == interpolationController->GetLastRescannedSlices());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Volume is not rescanned", numberOfVolumeScans,
+                                 interpolationController->GetNumberOfVolumeScans());
+    CPPUNIT_ASSERT_MESSAGE("Written slice is considered",
+                           interpolationController->Interpolate(dim, m_CenterPoint[dim], plane, 0).IsNotNull());
+
+    interpolationController->PrepareSliceChange(dim, m_CenterPoint[dim] + 1, 0);
+    setPixel(1, 0);
+    m_SegmentationImage->Modified();
+
+    CPPUNIT_ASSERT_MESSAGE("Only the announced slice is rescanned after erasing",
+                           expectedRescannedSlices == interpolationController->GetLastRescannedSlices());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Volume is not rescanned after erasing", numberOfVolumeScans,
+                                 interpolationController->GetNumberOfVolumeScans());
+    CPPUNIT_ASSERT_MESSAGE("Erased slice is not considered anymore",
+                           interpolationController->Interpolate(dim, m_CenterPoint[dim], plane, 0).IsNull());
+
+    // a modification that was not announced needs a scan of the whole volume
+    setPixel(1, 1);
+    m_SegmentationImage->Modified();
+
+    CPPUNIT_ASSERT_MESSAGE("No slice is rescanned for an unannounced change",
+                           interpolationController->GetLastRescannedSlices().empty());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Volume is rescanned for an unannounced change", numberOfVolumeScans + 1,
+                                 interpolationController->GetNumberOfVolumeScans());
+    CPPUNIT_ASSERT_MESSAGE("Slice written without announcement is considered",
+                           interpolationController->Interpolate(dim, m_CenterPoint[dim], plane, 0).IsNotNull());
+
+    interpolationController->SetSegmentationVolume(nullptr);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkSegmentationInterpolation)
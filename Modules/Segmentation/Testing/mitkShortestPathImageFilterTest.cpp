@@ -0,0 +1,401 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionIteratorWithIndex.h>
+#include <itkShortestPathCostFunction.h>
+#include <itkShortestPathImageFilter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+  typedef itk::Image<float, 2> ImageType;
+  typedef ImageType::IndexType IndexType;
+
+  typedef itk::Image<float, 3> Image3DType;
+
+  // Cost of a step is the mean of both pixel values times the length of the step
+  template <typename TImage>
+  class PixelCostFunction : public itk::ShortestPathCostFunction<TImage>
+  {
+  public:
+    typedef PixelCostFunction Self;
+    typedef itk::ShortestPathCostFunction<TImage> Superclass;
+    typedef itk::SmartPointer<Self> Pointer;
+    typedef itk::SmartPointer<const Self> ConstPointer;
+    typedef typename TImage::IndexType IndexType;
+
+    itkNewMacro(Self);
+    itkTypeMacro(PixelCostFunction, ShortestPathCostFunction);
+
+    double GetCost(IndexType p1, IndexType p2) override
+    {
+      double squaredLength = 0.0;
+      for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+        squaredLength += static_cast<double>(p1[d] - p2[d]) * (p1[d] - p2[d]);
+
+      return 0.5 * (this->m_Image->GetPixel(p1) + this->m_Image->GetPixel(p2)) * std::sqrt(squaredLength);
+    }
+
+    double GetMinCost() override { return m_MinCost; }
+
+    void Initialize() override
+    {
+      m_MinCost = std::numeric_limits<double>::max();
+      itk::ImageRegionConstIterator<TImage> it(this->m_Image, this->m_Image->GetLargestPossibleRegion());
+      for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+        m_MinCost = std::min(m_MinCost, static_cast<double>(it.Get()));
+    }
+
+  protected:
+    PixelCostFunction() : m_MinCost(0.0) {}
+
+    double m_MinCost;
+  };
+}
+
+/**
+ * \brief Test class for itk::ShortestPathImageFilter
+ *
+ * The paths of the filter are compared against the search of the previous implementation of the filter, which
+ * kept the discovered nodes in a std::multimap and re-inserted a node with its new key on every update. It is
+ * reproduced here as reference.
+ */
+class mitkShortestPathImageFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkShortestPathImageFilterTestSuite);
+  MITK_TEST(TestPathsEqualPreviousImplementation_N4);
+  MITK_TEST(TestPathsEqualPreviousImplementation_N8);
+  MITK_TEST(TestReusedSearchTreeEqualsPreviousImplementation);
+  MITK_TEST(TestPathsEqualPreviousImplementation_3D);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::ShortestPathImageFilter<ImageType, ImageType> FilterType;
+
+  template <typename TImage>
+  struct ReferenceResult
+  {
+    std::vector<typename TImage::IndexType> Path;
+    double Cost;
+  };
+
+  template <typename TImage = ImageType>
+  static typename TImage::Pointer CreateImage(unsigned int size,
+                                              const std::function<float(const typename TImage::IndexType &)> &cost)
+  {
+    typename TImage::SizeType imageSize;
+    imageSize.Fill(size);
+
+    auto image = TImage::New();
+    image->SetRegions(typename TImage::RegionType(imageSize));
+    image->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+      it.Set(cost(it.GetIndex()));
+
+    return image;
+  }
+
+  template <typename TImage = ImageType>
+  static typename TImage::Pointer CreateRandomImage(unsigned int size, unsigned int seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(1.0f, 10.0f);
+    return CreateImage<TImage>(size, [&](const typename TImage::IndexType &) { return distribution(generator); });
+  }
+
+  static IndexType MakeIndex(long x, long y)
+  {
+    IndexType index;
+    index[0] = x;
+    index[1] = y;
+    return index;
+  }
+
+  template <typename TImage>
+  static std::vector<typename TImage::IndexType> ComputePath(TImage *image,
+                                                             const typename TImage::IndexType &start,
+                                                             const typename TImage::IndexType &end,
+                                                             bool fullNeighbors)
+  {
+    auto costFunction = PixelCostFunction<TImage>::New();
+    costFunction->SetImage(image);
+
+    auto filter = itk::ShortestPathImageFilter<TImage, TImage>::New();
+    filter->SetInput(image);
+    filter->SetCostFunction(costFunction);
+    filter->SetGraph_fullNeighbors(fullNeighbors);
+    filter->SetMakeOutputImage(false);
+    filter->SetStartIndex(start);
+    filter->SetEndIndex(end);
+    filter->Update();
+
+    return filter->GetVectorPath();
+  }
+
+  // Search of the previous implementation, with the discovered nodes in a multimap keyed by distance + estimate
+  template <typename TImage>
+  static ReferenceResult<TImage> ComputeReferencePath(TImage *image,
+                                                      const typename TImage::IndexType &start,
+                                                      const typename TImage::IndexType &end,
+                                                      bool fullNeighbors)
+  {
+    typedef typename TImage::IndexType NodeIndexType;
+    typedef typename TImage::OffsetType OffsetType;
+    const unsigned int dimension = TImage::ImageDimension;
+
+    // face neighbors only, or all neighbors of the 3x3(x3) neighborhood
+    std::vector<OffsetType> offsets;
+    OffsetType offset;
+    offset.Fill(-1);
+    while (true)
+    {
+      unsigned int nonZero = 0;
+      for (unsigned int d = 0; d < dimension; ++d)
+        nonZero += 0 != offset[d] ? 1 : 0;
+
+      if (nonZero > 0 && (fullNeighbors || 1 == nonZero))
+        offsets.push_back(offset);
+
+      unsigned int d = 0;
+      for (; d < dimension && 1 == offset[d]; ++d)
+        offset[d] = -1;
+
+      if (d == dimension)
+        break;
+
+      ++offset[d];
+    }
+
+    auto costFunction = PixelCostFunction<TImage>::New();
+    costFunction->SetImage(image);
+    costFunction->Initialize();
+
+    const auto region = image->GetLargestPossibleRegion();
+    const std::size_t numberOfNodes = region.GetNumberOfPixels();
+
+    auto toNode = [&image](const NodeIndexType &index) { return static_cast<std::size_t>(image->ComputeOffset(index)); };
+    auto toIndex = [&image](std::size_t node) { return image->ComputeIndex(static_cast<itk::OffsetValueType>(node)); };
+    auto estimate = [&](const NodeIndexType &index) {
+      itk::Vector<float, TImage::ImageDimension> v;
+      for (unsigned int d = 0; d < dimension; ++d)
+        v[d] = end[d] - index[d];
+      return costFunction->GetMinCost() * v.GetNorm();
+    };
+
+    std::vector<double> distance(numberOfNodes, -1.0);
+    std::vector<double> distAndEst(numberOfNodes, -1.0);
+    std::vector<std::size_t> prevNode(numberOfNodes, 0);
+    std::vector<bool> closed(numberOfNodes, false);
+
+    const std::size_t startNode = toNode(start);
+    const std::size_t endNode = toNode(end);
+    distance[startNode] = 0.0;
+    distAndEst[startNode] = 0.0;
+
+    std::multimap<double, std::size_t> discovered;
+    discovered.emplace(0.0, startNode);
+
+    while (!discovered.empty())
+    {
+      const std::size_t node = discovered.begin()->second;
+      discovered.erase(discovered.begin());
+      closed[node] = true;
+
+      if (node == endNode)
+        break;
+
+      const NodeIndexType index = toIndex(node);
+      for (const auto &neighborOffset : offsets)
+      {
+        const NodeIndexType neighborIndex = index + neighborOffset;
+        if (!region.IsInside(neighborIndex))
+          continue;
+
+        const std::size_t neighbor = toNode(neighborIndex);
+        if (closed[neighbor])
+          continue;
+
+        const double newDistance = distance[node] + costFunction->GetCost(index, neighborIndex);
+        if (distance[neighbor] == -1.0)
+        {
+          distance[neighbor] = newDistance;
+          distAndEst[neighbor] = newDistance + estimate(neighborIndex);
+          prevNode[neighbor] = node;
+          discovered.emplace(distAndEst[neighbor], neighbor);
+        }
+        else if (newDistance < distance[neighbor])
+        {
+          // find the entry by its old key and re-insert it
+          auto range = discovered.equal_range(distAndEst[neighbor]);
+          auto entry = std::find_if(range.first, range.second, [neighbor](const std::pair<const double, std::size_t> &e)
+                                    { return e.second == neighbor; });
+          CPPUNIT_ASSERT(entry != range.second);
+          discovered.erase(entry);
+
+          distance[neighbor] = newDistance;
+          distAndEst[neighbor] = newDistance + estimate(neighborIndex);
+          prevNode[neighbor] = node;
+          discovered.emplace(distAndEst[neighbor], neighbor);
+        }
+      }
+    }
+
+    ReferenceResult<TImage> result;
+    result.Cost = distance[endNode];
+    for (std::size_t node = endNode; node != startNode; node = prevNode[node])
+      result.Path.push_back(toIndex(node));
+    result.Path.push_back(start);
+    std::reverse(result.Path.begin(), result.Path.end());
+    return result;
+  }
+
+  template <typename TImage>
+  static double GetPathCost(TImage *image, const std::vector<typename TImage::IndexType> &path, bool fullNeighbors)
+  {
+    auto costFunction = PixelCostFunction<TImage>::New();
+    costFunction->SetImage(image);
+
+    double cost = 0.0;
+    for (std::size_t i = 1; i < path.size(); ++i)
+    {
+      long maximumStep = 0;
+      long sumOfSteps = 0;
+      for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+      {
+        const long step = std::abs(path[i][d] - path[i - 1][d]);
+        maximumStep = std::max(maximumStep, step);
+        sumOfSteps += step;
+      }
+      CPPUNIT_ASSERT_MESSAGE("Consecutive path nodes are neighbors",
+                             fullNeighbors ? (maximumStep <= 1 && sumOfSteps > 0) : sumOfSteps == 1);
+      cost += costFunction->GetCost(path[i - 1], path[i]);
+    }
+    return cost;
+  }
+
+  // Paths of the filter and the reference have equal costs. If the optimum is unique, the paths are identical.
+  template <typename TImage>
+  static void ComparePaths(TImage *image,
+                           const typename TImage::IndexType &start,
+                           const typename TImage::IndexType &end,
+                           bool fullNeighbors,
+                           bool uniqueOptimum)
+  {
+    const auto path = ComputePath(image, start, end, fullNeighbors);
+    const auto reference = ComputeReferencePath(image, start, end, fullNeighbors);
+
+    CPPUNIT_ASSERT(!path.empty());
+    CPPUNIT_ASSERT(path.front() == start);
+    CPPUNIT_ASSERT(path.back() == end);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(reference.Cost, GetPathCost(image, path, fullNeighbors), 1e-6 * reference.Cost);
+
+    if (uniqueOptimum)
+      CPPUNIT_ASSERT_MESSAGE("Path equals the path of the previous implementation", path == reference.Path);
+  }
+
+  static void ComparePathsOnCostImages(bool fullNeighbors)
+  {
+    const unsigned int size = 48;
+    const IndexType start = MakeIndex(2, 5);
+    const IndexType end = MakeIndex(size - 3, size - 7);
+
+    for (unsigned int seed = 1; seed <= 5; ++seed)
+      ComparePaths<ImageType>(CreateRandomImage(size, seed), start, end, fullNeighbors, true);
+
+    // horizontal gradient
+    auto gradient = CreateImage(size, [](const IndexType &index) { return 1.0f + 0.5f * index[0]; });
+    ComparePaths<ImageType>(gradient, start, end, fullNeighbors, false);
+
+    // wall of high costs with a single gap
+    auto wall = CreateImage(size, [size](const IndexType &index) {
+      return index[0] == static_cast<long>(size / 2) && index[1] != 3 ? 100.0f : 1.0f;
+    });
+    ComparePaths<ImageType>(wall, start, end, fullNeighbors, false);
+
+    // constant costs, many paths are optimal
+    auto constant = CreateImage(size, [](const IndexType &) { return 1.0f; });
+    ComparePaths<ImageType>(constant, start, end, fullNeighbors, false);
+  }
+
+public:
+  void TestPathsEqualPreviousImplementation_N4() { ComparePathsOnCostImages(false); }
+
+  void TestPathsEqualPreviousImplementation_N8() { ComparePathsOnCostImages(true); }
+
+  void TestReusedSearchTreeEqualsPreviousImplementation()
+  {
+    auto image = CreateRandomImage(64, 42);
+    const IndexType start = MakeIndex(32, 32);
+
+    auto costFunction = PixelCostFunction<ImageType>::New();
+    costFunction->SetImage(image);
+
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetCostFunction(costFunction);
+    filter->SetGraph_fullNeighbors(true);
+    filter->SetMakeOutputImage(false);
+    filter->SetReuseSearchTree(true);
+    filter->SetStartIndex(start);
+
+    // the end point moves away from the start point and back, as while dragging the mouse
+    const IndexType ends[] = {
+      MakeIndex(35, 30), MakeIndex(45, 20), MakeIndex(60, 2), MakeIndex(50, 50), MakeIndex(33, 33)};
+    for (const auto &end : ends)
+    {
+      filter->SetEndIndex(end);
+      filter->Update();
+      CPPUNIT_ASSERT_MESSAGE("Path of the continued search equals the path of the previous implementation",
+                             filter->GetVectorPath() == ComputeReferencePath<ImageType>(image, start, end, true).Path);
+    }
+  }
+
+  // The flat node storage and the neighbor offsets are dimension independent, so a small volume is searched with
+  // face and with full neighborhoods as well
+  void TestPathsEqualPreviousImplementation_3D()
+  {
+    const unsigned int size = 12;
+
+    Image3DType::IndexType start;
+    start[0] = 1;
+    start[1] = 2;
+    start[2] = 1;
+
+    Image3DType::IndexType end;
+    end[0] = size - 2;
+    end[1] = size - 3;
+    end[2] = size - 1;
+
+    for (unsigned int seed = 1; seed <= 3; ++seed)
+    {
+      auto image = CreateRandomImage<Image3DType>(size, seed);
+      ComparePaths<Image3DType>(image, start, end, false, true);
+      ComparePaths<Image3DType>(image, start, end, true, true);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkShortestPathImageFilter)
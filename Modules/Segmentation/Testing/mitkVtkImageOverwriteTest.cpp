@@ -0,0 +1,215 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkExtractSliceFilter.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkInteractionConst.h>
+#include <mitkRotationOperation.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+#include <mitkVtkImageOverwrite.h>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+#include <vector>
+
+namespace
+{
+  const int SizeX = 20;
+  const int SizeY = 16;
+  const int SizeZ = 12;
+}
+
+class mitkVtkImageOverwriteTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkVtkImageOverwriteTestSuite);
+  MITK_TEST(TestAxisAlignedSlice);
+  MITK_TEST(TestObliqueSlice);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  // all voxels are inside [1, 100], so they can be told apart from the background
+  static int VoxelValue(int x, int y, int z) { return (x + 2 * y + 3 * z) % 100 + 1; }
+
+  template <typename TPixel>
+  static mitk::Image::Pointer CreateImage()
+  {
+    auto image = mitk::Image::New();
+    unsigned int dimensions[3] = {SizeX, SizeY, SizeZ};
+    image->Initialize(mitk::MakeScalarPixelType<TPixel>(), 3, dimensions);
+
+    mitk::ImageWriteAccessor accessor(image);
+    auto *data = static_cast<TPixel *>(accessor.GetData());
+    for (int z = 0; z < SizeZ; ++z)
+      for (int y = 0; y < SizeY; ++y)
+        for (int x = 0; x < SizeX; ++x)
+          *data++ = static_cast<TPixel>(VoxelValue(x, y, z));
+
+    return image;
+  }
+
+  template <typename TPixel>
+  static TPixel GetPixel(mitk::Image *image, int x, int y, int z)
+  {
+    mitk::ImagePixelReadAccessor<TPixel, 3> accessor(image);
+    itk::Index<3> index;
+    index[0] = x;
+    index[1] = y;
+    index[2] = z;
+    return accessor.GetPixelByIndex(index);
+  }
+
+  static mitk::PlaneGeometry::Pointer CreatePlane(mitk::Image *image, int sliceIndex, double angle)
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(image->GetGeometry(), mitk::PlaneGeometry::Axial, sliceIndex, true, false);
+
+    mitk::Vector3D normal = plane->GetNormal();
+    normal.Normalize();
+    plane->SetOrigin(plane->GetOrigin() + normal * 0.5); // pixel spacing is 1, so half the spacing is 0.5
+
+    if (angle != 0.0)
+    {
+      mitk::Vector3D rotationAxis = plane->GetAxisVector(0);
+      rotationAxis.Normalize();
+      mitk::RotationOperation op(mitk::OpROTATE, plane->GetCenter(), rotationAxis, angle);
+      plane->ExecuteOperation(&op);
+    }
+
+    return plane;
+  }
+
+  static vtkSmartPointer<vtkImageData> ExtractSlice(mitk::Image *image, mitk::PlaneGeometry *plane)
+  {
+    auto reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    auto extractor = mitk::ExtractSliceFilter::New(reslice);
+    extractor->SetInput(image);
+    extractor->SetWorldGeometry(plane);
+    extractor->SetVtkOutputRequest(true);
+    extractor->Update();
+
+    auto slice = vtkSmartPointer<vtkImageData>::New();
+    slice->DeepCopy(extractor->GetVtkOutput());
+    return slice;
+  }
+
+  static void OverwriteSlice(mitk::Image *image, mitk::PlaneGeometry *plane, vtkImageData *slice)
+  {
+    auto reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    reslice->SetOverwriteMode(true);
+    reslice->SetInputSlice(slice);
+    reslice->Modified();
+
+    auto overwriter = mitk::ExtractSliceFilter::New(reslice);
+    overwriter->SetInput(image);
+    overwriter->SetWorldGeometry(plane);
+    overwriter->SetVtkOutputRequest(true);
+    overwriter->Modified();
+    overwriter->Update();
+  }
+
+  template <typename TPixel>
+  void CheckAxisAlignedSlice()
+  {
+    auto image = CreateImage<TPixel>();
+    const int sliceIndex = 7;
+    auto plane = CreatePlane(image, sliceIndex, 0.0);
+
+    auto slice = ExtractSlice(image, plane);
+    CPPUNIT_ASSERT_EQUAL(SizeX, slice->GetDimensions()[0]);
+    CPPUNIT_ASSERT_EQUAL(SizeY, slice->GetDimensions()[1]);
+
+    for (int y = 0; y < SizeY; ++y)
+      for (int x = 0; x < SizeX; ++x)
+        CPPUNIT_ASSERT_EQUAL(static_cast<TPixel>(VoxelValue(x, y, sliceIndex)),
+                             *static_cast<TPixel *>(slice->GetScalarPointer(x, y, 0)));
+
+    *static_cast<TPixel *>(slice->GetScalarPointer(3, 4, 0)) = static_cast<TPixel>(111);
+    OverwriteSlice(image, plane, slice);
+
+    for (int z = 0; z < SizeZ; ++z)
+      for (int y = 0; y < SizeY; ++y)
+        for (int x = 0; x < SizeX; ++x)
+        {
+          const int expected = (x == 3 && y == 4 && z == sliceIndex) ? 111 : VoxelValue(x, y, z);
+          CPPUNIT_ASSERT_EQUAL(static_cast<TPixel>(expected), GetPixel<TPixel>(image, x, y, z));
+        }
+  }
+
+  template <typename TPixel>
+  void CheckObliqueSlice()
+  {
+    auto image = CreateImage<TPixel>();
+    auto plane = CreatePlane(image, SizeZ / 2, 30.0);
+
+    auto slice = ExtractSlice(image, plane);
+    const int numberOfPixels = slice->GetDimensions()[0] * slice->GetDimensions()[1];
+
+    // remember which pixels hit the volume, then fill the slice and write it back
+    std::vector<bool> isInside(numberOfPixels);
+    auto *slicePixels = static_cast<TPixel *>(slice->GetScalarPointer());
+    int numberOfInsidePixels = 0;
+    for (int i = 0; i < numberOfPixels; ++i)
+    {
+      isInside[i] = slicePixels[i] >= static_cast<TPixel>(1);
+      numberOfInsidePixels += isInside[i] ? 1 : 0;
+      slicePixels[i] = static_cast<TPixel>(111);
+    }
+    CPPUNIT_ASSERT(numberOfInsidePixels > 0);
+
+    OverwriteSlice(image, plane, slice);
+
+    int numberOfChangedVoxels = 0;
+    for (int z = 0; z < SizeZ; ++z)
+      for (int y = 0; y < SizeY; ++y)
+        for (int x = 0; x < SizeX; ++x)
+          numberOfChangedVoxels += GetPixel<TPixel>(image, x, y, z) == static_cast<TPixel>(111) ? 1 : 0;
+    CPPUNIT_ASSERT(numberOfChangedVoxels > 0);
+    CPPUNIT_ASSERT(numberOfChangedVoxels <= numberOfInsidePixels);
+
+    // extracting the slice again has to return the written values wherever the slice hits the volume
+    auto result = ExtractSlice(image, plane);
+    auto *resultPixels = static_cast<TPixel *>(result->GetScalarPointer());
+    for (int i = 0; i < numberOfPixels; ++i)
+    {
+      if (isInside[i])
+        CPPUNIT_ASSERT_EQUAL(static_cast<TPixel>(111), resultPixels[i]);
+      else
+        CPPUNIT_ASSERT(resultPixels[i] < static_cast<TPixel>(1));
+    }
+  }
+
+public:
+  void TestAxisAlignedSlice()
+  {
+    CheckAxisAlignedSlice<unsigned char>();
+    CheckAxisAlignedSlice<short>();
+    CheckAxisAlignedSlice<unsigned short>();
+    CheckAxisAlignedSlice<int>();
+    CheckAxisAlignedSlice<float>();
+    CheckAxisAlignedSlice<double>();
+  }
+
+  void TestObliqueSlice()
+  {
+    CheckObliqueSlice<unsigned char>();
+    CheckObliqueSlice<short>();
+    CheckObliqueSlice<unsigned short>();
+    CheckObliqueSlice<int>();
+    CheckObliqueSlice<float>();
+    CheckObliqueSlice<double>();
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkVtkImageOverwrite)
@@ -0,0 +1,99 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "QmitkRegionGrowingToolGUI.h"
+
+#include <QApplication>
+#include <qcheckbox.h>
+#include <qlayout.h>
+#include <qpushbutton.h>
+
+MITK_TOOL_GUI_MACRO(MITKSEGMENTATIONUI_EXPORT, QmitkRegionGrowingToolGUI, "")
+
+QmitkRegionGrowingToolGUI::QmitkRegionGrowingToolGUI() : QmitkToolGUI(), m_3DCheckBox(nullptr), m_CancelButton(nullptr)
+{
+  QBoxLayout *layout = new QHBoxLayout(this);
+  this->setContentsMargins(0, 0, 0, 0);
+
+  m_3DCheckBox = new QCheckBox("Grow in 3D", this);
+  m_3DCheckBox->setToolTip("Choose the thresholds on the slice, the region is grown in the whole volume after releasing the mouse button.");
+  connect(m_3DCheckBox, SIGNAL(toggled(bool)), this, SLOT(On3DToggled(bool)));
+  layout->addWidget(m_3DCheckBox);
+
+  m_CancelButton = new QPushButton("Cancel", this);
+  m_CancelButton->setToolTip("Stop the running 3D region growing.");
+  m_CancelButton->setEnabled(false);
+  connect(m_CancelButton, SIGNAL(clicked()), this, SLOT(OnCancelClicked()));
+  layout->addWidget(m_CancelButton);
+
+  connect(this, SIGNAL(NewToolAssociated(mitk::Tool *)), this, SLOT(OnNewToolAssociated(mitk::Tool *)));
+}
+
+QmitkRegionGrowingToolGUI::~QmitkRegionGrowingToolGUI()
+{
+  if (m_RegionGrowingTool.IsNotNull())
+  {
+    m_RegionGrowingTool->CurrentlyBusy -=
+      mitk::MessageDelegate1<QmitkRegionGrowingToolGUI, bool>(this, &QmitkRegionGrowingToolGUI::OnBusyStateChanged);
+  }
+}
+
+void QmitkRegionGrowingToolGUI::OnNewToolAssociated(mitk::Tool *tool)
+{
+  if (m_RegionGrowingTool.IsNotNull())
+  {
+    m_RegionGrowingTool->CurrentlyBusy -=
+      mitk::MessageDelegate1<QmitkRegionGrowingToolGUI, bool>(this, &QmitkRegionGrowingToolGUI::OnBusyStateChanged);
+  }
+
+  m_RegionGrowingTool = dynamic_cast<mitk::RegionGrowingTool *>(tool);
+
+  if (m_RegionGrowingTool.IsNotNull())
+  {
+    m_RegionGrowingTool->CurrentlyBusy +=
+      mitk::MessageDelegate1<QmitkRegionGrowingToolGUI, bool>(this, &QmitkRegionGrowingToolGUI::OnBusyStateChanged);
+
+    m_3DCheckBox->setChecked(m_RegionGrowingTool->GetUse3DRegionGrowing());
+    m_CancelButton->setEnabled(m_RegionGrowingTool->Is3DRegionGrowingRunning());
+  }
+}
+
+void QmitkRegionGrowingToolGUI::On3DToggled(bool checked)
+{
+  if (m_RegionGrowingTool.IsNotNull())
+  {
+    m_RegionGrowingTool->SetUse3DRegionGrowing(checked);
+  }
+}
+
+void QmitkRegionGrowingToolGUI::OnCancelClicked()
+{
+  if (m_RegionGrowingTool.IsNotNull())
+  {
+    m_RegionGrowingTool->Cancel3DRegionGrowing();
+  }
+}
+
+void QmitkRegionGrowingToolGUI::OnBusyStateChanged(bool isBusy)
+{
+  // the application stays responsive while the region grows in the background
+  if (isBusy)
+  {
+    QApplication::setOverrideCursor(QCursor(Qt::BusyCursor));
+  }
+  else
+  {
+    QApplication::restoreOverrideCursor();
+  }
+
+  m_CancelButton->setEnabled(isBusy);
+}
@@ -0,0 +1,59 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef QmitkRegionGrowingToolGUI_h_Included
+#define QmitkRegionGrowingToolGUI_h_Included
+
+#include "QmitkToolGUI.h"
+#include "mitkRegionGrowingTool.h"
+#include <MitkSegmentationUIExports.h>
+
+class QCheckBox;
+class QPushButton;
+
+/**
+  \ingroup org_mitk_gui_qt_interactivesegmentation_internal
+  \brief GUI for mitk::RegionGrowingTool.
+  \sa mitk::RegionGrowingTool
+
+  This GUI switches between slice based and 3D region growing and allows to cancel a running 3D region growing.
+*/
+class MITKSEGMENTATIONUI_EXPORT QmitkRegionGrowingToolGUI : public QmitkToolGUI
+{
+  Q_OBJECT
+
+public:
+  mitkClassMacro(QmitkRegionGrowingToolGUI, QmitkToolGUI);
+  itkFactorylessNewMacro(Self);
+  itkCloneMacro(Self);
+
+  void OnBusyStateChanged(bool isBusy);
+
+protected slots:
+
+  void OnNewToolAssociated(mitk::Tool *);
+
+  void On3DToggled(bool checked);
+
+  void OnCancelClicked();
+
+protected:
+  QmitkRegionGrowingToolGUI();
+  ~QmitkRegionGrowingToolGUI() override;
+
+  QCheckBox *m_3DCheckBox;
+  QPushButton *m_CancelButton;
+
+  mitk::RegionGrowingTool::Pointer m_RegionGrowingTool;
+};
+
+#endif
@@ -89,6 +89,11 @@ QmitkSlicesInterpolator::QmitkSlicesInterpolator(QWidget *parent, const char * /
     m_Initialized(false),
     m_LastSNC(nullptr),
     m_LastSliceIndex(0),
+    m_LastSliceDimension(-1),
+    m_PrefetchRequestPending(false),
+    m_PrefetchRunning(false),
+    m_PrefetchGeneration(0),
+    m_PrefetchDirection(1),
     m_2DInterpolationEnabled(false),
     m_3DInterpolationEnabled(false),
     m_FirstRun(true)
@@ -608,17 +613,139 @@ void QmitkSlicesInterpolator::Interpolate(mitk::PlaneGeometry *plane,
         // calculate real slice position, i.e. slice of the image
         mitk::SegTool2D::DetermineAffectedImageSlice(m_Segmentation, plane, clickedSliceDimension, clickedSliceIndex);
 
-        mitk::Image::Pointer interpolation =
-          m_Interpolator->Interpolate(clickedSliceDimension, clickedSliceIndex, plane, timeStep);
+        mitk::Image::Pointer interpolation;
+        if (!this->TakePrefetchedInterpolation(clickedSliceDimension, clickedSliceIndex, timeStep, interpolation))
+        {
+          interpolation = m_Interpolator->Interpolate(clickedSliceDimension, clickedSliceIndex, plane, timeStep);
+        }
         m_FeedbackNode->SetData(interpolation);
 
+        // keep the direction of the last scroll step to prefetch the slices the user will see next
+        if (m_LastSliceDimension == clickedSliceDimension && static_cast<int>(m_LastSliceIndex) != clickedSliceIndex)
+        {
+          m_PrefetchDirection = clickedSliceIndex > static_cast<int>(m_LastSliceIndex) ? 1 : -1;
+        }
+        this->PrefetchInterpolations(plane, clickedSliceDimension, clickedSliceIndex, timeStep);
+
         m_LastSNC = slicer;
         m_LastSliceIndex = clickedSliceIndex;
+        m_LastSliceDimension = clickedSliceDimension;
       }
     }
   }
 }
 
+void QmitkSlicesInterpolator::PrefetchInterpolations(const mitk::PlaneGeometry *plane,
+                                                     int sliceDimension,
+                                                     int sliceIndex,
+                                                     unsigned int timeStep)
+{
+  if (nullptr == m_Segmentation || nullptr == plane || sliceDimension < 0 || sliceDimension > 2)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+
+  m_PrefetchRequest.Plane = plane->Clone();
+  m_PrefetchRequest.SlicedGeometry = m_Segmentation->GetSlicedGeometry(timeStep);
+  m_PrefetchRequest.SliceDimension = sliceDimension;
+  m_PrefetchRequest.SliceIndex = sliceIndex;
+  m_PrefetchRequest.Direction = m_PrefetchDirection;
+  m_PrefetchRequest.NumberOfSlices = static_cast<int>(m_Segmentation->GetDimension(sliceDimension));
+  m_PrefetchRequest.TimeStep = timeStep;
+  m_PrefetchRequestPending = true;
+
+  // a running worker picks up the new request after the current slice
+  if (!m_PrefetchRunning)
+  {
+    m_PrefetchRunning = true;
+    m_PrefetchFuture = QtConcurrent::run(this, &QmitkSlicesInterpolator::RunPrefetch);
+  }
+}
+
+void QmitkSlicesInterpolator::RunPrefetch()
+{
+  const int PREFETCH_DEPTH = 4;
+  const std::size_t MAX_PREFETCHED_INTERPOLATIONS = 64;
+
+  std::unique_lock<std::mutex> lock(m_PrefetchMutex);
+
+  while (m_PrefetchRequestPending)
+  {
+    m_PrefetchRequestPending = false;
+    const auto request = m_PrefetchRequest;
+    const auto generation = m_PrefetchGeneration;
+    lock.unlock();
+
+    auto plane = request.Plane->Clone();
+    auto origin = plane->GetOrigin();
+
+    for (int step = 1; step <= PREFETCH_DEPTH; ++step)
+    {
+      const int sliceIndex = request.SliceIndex + step * request.Direction;
+      if (sliceIndex < 0 || sliceIndex >= request.NumberOfSlices)
+        break;
+
+      const auto key = std::make_tuple(request.SliceDimension, sliceIndex, request.TimeStep);
+
+      {
+        std::lock_guard<std::mutex> guard(m_PrefetchMutex);
+
+        if (m_PrefetchRequestPending || generation != m_PrefetchGeneration)
+          break; // outdated, continue with the newest request
+
+        if (0 != m_PrefetchedInterpolations.count(key))
+          continue;
+      }
+
+      request.SlicedGeometry->WorldToIndex(origin, origin);
+      origin[request.SliceDimension] = sliceIndex;
+      request.SlicedGeometry->IndexToWorld(origin, origin);
+      plane->SetOrigin(origin);
+
+      auto interpolation = m_Interpolator->Interpolate(request.SliceDimension, sliceIndex, plane, request.TimeStep);
+
+      std::lock_guard<std::mutex> guard(m_PrefetchMutex);
+
+      if (generation == m_PrefetchGeneration)
+      {
+        if (MAX_PREFETCHED_INTERPOLATIONS < m_PrefetchedInterpolations.size())
+          m_PrefetchedInterpolations.clear();
+
+        m_PrefetchedInterpolations[key] = interpolation;
+      }
+    }
+
+    lock.lock();
+  }
+
+  m_PrefetchRunning = false;
+}
+
+bool QmitkSlicesInterpolator::TakePrefetchedInterpolation(int sliceDimension,
+                                                          int sliceIndex,
+                                                          unsigned int timeStep,
+                                                          mitk::Image::Pointer &interpolation)
+{
+  std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+
+  auto iter = m_PrefetchedInterpolations.find(std::make_tuple(sliceDimension, sliceIndex, timeStep));
+  if (iter == m_PrefetchedInterpolations.end())
+    return false;
+
+  interpolation = iter->second;
+  m_PrefetchedInterpolations.erase(iter);
+  return true;
+}
+
+void QmitkSlicesInterpolator::ClearPrefetchedInterpolations()
+{
+  std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+
+  ++m_PrefetchGeneration;
+  m_PrefetchRequestPending = false;
+  m_PrefetchedInterpolations.clear();
+}
+
 void QmitkSlicesInterpolator::OnSurfaceInterpolationFinished()
 {
   mitk::Surface::Pointer interpolatedSurface = m_SurfaceInterpolator->GetInterpolationResult();
@@ -830,6 +957,8 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
       }
     };
 
+    // the cache is already enabled while the 2D interpolation is active, otherwise enable it just for this run
+    const bool disableSliceImageCache = !m_Interpolator->IsSliceImageCacheEnabled();
     m_Interpolator->EnableSliceImageCache();
 
     for (std::remove_const_t<decltype(numThreads)> threadIndex = 0; threadIndex < numThreads; ++threadIndex)
@@ -838,7 +967,8 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
     for (auto& thread : threads)
       thread.join();
 
-    m_Interpolator->DisableSliceImageCache();
+    if (disableSliceImageCache)
+      m_Interpolator->DisableSliceImageCache();
 
     if (totalChangedSlices > 0)
     {
@@ -1148,8 +1278,11 @@ void QmitkSlicesInterpolator::OnInterpolationActivated(bool on)
     m_BtnApply2D->setEnabled(on);
     m_FeedbackNode->SetVisibility(on);
 
+    this->ClearPrefetchedInterpolations();
+
     if (!on)
     {
+      m_Interpolator->DisableSliceImageCache();
       mitk::RenderingManager::GetInstance()->RequestUpdateAll();
       return;
     }
@@ -1166,6 +1299,9 @@ void QmitkSlicesInterpolator::OnInterpolationActivated(bool on)
           mitk::Image *referenceImage = dynamic_cast<mitk::Image *>(referenceNode->GetData());
           m_Interpolator->SetReferenceVolume(referenceImage); // may be nullptr
         }
+
+        // keep extracted slices and distance maps while scrolling, they are invalidated slice-wise on changes
+        m_Interpolator->EnableSliceImageCache();
       }
     }
   }
@@ -1292,12 +1428,15 @@ void QmitkSlicesInterpolator::UpdateVisibleSuggestion()
 
 void QmitkSlicesInterpolator::OnInterpolationInfoChanged(const itk::EventObject & /*e*/)
 {
+  this->ClearPrefetchedInterpolations();
+
   // something (e.g. undo) changed the interpolation info, we should refresh our display
   UpdateVisibleSuggestion();
 }
 
 void QmitkSlicesInterpolator::OnInterpolationAborted(const itk::EventObject& /*e*/)
 {
+  this->ClearPrefetchedInterpolations();
   m_CmbInterpolation->setCurrentIndex(0);
   m_FeedbackNode->SetData(nullptr);
 }
@@ -1419,6 +1558,13 @@ void QmitkSlicesInterpolator::OnSliceNavigationControllerDeleted(const itk::Obje
 
 void QmitkSlicesInterpolator::WaitForFutures()
 {
+  this->ClearPrefetchedInterpolations();
+
+  if (m_PrefetchFuture.isRunning())
+  {
+    m_PrefetchFuture.waitForFinished();
+  }
+
   if (m_Watcher.isRunning())
   {
     m_Watcher.waitForFinished();
@@ -15,7 +15,9 @@ found in the LICENSE file.
 
 #include "mitkDataNode.h"
 #include "mitkDataStorage.h"
+#include "mitkPlaneGeometry.h"
 #include "mitkSegmentationInterpolationController.h"
+#include "mitkSlicedGeometry3D.h"
 #include "mitkSliceNavigationController.h"
 #include "mitkSurfaceInterpolationController.h"
 #include "mitkToolManager.h"
@@ -26,6 +28,8 @@ found in the LICENSE file.
 
 #include <QWidget>
 #include <map>
+#include <mutex>
+#include <tuple>
 
 #include <QCheckBox>
 #include <QComboBox>
@@ -239,6 +243,21 @@ private:
   void WaitForFutures();
   void NodeRemoved(const mitk::DataNode* node);
 
+  /**
+    Requests the interpolation of the slices that follow the given slice in scroll direction. They are
+    computed by a worker thread and picked up by Interpolate() once the user scrolls there.
+   */
+  void PrefetchInterpolations(const mitk::PlaneGeometry *plane, int sliceDimension, int sliceIndex, unsigned int timeStep);
+
+  /** Runs in the worker thread as long as new prefetch requests arrive.*/
+  void RunPrefetch();
+
+  /** Removes a prefetched interpolation from the prefetched ones and returns it. Returns false if the slice was not prefetched (yet).*/
+  bool TakePrefetchedInterpolation(int sliceDimension, int sliceIndex, unsigned int timeStep, mitk::Image::Pointer &interpolation);
+
+  /** Discards all prefetched interpolations and the results of a running prefetch, e.g. because the segmentation changed.*/
+  void ClearPrefetchedInterpolations();
+
   mitk::SegmentationInterpolationController::Pointer m_Interpolator;
   mitk::SurfaceInterpolationController::Pointer m_SurfaceInterpolator;
 
@@ -276,6 +295,29 @@ private:
 
   mitk::SliceNavigationController *m_LastSNC;
   unsigned int m_LastSliceIndex;
+  int m_LastSliceDimension;
+
+  struct PrefetchRequest
+  {
+    mitk::PlaneGeometry::Pointer Plane;
+    mitk::SlicedGeometry3D::ConstPointer SlicedGeometry;
+    int SliceDimension;
+    int SliceIndex;
+    int Direction;
+    int NumberOfSlices;
+    unsigned int TimeStep;
+  };
+
+  /** Key is (slice dimension, slice index, time step). A null image means that there is nothing to interpolate.*/
+  std::map<std::tuple<int, int, unsigned int>, mitk::Image::Pointer> m_PrefetchedInterpolations;
+  PrefetchRequest m_PrefetchRequest;
+  bool m_PrefetchRequestPending;
+  bool m_PrefetchRunning;
+  /** Incremented whenever prefetched interpolations become invalid; results of older requests are discarded.*/
+  unsigned long m_PrefetchGeneration;
+  int m_PrefetchDirection;
+  std::mutex m_PrefetchMutex;
+  QFuture<void> m_PrefetchFuture;
 
   QHash<mitk::SliceNavigationController *, mitk::TimePointType> m_TimePoints;
 
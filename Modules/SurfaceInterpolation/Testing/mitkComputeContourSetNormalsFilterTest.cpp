@@ -31,6 +31,7 @@ class mitkComputeContourSetNormalsFilterTestSuite : public mitk::TestFixture
 
   MITK_TEST(TestComputeNormals);
   MITK_TEST(TestComputeNormalsWithHole);
+  MITK_TEST(TestNormalsAreReusedForUnchangedSegmentation);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -94,6 +95,35 @@ public:
                            contourWithNormals->GetVtkPolyData()->GetCellData()->GetNormals()->GetNumberOfTuples() ==
                              contourReference->GetVtkPolyData()->GetNumberOfPoints());
   }
+
+  // The normals are cached per segmentation and time step, not per volume image
+  void TestNormalsAreReusedForUnchangedSegmentation()
+  {
+    mitk::Image::Pointer segmentation =
+      mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("SurfaceInterpolation/Reference/LiverSegmentation.nrrd"));
+
+    mitk::Surface::Pointer contour =
+      mitk::IOUtil::Load<mitk::Surface>(GetTestDataFilePath("SurfaceInterpolation/ComputeNormals/ContourWithHoles.vtk"));
+    m_ContourNormalsFilter->SetInput(contour);
+
+    auto computeNormals = [this, &segmentation](mitk::TimeStepType timeStep) {
+      // like SurfaceInterpolationController, pass a new volume on every run
+      m_ContourNormalsFilter->SetSegmentationBinaryImage(segmentation->Clone(), segmentation, timeStep);
+      m_ContourNormalsFilter->Modified();
+      m_ContourNormalsFilter->Update();
+      return m_ContourNormalsFilter->GetOutput()->GetVtkPolyData()->GetCellData()->GetNormals();
+    };
+
+    auto *normals = computeNormals(0);
+    CPPUNIT_ASSERT(nullptr != normals);
+    CPPUNIT_ASSERT_MESSAGE("Normals of an unchanged segmentation are reused", normals == computeNormals(0));
+
+    segmentation->Modified();
+    auto *normalsOfModifiedSegmentation = computeNormals(0);
+    CPPUNIT_ASSERT_MESSAGE("Normals are computed again for a modified segmentation", normals != normalsOfModifiedSegmentation);
+
+    CPPUNIT_ASSERT_MESSAGE("Normals are computed again for another time step", normalsOfModifiedSegmentation != computeNormals(1));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkComputeContourSetNormalsFilter)
@@ -14,10 +14,18 @@ found in the LICENSE file.
 #include <mitkCreateDistanceImageFromSurfaceFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImageCast.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkDebugLeaks.h>
+#include <vtkDoubleArray.h>
+#include <vtkPolygon.h>
+
+#include <itkImageRegionConstIterator.h>
+#include <itkMath.h>
 
 class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixture
 {
@@ -26,6 +34,9 @@ class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixtu
   // Basically tests the same as the other test below
   // MITK_TEST(TestCreateDistanceImageForLiver);
   MITK_TEST(TestCreateDistanceImageForTube);
+  MITK_TEST(TestIterativeSolverMatchesDirectSolver);
+  MITK_TEST(TestIterativeSolverMatchesDirectSolverForFewCenters);
+  MITK_TEST(TestIncrementalSolvingMatchesFullSolve);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -39,6 +50,111 @@ public:
     result->Graft(input);
   }
 
+  // Creates a circular contour of a sphere with the given radius around the origin at height z. The normals are
+  // stored like the ComputeContourSetNormalsFilter does.
+  mitk::Surface::Pointer CreateSphereContour(double radius, double z, unsigned int numberOfPoints)
+  {
+    const double contourRadius = std::sqrt(radius * radius - z * z);
+
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    auto polygon = vtkSmartPointer<vtkPolygon>::New();
+    auto normals = vtkSmartPointer<vtkDoubleArray>::New();
+    normals->SetNumberOfComponents(3);
+    normals->SetNumberOfTuples(numberOfPoints);
+    polygon->GetPointIds()->SetNumberOfIds(numberOfPoints);
+
+    for (unsigned int i = 0; i < numberOfPoints; ++i)
+    {
+      const double angle = 2.0 * itk::Math::pi * i / numberOfPoints;
+      const double point[3] = {contourRadius * std::cos(angle), contourRadius * std::sin(angle), z};
+      const double normal[3] = {point[0] / radius, point[1] / radius, point[2] / radius};
+
+      points->InsertNextPoint(point);
+      normals->SetTuple(i, normal);
+      polygon->GetPointIds()->SetId(i, i);
+    }
+
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->InsertNextCell(polygon);
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polys);
+    polyData->GetCellData()->SetNormals(normals);
+
+    mitk::Surface::Pointer contour = mitk::Surface::New();
+    contour->SetVtkPolyData(polyData);
+    return contour;
+  }
+
+  itk::ImageBase<3>::Pointer CreateReferenceImage()
+  {
+    typedef itk::Image<unsigned char, 3> ReferenceImageType;
+    ReferenceImageType::Pointer referenceImage = ReferenceImageType::New();
+    ReferenceImageType::SizeType size;
+    size.Fill(128);
+    ReferenceImageType::PointType origin;
+    origin.Fill(-64.0);
+    referenceImage->SetRegions(size);
+    referenceImage->SetOrigin(origin);
+    referenceImage->Allocate();
+
+    itk::ImageBase<3>::Pointer result = referenceImage.GetPointer();
+    return result;
+  }
+
+  mitk::CreateDistanceImageFromSurfaceFilter::Pointer CreateSphereFilter(unsigned int numberOfContours,
+                                                                          unsigned int pointsPerContour)
+  {
+    const double radius = 40.0;
+
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer filter = mitk::CreateDistanceImageFromSurfaceFilter::New();
+    filter->SetReferenceImage(this->CreateReferenceImage());
+
+    for (unsigned int i = 0; i < numberOfContours; ++i)
+    {
+      const double z = -0.8 * radius + 1.6 * radius * i / (numberOfContours - 1);
+      filter->SetInput(i, this->CreateSphereContour(radius, z, pointsPerContour));
+    }
+    return filter;
+  }
+
+  // Both distance functions must describe the same surface, i.e. they have to agree on the side of the surface
+  // and on the distance everywhere within the narrow band up to a small fraction of the spacing
+  void AssertIterativeSolutionMatchesDirectSolution(mitk::CreateDistanceImageFromSurfaceFilter *directFilter,
+                                                    mitk::CreateDistanceImageFromSurfaceFilter *iterativeFilter)
+  {
+    typedef mitk::CreateDistanceImageFromSurfaceFilter::DistanceImageType DistanceImageType;
+
+    DistanceImageType::Pointer directImage;
+    DistanceImageType::Pointer iterativeImage;
+    mitk::CastToItkImage(directFilter->GetOutput(), directImage);
+    mitk::CastToItkImage(iterativeFilter->GetOutput(), iterativeImage);
+
+    CPPUNIT_ASSERT(directImage->GetLargestPossibleRegion() == iterativeImage->GetLargestPossibleRegion());
+
+    const double spacing = directFilter->GetDistanceImageSpacing();
+    const double tolerance = 0.05 * spacing;
+
+    itk::ImageRegionConstIterator<DistanceImageType> directIt(directImage, directImage->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<DistanceImageType> iterativeIt(iterativeImage,
+                                                                 iterativeImage->GetLargestPossibleRegion());
+    for (; !directIt.IsAtEnd(); ++directIt, ++iterativeIt)
+    {
+      const double direct = directIt.Get();
+      const double iterative = iterativeIt.Get();
+
+      if (std::abs(direct) <= 2 * spacing && std::abs(iterative) <= 2 * spacing)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(direct, iterative, tolerance);
+      }
+      else if ((direct < 0) != (iterative < 0))
+      {
+        CPPUNIT_ASSERT(std::abs(direct) < tolerance && std::abs(iterative) < tolerance);
+      }
+    }
+  }
+
   // Interpolate the shape of a liver
   void TestCreateDistanceImageForLiver()
   {
@@ -128,6 +244,63 @@ public:
     CPPUNIT_ASSERT_MESSAGE("HolesDistanceImages are not equal!",
                            mitk::Equal(*(holesDistanceImageReference), *(holeDistanceImage), 0.0001, true));
   }
+
+  void TestIterativeSolverMatchesDirectSolver()
+  {
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer directFilter = this->CreateSphereFilter(5, 120);
+    directFilter->Update();
+    CPPUNIT_ASSERT_EQUAL(0u, directFilter->GetNumberOfSolverIterations());
+
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer iterativeFilter = this->CreateSphereFilter(5, 120);
+    iterativeFilter->SetMaximumNumberOfCentersForDirectSolver(0);
+    iterativeFilter->Update();
+    CPPUNIT_ASSERT(iterativeFilter->GetNumberOfSolverIterations() > 0);
+
+    this->AssertIterativeSolutionMatchesDirectSolution(directFilter, iterativeFilter);
+  }
+
+  // 180 centers already split into several treecode leaves, so the far field approximation and the iterative solver
+  // are both used on a system that is still cheap to solve directly
+  void TestIterativeSolverMatchesDirectSolverForFewCenters()
+  {
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer directFilter = this->CreateSphereFilter(3, 20);
+    directFilter->Update();
+    CPPUNIT_ASSERT_EQUAL(0u, directFilter->GetNumberOfSolverIterations());
+
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer iterativeFilter = this->CreateSphereFilter(3, 20);
+    iterativeFilter->SetMaximumNumberOfCentersForDirectSolver(0);
+    iterativeFilter->Update();
+    CPPUNIT_ASSERT(iterativeFilter->GetNumberOfSolverIterations() > 0);
+
+    this->AssertIterativeSolutionMatchesDirectSolution(directFilter, iterativeFilter);
+  }
+
+  void TestIncrementalSolvingMatchesFullSolve()
+  {
+    const double radius = 40.0;
+
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer incrementalFilter = this->CreateSphereFilter(5, 60);
+    incrementalFilter->Update();
+    CPPUNIT_ASSERT_EQUAL(0u, incrementalFilter->GetNumberOfReusedCenters());
+
+    // Solving the same system again reuses all centers
+    incrementalFilter->Modified();
+    incrementalFilter->Update();
+    CPPUNIT_ASSERT_EQUAL(5u * 60u * 3u, incrementalFilter->GetNumberOfReusedCenters());
+
+    // A contour within the bounds of the others keeps the spacing and thus all previous centers
+    incrementalFilter->SetInput(5, this->CreateSphereContour(radius, 0.6 * radius, 60));
+    incrementalFilter->Update();
+    CPPUNIT_ASSERT_EQUAL(5u * 60u * 3u, incrementalFilter->GetNumberOfReusedCenters());
+
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer fullFilter = this->CreateSphereFilter(5, 60);
+    fullFilter->SetIncrementalSolving(false);
+    fullFilter->SetInput(5, this->CreateSphereContour(radius, 0.6 * radius, 60));
+    fullFilter->Update();
+
+    CPPUNIT_ASSERT_MESSAGE("Incrementally solved distance image differs from the fully solved one!",
+                           mitk::Equal(*(fullFilter->GetOutput()), *(incrementalFilter->GetOutput()), 1e-6, true));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkCreateDistanceImageFromSurfaceFilter)
@@ -4,6 +4,7 @@ set(CPP_FILES
   mitkImageToPointCloudFilter.cpp
   mitkPlaneProposer.cpp
   mitkPointCloudScoringFilter.cpp
+  mitkRadialBasisFunctionTreecode.cpp
   mitkReduceContourSetFilter.cpp
   mitkSurfaceInterpolationController.cpp
   mitkSurfaceBasedInterpolationController.cpp
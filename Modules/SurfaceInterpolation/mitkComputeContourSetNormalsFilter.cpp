@@ -17,6 +17,8 @@ found in the LICENSE file.
 
 mitk::ComputeContourSetNormalsFilter::ComputeContourSetNormalsFilter()
   : m_SegmentationBinaryImage(nullptr),
+    m_Segmentation(nullptr),
+    m_SegmentationTimeStep(0),
     m_MaxSpacing(5),
     m_NegativeNormalCounter(0),
     m_PositiveNormalCounter(0),
@@ -31,10 +33,21 @@ mitk::ComputeContourSetNormalsFilter::~ComputeContourSetNormalsFilter()
 {
 }
 
+void mitk::ComputeContourSetNormalsFilter::SetSegmentationBinaryImage(mitk::Image *segmentationImage,
+                                                                      const mitk::Image *segmentation,
+                                                                      TimeStepType timeStep)
+{
+  m_SegmentationBinaryImage = segmentationImage;
+  m_Segmentation = segmentation;
+  m_SegmentationTimeStep = timeStep;
+}
+
 void mitk::ComputeContourSetNormalsFilter::GenerateData()
 {
   unsigned int numberOfInputs = this->GetNumberOfIndexedInputs();
 
+  std::map<mitk::Surface::ConstPointer, ContourNormals> contourNormals;
+
   // Iterating over each input
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
@@ -42,6 +55,26 @@ void mitk::ComputeContourSetNormalsFilter::GenerateData()
     auto *currentSurface = this->GetInput(i);
     vtkPolyData *polyData = currentSurface->GetVtkPolyData();
 
+    ContourNormals currentNormals;
+    currentNormals.InputTime = polyData->GetMTime();
+    currentNormals.Segmentation = m_Segmentation;
+    currentNormals.SegmentationTime = m_Segmentation.IsNotNull() ? m_Segmentation->GetMTime() : 0;
+    currentNormals.SegmentationTimeStep = m_SegmentationTimeStep;
+    currentNormals.MaxSpacing = m_MaxSpacing;
+
+    // Reuse the normals of the previous run if neither the contour nor the segmentation nor the parameters changed
+    auto cachedNormals = m_NormalsCache.find(currentSurface);
+    if (cachedNormals != m_NormalsCache.end() && cachedNormals->second.InputTime == currentNormals.InputTime &&
+        cachedNormals->second.Segmentation == currentNormals.Segmentation &&
+        cachedNormals->second.SegmentationTime == currentNormals.SegmentationTime &&
+        cachedNormals->second.SegmentationTimeStep == currentNormals.SegmentationTimeStep &&
+        cachedNormals->second.MaxSpacing == currentNormals.MaxSpacing)
+    {
+      this->GetOutput(i)->GetVtkPolyData()->GetCellData()->SetNormals(cachedNormals->second.Normals);
+      contourNormals[currentSurface] = cachedNormals->second;
+      continue;
+    }
+
     vtkSmartPointer<vtkCellArray> existingPolys = polyData->GetPolys();
 
     vtkSmartPointer<vtkPoints> existingPoints = polyData->GetPoints();
@@ -238,8 +271,14 @@ void mitk::ComputeContourSetNormalsFilter::GenerateData()
 
     Surface::Pointer surface = this->GetOutput(i);
     surface->GetVtkPolyData()->GetCellData()->SetNormals(normals);
+
+    currentNormals.Normals = normals;
+    contourNormals[currentSurface] = currentNormals;
   } // end for all inputs
 
+  // Only keep the normals of the current inputs
+  m_NormalsCache.swap(contourNormals);
+
   // Setting progressbar
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(this->m_ProgressStepSize);
@@ -28,6 +28,8 @@ found in the LICENSE file.
 
 #include "mitkImage.h"
 
+#include <map>
+
 namespace mitk
 {
   /**
@@ -45,6 +47,10 @@ namespace mitk
    Note: If a segmentation binary image is provided this filter assures that the computed normals
          do not point into the segmentation image
 
+   The normals of each input are cached and only recomputed if the input, the segmentation image or the max
+   spacing changed. The content of the segmentation image is not part of the cache key, since a contour has to be
+   extracted again anyway if the segmentation changes at its position.
+
    $Author: fetzer$
 */
   class MITKSURFACEINTERPOLATION_EXPORT ComputeContourSetNormalsFilter : public SurfaceToSurfaceFilter
@@ -78,7 +84,16 @@ namespace mitk
     */
     void SetProgressStepSize(unsigned int stepSize);
 
-    void SetSegmentationBinaryImage(mitk::Image *segmentationImage) { m_SegmentationBinaryImage = segmentationImage; }
+    void SetSegmentationBinaryImage(mitk::Image *segmentationImage) { this->SetSegmentationBinaryImage(segmentationImage, segmentationImage, 0); }
+
+    /**
+      \brief Set the volume of a segmentation the contours were extracted from.
+
+      \a segmentationImage is the volume at \a timeStep of \a segmentation. Computed normals are reused for unchanged
+      contours as long as the segmentation, its modification time and the time step stay the same, even if
+      \a segmentationImage is a new volume every time.
+    */
+    void SetSegmentationBinaryImage(mitk::Image *segmentationImage, const mitk::Image *segmentation, TimeStepType timeStep);
   protected:
     ComputeContourSetNormalsFilter();
     ~ComputeContourSetNormalsFilter() override;
@@ -88,8 +103,25 @@ namespace mitk
   private:
     // The segmentation out of which the contours were extracted. Can be used to determine the direction of the normals
     mitk::Image::Pointer m_SegmentationBinaryImage;
+    // The segmentation m_SegmentationBinaryImage belongs to and its time step, they identify the cached normals
+    mitk::Image::ConstPointer m_Segmentation;
+    TimeStepType m_SegmentationTimeStep;
     double m_MaxSpacing;
 
+    /** The normals of one input of a previous run */
+    struct ContourNormals
+    {
+      itk::ModifiedTimeType InputTime;
+      mitk::Image::ConstPointer Segmentation;
+      itk::ModifiedTimeType SegmentationTime;
+      TimeStepType SegmentationTimeStep;
+      double MaxSpacing;
+      vtkSmartPointer<vtkDoubleArray> Normals;
+    };
+
+    /** The inputs are held, so that the address of a deleted input cannot be taken for a cached one */
+    std::map<mitk::Surface::ConstPointer, ContourNormals> m_NormalsCache;
+
     unsigned int m_NegativeNormalCounter;
     unsigned int m_PositiveNormalCounter;
 
@@ -22,7 +22,11 @@ found in the LICENSE file.
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkNeighborhoodIterator.h"
 
+#include <array>
+#include <cmath>
+#include <map>
 #include <queue>
+#include <set>
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -105,7 +109,16 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 }
 
 mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter()
-  : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
+  : m_UseIterativeSolver(false),
+    m_MaximumNumberOfCentersForDirectSolver(3000),
+    m_TreecodeOpeningAngle(0.3),
+    m_IterativeSolverTolerance(1e-4),
+    m_NumberOfSolverIterations(0),
+    m_IncrementalSolving(true),
+    m_NumberOfReusedCenters(0),
+    m_HasFactorization(false),
+    m_DistanceImageSpacing(0.0),
+    m_DistanceImageDefaultBufferValue(0.0)
 {
   m_DistanceImageVolume = 50000;
   this->m_UseProgressBar = false;
@@ -124,13 +137,25 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
   this->PreprocessContourPoints();
   this->CreateEmptyDistanceImage();
 
+  // Every contour point results in three centers (on, inside and outside of the surface)
+  m_UseIterativeSolver = m_Centers.size() * 3 > m_MaximumNumberOfCentersForDirectSolver;
+  m_NumberOfSolverIterations = 0;
+  m_NumberOfReusedCenters = 0;
+
   // First of all we have to build the equation-system from the existing contour-edge-points
   this->CreateSolutionMatrixAndFunctionValues();
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  if (m_UseIterativeSolver)
+  {
+    this->SolveIteratively();
+  }
+  else
+  {
+    this->SolveDirectly();
+  }
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
@@ -158,6 +183,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
 
   // First of all we have to extract the nomals and the surface points.
   // Duplicated points can be eliminated
+  std::set<std::array<double, 3>> uniqueCenters;
 
   vtkSmartPointer<vtkPolyData> polyData;
   vtkSmartPointer<vtkDoubleArray> currentCellNormals;
@@ -199,9 +225,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
 
         currentPoint.copy_in(p);
 
-        int count = std::count(m_Centers.begin(), m_Centers.end(), currentPoint);
-
-        if (count == 0)
+        if (uniqueCenters.insert({{p[0], p[1], p[2]}}).second)
         {
           double currentNormal[3];
           currentCellNormals->GetTuple(cell[j], currentNormal);
@@ -264,10 +288,32 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
   // Now we have created all centers and all function values. Next step is to create the solution matrix
   numberOfCenters = m_Centers.size();
 
-  m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
-
   m_Weights.resize(numberOfCenters);
 
+  if (m_UseIterativeSolver)
+  {
+    // The solution matrix is never assembled, its products are approximated by the treecode
+    m_SolutionMatrix.resize(0, 0);
+    m_Treecode.SetOpeningAngle(m_TreecodeOpeningAngle);
+    m_Treecode.Build(m_Centers);
+    return;
+  }
+
+  if (m_IncrementalSolving && m_HasFactorization)
+  {
+    // The solution matrix is only assembled if the previous factorization can not be extended (see SolveDirectly)
+    m_SolutionMatrix.resize(0, 0);
+    return;
+  }
+
+  this->AssembleSolutionMatrix();
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::AssembleSolutionMatrix()
+{
+  const auto numberOfCenters = static_cast<unsigned int>(m_Centers.size());
+  m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
+
   PointType p1;
   PointType p2;
   double norm;
@@ -419,8 +465,310 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   CastToMitkImage(m_DistanceImageITK, resultImage);
 }
 
+std::vector<Eigen::Index> mitk::CreateDistanceImageFromSurfaceFilter::MatchPreviousCenters() const
+{
+  std::vector<Eigen::Index> previousIndices(m_Centers.size(), -1);
+
+  std::map<std::array<double, 4>, Eigen::Index> previousCenters;
+  for (std::size_t i = 0; i < m_PreviousCenters.size(); ++i)
+  {
+    const PointType &center = m_PreviousCenters[i];
+    if (!previousCenters.insert({{{center[0], center[1], center[2], m_PreviousFunctionValues[i]}}, static_cast<Eigen::Index>(i)}).second)
+      return previousIndices;
+  }
+
+  std::vector<bool> matched(m_PreviousCenters.size(), false);
+  for (std::size_t i = 0; i < m_Centers.size(); ++i)
+  {
+    const PointType &center = m_Centers[i];
+    auto previousCenter = previousCenters.find({{center[0], center[1], center[2], m_FunctionValues[i]}});
+    if (previousCenter != previousCenters.end() && !matched[previousCenter->second])
+    {
+      matched[previousCenter->second] = true;
+      previousIndices[i] = previousCenter->second;
+    }
+  }
+  return previousIndices;
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::SolveDirectly()
+{
+  const auto numberOfCenters = static_cast<Eigen::Index>(m_Centers.size());
+
+  if (m_IncrementalSolving && m_HasFactorization)
+  {
+    // order contains the current indices of all previous centers in factorization order followed by the new ones
+    const auto numberOfPreviousCenters = static_cast<Eigen::Index>(m_PreviousCenters.size());
+    const std::vector<Eigen::Index> previousIndices = this->MatchPreviousCenters();
+
+    std::vector<Eigen::Index> order(numberOfPreviousCenters, -1);
+    Eigen::Index numberOfMatches = 0;
+    for (Eigen::Index i = 0; i < numberOfCenters; ++i)
+    {
+      if (previousIndices[i] >= 0)
+      {
+        order[previousIndices[i]] = i;
+        ++numberOfMatches;
+      }
+    }
+
+    // The factorization can only be extended if no previous center is gone. Extending it by more centers than it
+    // already contains is hardly cheaper than starting over.
+    const Eigen::Index numberOfNewCenters = numberOfCenters - numberOfMatches;
+    const std::size_t maximumNumberOfLevels = 32;
+    if (numberOfMatches == numberOfPreviousCenters && numberOfNewCenters <= numberOfPreviousCenters &&
+        m_FactorizationLevels.size() < maximumNumberOfLevels)
+    {
+      for (Eigen::Index i = 0; i < numberOfCenters; ++i)
+      {
+        if (previousIndices[i] < 0)
+          order.push_back(i);
+      }
+
+      m_NumberOfReusedCenters = numberOfMatches;
+
+      if (numberOfNewCenters == 0)
+      {
+        // Same system as before
+        for (Eigen::Index i = 0; i < numberOfCenters; ++i)
+          m_Weights[order[i]] = m_PreviousWeights[i];
+      }
+      else
+      {
+        this->ExtendFactorization(order, numberOfPreviousCenters);
+      }
+      return;
+    }
+  }
+
+  if (m_SolutionMatrix.rows() != numberOfCenters)
+    this->AssembleSolutionMatrix();
+
+  if (!m_IncrementalSolving)
+  {
+    m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+    m_HasFactorization = false;
+    return;
+  }
+
+  m_BaseFactorization.compute(m_SolutionMatrix);
+  m_Weights = m_BaseFactorization.solve(m_FunctionValues);
+  m_FactorizationLevels.clear();
+  m_HasFactorization = true;
+
+  // The factorization replaces the solution matrix
+  m_SolutionMatrix.resize(0, 0);
+
+  std::vector<Eigen::Index> order(numberOfCenters);
+  for (Eigen::Index i = 0; i < numberOfCenters; ++i)
+    order[i] = i;
+  this->StorePreviousSolution(order);
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::ExtendFactorization(const std::vector<Eigen::Index> &order,
+                                                                     Eigen::Index numberOfPreviousCenters)
+{
+  const auto numberOfCenters = static_cast<Eigen::Index>(order.size());
+  const Eigen::Index numberOfNewCenters = numberOfCenters - numberOfPreviousCenters;
+
+  // The extended system is [A B; B^T C] with A being the previous system
+  Eigen::MatrixXd coupling(numberOfPreviousCenters, numberOfNewCenters);
+  Eigen::MatrixXd newBlock(numberOfNewCenters, numberOfNewCenters);
+
+  for (Eigen::Index j = 0; j < numberOfNewCenters; ++j)
+  {
+    const PointType &newCenter = m_Centers[order[numberOfPreviousCenters + j]];
+    for (Eigen::Index i = 0; i < numberOfPreviousCenters; ++i)
+      coupling(i, j) = (m_Centers[order[i]] - newCenter).two_norm();
+    for (Eigen::Index i = 0; i < numberOfNewCenters; ++i)
+      newBlock(i, j) = (m_Centers[order[numberOfPreviousCenters + i]] - newCenter).two_norm();
+  }
+
+  // X = A^-1 B and the Schur complement S = C - B^T X
+  FactorizationLevel level;
+  level.Coupling = this->SolveFactorized(coupling, m_FactorizationLevels.size());
+  level.SchurComplement.compute(newBlock - coupling.transpose() * level.Coupling);
+  m_FactorizationLevels.push_back(level);
+
+  Eigen::VectorXd functionValues(numberOfCenters);
+  for (Eigen::Index i = 0; i < numberOfCenters; ++i)
+    functionValues[i] = m_FunctionValues[order[i]];
+
+  const Eigen::VectorXd weights = this->SolveFactorized(functionValues, m_FactorizationLevels.size());
+  for (Eigen::Index i = 0; i < numberOfCenters; ++i)
+    m_Weights[order[i]] = weights[i];
+
+  this->StorePreviousSolution(order);
+}
+
+Eigen::MatrixXd mitk::CreateDistanceImageFromSurfaceFilter::SolveFactorized(const Eigen::MatrixXd &rhs,
+                                                                            std::size_t numberOfLevels) const
+{
+  if (numberOfLevels == 0)
+    return m_BaseFactorization.solve(rhs);
+
+  // Block elimination with A^-1 [r1; r2] = [z - X w2; w2], z = A^-1 r1 and w2 = S^-1 (r2 - X^T r1)
+  const FactorizationLevel &level = m_FactorizationLevels[numberOfLevels - 1];
+  const Eigen::Index numberOfPreviousCenters = level.Coupling.rows();
+  const Eigen::Index numberOfNewCenters = level.Coupling.cols();
+
+  Eigen::MatrixXd result(rhs.rows(), rhs.cols());
+  result.bottomRows(numberOfNewCenters) = level.SchurComplement.solve(
+    rhs.bottomRows(numberOfNewCenters) - level.Coupling.transpose() * rhs.topRows(numberOfPreviousCenters));
+  result.topRows(numberOfPreviousCenters) =
+    this->SolveFactorized(rhs.topRows(numberOfPreviousCenters), numberOfLevels - 1) -
+    level.Coupling * result.bottomRows(numberOfNewCenters);
+  return result;
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::StorePreviousSolution(const std::vector<Eigen::Index> &order)
+{
+  const auto numberOfCenters = static_cast<Eigen::Index>(order.size());
+
+  m_PreviousCenters.resize(numberOfCenters);
+  m_PreviousFunctionValues.resize(numberOfCenters);
+  m_PreviousWeights.resize(numberOfCenters);
+
+  for (Eigen::Index i = 0; i < numberOfCenters; ++i)
+  {
+    m_PreviousCenters[i] = m_Centers[order[i]];
+    m_PreviousFunctionValues[i] = m_FunctionValues[order[i]];
+    m_PreviousWeights[i] = m_Weights[order[i]];
+  }
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::SolveIteratively()
+{
+  // Restarted GMRES (without preconditioning) on the linear system A * w = f. A is symmetric but indefinite, so
+  // conjugate gradients can not be used.
+  const unsigned int restart = 100;
+  const unsigned int maximumNumberOfIterations = 1000;
+
+  const Eigen::Index n = m_FunctionValues.size();
+  const double normOfFunctionValues = m_FunctionValues.norm();
+
+  m_Weights.setZero(n);
+
+  // Start from the previous solution for all centers that did not change
+  if (m_IncrementalSolving && !m_PreviousCenters.empty())
+  {
+    const std::vector<Eigen::Index> previousIndices = this->MatchPreviousCenters();
+    for (Eigen::Index i = 0; i < n; ++i)
+    {
+      if (previousIndices[i] >= 0)
+      {
+        m_Weights[i] = m_PreviousWeights[previousIndices[i]];
+        ++m_NumberOfReusedCenters;
+      }
+    }
+  }
+
+  if (normOfFunctionValues == 0.0)
+    return;
+
+  Eigen::VectorXd product(n);
+  Eigen::MatrixXd basis(n, restart + 1);
+  Eigen::MatrixXd hessenberg(restart + 1, restart);
+  Eigen::VectorXd cosines(restart);
+  Eigen::VectorXd sines(restart);
+  Eigen::VectorXd residualNorms(restart + 1);
+
+  unsigned int iteration = 0;
+  double relativeResidual = 1.0;
+
+  while (iteration < maximumNumberOfIterations)
+  {
+    m_Treecode.Multiply(m_Weights, product);
+    Eigen::VectorXd residual = m_FunctionValues - product;
+    const double beta = residual.norm();
+    relativeResidual = beta / normOfFunctionValues;
+
+    if (relativeResidual < m_IterativeSolverTolerance)
+      break;
+
+    hessenberg.setZero();
+    residualNorms.setZero();
+    basis.col(0) = residual / beta;
+    residualNorms[0] = beta;
+
+    unsigned int k = 0;
+    while (k < restart && iteration < maximumNumberOfIterations)
+    {
+      const Eigen::VectorXd direction = basis.col(k);
+      m_Treecode.Multiply(direction, product);
+
+      // Modified Gram-Schmidt
+      for (unsigned int j = 0; j <= k; ++j)
+      {
+        hessenberg(j, k) = basis.col(j).dot(product);
+        product -= hessenberg(j, k) * basis.col(j);
+      }
+      hessenberg(k + 1, k) = product.norm();
+      if (hessenberg(k + 1, k) > 0.0)
+        basis.col(k + 1) = product / hessenberg(k + 1, k);
+
+      // Apply the previous Givens rotations to the new column and compute the next one
+      for (unsigned int j = 0; j < k; ++j)
+      {
+        const double value = cosines[j] * hessenberg(j, k) + sines[j] * hessenberg(j + 1, k);
+        hessenberg(j + 1, k) = -sines[j] * hessenberg(j, k) + cosines[j] * hessenberg(j + 1, k);
+        hessenberg(j, k) = value;
+      }
+
+      const double denominator = std::hypot(hessenberg(k, k), hessenberg(k + 1, k));
+      cosines[k] = hessenberg(k, k) / denominator;
+      sines[k] = hessenberg(k + 1, k) / denominator;
+      hessenberg(k, k) = denominator;
+      hessenberg(k + 1, k) = 0.0;
+
+      residualNorms[k + 1] = -sines[k] * residualNorms[k];
+      residualNorms[k] = cosines[k] * residualNorms[k];
+
+      ++k;
+      ++iteration;
+
+      relativeResidual = std::abs(residualNorms[k]) / normOfFunctionValues;
+      if (relativeResidual < m_IterativeSolverTolerance)
+        break;
+    }
+
+    const Eigen::VectorXd y =
+      hessenberg.topLeftCorner(k, k).triangularView<Eigen::Upper>().solve(residualNorms.head(k));
+    m_Weights += basis.leftCols(k) * y;
+
+    if (relativeResidual < m_IterativeSolverTolerance)
+      break;
+  }
+
+  m_NumberOfSolverIterations = iteration;
+
+  if (relativeResidual >= m_IterativeSolverTolerance)
+  {
+    MITK_WARN << "mitk::CreateDistanceImageFromSurfaceFilter: Iterative solver did not converge after " << iteration
+              << " iterations (relative residual " << relativeResidual << ")";
+  }
+
+  // Prepare the treecode for the evaluation of the distance function
+  m_Treecode.SetWeights(m_Weights);
+
+  // A previous factorization does not describe the current system anymore
+  m_HasFactorization = false;
+  m_FactorizationLevels.clear();
+
+  if (m_IncrementalSolving)
+  {
+    std::vector<Eigen::Index> order(n);
+    for (Eigen::Index i = 0; i < n; ++i)
+      order[i] = i;
+    this->StorePreviousSolution(order);
+  }
+}
+
 double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
 {
+  if (m_UseIterativeSolver)
+    return m_Treecode.Evaluate(p);
+
   double distanceValue(0);
   PointType p1;
   PointType p2;
@@ -446,6 +794,13 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateOutputInformation()
 
 void mitk::CreateDistanceImageFromSurfaceFilter::PrintEquationSystem()
 {
+  if (m_SolutionMatrix.size() == 0)
+  {
+    std::cout << "Equation system of " << m_Centers.size()
+              << " centers was not assembled, it is either solved iteratively or incrementally." << std::endl;
+    return;
+  }
+
   std::stringstream out;
   out << "Nummber of rows: " << m_SolutionMatrix.rows() << " ****** Number of columns: " << m_SolutionMatrix.cols()
       << endl;
@@ -17,6 +17,7 @@ found in the LICENSE file.
 
 #include "mitkImageSource.h"
 #include "mitkProgressBar.h"
+#include "mitkRadialBasisFunctionTreecode.h"
 #include "mitkSurface.h"
 
 #include "vnl/vnl_vector_fixed.h"
@@ -52,6 +53,19 @@ namespace mitk
          with the marching cubes algorithm. (Within the  distance image the surface goes exactly where the pixelvalues
   are zero)
 
+         The interpolation system is solved directly as long as it contains at most
+         MaximumNumberOfCentersForDirectSolver centers (the dense solution matrix grows quadratically and its
+         factorization cubically with the number of centers). Larger systems are solved with a restarted GMRES whose
+         matrix vector products, as well as the evaluation of the distance function, are approximated by a
+         RadialBasisFunctionTreecode. The resulting distance function deviates from the exact one by a small fraction
+         of the distance image spacing which is controlled by TreecodeOpeningAngle and IterativeSolverTolerance.
+
+         If IncrementalSolving is enabled (default) the filter remembers the last interpolation system. When the new
+         system only adds centers to it, e.g. because a contour was added within the bounds of the existing ones, the
+         existing factorization is extended by a block for the new centers via their Schur complement instead of
+         factorizing the whole system again. This costs O(N^2 * K) instead of O(N^3) for K new centers. The iterative
+         solver starts from the weights of the previous solution for all centers that did not change.
+
          Note that the obtained distance image has always an isotropig spacing. The size (in this case volume) of the
   image can be
          adjusted by calling SetDistanceImageVolume(unsigned int volume) which specifies the number ob pixels enclosed
@@ -99,6 +113,44 @@ namespace mitk
     */
     itkSetMacro(DistanceImageVolume, unsigned int);
 
+    /**
+    \brief Set the maximum number of centers (three per contour point) for which the interpolation system is
+           solved directly. Larger systems are solved iteratively. Default is 3000.
+    */
+    itkSetMacro(MaximumNumberOfCentersForDirectSolver, unsigned int);
+    itkGetMacro(MaximumNumberOfCentersForDirectSolver, unsigned int);
+
+    /**
+    \brief Set the opening angle of the treecode used by the iterative solver. Smaller values are more accurate
+           but slower. Default is 0.3.
+    */
+    itkSetMacro(TreecodeOpeningAngle, double);
+    itkGetMacro(TreecodeOpeningAngle, double);
+
+    /**
+    \brief Set the relative residual at which the iterative solver stops. Default is 1e-4.
+    */
+    itkSetMacro(IterativeSolverTolerance, double);
+    itkGetMacro(IterativeSolverTolerance, double);
+
+    /**
+    \brief Returns the number of iterations of the last iterative solve or 0 if the system was solved directly.
+    */
+    itkGetMacro(NumberOfSolverIterations, unsigned int);
+
+    /**
+    \brief Set whether the previous solution is reused if the interpolation system only changed partially.
+           Default is true.
+    */
+    itkSetMacro(IncrementalSolving, bool);
+    itkGetMacro(IncrementalSolving, bool);
+    itkBooleanMacro(IncrementalSolving);
+
+    /**
+    \brief Returns the number of centers of the last solve that were taken over from the previous one.
+    */
+    itkGetMacro(NumberOfReusedCenters, unsigned int);
+
     void PrintEquationSystem();
 
     // Resets the filter, i.e. removes all inputs and outputs
@@ -128,6 +180,27 @@ namespace mitk
 
   private:
     void CreateSolutionMatrixAndFunctionValues();
+    void AssembleSolutionMatrix();
+    void SolveDirectly();
+    void SolveIteratively();
+
+    /**
+    * \brief Returns for each current center the index of the equal center (same position and function value) of the
+    * previous solve or -1 if there is none.
+    */
+    std::vector<Eigen::Index> MatchPreviousCenters() const;
+
+    /**
+    * \brief Adds the centers that are not part of the previous factorization as a new block and solves the
+    * extended system. order contains the indices of the previous centers in factorization order followed by the
+    * new ones.
+    */
+    void ExtendFactorization(const std::vector<Eigen::Index> &order, Eigen::Index numberOfPreviousCenters);
+
+    /** \brief Solves the system of the first numberOfLevels blocks of the factorization for the given right hand sides */
+    Eigen::MatrixXd SolveFactorized(const Eigen::MatrixXd &rhs, std::size_t numberOfLevels) const;
+
+    void StorePreviousSolution(const std::vector<Eigen::Index> &order);
     double CalculateDistanceValue(PointType p);
 
     void FillDistanceImage();
@@ -162,6 +235,29 @@ namespace mitk
     Eigen::VectorXd m_FunctionValues;
     Eigen::VectorXd m_Weights;
 
+    RadialBasisFunctionTreecode m_Treecode;
+    bool m_UseIterativeSolver;
+    unsigned int m_MaximumNumberOfCentersForDirectSolver;
+    double m_TreecodeOpeningAngle;
+    double m_IterativeSolverTolerance;
+    unsigned int m_NumberOfSolverIterations;
+
+    /** A block of new centers that was added to an existing factorization */
+    struct FactorizationLevel
+    {
+      Eigen::MatrixXd Coupling; // inverse of the previous system times the coupling block
+      Eigen::PartialPivLU<Eigen::MatrixXd> SchurComplement;
+    };
+
+    bool m_IncrementalSolving;
+    unsigned int m_NumberOfReusedCenters;
+    bool m_HasFactorization;
+    Eigen::PartialPivLU<Eigen::MatrixXd> m_BaseFactorization;
+    std::vector<FactorizationLevel> m_FactorizationLevels;
+    CenterList m_PreviousCenters;
+    Eigen::VectorXd m_PreviousFunctionValues;
+    Eigen::VectorXd m_PreviousWeights;
+
     DistanceImageType::Pointer m_DistanceImageITK;
     itk::ImageBase<3>::Pointer m_ReferenceImage;
 
@@ -0,0 +1,215 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkRadialBasisFunctionTreecode.h"
+
+#include <algorithm>
+#include <array>
+#include <thread>
+
+mitk::RadialBasisFunctionTreecode::RadialBasisFunctionTreecode()
+  : m_OpeningAngle(0.3), m_MaximumLeafSize(64), m_NumberOfThreads(0)
+{
+}
+
+void mitk::RadialBasisFunctionTreecode::Build(const PointList &centers)
+{
+  m_Centers.resize(centers.size());
+  m_Order.resize(centers.size());
+  for (std::size_t i = 0; i < centers.size(); ++i)
+  {
+    m_Centers[i] = Eigen::Vector3d(centers[i][0], centers[i][1], centers[i][2]);
+    m_Order[i] = static_cast<unsigned int>(i);
+  }
+
+  m_SortedWeights.assign(centers.size(), 0.0);
+  m_Nodes.clear();
+
+  if (centers.empty())
+    return;
+
+  m_Nodes.reserve(4 * centers.size() / std::max(1u, m_MaximumLeafSize) + 1);
+  m_Nodes.emplace_back();
+  this->BuildNode(0, 0, static_cast<unsigned int>(centers.size()));
+}
+
+void mitk::RadialBasisFunctionTreecode::BuildNode(unsigned int nodeId, unsigned int begin, unsigned int end)
+{
+  Eigen::Vector3d minimum = m_Centers[m_Order[begin]];
+  Eigen::Vector3d maximum = minimum;
+  for (unsigned int i = begin + 1; i < end; ++i)
+  {
+    minimum = minimum.cwiseMin(m_Centers[m_Order[i]]);
+    maximum = maximum.cwiseMax(m_Centers[m_Order[i]]);
+  }
+
+  const Eigen::Vector3d center = 0.5 * (minimum + maximum);
+  double radius = 0.0;
+  for (unsigned int i = begin; i < end; ++i)
+    radius = std::max(radius, (m_Centers[m_Order[i]] - center).norm());
+
+  Node &node = m_Nodes[nodeId];
+  node.Center = center;
+  node.Radius = radius;
+  node.Begin = begin;
+  node.End = end;
+  node.FirstChild = 0;
+  node.NumberOfChildren = 0;
+
+  if (end - begin <= m_MaximumLeafSize || radius == 0.0)
+    return;
+
+  // Sort the centers of this cell by octant and create all children first, so that they are stored contiguously
+  auto octant = [this, &center](unsigned int index) {
+    const Eigen::Vector3d &p = m_Centers[index];
+    return (p[0] > center[0] ? 1 : 0) | (p[1] > center[1] ? 2 : 0) | (p[2] > center[2] ? 4 : 0);
+  };
+
+  std::stable_sort(m_Order.begin() + begin, m_Order.begin() + end, [&octant](unsigned int a, unsigned int b) {
+    return octant(a) < octant(b);
+  });
+
+  std::array<std::pair<unsigned int, unsigned int>, 8> ranges;
+  unsigned int numberOfChildren = 0;
+  for (unsigned int childBegin = begin; childBegin < end;)
+  {
+    const int currentOctant = octant(m_Order[childBegin]);
+    unsigned int childEnd = childBegin + 1;
+    while (childEnd < end && octant(m_Order[childEnd]) == currentOctant)
+      ++childEnd;
+
+    ranges[numberOfChildren++] = std::make_pair(childBegin, childEnd);
+    childBegin = childEnd;
+  }
+
+  const auto firstChild = static_cast<unsigned int>(m_Nodes.size());
+  m_Nodes[nodeId].FirstChild = firstChild;
+  m_Nodes[nodeId].NumberOfChildren = numberOfChildren;
+  m_Nodes.resize(m_Nodes.size() + numberOfChildren);
+
+  for (unsigned int i = 0; i < numberOfChildren; ++i)
+    this->BuildNode(firstChild + i, ranges[i].first, ranges[i].second);
+}
+
+void mitk::RadialBasisFunctionTreecode::SetWeights(const Eigen::VectorXd &weights)
+{
+  for (std::size_t i = 0; i < m_Order.size(); ++i)
+    m_SortedWeights[i] = weights[m_Order[i]];
+
+  for (auto &node : m_Nodes)
+  {
+    node.Moment0 = 0.0;
+    node.Moment1.setZero();
+    node.Moment2.setZero();
+    node.Moment3Trace.setZero();
+    std::fill(node.Moment3, node.Moment3 + 10, 0.0);
+
+    for (unsigned int i = node.Begin; i < node.End; ++i)
+    {
+      const Eigen::Vector3d d = m_Centers[m_Order[i]] - node.Center;
+      const double w = m_SortedWeights[i];
+
+      node.Moment0 += w;
+      node.Moment1 += w * d;
+      node.Moment2 += w * d * d.transpose();
+      node.Moment3Trace += w * d.squaredNorm() * d;
+
+      node.Moment3[0] += w * d[0] * d[0] * d[0];
+      node.Moment3[1] += w * d[0] * d[0] * d[1];
+      node.Moment3[2] += w * d[0] * d[0] * d[2];
+      node.Moment3[3] += w * d[0] * d[1] * d[1];
+      node.Moment3[4] += w * d[0] * d[1] * d[2];
+      node.Moment3[5] += w * d[0] * d[2] * d[2];
+      node.Moment3[6] += w * d[1] * d[1] * d[1];
+      node.Moment3[7] += w * d[1] * d[1] * d[2];
+      node.Moment3[8] += w * d[1] * d[2] * d[2];
+      node.Moment3[9] += w * d[2] * d[2] * d[2];
+    }
+  }
+}
+
+double mitk::RadialBasisFunctionTreecode::Evaluate(const PointType &point) const
+{
+  if (m_Nodes.empty())
+    return 0.0;
+
+  return this->EvaluateNode(0, Eigen::Vector3d(point[0], point[1], point[2]));
+}
+
+double mitk::RadialBasisFunctionTreecode::EvaluateNode(unsigned int nodeId, const Eigen::Vector3d &point) const
+{
+  const Node &node = m_Nodes[nodeId];
+  const Eigen::Vector3d r = point - node.Center;
+  const double distance = r.norm();
+
+  if (node.Radius < m_OpeningAngle * distance)
+  {
+    // Taylor expansion of |r - d| around r up to the third order
+    const Eigen::Vector3d u = r / distance;
+    const double *t = node.Moment3;
+    const double uuu = t[0] * u[0] * u[0] * u[0] + 3 * t[1] * u[0] * u[0] * u[1] + 3 * t[2] * u[0] * u[0] * u[2] +
+                       3 * t[3] * u[0] * u[1] * u[1] + 6 * t[4] * u[0] * u[1] * u[2] + 3 * t[5] * u[0] * u[2] * u[2] +
+                       t[6] * u[1] * u[1] * u[1] + 3 * t[7] * u[1] * u[1] * u[2] + 3 * t[8] * u[1] * u[2] * u[2] +
+                       t[9] * u[2] * u[2] * u[2];
+
+    return distance * node.Moment0 - u.dot(node.Moment1) +
+           (node.Moment2.trace() - u.dot(node.Moment2 * u)) / (2 * distance) +
+           (u.dot(node.Moment3Trace) - uuu) / (2 * distance * distance);
+  }
+
+  double value = 0.0;
+  if (node.NumberOfChildren == 0)
+  {
+    for (unsigned int i = node.Begin; i < node.End; ++i)
+      value += m_SortedWeights[i] * (point - m_Centers[m_Order[i]]).norm();
+  }
+  else
+  {
+    for (unsigned int i = 0; i < node.NumberOfChildren; ++i)
+      value += this->EvaluateNode(node.FirstChild + i, point);
+  }
+  return value;
+}
+
+void mitk::RadialBasisFunctionTreecode::Multiply(const Eigen::VectorXd &weights, Eigen::VectorXd &result)
+{
+  this->SetWeights(weights);
+
+  const auto numberOfCenters = static_cast<unsigned int>(m_Centers.size());
+  result.resize(numberOfCenters);
+
+  unsigned int numberOfThreads = m_NumberOfThreads > 0 ? m_NumberOfThreads : std::thread::hardware_concurrency();
+  numberOfThreads = std::max(1u, std::min(numberOfThreads, numberOfCenters / 256 + 1));
+
+  auto evaluateRange = [this, &result](unsigned int begin, unsigned int end) {
+    for (unsigned int i = begin; i < end; ++i)
+      result[i] = this->EvaluateNode(0, m_Centers[i]);
+  };
+
+  if (numberOfThreads == 1)
+  {
+    evaluateRange(0, numberOfCenters);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(numberOfThreads);
+  for (unsigned int thread = 0; thread < numberOfThreads; ++thread)
+  {
+    threads.emplace_back(evaluateRange,
+                         thread * numberOfCenters / numberOfThreads,
+                         (thread + 1) * numberOfCenters / numberOfThreads);
+  }
+
+  for (auto &thread : threads)
+    thread.join();
+}
@@ -0,0 +1,105 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkRadialBasisFunctionTreecode_h_Included
+#define mitkRadialBasisFunctionTreecode_h_Included
+
+#include <MitkSurfaceInterpolationExports.h>
+
+#include "vnl/vnl_vector_fixed.h"
+
+#include <Eigen/Dense>
+
+#include <vector>
+
+namespace mitk
+{
+  /**
+  \brief Fast approximate evaluation of the radial basis function sum f(x) = sum_j w_j * |x - c_j|.
+
+         The centers c_j are sorted into an octree. The contribution of an octree cell whose radius is small
+         compared to its distance to x is approximated by a third order Taylor expansion of |x - c_j| around the
+         center of the cell, all other cells are descended until the leaves are summed up directly.
+         The ratio between cell radius and distance (the opening angle) controls the accuracy.
+
+         Evaluating the sum for N points costs O(N log N) instead of O(N^2) which makes it possible to solve
+         large interpolation systems with an iterative solver (see CreateDistanceImageFromSurfaceFilter).
+
+         Build() has to be called once for the centers and SetWeights() whenever the weights change. After that,
+         Evaluate() and Multiply() may be called concurrently.
+
+  \ingroup Process
+  */
+  class MITKSURFACEINTERPOLATION_EXPORT RadialBasisFunctionTreecode
+  {
+  public:
+    typedef vnl_vector_fixed<double, 3> PointType;
+    typedef std::vector<PointType> PointList;
+
+    RadialBasisFunctionTreecode();
+
+    void SetOpeningAngle(double openingAngle) { m_OpeningAngle = openingAngle; }
+    double GetOpeningAngle() const { return m_OpeningAngle; }
+
+    void SetMaximumLeafSize(unsigned int leafSize) { m_MaximumLeafSize = leafSize; }
+    unsigned int GetMaximumLeafSize() const { return m_MaximumLeafSize; }
+
+    /** \brief Number of threads used by Multiply(). 0 (default) uses the number of hardware threads. */
+    void SetNumberOfThreads(unsigned int numberOfThreads) { m_NumberOfThreads = numberOfThreads; }
+
+    /** \brief Builds the octree for the given centers. */
+    void Build(const PointList &centers);
+
+    /** \brief Sets the weights (one per center, in the order of the centers passed to Build()) and updates the
+               expansions of all cells. */
+    void SetWeights(const Eigen::VectorXd &weights);
+
+    double Evaluate(const PointType &point) const;
+
+    /** \brief Evaluates the sum at all centers, i.e. approximates result = A * weights with A_ij = |c_i - c_j|. */
+    void Multiply(const Eigen::VectorXd &weights, Eigen::VectorXd &result);
+
+    std::size_t GetNumberOfCenters() const { return m_Centers.size(); }
+
+  private:
+    struct Node
+    {
+      Eigen::Vector3d Center;
+      double Radius;
+      unsigned int Begin;
+      unsigned int End;
+      unsigned int FirstChild;
+      unsigned int NumberOfChildren;
+
+      // Moments of the weights around Center: sum w, sum w*d, sum w*d*d^T, sum w*|d|^2*d, sum w*d(x)d(x)d
+      double Moment0;
+      Eigen::Vector3d Moment1;
+      Eigen::Matrix3d Moment2;
+      Eigen::Vector3d Moment3Trace;
+      double Moment3[10];
+    };
+
+    void BuildNode(unsigned int nodeId, unsigned int begin, unsigned int end);
+    double EvaluateNode(unsigned int nodeId, const Eigen::Vector3d &point) const;
+
+    std::vector<Eigen::Vector3d> m_Centers;
+    std::vector<unsigned int> m_Order;
+    std::vector<double> m_SortedWeights;
+    std::vector<Node> m_Nodes;
+
+    double m_OpeningAngle;
+    unsigned int m_MaximumLeafSize;
+    unsigned int m_NumberOfThreads;
+  };
+} // namespace
+
+#endif
@@ -48,77 +48,88 @@ void mitk::ReduceContourSetFilter::GenerateData()
   unsigned int numberOfInputs = this->GetNumberOfIndexedInputs();
   unsigned int numberOfOutputs(0);
 
-  vtkSmartPointer<vtkPolyData> newPolyData;
-  vtkSmartPointer<vtkCellArray> newPolygons;
-  vtkSmartPointer<vtkPoints> newPoints;
-
   // For the purpose of evaluation
   //  unsigned int numberOfPointsBefore (0);
   m_NumberOfPointsAfterReduction = 0;
 
+  // Set the tolerance if none is specified. This is done before any reduction since it is part of the cache key
+  if (m_ReductionType == DOUGLAS_PEUCKER && m_Tolerance < 0)
+  {
+    if (m_MaxSpacing > 0)
+    {
+      m_Tolerance = m_MinSpacing;
+    }
+    else
+    {
+      m_Tolerance = 1.5;
+    }
+  }
+
+  // The planes of all inputs are needed to detect intersection contours
+  m_ContourPlanes.clear();
+  for (unsigned int i = 0; i < numberOfInputs; i++)
+  {
+    m_ContourPlanes.push_back(this->ComputeContourPlane(this->GetInput(i)->GetVtkPolyData()));
+  }
+
+  std::map<mitk::Surface::ConstPointer, ReducedContour> reducedContours;
+
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
     auto *currentSurface = this->GetInput(i);
     vtkSmartPointer<vtkPolyData> polyData = currentSurface->GetVtkPolyData();
 
-    newPolyData = vtkSmartPointer<vtkPolyData>::New();
-    newPolygons = vtkSmartPointer<vtkCellArray>::New();
-    newPoints = vtkSmartPointer<vtkPoints>::New();
-
     vtkSmartPointer<vtkCellArray> existingPolys = polyData->GetPolys();
 
     vtkSmartPointer<vtkPoints> existingPoints = polyData->GetPoints();
 
-    existingPolys->InitTraversal();
-
     const vtkIdType *cell(nullptr);
     vtkIdType cellSize(0);
 
+    ReducedContour reducedContour;
+    reducedContour.InputTime = polyData->GetMTime();
+    reducedContour.ReductionType = m_ReductionType;
+    reducedContour.StepSize = m_StepSize;
+    reducedContour.Tolerance = m_Tolerance;
+    reducedContour.NumberOfPoints = 0;
+
     for (existingPolys->InitTraversal(); existingPolys->GetNextCell(cellSize, cell);)
     {
-      bool incorporatePolygon =
-        this->CheckForIntersection(cell, cellSize, existingPoints, /*numberOfIntersections, intersectionPoints, */ i);
-      if (!incorporatePolygon)
-        continue;
-
-      vtkSmartPointer<vtkPolygon> newPolygon = vtkSmartPointer<vtkPolygon>::New();
-
-      if (m_ReductionType == NTH_POINT)
-      {
-        this->ReduceNumberOfPointsByNthPoint(cellSize, cell, existingPoints, newPolygon, newPoints);
-        if (newPolygon->GetPointIds()->GetNumberOfIds() != 0)
-        {
-          newPolygons->InsertNextCell(newPolygon);
-        }
-      }
-      else if (m_ReductionType == DOUGLAS_PEUCKER)
-      {
-        this->ReduceNumberOfPointsByDouglasPeucker(cellSize, cell, existingPoints, newPolygon, newPoints);
-        if (newPolygon->GetPointIds()->GetNumberOfIds() > 3)
-        {
-          newPolygons->InsertNextCell(newPolygon);
-        }
-      }
-
-      // Again for evaluation
-      //      numberOfPointsBefore += cellSize;
-      m_NumberOfPointsAfterReduction += newPolygon->GetPointIds()->GetNumberOfIds();
+      reducedContour.IncorporatedPolygons.push_back(
+        this->CheckForIntersection(cell, cellSize, existingPoints, /*numberOfIntersections, intersectionPoints, */ i));
     }
 
-    if (newPolygons->GetNumberOfCells() != 0)
+    // Reuse the reduction of the previous run if nothing changed for this input
+    auto cachedContour = m_ReducedContourCache.find(currentSurface);
+    if (cachedContour != m_ReducedContourCache.end() && cachedContour->second.InputTime == reducedContour.InputTime &&
+        cachedContour->second.IncorporatedPolygons == reducedContour.IncorporatedPolygons &&
+        cachedContour->second.ReductionType == reducedContour.ReductionType &&
+        cachedContour->second.StepSize == reducedContour.StepSize &&
+        cachedContour->second.Tolerance == reducedContour.Tolerance)
     {
-      newPolyData->SetPolys(newPolygons);
-      newPolyData->SetPoints(newPoints);
-      newPolyData->BuildLinks();
+      reducedContour = cachedContour->second;
+    }
+    else
+    {
+      reducedContour.Output = this->ReduceContour(polyData, reducedContour.IncorporatedPolygons,
+                                                  reducedContour.NumberOfPoints);
+    }
+
+    m_NumberOfPointsAfterReduction += reducedContour.NumberOfPoints;
 
+    if (reducedContour.Output.IsNotNull())
+    {
       this->SetNumberOfIndexedOutputs(numberOfOutputs + 1);
-      mitk::Surface::Pointer surface = mitk::Surface::New();
-      this->SetNthOutput(numberOfOutputs, surface.GetPointer());
-      surface->SetVtkPolyData(newPolyData);
+      this->SetNthOutput(numberOfOutputs, reducedContour.Output.GetPointer());
       numberOfOutputs++;
     }
+
+    reducedContours[currentSurface] = reducedContour;
   }
 
+  // Only keep the reductions of the current inputs
+  m_ReducedContourCache.swap(reducedContours);
+
   //  MITK_INFO<<"Points before: "<<numberOfPointsBefore<<" ##### Points after: "<<numberOfPointsAfter;
   this->SetNumberOfIndexedOutputs(numberOfOutputs);
 
@@ -133,6 +144,64 @@ void mitk::ReduceContourSetFilter::GenerateData()
     mitk::ProgressBar::GetInstance()->Progress(this->m_ProgressStepSize);
 }
 
+mitk::Surface::Pointer mitk::ReduceContourSetFilter::ReduceContour(vtkPolyData *polyData,
+                                                                   const std::vector<bool> &incorporatedPolygons,
+                                                                   unsigned int &numberOfPoints)
+{
+  vtkSmartPointer<vtkPolyData> newPolyData = vtkSmartPointer<vtkPolyData>::New();
+  vtkSmartPointer<vtkCellArray> newPolygons = vtkSmartPointer<vtkCellArray>::New();
+  vtkSmartPointer<vtkPoints> newPoints = vtkSmartPointer<vtkPoints>::New();
+
+  vtkSmartPointer<vtkCellArray> existingPolys = polyData->GetPolys();
+  vtkSmartPointer<vtkPoints> existingPoints = polyData->GetPoints();
+
+  const vtkIdType *cell(nullptr);
+  vtkIdType cellSize(0);
+  unsigned int cellIndex(0);
+
+  numberOfPoints = 0;
+
+  for (existingPolys->InitTraversal(); existingPolys->GetNextCell(cellSize, cell); ++cellIndex)
+  {
+    if (!incorporatedPolygons[cellIndex])
+      continue;
+
+    vtkSmartPointer<vtkPolygon> newPolygon = vtkSmartPointer<vtkPolygon>::New();
+
+    if (m_ReductionType == NTH_POINT)
+    {
+      this->ReduceNumberOfPointsByNthPoint(cellSize, cell, existingPoints, newPolygon, newPoints);
+      if (newPolygon->GetPointIds()->GetNumberOfIds() != 0)
+      {
+        newPolygons->InsertNextCell(newPolygon);
+      }
+    }
+    else if (m_ReductionType == DOUGLAS_PEUCKER)
+    {
+      this->ReduceNumberOfPointsByDouglasPeucker(cellSize, cell, existingPoints, newPolygon, newPoints);
+      if (newPolygon->GetPointIds()->GetNumberOfIds() > 3)
+      {
+        newPolygons->InsertNextCell(newPolygon);
+      }
+    }
+
+    // Again for evaluation
+    //      numberOfPointsBefore += cellSize;
+    numberOfPoints += newPolygon->GetPointIds()->GetNumberOfIds();
+  }
+
+  if (newPolygons->GetNumberOfCells() == 0)
+    return nullptr;
+
+  newPolyData->SetPolys(newPolygons);
+  newPolyData->SetPoints(newPoints);
+  newPolyData->BuildLinks();
+
+  mitk::Surface::Pointer surface = mitk::Surface::New();
+  surface->SetVtkPolyData(newPolyData);
+  return surface;
+}
+
 void mitk::ReduceContourSetFilter::ReduceNumberOfPointsByNthPoint(
   vtkIdType cellSize, const vtkIdType *cell, vtkPoints *points, vtkPolygon *reducedPolygon, vtkPoints *reducedPoints)
 {
@@ -208,19 +277,6 @@ void mitk::ReduceContourSetFilter::ReduceNumberOfPointsByDouglasPeucker(
   reduced ones
   */
 
-  // First of all set tolerance if none is specified
-  if (m_Tolerance < 0)
-  {
-    if (m_MaxSpacing > 0)
-    {
-      m_Tolerance = m_MinSpacing;
-    }
-    else
-    {
-      m_Tolerance = 1.5;
-    }
-  }
-
   std::stack<LineSegment> lineSegments;
 
   // 1. Divide in line segments
@@ -368,123 +424,126 @@ bool mitk::ReduceContourSetFilter::CheckForIntersection(
   - That mean we can just reduce the current polygons points without considering any intersections
   */
 
-  for (unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); i++)
+  for (unsigned int i = 0; i < m_ContourPlanes.size(); i++)
   {
     // Don't check for intersection with the polygon itself
     if (i == currentInputIndex)
       continue;
 
-    // Get the next polydata to check for intersection
-    vtkSmartPointer<vtkPolyData> poly = this->GetInput(i)->GetVtkPolyData();
-    vtkSmartPointer<vtkCellArray> polygonArray = poly->GetPolys();
-    polygonArray->InitTraversal();
-    vtkIdType anotherInputPolygonSize(0);
-    const vtkIdType *anotherInputPolygonIDs(nullptr);
-
     /*
     The procedure is:
-    - Create the equation of the plane, defined by the points of next input
+    - Take the plane defined by the first polygon of the next input (see ComputeContourPlane)
     - Calculate the distance of each point of the current polygon to the plane
     - If the maximum distance is not bigger than 1.5 of the maximum spacing AND the minimal distance is not bigger
     than 0.5 of the minimum spacing then the current contour is an intersection contour
     */
+    const ContourPlane &plane = m_ContourPlanes[i];
+    if (!plane.Valid)
+      continue;
+
+    double maxDistance(0);
+    double minDistance(10000);
 
-    for (polygonArray->InitTraversal(); polygonArray->GetNextCell(anotherInputPolygonSize, anotherInputPolygonIDs);)
+    /*
+    Calculate the distance to the plane for each point of the current polygon
+    If the distance is zero then save the currentPoint as intersection point
+    */
+    for (vtkIdType k = 0; k < currentCellSize; k++)
     {
-      // Choosing three plane points to calculate the plane vectors
-      double p1[3];
-      double p2[3];
-      double p3[3];
+      double currentPoint[3];
+      currentPoints->GetPoint(currentCell[k], currentPoint);
 
-      // The plane vectors
-      double v1[3];
-      double v2[3] = {0};
-      // The plane normal
-      double normal[3];
+      double tempPoint[3];
+      tempPoint[0] = plane.Normal[0] * currentPoint[0];
+      tempPoint[1] = plane.Normal[1] * currentPoint[1];
+      tempPoint[2] = plane.Normal[2] * currentPoint[2];
 
-      // Create first Vector
-      poly->GetPoint(anotherInputPolygonIDs[0], p1);
-      poly->GetPoint(anotherInputPolygonIDs[1], p2);
+      double temp = tempPoint[0] + tempPoint[1] + tempPoint[2] - plane.Lambda;
+      double distance = fabs(temp);
 
-      v1[0] = p2[0] - p1[0];
-      v1[1] = p2[1] - p1[1];
-      v1[2] = p2[2] - p1[2];
+      if (distance > maxDistance)
+      {
+        maxDistance = distance;
+      }
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+      }
+    } // for (to calculate distance and intersections with currentPolygon)
 
-      // Find 3rd point for 2nd vector (The angle between the two plane vectors should be bigger than 30 degrees)
+    if (maxDistance < 1.5 * m_MaxSpacing && minDistance < 0.5 * m_MinSpacing)
+    {
+      return false;
+    }
+  } // for (to iterate through all inputs)
 
-      double maxDistance(0);
-      double minDistance(10000);
+  return true;
+}
 
-      for (vtkIdType j = 2; j < anotherInputPolygonSize; j++)
-      {
-        poly->GetPoint(anotherInputPolygonIDs[j], p3);
+mitk::ReduceContourSetFilter::ContourPlane mitk::ReduceContourSetFilter::ComputeContourPlane(vtkPolyData *poly)
+{
+  ContourPlane plane;
+  plane.Valid = false;
 
-        v2[0] = p3[0] - p1[0];
-        v2[1] = p3[1] - p1[1];
-        v2[2] = p3[2] - p1[2];
+  vtkSmartPointer<vtkCellArray> polygonArray = poly->GetPolys();
+  vtkIdType anotherInputPolygonSize(0);
+  const vtkIdType *anotherInputPolygonIDs(nullptr);
 
-        // Calculate the angle between the two vector for the current point
-        double dotV1V2 = vtkMath::Dot(v1, v2);
-        double absV1 = sqrt(vtkMath::Dot(v1, v1));
-        double absV2 = sqrt(vtkMath::Dot(v2, v2));
-        double cosV1V2 = dotV1V2 / (absV1 * absV2);
+  // Because we are considering the plane defined by the acual input polygon only the first cell is used
+  polygonArray->InitTraversal();
+  if (!polygonArray->GetNextCell(anotherInputPolygonSize, anotherInputPolygonIDs))
+    return plane;
 
-        double arccos = acos(cosV1V2);
-        double degree = vtkMath::DegreesFromRadians(arccos);
+  // Choosing three plane points to calculate the plane vectors
+  double p1[3];
+  double p2[3];
+  double p3[3];
 
-        // If angle is bigger than 30 degrees break
-        if (degree > 30)
-          break;
+  // The plane vectors
+  double v1[3];
+  double v2[3] = {0};
 
-      } // for (to find 3rd point)
+  // Create first Vector
+  poly->GetPoint(anotherInputPolygonIDs[0], p1);
+  poly->GetPoint(anotherInputPolygonIDs[1], p2);
 
-      // Calculate normal of the plane by taking the cross product of the two vectors
-      vtkMath::Cross(v1, v2, normal);
-      vtkMath::Normalize(normal);
+  v1[0] = p2[0] - p1[0];
+  v1[1] = p2[1] - p1[1];
+  v1[2] = p2[2] - p1[2];
 
-      // Determine position of the plane
-      double lambda = vtkMath::Dot(normal, p1);
+  // Find 3rd point for 2nd vector (The angle between the two plane vectors should be bigger than 30 degrees)
+  for (vtkIdType j = 2; j < anotherInputPolygonSize; j++)
+  {
+    poly->GetPoint(anotherInputPolygonIDs[j], p3);
 
-      /*
-      Calculate the distance to the plane for each point of the current polygon
-      If the distance is zero then save the currentPoint as intersection point
-      */
-      for (vtkIdType k = 0; k < currentCellSize; k++)
-      {
-        double currentPoint[3];
-        currentPoints->GetPoint(currentCell[k], currentPoint);
+    v2[0] = p3[0] - p1[0];
+    v2[1] = p3[1] - p1[1];
+    v2[2] = p3[2] - p1[2];
 
-        double tempPoint[3];
-        tempPoint[0] = normal[0] * currentPoint[0];
-        tempPoint[1] = normal[1] * currentPoint[1];
-        tempPoint[2] = normal[2] * currentPoint[2];
+    // Calculate the angle between the two vector for the current point
+    double dotV1V2 = vtkMath::Dot(v1, v2);
+    double absV1 = sqrt(vtkMath::Dot(v1, v1));
+    double absV2 = sqrt(vtkMath::Dot(v2, v2));
+    double cosV1V2 = dotV1V2 / (absV1 * absV2);
 
-        double temp = tempPoint[0] + tempPoint[1] + tempPoint[2] - lambda;
-        double distance = fabs(temp);
+    double arccos = acos(cosV1V2);
+    double degree = vtkMath::DegreesFromRadians(arccos);
 
-        if (distance > maxDistance)
-        {
-          maxDistance = distance;
-        }
-        if (distance < minDistance)
-        {
-          minDistance = distance;
-        }
-      } // for (to calculate distance and intersections with currentPolygon)
+    // If angle is bigger than 30 degrees break
+    if (degree > 30)
+      break;
 
-      if (maxDistance < 1.5 * m_MaxSpacing && minDistance < 0.5 * m_MinSpacing)
-      {
-        return false;
-      }
+  } // for (to find 3rd point)
 
-      // Because we are considering the plane defined by the acual input polygon only one iteration is sufficient
-      // We do not need to consider each cell of the plane
-      break;
-    } // for (to traverse through all cells of actualInputPolyData)
+  // Calculate normal of the plane by taking the cross product of the two vectors
+  vtkMath::Cross(v1, v2, plane.Normal);
+  vtkMath::Normalize(plane.Normal);
 
-  } // for (to iterate through all inputs)
+  // Determine position of the plane
+  plane.Lambda = vtkMath::Dot(plane.Normal, p1);
+  plane.Valid = true;
 
-  return true;
+  return plane;
 }
 
 void mitk::ReduceContourSetFilter::GenerateOutputInformation()
@@ -506,6 +565,7 @@ void mitk::ReduceContourSetFilter::Reset()
   this->SetNthOutput(0, output.GetPointer());
 
   m_NumberOfPointsAfterReduction = 0;
+  m_ContourPlanes.clear();
 }
 
 void mitk::ReduceContourSetFilter::SetUseProgressBar(bool status)
@@ -25,7 +25,9 @@ found in the LICENSE file.
 #include "vtkPolygon.h"
 #include "vtkSmartPointer.h"
 
+#include <map>
 #include <stack>
+#include <vector>
 
 namespace mitk
 {
@@ -44,6 +46,10 @@ namespace mitk
     max
     spacing of the original image must be provided.
 
+    The reduced polygons of each input are cached. As long as an input, the reduction parameters and the set of its
+    polygons that are incorporated do not change, the output of the previous run is reused. Hence adding a contour
+    to a large set of contours only reduces the new one.
+
     The output is a mitk::Surface.
 
     $Author: fetzer$
@@ -103,6 +109,11 @@ namespace mitk
     void GenerateOutputInformation() override;
 
   private:
+    /** Reduces all incorporated polygons of the given contour. Returns nullptr if no polygon remains. */
+    mitk::Surface::Pointer ReduceContour(vtkPolyData *polyData,
+                                         const std::vector<bool> &incorporatedPolygons,
+                                         unsigned int &numberOfPoints);
+
     void ReduceNumberOfPointsByNthPoint(
       vtkIdType cellSize, const vtkIdType *cell, vtkPoints *points, vtkPolygon *reducedPolygon, vtkPoints *reducedPoints);
 
@@ -115,6 +126,32 @@ namespace mitk
       vtkPoints *currentPoints,
       /*vtkIdType numberOfIntersections, vtkIdType* intersectionPoints,*/ unsigned int currentInputIndex);
 
+    /** The plane of the first polygon of an input which is used to detect intersection contours */
+    struct ContourPlane
+    {
+      bool Valid;
+      double Normal[3];
+      double Lambda;
+    };
+
+    ContourPlane ComputeContourPlane(vtkPolyData *polyData);
+
+    /** The reduction of one input of a previous run */
+    struct ReducedContour
+    {
+      itk::ModifiedTimeType InputTime;
+      std::vector<bool> IncorporatedPolygons;
+      Reduction_Type ReductionType;
+      unsigned int StepSize;
+      double Tolerance;
+      mitk::Surface::Pointer Output;
+      unsigned int NumberOfPoints;
+    };
+
+    std::vector<ContourPlane> m_ContourPlanes;
+    /** The inputs are held, so that the address of a deleted input cannot be taken for a cached one */
+    std::map<mitk::Surface::ConstPointer, ReducedContour> m_ReducedContourCache;
+
     double m_MinSpacing;
     double m_MaxSpacing;
 
@@ -289,7 +289,7 @@ void mitk::SurfaceInterpolationController::Interpolate()
   timeSelector->Update();
   mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
 
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
+  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage, m_SelectedSegmentation, currentTimeStep);
   for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
   {
     mitk::Surface::Pointer reducedContour = m_ReduceFilter->GetOutput(i);
@@ -493,7 +493,7 @@ bool mitk::SurfaceInterpolationController::ReplaceInterpolationSession(mitk::Ima
   timeSelector->SetChannelNr(0);
   timeSelector->Update();
   mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
+  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage, m_SelectedSegmentation, currentTimeStep);
 
   this->RemoveInterpolationSession(oldSession);
   return true;
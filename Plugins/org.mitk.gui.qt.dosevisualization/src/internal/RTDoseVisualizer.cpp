@@ -460,10 +460,12 @@ void RTDoseVisualizer::UpdateColorWashTransferFunction()
 
     float referenceDose;
     m_selectedNode->GetFloatProperty(mitk::RTConstants::REFERENCE_DOSE_PROPERTY_NAME.c_str(),referenceDose);
+    //the transfer function maps the stored pixel values of the dose image
+    const mitk::DoseValueAbs gridScaling = mitk::GetDoseGridScaling(m_selectedNode->GetData());
     mitk::TransferFunction::ControlPoints scalarOpacityPoints;
     scalarOpacityPoints.push_back( std::make_pair(0, 1 ) );
     //Backgroud
-    transferFunction->AddHSVPoint(((isoDoseLevelSet->Begin())->GetDoseValue()*referenceDose)-0.001,0,0,0,1.0,1.0);
+    transferFunction->AddHSVPoint(((isoDoseLevelSet->Begin())->GetDoseValue()*referenceDose-0.001)/gridScaling,0,0,0,1.0,1.0);
 
     for(mitk::IsoDoseLevelSet::ConstIterator itIsoDoseLevel = isoDoseLevelSet->Begin(); itIsoDoseLevel != isoDoseLevelSet->End(); ++itIsoDoseLevel)
     {
@@ -474,11 +476,11 @@ void RTDoseVisualizer::UpdateColorWashTransferFunction()
       if(itIsoDoseLevel->GetVisibleColorWash())
       {
         cCalc->RGBToHSV(itIsoDoseLevel->GetColor()[0],itIsoDoseLevel->GetColor()[1],itIsoDoseLevel->GetColor()[2],&hsv[0],&hsv[1],&hsv[2]);
-        transferFunction->AddHSVPoint(itIsoDoseLevel->GetDoseValue()*referenceDose,hsv[0],hsv[1],hsv[2],1.0,1.0);
+        transferFunction->AddHSVPoint(itIsoDoseLevel->GetDoseValue()*referenceDose/gridScaling,hsv[0],hsv[1],hsv[2],1.0,1.0);
       }
       else
       {
-        scalarOpacityPoints.push_back( std::make_pair(itIsoDoseLevel->GetDoseValue()*referenceDose, 1 ) );
+        scalarOpacityPoints.push_back( std::make_pair(itIsoDoseLevel->GetDoseValue()*referenceDose/gridScaling, 1 ) );
       }
     }
 
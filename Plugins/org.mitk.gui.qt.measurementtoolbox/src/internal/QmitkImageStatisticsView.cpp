@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "QmitkImageStatisticsView.h"
 
+#include <algorithm>
 #include <utility>
 
 // berry includes
@@ -123,6 +124,7 @@ void QmitkImageStatisticsView::CreateConnections()
 void QmitkImageStatisticsView::UpdateIntensityProfile()
 {
   m_Controls.groupBox_intensityProfile->setVisible(false);
+  bool intensityProfileVisible = false;
 
   const auto selectedImageNodes = m_Controls.imageNodesSelector->GetSelectedNodes();
   const auto selectedROINodes = m_Controls.roiNodesSelector->GetSelectedNodes();
@@ -137,35 +139,46 @@ void QmitkImageStatisticsView::UpdateIntensityProfile()
     {
       if (!maskPlanarFigure->IsClosed())
       {
-        mitk::Image::Pointer inputImage;
+        const auto mTime = std::max(image->GetMTime(), maskPlanarFigure->GetMTime());
+
+        // The profiles of all time steps are computed at once, so that the time step slider only selects one of them
+        if (m_IntensityProfilesImage != image || m_IntensityProfilesPlanarFigure != maskPlanarFigure || m_IntensityProfilesMTime != mTime)
+        {
+          m_IntensityProfiles = mitk::ComputeIntensityProfiles(image, maskPlanarFigure);
+          m_IntensityProfilesImage = image;
+          m_IntensityProfilesPlanarFigure = maskPlanarFigure;
+          m_IntensityProfilesMTime = mTime;
+        }
+
+        unsigned int currentTimestep = 0;
         if (image->GetDimension() == 4)
         {
           m_Controls.sliderWidget_intensityProfile->setVisible(true);
           unsigned int maxTimestep = image->GetTimeSteps();
           m_Controls.sliderWidget_intensityProfile->setMaximum(maxTimestep - 1);
-          // Intensity profile can only be calculated on 3D, so extract if 4D
-          mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-          int currentTimestep = static_cast<int>(m_Controls.sliderWidget_intensityProfile->value());
-          timeSelector->SetInput(image);
-          timeSelector->SetTimeNr(currentTimestep);
-          timeSelector->Update();
-
-          inputImage = timeSelector->GetOutput();
+          currentTimestep = static_cast<unsigned int>(m_Controls.sliderWidget_intensityProfile->value());
         }
         else
         {
           m_Controls.sliderWidget_intensityProfile->setVisible(false);
-          inputImage = image;
         }
 
-        auto intensityProfile = mitk::ComputeIntensityProfile(inputImage, maskPlanarFigure);
+        auto intensityProfile = m_IntensityProfiles.at(std::min<std::size_t>(currentTimestep, m_IntensityProfiles.size() - 1));
         m_Controls.groupBox_intensityProfile->setVisible(true);
         m_Controls.widget_intensityProfile->Reset();
         m_Controls.widget_intensityProfile->SetIntensityProfile(intensityProfile.GetPointer(),
           "Intensity Profile of " + selectedImageNodes.front()->GetName());
+        intensityProfileVisible = true;
       }
     }
   }
+
+  if (!intensityProfileVisible)
+  { // do not keep the image and planar figure of a previous selection alive
+    m_IntensityProfiles.clear();
+    m_IntensityProfilesImage = nullptr;
+    m_IntensityProfilesPlanarFigure = nullptr;
+  }
 }
 
 void QmitkImageStatisticsView::UpdateHistogramWidget()
@@ -17,6 +17,7 @@ found in the LICENSE file.
 
 #include <QmitkAbstractView.h>
 #include <mitkImageStatisticsContainer.h>
+#include <mitkIntensityProfile.h>
 #include <QmitkNodeSelectionDialog.h>
 #include <QmitkSliceNavigationListener.h>
 
@@ -90,6 +91,13 @@ private:
 
   QmitkSliceNavigationListener m_TimePointChangeListener;
 
+  /** Intensity profiles of all time steps of the selected image along the selected open planar figure.
+    * They are recomputed only if the image or the planar figure changed, not if the time step changes. */
+  std::vector<mitk::IntensityProfile::Pointer> m_IntensityProfiles;
+  mitk::Image::ConstPointer m_IntensityProfilesImage;
+  mitk::PlanarFigure::ConstPointer m_IntensityProfilesPlanarFigure;
+  itk::ModifiedTimeType m_IntensityProfilesMTime = 0;
+
 };
 
 #endif // QMITKIMAGESTATISTICSVIEW_H